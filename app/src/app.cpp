@@ -8,14 +8,21 @@
 #include "tools/pak_parser.h"
 
 #include "core/event.h"
+#include "core/frandom.h"
 #include "core/ftime.h"
 #include "core/fmemory.h"
+#include "core/fjob.h"
+#include "core/finput.h"
+#include "core/fprofiler.h"
 #include "core/logger.h"
 
+#include "game/replay.h"
 #include "game/resource.h"
 #include "game/scenes/scene_manager.h"
 #include "game/world.h"
 #include "game/fshader.h"
+#include "game/spritesheet.h"
+#include "game/tilemap.h"
 
 struct app_system_state {
   bool app_running {};
@@ -50,8 +57,30 @@ bool app_initialize(i32 build_id) {
     alert("Time system init failed", "Fatal");
     return false;
   }
+  if (not random_system_initialize(0u)) { // INFO: Zero takes a seed from the OS, see random_set_seed()
+    alert("Random system init failed", "Fatal");
+    return false;
+  }
+  if (not job_system_initialize(job_system_recommended_worker_count())) {
+    alert("Job system init failed", "Fatal");
+    return false;
+  }
+  if (not input_system_initialize()) {
+    alert("Input system init failed", "Fatal");
+    return false;
+  }
+  if (not replay_system_initialize()) {
+    alert("Replay system init failed", "Fatal");
+    return false;
+  }
+  #if PROFILER_ENABLED
+    if (not profiler_system_initialize()) {
+      alert("Profiler init failed", "Fatal");
+      return false;
+    }
+  #endif
 
-  state = (app_system_state*)allocate_memory_linear(sizeof(app_system_state), true);
+  state = (app_system_state*)allocate_memory_linear(sizeof(app_system_state), true, MEMORY_TAG_APP);
   if (not state or state == nullptr) {
     alert("App state allocation failed", "Fatal");
     return false;
@@ -78,6 +107,7 @@ bool app_initialize(i32 build_id) {
   }
   set_settings_from_ini_file(CONFIG_FILE_LOCATION);
   state->settings = get_app_settings();
+  set_simulation_tick_rate(state->settings->simulation_tick_rate);
 
 	if (not pak_parser_system_initialize()) {
   	alert("failed to init resourse parser", "Fatal");
@@ -119,6 +149,7 @@ bool app_initialize(i32 build_id) {
   #endif
   
 
+  const f64 pak_parse_begin = GetTime();
   if(not parse_asset_pak(PAK_FILE_ASSET1)) {
     IERROR("app::app_initialize()::failed to parse asset1");
   }
@@ -129,9 +160,7 @@ bool app_initialize(i32 build_id) {
     IERROR("app::app_initialize()::failed to parse map");
   }
 
-  pak_parser_drop_pak_data(PAK_FILE_ASSET1);
-  pak_parser_drop_pak_data(PAK_FILE_ASSET2);
-  pak_parser_drop_pak_data(PAK_FILE_MAP);
+  IINFO("app::app_initialize()::Paks parsed in %.2f ms", (GetTime() - pak_parse_begin) * 1000.0);
 
   if (not loc_parser_system_initialize()) {
     IFATAL("app::app_initialize()::Localization system init failed");
@@ -161,6 +190,14 @@ bool app_initialize(i32 build_id) {
     return false;
   }
   state->post_process_shader = get_shader_by_enum(SHADER_ID_POST_PROCESS);
+  if (not sprite_batch_initialize(SPRITE_BATCH_BACKEND_RAYLIB)) {
+    IFATAL("app::app_initialize()::Sprite batch initialization failed");
+    return false;
+  }
+  if (not tilemap_chunk_cache_initialize(TILEMAP_CHUNK_BACKEND_RAYLIB)) {
+    IFATAL("app::app_initialize()::Tilemap chunk cache initialization failed");
+    return false;
+  }
 
   event_register(EVENT_CODE_APPLICATION_QUIT, application_on_event);
   event_register(EVENT_CODE_TOGGLE_BORDERLESS, application_on_event);
@@ -185,6 +222,10 @@ bool app_initialize(i32 build_id) {
 
   event_fire(EVENT_CODE_SET_POST_PROCESS_FADE_VALUE, event_context(1.f));
 
+  // INFO: Every loader has decoded or copied its files by now. The map pak stays, stages are read from it when they begin
+  pak_parser_drop_pak_data(PAK_FILE_ASSET1);
+  pak_parser_drop_pak_data(PAK_FILE_ASSET2);
+
   state->app_running = true;
   save_ini_file();
   return true;
@@ -195,11 +236,31 @@ bool window_should_close(void) {
 }
 
 bool app_update(void) {
+  #if PROFILER_ENABLED
+    profiler_begin_frame();
+  #endif
+  PROFILE_FUNCTION();
   update_app_settings_state();
 
   if ((IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_W)) || (IsKeyDown(KEY_LEFT_ALT) && IsKeyPressed(KEY_F4))) {
     state->app_running = false;
   }
+  #if PROFILER_ENABLED
+    if (IsKeyPressed(KEY_F3)) {
+      if (IsKeyDown(KEY_LEFT_SHIFT)) {
+        profiler_export_chrome_trace(PROFILER_TRACE_FILE_LOCATION);
+      }
+      else {
+        profiler_toggle_overlay();
+      }
+    }
+    if (IsKeyPressed(KEY_F5)) { // INFO: Armed replays start with the next stage
+      replay_arm_recording(REPLAY_FILE_LOCATION);
+    }
+    if (IsKeyPressed(KEY_F6)) {
+      replay_arm_playback(REPLAY_FILE_LOCATION);
+    }
+  #endif
   if (IsKeyDown(KEY_LEFT_ALT) && IsKeyPressed(KEY_ENTER)) {
     if (state->settings->window_state == 0) {
       event_fire(EVENT_CODE_TOGGLE_BORDERLESS, event_context());
@@ -227,6 +288,7 @@ bool app_update(void) {
   }
 
   update_scene_scene();
+  event_dispatch_deferred();
   update_time();
   return true;
 }
@@ -239,6 +301,9 @@ bool app_render(void) {
     render_scene_interface();
     
     DrawFPS(state->settings->render_width * .8f , state->settings->render_height - SCREEN_OFFSET.y * 5.f );
+    #if PROFILER_ENABLED
+      profiler_render_overlay(SCREEN_OFFSET, 10);
+    #endif
   EndTextureMode();
   
   state->screen_space_camera.target = Vector2 {0.f, 0.f};
@@ -256,6 +321,16 @@ bool app_render(void) {
 
     EndMode2D();
   EndDrawing();
+
+  event_dispatch_deferred(); // INFO: Typed payloads live in the frame arena, nothing may stay queued over the reset
+  shader_system_report_frame_stats();
+  event_report_frame_stats();
+  #if PROFILER_ENABLED
+    profiler_set_counter("heap allocations", static_cast<f64>(get_heap_allocation_count_frame()));
+    profiler_set_counter("frame arena KB", static_cast<f64>(get_frame_arena()->offset) / 1024.0);
+    profiler_end_frame(); // INFO: Frame zone is opened by app_update()
+  #endif
+  memory_frame_reset(); // INFO: Frame scratch lives through one update and one render
   return true;
 }
 
@@ -341,7 +416,7 @@ bool application_on_event(i32 code, event_context context) {
     return true;
   }
   case EVENT_CODE_SET_POST_PROCESS_FADE_VALUE: {
-    set_shader_uniform(SHADER_ID_POST_PROCESS, "fade", data128(static_cast<f32>(context.data.f32[0])));
+    set_shader_uniform_float(SHADER_UNIFORM_ID_POST_PROCESS_FADE, context.data.f32[0]);
     return true;
   }
   default:
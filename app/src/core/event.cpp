@@ -1,28 +1,64 @@
 #include "core/event.h"
 
 #include "core/fmemory.h"
+#include "core/fprofiler.h"
+#include "core/logger.h"
+
+#include <algorithm>
+#if PROFILER_ENABLED
+  #include <chrono>
+#endif
 
 typedef struct event_code_entry {
-    PFN_on_event callback;
+    std::array<PFN_on_event, MAX_EVENT_LISTENER_PER_CODE> callbacks;
+    u16 callback_count;
+    bool coalesce;
+    i32 pending_head; // INFO: Newest queued event of this code, chained through deferred_event::prev_same_code
+    event_code_stats frame_stats;
+    event_code_stats last_frame_stats;
+    f64 latency_total_ms;
+    u32 latency_sample_count;
     event_code_entry(void) {
-        this->callback = nullptr;
+        this->callbacks.fill(nullptr);
+        this->callback_count = 0u;
+        this->coalesce = false;
+        this->pending_head = -1;
+        this->frame_stats = event_code_stats();
+        this->last_frame_stats = event_code_stats();
+        this->latency_total_ms = 0.0;
+        this->latency_sample_count = 0u;
     }
 } event_code_entry;
 
+typedef struct deferred_event {
+    i32 code;
+    i32 prev_same_code;
+    event_context context;
+    u64 post_time_ns;
+} deferred_event;
+
 typedef struct event_system_state {
     std::array<event_code_entry, MAX_EVENT_CODE> registered;
+    std::vector<deferred_event> queue;
+    std::vector<deferred_event> dispatching; // INFO: Queue is swapped in here, so handlers can post while a pass runs
 } event_system_state;
 
 static event_system_state * state;
 
+bool event_dispatch_listeners(i32 code, event_context context);
+u64 event_time_ns(void);
+
 bool event_system_initialize(void) {
     if (state) {
         return false;
     }
-    state = (event_system_state*)allocate_memory_linear(sizeof(event_system_state), true);
+    state = (event_system_state*)allocate_memory_linear(sizeof(event_system_state), true, MEMORY_TAG_CORE);
     if (!state || state == nullptr) {
         return false;
     }
+    *state = event_system_state();
+    state->queue.reserve(MAX_DEFERRED_EVENT_COUNT);
+    state->dispatching.reserve(MAX_DEFERRED_EVENT_COUNT);
 
     return true;
 }
@@ -32,37 +68,44 @@ consteval void event_system_shutdown(void) {
         return;
     }
     state->registered.fill(event_code_entry());
-    
+
     free(state);
     state = nullptr;
 }
 
 bool event_register(i32 code, PFN_on_event on_event) {
-    if (!state) {
+    if (!state || code < 0 || code >= MAX_EVENT_CODE || on_event == nullptr) {
         return false;
     }
-    
-    event_code_entry event;
-    event.callback = on_event;
-    state->registered.at(code) = event;
+    event_code_entry& entry = state->registered.at(code);
+    for (u16 itr_000 = 0u; itr_000 < entry.callback_count; ++itr_000) {
+        if (entry.callbacks.at(itr_000) == on_event) {
+            return true;
+        }
+    }
+    if (entry.callback_count >= MAX_EVENT_LISTENER_PER_CODE) {
+        IWARN("event::event_register()::Listener limit of code %d is reached", code);
+        return false;
+    }
+    entry.callbacks.at(entry.callback_count++) = on_event;
     return true;
 }
 
-[[__deprecated__]] bool event_unregister([[maybe_unused]] i32 code,[[maybe_unused]] PFN_on_event on_event) {
-    if (!state) {
+bool event_unregister(i32 code, PFN_on_event on_event) {
+    if (!state || code < 0 || code >= MAX_EVENT_CODE) {
         return false;
     }
-    //std::vector<registered_event>& events = state->registered[code].events;
-    //if (events.empty()) {
-    //    return false;
-    //}
-    //
-    //for (size_t itr_000 = 0; itr_000 < events.size(); ++itr_000) {
-    //    if (events[itr_000].callback == on_event) {
-    //        events.erase(events.begin() + itr_000);
-    //        return true;
-    //    }
-    //}
+    event_code_entry& entry = state->registered.at(code);
+    for (u16 itr_000 = 0u; itr_000 < entry.callback_count; ++itr_000) {
+        if (entry.callbacks.at(itr_000) != on_event) {
+            continue;
+        }
+        for (u16 itr_111 = itr_000 + 1u; itr_111 < entry.callback_count; ++itr_111) {
+            entry.callbacks.at(itr_111 - 1u) = entry.callbacks.at(itr_111);
+        }
+        entry.callbacks.at(--entry.callback_count) = nullptr;
+        return true;
+    }
     return false;
 }
 
@@ -70,10 +113,140 @@ bool event_fire(i32 code, event_context context) {
     if (!state) {
         return false;
     }
-    PFN_on_event callback = state->registered.at(code).callback;
-    if (!callback || callback == nullptr) {
+    state->registered.at(code).frame_stats.fire_count++;
+    return event_dispatch_listeners(code, context);
+}
+
+bool event_post(i32 code, event_context context) {
+    if (!state || code < 0 || code >= MAX_EVENT_CODE) {
+        return false;
+    }
+    event_code_entry& entry = state->registered.at(code);
+    if (entry.coalesce) {
+        for (i32 itr = entry.pending_head; itr >= 0; itr = state->queue.at(itr).prev_same_code) {
+            const data128& pending = state->queue.at(itr).context.data;
+            if (pending.u64[0] == context.data.u64[0] && pending.u64[1] == context.data.u64[1]) {
+                entry.frame_stats.coalesced_count++;
+                return true;
+            }
+        }
+    }
+    if (state->queue.size() >= MAX_DEFERRED_EVENT_COUNT) {
+        entry.frame_stats.dropped_count++;
         return false;
     }
+    deferred_event event = deferred_event();
+    event.code = code;
+    event.prev_same_code = entry.pending_head;
+    event.context = context;
+    event.post_time_ns = event_time_ns();
+
+    entry.pending_head = static_cast<i32>(state->queue.size());
+    entry.frame_stats.post_count++;
+    state->queue.push_back(event);
+    return true;
+}
+
+void event_set_coalescing(i32 code, bool coalesce) {
+    if (!state || code < 0 || code >= MAX_EVENT_CODE) {
+        return;
+    }
+    state->registered.at(code).coalesce = coalesce;
+}
+
+void event_dispatch_deferred(void) {
+    if (!state || state->queue.empty()) {
+        return;
+    }
+    PROFILE_FUNCTION();
+
+    for (u32 pass = 0u; pass < MAX_EVENT_DISPATCH_PASS && not state->queue.empty(); ++pass) {
+        state->dispatching.swap(state->queue);
+        for (const deferred_event& event : state->dispatching) {
+            state->registered.at(event.code).pending_head = -1;
+        }
+        const u64 dispatch_time_ns = event_time_ns();
+        for (const deferred_event& event : state->dispatching) {
+            event_code_entry& entry = state->registered.at(event.code);
+            if (dispatch_time_ns > event.post_time_ns) {
+                const f64 latency_ms = static_cast<f64>(dispatch_time_ns - event.post_time_ns) / 1000000.0;
+                entry.latency_total_ms += latency_ms;
+                entry.frame_stats.latency_max_ms = std::max(entry.frame_stats.latency_max_ms, latency_ms);
+            }
+            entry.latency_sample_count++;
+            event_dispatch_listeners(event.code, event.context);
+        }
+        state->dispatching.clear();
+    }
+    if (not state->queue.empty()) {
+        IWARN("event::event_dispatch_deferred()::%d events are still queued after %d passes, they are dropped", static_cast<i32>(state->queue.size()), MAX_EVENT_DISPATCH_PASS);
+        for (const deferred_event& event : state->queue) {
+            state->registered.at(event.code).pending_head = -1;
+            state->registered.at(event.code).frame_stats.dropped_count++;
+        }
+        state->queue.clear();
+    }
+}
+
+void event_report_frame_stats(void) {
+    if (!state) {
+        return;
+    }
+    u32 fire_total = 0u;
+    u32 post_total = 0u;
+    u32 coalesced_total = 0u;
+    f64 latency_max_ms = 0.0;
+    for (event_code_entry& entry : state->registered) {
+        if (entry.latency_sample_count > 0u) {
+            entry.frame_stats.latency_avg_ms = entry.latency_total_ms / static_cast<f64>(entry.latency_sample_count);
+        }
+        fire_total += entry.frame_stats.fire_count;
+        post_total += entry.frame_stats.post_count;
+        coalesced_total += entry.frame_stats.coalesced_count;
+        latency_max_ms = std::max(latency_max_ms, entry.frame_stats.latency_max_ms);
+
+        entry.last_frame_stats = entry.frame_stats;
+        entry.frame_stats = event_code_stats();
+        entry.latency_total_ms = 0.0;
+        entry.latency_sample_count = 0u;
+    }
+    #if PROFILER_ENABLED
+        profiler_set_counter("events fired", static_cast<f64>(fire_total));
+        profiler_set_counter("events posted", static_cast<f64>(post_total));
+        profiler_set_counter("events coalesced", static_cast<f64>(coalesced_total));
+        profiler_set_counter("event latency max ms", latency_max_ms);
+    #else
+        (void)fire_total; (void)post_total; (void)coalesced_total; (void)latency_max_ms;
+    #endif
+}
+
+const event_code_stats * event_get_code_stats(i32 code) {
+    if (!state || code < 0 || code >= MAX_EVENT_CODE) {
+        return nullptr;
+    }
+    return &state->registered.at(code).last_frame_stats;
+}
+
+/**
+ * @brief Listeners are copied first, a handler may register or unregister while the event is being dispatched
+ */
+bool event_dispatch_listeners(i32 code, event_context context) {
+    const event_code_entry& entry = state->registered.at(code);
+    const std::array<PFN_on_event, MAX_EVENT_LISTENER_PER_CODE> callbacks = entry.callbacks;
+    const u16 callback_count = entry.callback_count;
+
+    bool handled = false;
+    for (u16 itr_000 = 0u; itr_000 < callback_count; ++itr_000) {
+        handled = callbacks.at(itr_000)(code, context) || handled;
+    }
+    return handled;
+}
 
-    return callback(code, context);
+u64 event_time_ns(void) {
+    #if PROFILER_ENABLED
+        static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+    #else
+        return 0u;
+    #endif
 }
@@ -3,6 +3,12 @@
 #define EVENT_H
 
 #include "defines.h"
+#include "core/fmemory.h"
+#include <type_traits>
+
+#define MAX_EVENT_LISTENER_PER_CODE 4
+#define MAX_DEFERRED_EVENT_COUNT 8192
+#define MAX_EVENT_DISPATCH_PASS 4 // INFO: Events posted by handlers of the deferred queue are dispatched in the next pass
 
 typedef struct event_context {
   data128 data;
@@ -47,15 +53,91 @@ typedef struct event_context {
 
 typedef bool (*PFN_on_event)(i32 code, event_context data);
 
+/**
+ * @brief Counters of one code over the last reported frame. Latencies are measured only when the profiler is enabled.
+ */
+typedef struct event_code_stats {
+  u32 fire_count;
+  u32 post_count;
+  u32 coalesced_count;
+  u32 dropped_count;
+  f64 latency_avg_ms;
+  f64 latency_max_ms;
+  event_code_stats(void) {
+    this->fire_count = 0u;
+    this->post_count = 0u;
+    this->coalesced_count = 0u;
+    this->dropped_count = 0u;
+    this->latency_avg_ms = 0.0;
+    this->latency_max_ms = 0.0;
+  }
+} event_code_stats;
+
 bool event_system_initialize(void) ;
 consteval void event_system_shutdown(void);
 
+/**
+ * @brief A code keeps up to MAX_EVENT_LISTENER_PER_CODE listeners, called in register order. Registering the same callback twice is a no-op.
+ */
 bool event_register(i32 code, PFN_on_event on_event);
 
 bool event_unregister(i32 code, PFN_on_event on_event);
 
+/**
+ * @brief Calls every listener right away, returns true if any of them handled the event
+ */
 bool event_fire(i32 code, event_context context);
 
+/**
+ * @brief Queues the event for the next event_dispatch_deferred(). Main thread only, like event_fire().
+ */
+bool event_post(i32 code, event_context context);
+
+/**
+ * @brief A coalescing code drops a post whose context equals one already waiting in the queue
+ */
+void event_set_coalescing(i32 code, bool coalesce);
+
+/**
+ * @brief Sync point. App calls it after the scene update and again before the frame arena reset, so typed payloads never outlive the frame.
+ */
+void event_dispatch_deferred(void);
+
+/**
+ * @brief Publishes the counters of the frame to the profiler and starts new ones
+ */
+void event_report_frame_stats(void);
+const event_code_stats * event_get_code_stats(i32 code);
+
+/**
+ * @brief Typed payloads travel as a pointer and a size in the context, listeners read them back with event_payload<T>()
+ */
+template <typename T>
+bool event_fire_payload(i32 code, const T& payload) {
+  static_assert(std::is_trivially_copyable_v<T>, "Event payloads must be trivially copyable");
+  return event_fire(code, event_context(static_cast<u64>(reinterpret_cast<uintptr_t>(__builtin_addressof(payload))), static_cast<u64>(sizeof(T))));
+}
+/**
+ * @brief Copies the payload into the frame arena, the copy lives until the frame memory is reset
+ */
+template <typename T>
+bool event_post_payload(i32 code, const T& payload) {
+  static_assert(std::is_trivially_copyable_v<T>, "Event payloads must be trivially copyable");
+  T * copy = static_cast<T *>(arena_allocator_allocate(get_frame_arena(), sizeof(T), alignof(T)));
+  if (not copy or copy == nullptr) {
+    return false;
+  }
+  *copy = payload;
+  return event_post(code, event_context(static_cast<u64>(reinterpret_cast<uintptr_t>(copy)), static_cast<u64>(sizeof(T))));
+}
+template <typename T>
+const T * event_payload(const event_context& context) {
+  if (context.data.u64[1] != static_cast<u64>(sizeof(T))) {
+    return nullptr;
+  }
+  return reinterpret_cast<const T *>(static_cast<uintptr_t>(context.data.u64[0]));
+}
+
 typedef enum system_event_code {
   // app
   EVENT_CODE_APPLICATION_QUIT,
@@ -76,16 +158,29 @@ typedef enum system_event_code {
   EVENT_CODE_SPAWN_ITEM,
   /**
    * @brief coll_data data128(i16[0], i16[1], i16[2], i16[3])
-   * @brief gm_damage_spawn_if_collide(coll_data, damage i16[4], collision_type i16[5]);
+   * @brief gm_damage_spawn_if_collide(coll_data, damage i16[4], collision_type i16[5], source i16[6]);
+   * @brief Damage is queued and lands in the spawn damage stage of the same update, see resolve_spawn_damage()
    */
   EVENT_CODE_DAMAGE_ANY_SPAWN_IF_COLLIDE,
   EVENT_CODE_KILL_ALL_SPAWNS,
 
   // Spawn
   EVENT_CODE_SET_SPAWN_FOLLOW_DISTANCE,
+  /**
+   * @brief Spawn id i32[0], index i32[1], tint r g b a in u8[8] to u8[11]
+   */
   EVENT_CODE_SET_SPAWN_TINT,
+  /**
+   * @brief Spawn id i32[0], index i32[1], duration f32[2]
+   */
   EVENT_CODE_HALT_SPAWN_MOVEMENT,
+  /**
+   * @brief queue_spawn_damage_by_id(id i32[0], damage i32[1], source i32[2]);
+   */
   EVENT_CODE_DAMAGE_SPAWN_BY_ID,
+  /**
+   * @brief Typed payload, event_fire_payload(EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT, damage_rotated_rect_payload);
+   */
   EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT,
 
   // scene_manager
@@ -0,0 +1,129 @@
+#include "finput.h"
+
+#include "core/fmemory.h"
+#include "core/logger.h"
+
+typedef struct input_system_state {
+  input_source source;
+  input_frame scripted_frame;
+  std::array<bool, INPUT_ACTION_MAX> latched_releases;
+
+  input_system_state(void) {
+    this->source = INPUT_SOURCE_DEVICE;
+    this->scripted_frame = input_frame();
+    this->latched_releases.fill(false);
+  }
+} input_system_state;
+
+static input_system_state * state = nullptr;
+
+bool input_device_is_action_down(input_action action);
+bool input_device_is_action_released(input_action action);
+
+bool input_system_initialize(void) {
+  if (state and state != nullptr) {
+    return true;
+  }
+  state = (input_system_state *)allocate_memory_linear(sizeof(input_system_state), true, MEMORY_TAG_CORE);
+  if (not state or state == nullptr) {
+    IERROR("finput::input_system_initialize()::State allocation failed");
+    return false;
+  }
+  *state = input_system_state();
+
+  return true;
+}
+
+void input_set_source(input_source source) {
+  if (not state or state == nullptr) {
+    IWARN("finput::input_set_source()::Input system is not initialized");
+    return;
+  }
+  if (source < INPUT_SOURCE_DEVICE or source >= INPUT_SOURCE_MAX) {
+    IWARN("finput::input_set_source()::Source is out of bound");
+    return;
+  }
+  state->source = source;
+  state->scripted_frame = input_frame();
+  state->latched_releases.fill(false);
+}
+input_source input_get_source(void) {
+  if (not state or state == nullptr) {
+    return INPUT_SOURCE_DEVICE;
+  }
+  return state->source;
+}
+void input_set_scripted_frame(input_frame frame) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  state->scripted_frame = frame;
+}
+
+void input_latch_releases(void) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  for (size_t itr_000 = INPUT_ACTION_UNDEFINED + 1; itr_000 < INPUT_ACTION_MAX; ++itr_000) {
+    const input_action action = static_cast<input_action>(itr_000);
+    const bool released = (state->source == INPUT_SOURCE_DEVICE) 
+      ? input_device_is_action_released(action) 
+      : state->scripted_frame.released.at(action);
+
+    state->latched_releases.at(action) = state->latched_releases.at(action) or released;
+  }
+}
+void input_consume_releases(void) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  state->latched_releases.fill(false);
+}
+
+bool input_is_action_down(input_action action) {
+  if (action <= INPUT_ACTION_UNDEFINED or action >= INPUT_ACTION_MAX) {
+    return false;
+  }
+  if (not state or state == nullptr or state->source == INPUT_SOURCE_DEVICE) {
+    return input_device_is_action_down(action);
+  }
+  return state->scripted_frame.down.at(action);
+}
+bool input_is_action_released(input_action action) {
+  if (action <= INPUT_ACTION_UNDEFINED or action >= INPUT_ACTION_MAX) {
+    return false;
+  }
+  if (not state or state == nullptr) {
+    return input_device_is_action_released(action);
+  }
+  return state->latched_releases.at(action);
+}
+Vector2 input_get_mouse_position(void) {
+  if (not state or state == nullptr or state->source == INPUT_SOURCE_DEVICE) {
+    return GetMousePosition();
+  }
+  return state->scripted_frame.mouse_position;
+}
+
+bool input_device_is_action_down(input_action action) {
+  switch (action) {
+    case INPUT_ACTION_MOVE_UP:    return IsKeyDown(KEY_W);
+    case INPUT_ACTION_MOVE_LEFT:  return IsKeyDown(KEY_A);
+    case INPUT_ACTION_MOVE_DOWN:  return IsKeyDown(KEY_S);
+    case INPUT_ACTION_MOVE_RIGHT: return IsKeyDown(KEY_D);
+    case INPUT_ACTION_ATTACK:     return IsMouseButtonDown(MOUSE_LEFT_BUTTON);
+    case INPUT_ACTION_ROLL:       return IsKeyDown(KEY_SPACE);
+    default: return false;
+  }
+}
+bool input_device_is_action_released(input_action action) {
+  switch (action) {
+    case INPUT_ACTION_MOVE_UP:    return IsKeyReleased(KEY_W);
+    case INPUT_ACTION_MOVE_LEFT:  return IsKeyReleased(KEY_A);
+    case INPUT_ACTION_MOVE_DOWN:  return IsKeyReleased(KEY_S);
+    case INPUT_ACTION_MOVE_RIGHT: return IsKeyReleased(KEY_D);
+    case INPUT_ACTION_ATTACK:     return IsMouseButtonReleased(MOUSE_LEFT_BUTTON);
+    case INPUT_ACTION_ROLL:       return IsKeyReleased(KEY_SPACE);
+    default: return false;
+  }
+}
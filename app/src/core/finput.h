@@ -0,0 +1,61 @@
+
+#ifndef FINPUT_H
+#define FINPUT_H
+
+#include <array>
+
+#include "defines.h"
+#include "raylib.h"
+
+typedef enum input_action {
+  INPUT_ACTION_UNDEFINED,
+  INPUT_ACTION_MOVE_UP,
+  INPUT_ACTION_MOVE_LEFT,
+  INPUT_ACTION_MOVE_DOWN,
+  INPUT_ACTION_MOVE_RIGHT,
+  INPUT_ACTION_ATTACK,
+  INPUT_ACTION_ROLL,
+  INPUT_ACTION_MAX,
+} input_action;
+
+typedef enum input_source {
+  INPUT_SOURCE_DEVICE,
+  INPUT_SOURCE_SCRIPTED,
+  INPUT_SOURCE_MAX,
+} input_source;
+
+/**
+ * @brief Gameplay input of a single update. Mouse position is in window space, same as GetMousePosition()
+ */
+typedef struct input_frame {
+  std::array<bool, INPUT_ACTION_MAX> down;
+  std::array<bool, INPUT_ACTION_MAX> released;
+  Vector2 mouse_position;
+  input_frame(void) {
+    this->down.fill(false);
+    this->released.fill(false);
+    this->mouse_position = Vector2 {0.f, 0.f};
+  }
+} input_frame;
+
+bool input_system_initialize(void);
+
+/**
+ * @brief Device source reads raylib directly. Scripted source answers from the last frame given to input_set_scripted_frame()
+ */
+void input_set_source(input_source source);
+input_source input_get_source(void);
+void input_set_scripted_frame(input_frame frame);
+
+/**
+ * @brief Releases are latched once per rendered frame and held until a simulation tick consumes them,
+ * @brief so a click is neither lost on a frame without ticks nor repeated on a frame with several.
+ */
+void input_latch_releases(void);
+void input_consume_releases(void);
+
+bool input_is_action_down(input_action action);
+bool input_is_action_released(input_action action);
+Vector2 input_get_mouse_position(void);
+
+#endif
@@ -0,0 +1,192 @@
+#include "fjob.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <new>
+
+#include "core/fmemory.h"
+#include "core/logger.h"
+
+typedef struct job_system_state {
+  std::vector<std::thread> workers;
+  std::mutex mutex;
+  std::condition_variable work_signal;
+  std::condition_variable done_signal;
+
+  PFN_job job;
+  void* user_data;
+  u32 job_count;
+  u64 generation;
+  u32 active_workers;
+  bool running;
+
+  std::atomic<u32> next_job;
+  std::atomic<u32> finished_jobs;
+
+  job_system_state(void) {
+    this->job = nullptr;
+    this->user_data = nullptr;
+    this->job_count = 0u;
+    this->generation = 0u;
+    this->active_workers = 0u;
+    this->running = false;
+    this->next_job = 0u;
+    this->finished_jobs = 0u;
+  }
+} job_system_state;
+
+static job_system_state * state = nullptr;
+
+void job_run_pending(PFN_job job, void* user_data, u32 job_count);
+void job_worker_main(void);
+
+bool job_system_initialize(u32 worker_count) {
+  if (state and state != nullptr) {
+    return true;
+  }
+  state = (job_system_state *)allocate_memory_linear(sizeof(job_system_state), true, MEMORY_TAG_CORE);
+  if (not state or state == nullptr) {
+    IERROR("fjob::job_system_initialize()::State allocation failed");
+    return false;
+  }
+  new (state) job_system_state(); // INFO: Mutex and atomics are not assignable, so the state is constructed in place
+
+  if (worker_count > JOB_SYSTEM_MAX_WORKER_COUNT) {
+    worker_count = JOB_SYSTEM_MAX_WORKER_COUNT;
+  }
+  state->running = true;
+  state->workers.reserve(worker_count);
+  for (u32 itr_000 = 0u; itr_000 < worker_count; ++itr_000) {
+    state->workers.emplace_back(job_worker_main);
+  }
+  return true;
+}
+
+void job_system_shutdown(void) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->running = false;
+  }
+  state->work_signal.notify_all();
+
+  for (std::thread& worker : state->workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  state->workers.clear();
+}
+
+bool job_system_set_worker_count(u32 worker_count) {
+  if (not state or state == nullptr) {
+    IWARN("fjob::job_system_set_worker_count()::Job system is not initialized");
+    return false;
+  }
+  job_system_shutdown();
+
+  if (worker_count > JOB_SYSTEM_MAX_WORKER_COUNT) {
+    worker_count = JOB_SYSTEM_MAX_WORKER_COUNT;
+  }
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->running = true;
+  }
+  state->workers.reserve(worker_count);
+  for (u32 itr_000 = 0u; itr_000 < worker_count; ++itr_000) {
+    state->workers.emplace_back(job_worker_main);
+  }
+  return true;
+}
+
+u32 job_system_recommended_worker_count(void) {
+  const u32 hardware_threads = static_cast<u32>(std::thread::hardware_concurrency());
+  if (hardware_threads <= 1u) {
+    return 0u;
+  }
+  return std::min(hardware_threads - 1u, static_cast<u32>(JOB_SYSTEM_MAX_WORKER_COUNT));
+}
+
+u32 job_system_thread_count(void) {
+  if (not state or state == nullptr) {
+    return 1u;
+  }
+  return static_cast<u32>(state->workers.size()) + 1u;
+}
+
+void job_dispatch(u32 job_count, PFN_job job, void* user_data) {
+  if (job_count == 0u or job == nullptr) {
+    return;
+  }
+  if (not state or state == nullptr or state->workers.empty() or job_count == 1u) {
+    for (u32 itr_000 = 0u; itr_000 < job_count; ++itr_000) {
+      job(itr_000, user_data);
+    }
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    // INFO: A worker that woke late for the previous dispatch may still be holding its job pointer
+    state->done_signal.wait(lock, []{ return state->active_workers == 0u; });
+
+    state->job = job;
+    state->user_data = user_data;
+    state->job_count = job_count;
+    state->next_job.store(0u, std::memory_order_relaxed);
+    state->finished_jobs.store(0u, std::memory_order_relaxed);
+    state->generation++;
+  }
+  state->work_signal.notify_all();
+
+  job_run_pending(job, user_data, job_count);
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done_signal.wait(lock, [job_count]{ return state->finished_jobs.load(std::memory_order_acquire) == job_count; });
+}
+
+void job_run_pending(PFN_job job, void* user_data, u32 job_count) {
+  for (u32 index = state->next_job.fetch_add(1u, std::memory_order_relaxed); index < job_count; index = state->next_job.fetch_add(1u, std::memory_order_relaxed)) {
+    job(index, user_data);
+
+    if (state->finished_jobs.fetch_add(1u, std::memory_order_acq_rel) + 1u == job_count) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->done_signal.notify_all();
+    }
+  }
+}
+
+void job_worker_main(void) {
+  u64 seen_generation = 0u;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    seen_generation = state->generation; // INFO: Workers respawned by job_system_set_worker_count() must not pick up the last dispatch again
+  }
+
+  while (true) {
+    PFN_job job = nullptr;
+    void* user_data = nullptr;
+    u32 job_count = 0u;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+      state->work_signal.wait(lock, [&seen_generation]{ return not state->running or state->generation != seen_generation; });
+      if (not state->running) {
+        return;
+      }
+      seen_generation = state->generation;
+      job = state->job;
+      user_data = state->user_data;
+      job_count = state->job_count;
+      state->active_workers++;
+    }
+    job_run_pending(job, user_data, job_count);
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      state->active_workers--;
+    }
+    state->done_signal.notify_all();
+  }
+}
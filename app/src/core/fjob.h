@@ -0,0 +1,40 @@
+
+#ifndef FJOB_H
+#define FJOB_H
+
+#include "defines.h"
+
+#define JOB_SYSTEM_MAX_WORKER_COUNT 7
+
+/**
+ * @brief Called once per job index. Jobs of a single dispatch must not write to shared data.
+ */
+typedef void (*PFN_job)(u32 job_index, void* user_data);
+
+/**
+ * @brief Spawns a fixed worker pool. Zero workers is valid, dispatches then run on the calling thread.
+ */
+bool job_system_initialize(u32 worker_count);
+void job_system_shutdown(void);
+
+/**
+ * @brief Joins the current workers and spawns worker_count new ones, clamped like job_system_initialize(). Not to be called while a dispatch runs.
+ */
+bool job_system_set_worker_count(u32 worker_count);
+
+/**
+ * @brief Hardware threads minus the main thread, clamped to JOB_SYSTEM_MAX_WORKER_COUNT
+ */
+u32 job_system_recommended_worker_count(void);
+
+/**
+ * @brief Worker threads plus the calling thread
+ */
+u32 job_system_thread_count(void);
+
+/**
+ * @brief Runs job(0 .. job_count - 1) over the workers and the calling thread. Returns when every job is done.
+ */
+void job_dispatch(u32 job_count, PFN_job job, void* user_data);
+
+#endif
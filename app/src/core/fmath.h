@@ -36,5 +36,11 @@ static inline f32 vec2_distance_sq(Vector2 v1, Vector2 v2) {
     f32 dy = v1.y - v2.y;
     return (dx * dx) + (dy * dy);
 }
+static inline Vector2 vec2_lerp(Vector2 from, Vector2 to, f32 t) {
+    return Vector2 { from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t };
+}
+static inline Rectangle rect_offset(Rectangle rect, Vector2 offset) {
+    return Rectangle { rect.x + offset.x, rect.y + offset.y, rect.width, rect.height };
+}
 
 #endif
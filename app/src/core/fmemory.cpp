@@ -2,56 +2,131 @@
 
 #include <stdlib.h> // Required for: malloc(), free()
 #include <string.h> // Required for: memset(), memcpy()
+#include <stdint.h> // Required for: uintptr_t
 #include <stdexcept> // Required for: runtime_error()
+#include <new> // Required for: bad_alloc, nothrow_t
+#include <atomic>
 
 #define TOTAL_ALLOCATED_MEMORY 512 * 1024 * 1024
+#define FRAME_ARENA_SIZE 8 * 1024 * 1024
 
 typedef struct memory_system_state {
     unsigned long long linear_memory_total_size;
     unsigned long long  linear_memory_allocated;
     void *linear_memory;
+    memory_arena frame_arena;
+    memory_usage_stats stats;
   } memory_system_state;
 
 static memory_system_state* memory_system;
 
+// INFO: Outside of the state, operator new runs before memory_system_initialize() and on job workers
+static std::atomic<unsigned long long> heap_allocation_count_frame {0u};
+static std::atomic<unsigned long long> heap_allocation_count_last_frame {0u};
+
+static inline bool is_power_of_two(unsigned long long value) {
+    return value != 0u and (value & (value - 1u)) == 0u;
+}
+static inline unsigned long long align_forward(unsigned long long value, unsigned long long alignment) {
+    return (value + (alignment - 1u)) & ~(alignment - 1u);
+}
+static inline void memory_stats_add(memory_tag tag, unsigned long long size) {
+    memory_usage_stats& stats = memory_system->stats;
+    stats.current[tag] += size;
+    if (stats.current[tag] > stats.high_water[tag]) {
+        stats.high_water[tag] = stats.current[tag];
+    }
+}
+static inline void memory_stats_remove(memory_tag tag, unsigned long long size) {
+    memory_usage_stats& stats = memory_system->stats;
+    stats.current[tag] = (stats.current[tag] > size) ? stats.current[tag] - size : 0u;
+}
+
+/**
+ * @brief Carves a block from the linear memory without accounting it to a tag
+ */
+static void* linear_memory_reserve(unsigned long long size, unsigned long long alignment) {
+    if (not is_power_of_two(alignment)) {
+        throw std::runtime_error("Alignment is not a power of two");
+    }
+    const uintptr_t base = reinterpret_cast<uintptr_t>(memory_system->linear_memory);
+    const unsigned long long padding = align_forward(base + memory_system->linear_memory_allocated, alignment) - (base + memory_system->linear_memory_allocated);
+
+    if (memory_system->linear_memory_allocated + padding + size > memory_system->linear_memory_total_size) {
+      throw std::runtime_error("Insufficient memory");
+    }
+    void* block = ((unsigned char*)memory_system->linear_memory) + memory_system->linear_memory_allocated + padding;
+    memory_system->linear_memory_allocated += padding + size;
+    memory_system->stats.linear_memory_allocated = memory_system->linear_memory_allocated;
+
+    return block;
+}
+
 void memory_system_initialize(void) {
     memory_system = (memory_system_state*)malloc(sizeof(memory_system_state));
+    memset(memory_system, 0, sizeof(memory_system_state));
     memory_system->linear_memory_total_size = TOTAL_ALLOCATED_MEMORY;
     memory_system->linear_memory_allocated = 0u;
     memory_system->linear_memory = nullptr;
 
     memory_system->linear_memory = malloc(memory_system->linear_memory_total_size);
-}
+    memory_system->stats.linear_memory_total_size = memory_system->linear_memory_total_size;
 
-void* allocate_memory_linear(unsigned long long  size, bool will_zero_memory) {
-
-    if (memory_system->linear_memory_allocated + size > memory_system->linear_memory_total_size) {
-      throw std::runtime_error("Insufficient memory");
+    if (not memory_arena_create(&memory_system->frame_arena, FRAME_ARENA_SIZE, MEMORY_TAG_FRAME)) {
+        throw std::runtime_error("Frame arena creation failed");
     }
-    if (size % sizeof(size_t) != 0) {
-      throw std::runtime_error("Unaligned memory");
-    }
-    void* block = ((unsigned char*)memory_system->linear_memory) + memory_system->linear_memory_allocated;
-    memory_system->linear_memory_allocated += size;
+}
+
+void* allocate_memory_linear(unsigned long long  size, bool will_zero_memory, memory_tag tag) {
+    // INFO: Sizes are padded instead of rejected, every linear block stays pointer aligned
+    return allocate_memory_linear_aligned(align_forward(size, sizeof(size_t)), sizeof(size_t), will_zero_memory, tag);
+}
+void* allocate_memory_linear_aligned(unsigned long long size, unsigned long long alignment, bool will_zero_memory, memory_tag tag) {
+    void* block = linear_memory_reserve(size, alignment);
+    memory_stats_add(tag, size);
 
     if (will_zero_memory) memset(block, 0, size);
 
     return block;
 }
 void* allocate_memory(unsigned long long size, bool will_zero_memory) {
+    heap_allocation_count_frame.fetch_add(1u, std::memory_order_relaxed);
     void* block = malloc(size);
 
     if (block == NULL) {
-        // TODO: 
+        // TODO:
         exit(EXIT_FAILURE);
     }
     if (will_zero_memory) memset(block, 0, size);
 
     return block;
 }
+void* allocate_memory_aligned(unsigned long long size, unsigned long long alignment, bool will_zero_memory) {
+    if (not is_power_of_two(alignment)) {
+        throw std::runtime_error("Alignment is not a power of two");
+    }
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+    // INFO: Over-allocates and stores the original pointer right before the aligned block
+    unsigned char* raw = (unsigned char*)allocate_memory(size + alignment + sizeof(void*), false);
+    const uintptr_t aligned = align_forward(reinterpret_cast<uintptr_t>(raw) + sizeof(void*), alignment);
+    void* block = reinterpret_cast<void*>(aligned);
+    reinterpret_cast<void**>(block)[-1] = raw;
+
+    if (will_zero_memory) memset(block, 0, size);
+
+    return block;
+}
 void free_memory(void* block) {
     free(block);
 }
+void free_memory_aligned(void* block) {
+    if (block == nullptr) {
+        return;
+    }
+    free(reinterpret_cast<void**>(block)[-1]);
+}
 void zero_memory(void* block, unsigned long long  size) {
     memset(block, 0, size);
 }
@@ -61,3 +136,228 @@ void* copy_memory(void* dest, const void* source, unsigned long long  size) {
 void* set_memory(void* dest, int value, unsigned long long  size) {
     return memset(dest, value, size);
 }
+
+bool memory_arena_create(memory_arena* arena, unsigned long long capacity, memory_tag tag) {
+    if (arena == nullptr or capacity == 0u) {
+        return false;
+    }
+    // INFO: The reserved block is accounted to the arena's tag as it gets used, not when it is carved
+    arena->base = (unsigned char*)linear_memory_reserve(capacity, MEMORY_DEFAULT_ALIGNMENT);
+    arena->capacity = capacity;
+    arena->offset = 0u;
+    arena->high_water = 0u;
+    arena->tag = tag;
+    return true;
+}
+void* memory_arena_allocate(memory_arena* arena, unsigned long long size, unsigned long long alignment, bool will_zero_memory) {
+    if (not is_power_of_two(alignment)) {
+        throw std::runtime_error("Alignment is not a power of two");
+    }
+    const uintptr_t base = reinterpret_cast<uintptr_t>(arena->base);
+    const unsigned long long start = align_forward(base + arena->offset, alignment) - base;
+
+    if (start + size > arena->capacity) {
+        return nullptr;
+    }
+    void* block = arena->base + start;
+    memory_stats_add(arena->tag, start + size - arena->offset);
+    arena->offset = start + size;
+    if (arena->offset > arena->high_water) {
+        arena->high_water = arena->offset;
+    }
+    if (will_zero_memory) memset(block, 0, size);
+
+    return block;
+}
+memory_arena_marker memory_arena_get_marker(memory_arena* arena) {
+    return memory_arena_marker {arena, arena->offset};
+}
+void memory_arena_rollback(memory_arena_marker marker) {
+    if (marker.arena == nullptr or marker.offset > marker.arena->offset) {
+        return;
+    }
+    memory_stats_remove(marker.arena->tag, marker.arena->offset - marker.offset);
+    marker.arena->offset = marker.offset;
+}
+void memory_arena_reset(memory_arena* arena) {
+    memory_arena_rollback(memory_arena_marker {arena, 0u});
+}
+
+memory_arena_scope::memory_arena_scope(memory_arena* arena) {
+    this->marker = memory_arena_get_marker(arena);
+}
+memory_arena_scope::~memory_arena_scope(void) {
+    memory_arena_rollback(this->marker);
+}
+
+bool memory_pool_create(memory_pool* pool, unsigned long long block_size, unsigned long long block_count, memory_tag tag) {
+    if (pool == nullptr or block_size == 0u or block_count == 0u) {
+        return false;
+    }
+    pool->block_size = align_forward(block_size < sizeof(void*) ? sizeof(void*) : block_size, sizeof(void*));
+    pool->block_count = block_count;
+    pool->base = (unsigned char*)linear_memory_reserve(pool->block_size * block_count, MEMORY_DEFAULT_ALIGNMENT);
+    pool->tag = tag;
+
+    memory_pool_reset(pool);
+    return true;
+}
+void* memory_pool_allocate(memory_pool* pool, bool will_zero_memory) {
+    if (pool->free_list == nullptr) {
+        return nullptr;
+    }
+    void* block = pool->free_list;
+    pool->free_list = *reinterpret_cast<void**>(block);
+    pool->used_blocks++;
+    if (pool->used_blocks > pool->high_water_blocks) {
+        pool->high_water_blocks = pool->used_blocks;
+    }
+    memory_stats_add(pool->tag, pool->block_size);
+
+    if (will_zero_memory) memset(block, 0, pool->block_size);
+
+    return block;
+}
+void memory_pool_free(memory_pool* pool, void* block) {
+    if (block == nullptr) {
+        return;
+    }
+    *reinterpret_cast<void**>(block) = pool->free_list;
+    pool->free_list = block;
+    pool->used_blocks--;
+    memory_stats_remove(pool->tag, pool->block_size);
+}
+void memory_pool_reset(memory_pool* pool) {
+    memory_stats_remove(pool->tag, pool->used_blocks * pool->block_size);
+    pool->used_blocks = 0u;
+    pool->free_list = nullptr;
+
+    // INFO: Linked back to front, so the first allocation returns the first block
+    for (unsigned long long itr_000 = pool->block_count; itr_000-- > 0u;) {
+        void* block = pool->base + (itr_000 * pool->block_size);
+        *reinterpret_cast<void**>(block) = pool->free_list;
+        pool->free_list = block;
+    }
+}
+
+memory_arena* get_frame_arena(void) {
+    return &memory_system->frame_arena;
+}
+void memory_frame_reset(void) {
+    memory_arena_reset(&memory_system->frame_arena);
+    heap_allocation_count_last_frame.store(heap_allocation_count_frame.exchange(0u, std::memory_order_relaxed), std::memory_order_relaxed);
+}
+unsigned long long get_heap_allocation_count_frame(void) {
+    return heap_allocation_count_frame.load(std::memory_order_relaxed);
+}
+unsigned long long get_heap_allocation_count_last_frame(void) {
+    return heap_allocation_count_last_frame.load(std::memory_order_relaxed);
+}
+
+static inline bool arena_owns(const memory_arena* arena, const void* block) {
+    const unsigned char* ptr = static_cast<const unsigned char*>(block);
+    return arena != nullptr and ptr >= arena->base and ptr < arena->base + arena->capacity;
+}
+void* arena_allocator_allocate(memory_arena* arena, unsigned long long size, unsigned long long alignment) {
+    if (arena != nullptr) {
+        void* block = memory_arena_allocate(arena, size, alignment, false);
+        if (block != nullptr) {
+            return block;
+        }
+    }
+    return allocate_memory(size, false);
+}
+void arena_allocator_deallocate(memory_arena* arena, void* block, unsigned long long size) {
+    if (block == nullptr) {
+        return;
+    }
+    if (not arena_owns(arena, block)) {
+        free_memory(block);
+        return;
+    }
+    // INFO: Only the most recent allocation can be given back
+    const unsigned long long offset = static_cast<unsigned long long>(static_cast<unsigned char*>(block) - arena->base);
+    if (offset + size == arena->offset) {
+        memory_arena_rollback(memory_arena_marker {arena, offset});
+    }
+}
+void* pool_allocator_allocate(memory_pool* pool, unsigned long long size) {
+    if (pool != nullptr and size <= pool->block_size) {
+        void* block = memory_pool_allocate(pool, false);
+        if (block != nullptr) {
+            return block;
+        }
+    }
+    return allocate_memory(size, false);
+}
+void pool_allocator_deallocate(memory_pool* pool, void* block) {
+    if (block == nullptr) {
+        return;
+    }
+    const unsigned char* ptr = static_cast<const unsigned char*>(block);
+    if (pool != nullptr and ptr >= pool->base and ptr < pool->base + (pool->block_size * pool->block_count)) {
+        memory_pool_free(pool, block);
+        return;
+    }
+    free_memory(block);
+}
+
+const memory_usage_stats* get_memory_usage_stats(void) {
+    return &memory_system->stats;
+}
+const char* memory_tag_to_string(memory_tag tag) {
+    switch (tag) {
+        case MEMORY_TAG_UNKNOWN:        return "UNKNOWN";
+        case MEMORY_TAG_CORE:           return "CORE";
+        case MEMORY_TAG_APP:            return "APP";
+        case MEMORY_TAG_TOOLS:          return "TOOLS";
+        case MEMORY_TAG_RESOURCE:       return "RESOURCE";
+        case MEMORY_TAG_SOUND:          return "SOUND";
+        case MEMORY_TAG_WORLD:          return "WORLD";
+        case MEMORY_TAG_SCENE:          return "SCENE";
+        case MEMORY_TAG_USER_INTERFACE: return "USER_INTERFACE";
+        case MEMORY_TAG_GAME:           return "GAME";
+        case MEMORY_TAG_SPAWN:          return "SPAWN";
+        case MEMORY_TAG_ABILITY:        return "ABILITY";
+        case MEMORY_TAG_FRAME:          return "FRAME";
+        default: return "INVALID";
+    }
+}
+
+// INFO: Replaced global allocation functions, only to count heap traffic
+void* operator new(std::size_t size) {
+    heap_allocation_count_frame.fetch_add(1u, std::memory_order_relaxed);
+    void* block = malloc(size == 0u ? 1u : size);
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    return block;
+}
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    heap_allocation_count_frame.fetch_add(1u, std::memory_order_relaxed);
+    return malloc(size == 0u ? 1u : size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+void operator delete(void* block) noexcept {
+    free(block);
+}
+void operator delete[](void* block) noexcept {
+    free(block);
+}
+void operator delete(void* block, std::size_t) noexcept {
+    free(block);
+}
+void operator delete[](void* block, std::size_t) noexcept {
+    free(block);
+}
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    free(block);
+}
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    free(block);
+}
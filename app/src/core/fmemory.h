@@ -2,14 +2,179 @@
 #ifndef FMEMORY_H
 #define FMEMORY_H
 
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#define MEMORY_DEFAULT_ALIGNMENT 16u
+
+typedef enum memory_tag {
+  MEMORY_TAG_UNKNOWN,
+  MEMORY_TAG_CORE,
+  MEMORY_TAG_APP,
+  MEMORY_TAG_TOOLS,
+  MEMORY_TAG_RESOURCE,
+  MEMORY_TAG_SOUND,
+  MEMORY_TAG_WORLD,
+  MEMORY_TAG_SCENE,
+  MEMORY_TAG_USER_INTERFACE,
+  MEMORY_TAG_GAME,
+  MEMORY_TAG_SPAWN,
+  MEMORY_TAG_ABILITY,
+  MEMORY_TAG_FRAME,
+  MEMORY_TAG_MAX,
+} memory_tag;
+
+/**
+ * @brief Bump allocator over a block carved from the linear memory. Never frees individual allocations.
+ */
+typedef struct memory_arena {
+  unsigned char* base;
+  unsigned long long capacity;
+  unsigned long long offset;
+  unsigned long long high_water;
+  memory_tag tag;
+} memory_arena;
+
+typedef struct memory_arena_marker {
+  memory_arena* arena;
+  unsigned long long offset;
+} memory_arena_marker;
+
+/**
+ * @brief Rolls the arena back to where it was when the scope was opened
+ */
+struct memory_arena_scope {
+  memory_arena_marker marker;
+  memory_arena_scope(memory_arena* arena);
+  ~memory_arena_scope(void);
+  memory_arena_scope(const memory_arena_scope&) = delete;
+  memory_arena_scope& operator=(const memory_arena_scope&) = delete;
+};
+
+/**
+ * @brief Fixed-size blocks with an intrusive free list. Block size is rounded up to pointer size.
+ */
+typedef struct memory_pool {
+  unsigned char* base;
+  void* free_list;
+  unsigned long long block_size;
+  unsigned long long block_count;
+  unsigned long long used_blocks;
+  unsigned long long high_water_blocks;
+  memory_tag tag;
+} memory_pool;
+
+typedef struct memory_usage_stats {
+  unsigned long long linear_memory_total_size;
+  unsigned long long linear_memory_allocated;
+  unsigned long long current[MEMORY_TAG_MAX];
+  unsigned long long high_water[MEMORY_TAG_MAX];
+} memory_usage_stats;
+
 void memory_system_initialize(void);
 
 void* allocate_memory(unsigned long long size, bool will_zero_memory);
-void* allocate_memory_linear(unsigned long long  size, bool will_zero_memory);
+void* allocate_memory_linear(unsigned long long  size, bool will_zero_memory, memory_tag tag = MEMORY_TAG_UNKNOWN);
+void* allocate_memory_linear_aligned(unsigned long long size, unsigned long long alignment, bool will_zero_memory, memory_tag tag);
+void* allocate_memory_aligned(unsigned long long size, unsigned long long alignment, bool will_zero_memory);
 
 void free_memory(void* block);
+void free_memory_aligned(void* block);
 void zero_memory(void* block, unsigned long long  size);
 void* copy_memory(void* dest, const void* source, unsigned long long  size);
 void* set_memory(void* dest, int value, unsigned long long  size);
 
+bool memory_arena_create(memory_arena* arena, unsigned long long capacity, memory_tag tag);
+void* memory_arena_allocate(memory_arena* arena, unsigned long long size, unsigned long long alignment, bool will_zero_memory);
+memory_arena_marker memory_arena_get_marker(memory_arena* arena);
+void memory_arena_rollback(memory_arena_marker marker);
+void memory_arena_reset(memory_arena* arena);
+
+bool memory_pool_create(memory_pool* pool, unsigned long long block_size, unsigned long long block_count, memory_tag tag);
+void* memory_pool_allocate(memory_pool* pool, bool will_zero_memory);
+void memory_pool_free(memory_pool* pool, void* block);
+void memory_pool_reset(memory_pool* pool);
+
+/**
+ * @brief Scratch arena valid until the end of the current frame. Main thread only.
+ */
+memory_arena* get_frame_arena(void);
+void memory_frame_reset(void);
+
+/**
+ * @brief Bytes in use and the high water mark for each tag, linear blocks, pools and arena allocations alike
+ */
+const memory_usage_stats* get_memory_usage_stats(void);
+const char* memory_tag_to_string(memory_tag tag);
+
+/**
+ * @brief Global heap allocations (operator new and allocate_memory) made since the last memory_frame_reset()
+ */
+unsigned long long get_heap_allocation_count_frame(void);
+/**
+ * @brief Heap allocation count of the last finished frame
+ */
+unsigned long long get_heap_allocation_count_last_frame(void);
+
+void* arena_allocator_allocate(memory_arena* arena, unsigned long long size, unsigned long long alignment);
+void arena_allocator_deallocate(memory_arena* arena, void* block, unsigned long long size);
+void* pool_allocator_allocate(memory_pool* pool, unsigned long long size);
+void pool_allocator_deallocate(memory_pool* pool, void* block);
+
+/**
+ * @brief STL allocator over a memory_arena. Deallocation is a no-op unless the block is the last one in the arena.
+ * Falls back to the heap when there is no arena or the arena is full. Containers must be emptied and
+ * their capacity released before the arena is reset.
+ */
+template <typename T>
+struct arena_allocator {
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  memory_arena* arena;
+
+  arena_allocator(void) : arena(nullptr) {}
+  arena_allocator(memory_arena* _arena) : arena(_arena) {}
+  template <typename U> arena_allocator(const arena_allocator<U>& other) : arena(other.arena) {}
+
+  T* allocate(size_t count) {
+    return static_cast<T*>(arena_allocator_allocate(arena, count * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* block, size_t count) {
+    arena_allocator_deallocate(arena, block, count * sizeof(T));
+  }
+  template <typename U> bool operator==(const arena_allocator<U>& other) const { return arena == other.arena; }
+  template <typename U> bool operator!=(const arena_allocator<U>& other) const { return arena != other.arena; }
+};
+
+/**
+ * @brief STL allocator over a memory_pool, meant for node based containers. Requests bigger than a block go to the heap.
+ */
+template <typename T>
+struct pool_allocator {
+  typedef T value_type;
+  typedef std::true_type propagate_on_container_move_assignment;
+  typedef std::true_type propagate_on_container_swap;
+
+  memory_pool* pool;
+
+  pool_allocator(void) : pool(nullptr) {}
+  pool_allocator(memory_pool* _pool) : pool(_pool) {}
+  template <typename U> pool_allocator(const pool_allocator<U>& other) : pool(other.pool) {}
+
+  T* allocate(size_t count) {
+    return static_cast<T*>(pool_allocator_allocate(pool, count * sizeof(T)));
+  }
+  void deallocate(T* block, [[maybe_unused]] size_t count) {
+    pool_allocator_deallocate(pool, block);
+  }
+  template <typename U> bool operator==(const pool_allocator<U>& other) const { return pool == other.pool; }
+  template <typename U> bool operator!=(const pool_allocator<U>& other) const { return pool != other.pool; }
+};
+
+template <typename T>
+using arena_vector = std::vector<T, arena_allocator<T>>;
+
 #endif
@@ -0,0 +1,364 @@
+#include "fprofiler.h"
+
+#if PROFILER_ENABLED
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <new>
+#include <algorithm>
+
+#include "core/fmemory.h"
+#include "core/logger.h"
+
+#define PROFILER_OVERLAY_BACKGROUND CLITERAL(Color){ 0, 0, 0, 170 }
+#define PROFILER_OVERLAY_COLUMN_WIDTH 5.f // INFO: In font sizes
+
+typedef struct profiler_event {
+  const char * name;
+  u64 begin_ns;
+  u64 end_ns;
+  u32 depth;
+  bool is_closed;
+} profiler_event;
+
+typedef struct profiler_thread_buffer {
+  std::array<profiler_event, PROFILER_RING_CAPACITY> events;
+  std::array<u64, PROFILER_MAX_DEPTH> open_zones; // INFO: Serials of the events that are not closed yet
+  u64 event_count;     // INFO: Serial of the next event, slot is serial % PROFILER_RING_CAPACITY
+  u64 processed_count; // INFO: Events before this serial are already in the frame history
+  u32 depth;
+} profiler_thread_buffer;
+
+typedef struct profiler_zone {
+  const char * name;
+  u32 depth;
+  f64 frame_ms;
+  std::array<f64, PROFILER_HISTORY_FRAMES> history_ms;
+} profiler_zone;
+
+typedef struct profiler_counter {
+  const char * name;
+  f64 value;
+} profiler_counter;
+
+typedef struct profiler_system_state {
+  std::array<profiler_thread_buffer, PROFILER_MAX_THREADS> threads;
+  std::atomic<u32> thread_count;
+  std::chrono::steady_clock::time_point epoch;
+
+  std::array<profiler_zone, PROFILER_MAX_ZONES> zones;
+  u32 zone_count;
+  u32 history_head;
+  u32 history_count;
+
+  std::array<profiler_counter, PROFILER_MAX_COUNTERS> counters;
+  u32 counter_count;
+
+  std::vector<profiler_zone_stats> zone_stats;
+  bool is_stats_dirty;
+  bool is_overlay_visible;
+
+  profiler_system_state(void) { // INFO: Buffers and zones are left to the zeroed allocation
+    this->thread_count = 0u;
+    this->epoch = std::chrono::steady_clock::now();
+    this->zone_count = 0u;
+    this->history_head = 0u;
+    this->history_count = 0u;
+    this->counter_count = 0u;
+    this->zone_stats = std::vector<profiler_zone_stats>();
+    this->is_stats_dirty = false;
+    this->is_overlay_visible = false;
+  }
+} profiler_system_state;
+
+static profiler_system_state * state = nullptr;
+static thread_local profiler_thread_buffer * thread_buffer = nullptr;
+static thread_local bool is_thread_rejected = false;
+
+profiler_thread_buffer * profiler_get_thread_buffer(void);
+u64 profiler_now_ns(void);
+profiler_zone * profiler_get_zone(const char * name, u32 depth);
+void profiler_collect_thread(profiler_thread_buffer& buffer);
+void profiler_refresh_stats(void);
+
+bool profiler_system_initialize(void) {
+  if (state and state != nullptr) {
+    return true;
+  }
+  state = (profiler_system_state *)allocate_memory_linear(sizeof(profiler_system_state), true, MEMORY_TAG_CORE);
+  if (not state or state == nullptr) {
+    IERROR("fprofiler::profiler_system_initialize()::State allocation failed");
+    return false;
+  }
+  new (state) profiler_system_state(); // INFO: Ring buffers are too large for a temporary, and the atomic is not assignable
+
+  profiler_get_thread_buffer(); // INFO: Calling thread takes the first buffer, it is the main thread on the trace
+  return true;
+}
+
+void profiler_begin_frame(void) {
+  profiler_begin_zone("frame");
+}
+/**
+ * @brief Closes the frame zone and moves every closed event of the frame into the zone history.
+ * @brief An event that is still open holds back its thread until it closes, so no zone is counted twice.
+ */
+void profiler_end_frame(void) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  profiler_end_zone();
+
+  for (u32 itr_000 = 0u; itr_000 < state->zone_count; ++itr_000) {
+    state->zones.at(itr_000).frame_ms = 0.0;
+  }
+  const u32 thread_count = std::min(state->thread_count.load(std::memory_order_acquire), static_cast<u32>(PROFILER_MAX_THREADS));
+  for (u32 itr_000 = 0u; itr_000 < thread_count; ++itr_000) {
+    profiler_collect_thread(state->threads.at(itr_000));
+  }
+  for (u32 itr_000 = 0u; itr_000 < state->zone_count; ++itr_000) {
+    profiler_zone& zone = state->zones.at(itr_000);
+    zone.history_ms.at(state->history_head) = zone.frame_ms;
+  }
+  state->history_head = (state->history_head + 1u) % PROFILER_HISTORY_FRAMES;
+  state->history_count = std::min(state->history_count + 1u, static_cast<u32>(PROFILER_HISTORY_FRAMES));
+  state->is_stats_dirty = true;
+}
+
+void profiler_begin_zone(const char * name) {
+  profiler_thread_buffer * buffer = profiler_get_thread_buffer();
+  if (not buffer or buffer == nullptr) {
+    return;
+  }
+  const u32 depth = buffer->depth++;
+  if (depth >= PROFILER_MAX_DEPTH) {
+    return; // INFO: Only counted, so the matching end stays balanced
+  }
+  const u64 serial = buffer->event_count;
+  buffer->events.at(serial % PROFILER_RING_CAPACITY) = profiler_event {name, profiler_now_ns(), 0u, depth, false};
+  buffer->open_zones.at(depth) = serial;
+  buffer->event_count = serial + 1u;
+}
+void profiler_end_zone(void) {
+  profiler_thread_buffer * buffer = profiler_get_thread_buffer();
+  if (not buffer or buffer == nullptr or buffer->depth == 0u) {
+    return;
+  }
+  const u32 depth = --buffer->depth;
+  if (depth >= PROFILER_MAX_DEPTH) {
+    return;
+  }
+  const u64 serial = buffer->open_zones.at(depth);
+  if (buffer->event_count - serial > PROFILER_RING_CAPACITY) {
+    return; // INFO: Overwritten by newer events while it was open
+  }
+  profiler_event& event = buffer->events.at(serial % PROFILER_RING_CAPACITY);
+  event.end_ns = profiler_now_ns();
+  event.is_closed = true;
+}
+
+const std::vector<profiler_zone_stats>& profiler_get_zone_stats(void) {
+  static const std::vector<profiler_zone_stats> empty_stats = std::vector<profiler_zone_stats>();
+  if (not state or state == nullptr) {
+    return empty_stats;
+  }
+  if (state->is_stats_dirty) {
+    profiler_refresh_stats();
+  }
+  return state->zone_stats;
+}
+
+void profiler_set_counter(const char * name, f64 value) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  for (u32 itr_000 = 0u; itr_000 < state->counter_count; ++itr_000) {
+    if (state->counters.at(itr_000).name == name) {
+      state->counters.at(itr_000).value = value;
+      return;
+    }
+  }
+  if (state->counter_count >= PROFILER_MAX_COUNTERS) {
+    return;
+  }
+  state->counters.at(state->counter_count++) = profiler_counter {name, value};
+}
+
+/**
+ * @brief Writes the closed events still in the ring buffers as complete events ("ph":"X"), loadable by chrome://tracing and Perfetto
+ */
+bool profiler_export_chrome_trace(const char * path) {
+  if (not state or state == nullptr) {
+    IWARN("fprofiler::profiler_export_chrome_trace()::Profiler is not initialized");
+    return false;
+  }
+  std::string trace = std::string();
+  trace.reserve(PROFILER_RING_CAPACITY * 96u);
+  trace.append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+  char line[256] = {};
+  bool is_first_event = true;
+  const u32 thread_count = std::min(state->thread_count.load(std::memory_order_acquire), static_cast<u32>(PROFILER_MAX_THREADS));
+  for (u32 itr_000 = 0u; itr_000 < thread_count; ++itr_000) {
+    const profiler_thread_buffer& buffer = state->threads.at(itr_000);
+
+    std::snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s %u\"}}",
+      is_first_event ? "" : ",", itr_000, itr_000 == 0u ? "main" : "worker", itr_000
+    );
+    trace.append(line);
+    is_first_event = false;
+
+    const u64 first_serial = buffer.event_count > PROFILER_RING_CAPACITY ? buffer.event_count - PROFILER_RING_CAPACITY : 0u;
+    for (u64 serial = first_serial; serial < buffer.event_count; ++serial) {
+      const profiler_event& event = buffer.events.at(serial % PROFILER_RING_CAPACITY);
+      if (not event.is_closed) {
+        continue;
+      }
+      std::snprintf(line, sizeof(line), ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+        event.name, itr_000, static_cast<f64>(event.begin_ns) / 1000.0, static_cast<f64>(event.end_ns - event.begin_ns) / 1000.0
+      );
+      trace.append(line);
+    }
+  }
+  const f64 export_us = static_cast<f64>(profiler_now_ns()) / 1000.0;
+  for (u32 itr_000 = 0u; itr_000 < state->counter_count; ++itr_000) {
+    const profiler_counter& counter = state->counters.at(itr_000);
+    std::snprintf(line, sizeof(line), ",{\"name\":\"%s\",\"ph\":\"C\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"args\":{\"value\":%.3f}}",
+      counter.name, export_us, counter.value
+    );
+    trace.append(line);
+  }
+  trace.append("]}");
+
+  if (not SaveFileText(path, trace.data())) {
+    IWARN("fprofiler::profiler_export_chrome_trace()::Trace cannot be written to %s", path);
+    return false;
+  }
+  IINFO("fprofiler::profiler_export_chrome_trace()::Trace is written to %s", path);
+  return true;
+}
+
+void profiler_toggle_overlay(void) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  state->is_overlay_visible = not state->is_overlay_visible;
+}
+void profiler_render_overlay(Vector2 position, i32 font_size) {
+  if (not state or state == nullptr or not state->is_overlay_visible) {
+    return;
+  }
+  const std::vector<profiler_zone_stats>& stats = profiler_get_zone_stats();
+  const f32 line_height = static_cast<f32>(font_size) * 1.2f;
+  const f32 column_width = static_cast<f32>(font_size) * PROFILER_OVERLAY_COLUMN_WIDTH;
+  const f32 name_width = static_cast<f32>(font_size) * 12.f;
+
+  const size_t line_count = stats.size() + state->counter_count + 1u;
+  DrawRectangleV(position, Vector2 {name_width + column_width * 4.f, line_height * static_cast<f32>(line_count)}, PROFILER_OVERLAY_BACKGROUND);
+
+  const char * const headers[4] = {"avg", "p50", "p95", "max"};
+  for (size_t itr_000 = 0u; itr_000 < 4u; ++itr_000) {
+    DrawText(headers[itr_000], static_cast<i32>(position.x + name_width + column_width * itr_000), static_cast<i32>(position.y), font_size, LIGHTGRAY);
+  }
+  for (size_t itr_000 = 0u; itr_000 < stats.size(); ++itr_000) {
+    const profiler_zone_stats& zone = stats.at(itr_000);
+    const i32 line_y = static_cast<i32>(position.y + line_height * static_cast<f32>(itr_000 + 1u));
+    const i32 indent = static_cast<i32>(zone.depth) * font_size;
+
+    DrawText(zone.name, static_cast<i32>(position.x) + indent, line_y, font_size, WHITE);
+    const f64 values[4] = {zone.avg_ms, zone.p50_ms, zone.p95_ms, zone.max_ms};
+    for (size_t itr_111 = 0u; itr_111 < 4u; ++itr_111) {
+      DrawText(TextFormat("%.2f", values[itr_111]), static_cast<i32>(position.x + name_width + column_width * itr_111), line_y, font_size, WHITE);
+    }
+  }
+  for (u32 itr_000 = 0u; itr_000 < state->counter_count; ++itr_000) {
+    const profiler_counter& counter = state->counters.at(itr_000);
+    const i32 line_y = static_cast<i32>(position.y + line_height * static_cast<f32>(stats.size() + itr_000 + 1u));
+
+    DrawText(counter.name, static_cast<i32>(position.x), line_y, font_size, LIGHTGRAY);
+    DrawText(TextFormat("%.0f", counter.value), static_cast<i32>(position.x + name_width), line_y, font_size, LIGHTGRAY);
+  }
+}
+
+profiler_thread_buffer * profiler_get_thread_buffer(void) {
+  if (thread_buffer) {
+    return thread_buffer;
+  }
+  if (not state or state == nullptr or is_thread_rejected) {
+    return nullptr;
+  }
+  const u32 slot = state->thread_count.fetch_add(1u, std::memory_order_acq_rel);
+  if (slot >= PROFILER_MAX_THREADS) {
+    is_thread_rejected = true;
+    IWARN("fprofiler::profiler_get_thread_buffer()::More threads than buffers, zones of this thread are dropped");
+    return nullptr;
+  }
+  thread_buffer = __builtin_addressof(state->threads.at(slot));
+  return thread_buffer;
+}
+
+u64 profiler_now_ns(void) {
+  return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state->epoch).count());
+}
+
+profiler_zone * profiler_get_zone(const char * name, u32 depth) {
+  for (u32 itr_000 = 0u; itr_000 < state->zone_count; ++itr_000) {
+    if (state->zones.at(itr_000).name == name) {
+      return __builtin_addressof(state->zones.at(itr_000));
+    }
+  }
+  if (state->zone_count >= PROFILER_MAX_ZONES) {
+    return nullptr;
+  }
+  profiler_zone& zone = state->zones.at(state->zone_count++);
+  zone = profiler_zone {};
+  zone.name = name;
+  zone.depth = depth;
+  return __builtin_addressof(zone);
+}
+
+void profiler_collect_thread(profiler_thread_buffer& buffer) {
+  u64 serial = std::max(buffer.processed_count, buffer.event_count > PROFILER_RING_CAPACITY ? buffer.event_count - PROFILER_RING_CAPACITY : 0u);
+  for (; serial < buffer.event_count; ++serial) {
+    const profiler_event& event = buffer.events.at(serial % PROFILER_RING_CAPACITY);
+    if (not event.is_closed) {
+      break;
+    }
+    profiler_zone * zone = profiler_get_zone(event.name, event.depth);
+    if (zone) {
+      zone->frame_ms += static_cast<f64>(event.end_ns - event.begin_ns) / 1000000.0;
+    }
+  }
+  buffer.processed_count = serial;
+}
+
+void profiler_refresh_stats(void) {
+  state->zone_stats.resize(state->zone_count);
+  if (state->history_count == 0u) {
+    return;
+  }
+  std::array<f64, PROFILER_HISTORY_FRAMES> samples = {};
+  const size_t sample_count = state->history_count;
+
+  for (u32 itr_000 = 0u; itr_000 < state->zone_count; ++itr_000) {
+    const profiler_zone& zone = state->zones.at(itr_000);
+    std::copy_n(zone.history_ms.begin(), sample_count, samples.begin()); // INFO: Order does not matter, the window is sorted
+    std::sort(samples.begin(), samples.begin() + sample_count);
+
+    f64 total_ms = 0.0;
+    for (size_t itr_111 = 0u; itr_111 < sample_count; ++itr_111) {
+      total_ms += samples.at(itr_111);
+    }
+    profiler_zone_stats& stats = state->zone_stats.at(itr_000);
+    stats.name = zone.name;
+    stats.depth = zone.depth;
+    stats.avg_ms = total_ms / static_cast<f64>(sample_count);
+    stats.p50_ms = samples.at(static_cast<size_t>(static_cast<f64>(sample_count - 1u) * .50));
+    stats.p95_ms = samples.at(static_cast<size_t>(static_cast<f64>(sample_count - 1u) * .95));
+    stats.max_ms = samples.at(sample_count - 1u);
+  }
+  state->is_stats_dirty = false;
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,85 @@
+
+#ifndef FPROFILER_H
+#define FPROFILER_H
+
+#include "defines.h"
+#include "raylib.h"
+
+#define PROFILER_MAX_THREADS 8 // INFO: Main thread plus JOB_SYSTEM_MAX_WORKER_COUNT workers
+#define PROFILER_RING_CAPACITY 8192u
+#define PROFILER_MAX_DEPTH 32u
+#define PROFILER_MAX_ZONES 64u
+#define PROFILER_HISTORY_FRAMES 120u
+#define PROFILER_MAX_COUNTERS 32u
+#define PROFILER_TRACE_FILE_LOCATION "./profiler_trace.json"
+
+/**
+ * @brief Rolling statistics of a zone, in milliseconds per frame summed over every thread
+ */
+typedef struct profiler_zone_stats {
+  const char * name;
+  u32 depth;
+  f64 avg_ms;
+  f64 p50_ms;
+  f64 p95_ms;
+  f64 max_ms;
+  profiler_zone_stats(void) {
+    this->name = "";
+    this->depth = 0u;
+    this->avg_ms = 0.0;
+    this->p50_ms = 0.0;
+    this->p95_ms = 0.0;
+    this->max_ms = 0.0;
+  }
+} profiler_zone_stats;
+
+#if PROFILER_ENABLED
+
+/**
+ * @brief Every thread writes its zones into its own ring buffer, the oldest events are overwritten.
+ * @brief Frame bookkeeping, stats and export read all buffers, so they must run on the main thread
+ * @brief while no job dispatch is in flight.
+ */
+bool profiler_system_initialize(void);
+
+void profiler_begin_frame(void);
+void profiler_end_frame(void);
+
+/**
+ * @brief Name must outlive the profiler, zones are told apart by the pointer. String literals and __func__ are fine
+ */
+void profiler_begin_zone(const char * name);
+void profiler_end_zone(void);
+
+const std::vector<profiler_zone_stats>& profiler_get_zone_stats(void);
+
+/**
+ * @brief Named value shown under the zones, the last value set wins. Main thread only, same naming rule as the zones
+ */
+void profiler_set_counter(const char * name, f64 value);
+
+bool profiler_export_chrome_trace(const char * path);
+
+void profiler_toggle_overlay(void);
+void profiler_render_overlay(Vector2 position, i32 font_size);
+
+struct profiler_scope {
+  profiler_scope(const char * name) { profiler_begin_zone(name); }
+  ~profiler_scope(void) { profiler_end_zone(); }
+  profiler_scope(const profiler_scope&) = delete;
+  profiler_scope& operator=(const profiler_scope&) = delete;
+};
+
+#define PROFILER_CONCAT_INNER(A, B) A##B
+#define PROFILER_CONCAT(A, B) PROFILER_CONCAT_INNER(A, B)
+#define PROFILE_SCOPE(NAME) const profiler_scope PROFILER_CONCAT(profiler_scope_, __LINE__)(NAME)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+
+#else
+
+#define PROFILE_SCOPE(NAME) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+
+#endif // PROFILER_ENABLED
+
+#endif
@@ -0,0 +1,146 @@
+#include "frandom.h"
+
+#include <openssl/rand.h>
+#include <algorithm>
+#include <chrono>
+
+#include "core/fmemory.h"
+#include "core/logger.h"
+
+typedef struct random_stream {
+  u64 s[4];
+} random_stream;
+
+typedef struct random_system_state {
+  std::array<random_stream, RANDOM_STREAM_MAX> streams;
+  u64 seed;
+  random_system_state(void) {
+    this->streams = {};
+    this->seed = 0u;
+  }
+} random_system_state;
+
+static random_system_state * state = nullptr;
+
+static inline u64 random_rotl(u64 x, i32 k) {
+  return (x << k) | (x >> (64 - k));
+}
+/**
+ * @brief Used only to expand a seed into stream states, xoshiro must not start from an all zero state
+ */
+static inline u64 random_splitmix64(u64& x) {
+  u64 z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+static inline u64 random_xoshiro256ss(random_stream& rs) {
+  const u64 result = random_rotl(rs.s[1] * 5u, 7) * 9u;
+  const u64 t = rs.s[1] << 17;
+
+  rs.s[2] ^= rs.s[0];
+  rs.s[3] ^= rs.s[1];
+  rs.s[1] ^= rs.s[2];
+  rs.s[0] ^= rs.s[3];
+  rs.s[2] ^= t;
+  rs.s[3] = random_rotl(rs.s[3], 45);
+  return result;
+}
+/**
+ * @brief Lemire's multiply-shift with rejection, unbiased without a division on the common path
+ */
+static inline u64 random_bounded(random_stream& rs, u64 range) {
+  __uint128_t m = static_cast<__uint128_t>(random_xoshiro256ss(rs)) * range;
+  u64 low = static_cast<u64>(m);
+  if (low < range) {
+    const u64 threshold = (0u - range) % range;
+    while (low < threshold) {
+      m = static_cast<__uint128_t>(random_xoshiro256ss(rs)) * range;
+      low = static_cast<u64>(m);
+    }
+  }
+  return static_cast<u64>(m >> 64);
+}
+static inline f32 random_to_f32(u64 x) {
+  return static_cast<f32>(x >> 40) * (1.f / 16777216.f); // INFO: Top 24 bits fill the f32 mantissa
+}
+
+bool random_system_initialize(u64 seed) {
+  if (state and state != nullptr) {
+    random_set_seed(seed);
+    return true;
+  }
+  state = (random_system_state *)allocate_memory_linear(sizeof(random_system_state), true, MEMORY_TAG_CORE);
+  if (not state or state == nullptr) {
+    return false;
+  }
+  *state = random_system_state();
+  random_set_seed(seed);
+  return true;
+}
+void random_set_seed(u64 seed) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  if (seed == 0u and not random_secure_bytes(&seed, sizeof(seed))) {
+    IWARN("frandom::random_set_seed()::Secure seed failed, falling back to the clock");
+    seed = static_cast<u64>(std::chrono::steady_clock::now().time_since_epoch().count());
+  }
+  state->seed = seed;
+
+  for (size_t itr_000 = 0u; itr_000 < RANDOM_STREAM_MAX; ++itr_000) {
+    u64 sm = seed ^ (static_cast<u64>(itr_000) * 0xD1B54A32D192ED03ull);
+    random_stream& rs = state->streams.at(itr_000);
+    for (u64& word : rs.s) {
+      word = random_splitmix64(sm);
+    }
+  }
+}
+u64 random_get_seed(void) {
+  if (not state or state == nullptr) {
+    return 0u;
+  }
+  return state->seed;
+}
+
+[[__nodiscard__]] u64 random_next_u64(random_stream_id stream) {
+  return random_xoshiro256ss(state->streams.at(stream));
+}
+[[__nodiscard__]] i32 random_range(random_stream_id stream, i32 min, i32 max) {
+  if (min >= max) {
+    return min;
+  }
+  const u64 range = static_cast<u64>(static_cast<i64>(max) - static_cast<i64>(min)) + 1u;
+  return static_cast<i32>(static_cast<i64>(min) + static_cast<i64>(random_bounded(state->streams.at(stream), range)));
+}
+[[__nodiscard__]] f32 random_f32(random_stream_id stream) {
+  return random_to_f32(random_xoshiro256ss(state->streams.at(stream)));
+}
+[[__nodiscard__]] bool random_chance(random_stream_id stream, f32 chance) {
+  if (chance <= 0.f) return false;
+  if (chance >= 1.f) return true;
+
+  return random_f32(stream) < chance;
+}
+
+void random_fill_range(random_stream_id stream, i32 min, i32 max, i32 * out, size_t count) {
+  if (min >= max) {
+    std::fill(out, out + count, min);
+    return;
+  }
+  random_stream& rs = state->streams.at(stream);
+  const u64 range = static_cast<u64>(static_cast<i64>(max) - static_cast<i64>(min)) + 1u;
+  for (size_t itr_000 = 0u; itr_000 < count; ++itr_000) {
+    out[itr_000] = static_cast<i32>(static_cast<i64>(min) + static_cast<i64>(random_bounded(rs, range)));
+  }
+}
+void random_fill_f32(random_stream_id stream, f32 * out, size_t count) {
+  random_stream& rs = state->streams.at(stream);
+  for (size_t itr_000 = 0u; itr_000 < count; ++itr_000) {
+    out[itr_000] = random_to_f32(random_xoshiro256ss(rs));
+  }
+}
+
+bool random_secure_bytes(void * out, size_t size) {
+  return RAND_bytes(reinterpret_cast<unsigned char*>(out), static_cast<int>(size)) == 1;
+}
@@ -0,0 +1,53 @@
+
+#ifndef FRANDOM_H
+#define FRANDOM_H
+
+#include "defines.h"
+
+/**
+ * @brief Every subsystem rolls from its own stream, so extra rolls in one of them do not shift the others
+ */
+typedef enum random_stream_id {
+  RANDOM_STREAM_UNDEFINED,
+  RANDOM_STREAM_SPAWN,
+  RANDOM_STREAM_LOOT,
+  RANDOM_STREAM_ABILITY,
+  RANDOM_STREAM_UI,
+  RANDOM_STREAM_SOUND,
+  RANDOM_STREAM_MAX,
+} random_stream_id;
+
+/**
+ * @brief xoshiro256** streams, all derived from one master seed. Zero seed takes one from the OS CSPRNG.
+ * @brief Streams are not synchronized, roll only on the main thread.
+ */
+bool random_system_initialize(u64 seed);
+
+/**
+ * @brief Reseeds every stream, same seed gives the same sequence of rolls on every stream
+ */
+void random_set_seed(u64 seed);
+u64 random_get_seed(void);
+
+[[__nodiscard__]] u64 random_next_u64(random_stream_id stream);
+
+/**
+ * @brief Uniform in [min, max], both inclusive. Returns min if the range is empty.
+ */
+[[__nodiscard__]] i32 random_range(random_stream_id stream, i32 min, i32 max);
+
+/**
+ * @brief Uniform in [0, 1)
+ */
+[[__nodiscard__]] f32 random_f32(random_stream_id stream);
+[[__nodiscard__]] bool random_chance(random_stream_id stream, f32 chance);
+
+void random_fill_range(random_stream_id stream, i32 min, i32 max, i32 * out, size_t count);
+void random_fill_f32(random_stream_id stream, f32 * out, size_t count);
+
+/**
+ * @brief OS CSPRNG, for values that must not be predictable. Gameplay rolls use the streams.
+ */
+bool random_secure_bytes(void * out, size_t size);
+
+#endif
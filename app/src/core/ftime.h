@@ -4,18 +4,27 @@
 
 #include "defines.h"
 
-#define RANDOM_TABLE_NUMBER_COUNT 507
+#define SIMULATION_MAX_TICKS_PER_FRAME 5u
 
 bool time_system_initialize(void);
 void update_time(void);
 
-[[__nodiscard__]] i32 get_random(i32 min, i32 max);
-[[__nodiscard__]] i32 get_random_ssl(i32 min, i32 max);
-[[__nodiscard__]] bool get_random_chance_ssl(f32 chance);
-
 void set_ingame_delta_time_multiplier(f32 val);
+/**
+ * @brief Replaces the frame time with a constant step, used by the headless runner. Zero returns to the frame time
+ */
+void set_fixed_delta_time(f32 val);
 
 f32 delta_time_ingame(void);
+
+/**
+ * @brief Gameplay advances in fixed steps. In-game frame time is accumulated and spent in whole ticks,
+ * @brief the remainder is the interpolation factor between the last two simulated states.
+ */
+void set_simulation_tick_rate(i32 tick_rate);
+u32 simulation_accumulate(void);
+f32 get_simulation_step(void);
+f32 get_simulation_alpha(void);
 f64 ftime_get_app_time(void);
 
 std::string get_time_now(std::string format);
@@ -51,7 +51,7 @@ bool logging_system_initialize(int build_id) {
   if (state and state != nullptr) {
     return false;
   }
-  state = (logging_system_state*)allocate_memory_linear(sizeof(logging_system_state), true);
+  state = (logging_system_state*)allocate_memory_linear(sizeof(logging_system_state), true, MEMORY_TAG_CORE);
   if (not state or state == nullptr) {
     return false;
   }
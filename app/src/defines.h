@@ -48,6 +48,7 @@ int alert(const char* caption, const char* message);
 #define DEFAULT_SETTINGS_WINDOW_MODE "windowed"
 #define DEFAULT_SETTINGS_MASTER_VOLUME_C "50"
 #define DEFAULT_SETTINGS_MASTER_VOLUME 5
+#define DEFAULT_SETTINGS_SIMULATION_TICK_RATE 60
 #define DEFAULT_SETTINGS_LANGUAGE "English"
 
 #define RESOURCE_PATH ".\\resources\\"
@@ -64,6 +65,18 @@ int alert(const char* caption, const char* message);
   #define USE_PAK_FORMAT 0
 #endif
 
+#ifndef HEADLESS_BUILD
+  #define HEADLESS_BUILD 0 // INFO: No window, GPU or audio device. Asset uploads are stubbed, decoding still runs
+#endif
+
+#ifndef PROFILER_ENABLED
+  #ifdef _RELEASE
+    #define PROFILER_ENABLED 0 // INFO: Zone macros expand to nothing
+  #else
+    #define PROFILER_ENABLED 1
+  #endif
+#endif
+
 #define PAK_FILE_LOCATION "./resource.pak"
 #define CONFIG_FILE_LOCATION "./config.ini"
 #define SAVE_GAME_EXTENSION ".save_slot"
@@ -92,6 +105,7 @@ int alert(const char* caption, const char* message);
 #define WORLDMAP_MAINMENU_MAP 0
 
 #include <vector>
+#include <string_view>
 
 // Unsigned int types.
 typedef unsigned char u8;
@@ -709,6 +723,15 @@ typedef enum shader_id {
   SHADER_ID_MAX,
 } shader_id;
 
+typedef enum shader_uniform_id {
+  SHADER_UNIFORM_ID_UNSPECIFIED,
+  SHADER_UNIFORM_ID_PROGRESS_BAR_MASK_PROGRESS,
+  SHADER_UNIFORM_ID_PROGRESS_BAR_MASK_TINT,
+  SHADER_UNIFORM_ID_FADE_TRANSITION_PROCESS,
+  SHADER_UNIFORM_ID_POST_PROCESS_FADE,
+  SHADER_UNIFORM_ID_MAX,
+} shader_uniform_id;
+
 
 typedef enum sound_id {
   SOUND_ID_UNSPECIFIED,
@@ -1091,6 +1114,7 @@ typedef struct app_settings {
   i32 render_height {};
   i32 render_width_div2 {};
   i32 render_height_div2 {};
+  i32 simulation_tick_rate = DEFAULT_SETTINGS_SIMULATION_TICK_RATE;
   std::string language;
   app_settings(void) {}
   app_settings(save_slot_id _active_save_slot, i32 window_state, i32 width, i32 height, i32 volume, std::string language) : app_settings() {
@@ -1109,10 +1133,13 @@ typedef struct app_settings {
   }
 } app_settings;
 
+/**
+ * @brief Index entry of a pak file. Content is a view into the pak bytes owned by pak parser, valid until the pak is dropped.
+ */
 typedef struct file_buffer {
   pak_file_id pak_id;
   i32 file_id {};
-  std::string content;
+  std::string_view content;
   std::string file_extension;
   size_t offset {};
   bool is_success {};
@@ -1130,9 +1157,9 @@ typedef struct file_buffer {
 
 typedef struct worldmap_stage_file {
   i32 stage_index {};
-  std::array<std::string, MAX_TILEMAP_LAYERS> layer_data;
-  std::string file_collision;
-  std::string file_prop;
+  std::array<std::string_view, MAX_TILEMAP_LAYERS> layer_data;
+  std::string_view file_collision;
+  std::string_view file_prop;
   size_t pak_offset {};
   bool is_success {};
   worldmap_stage_file(void) {}
@@ -1141,9 +1168,10 @@ typedef struct worldmap_stage_file {
 typedef struct asset_pak_file {
   std::string path_to_resource;
   std::string pak_file_name;
-  std::string pak_data;
+  std::string_view pak_data;
   std::vector<file_buffer> file_buffers;
   bool is_initialized {};
+  bool is_indexed {};
   
   asset_pak_file(void) {}
   asset_pak_file(std::string pak_name, std::string path_to_res, std::vector<file_buffer> file_infos) : asset_pak_file() {
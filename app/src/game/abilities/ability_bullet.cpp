@@ -10,6 +10,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 typedef struct ability_bullet_state {
   const camera_metrics* in_camera_metrics;
   const app_settings* in_settings;
@@ -28,7 +30,7 @@ bool ability_bullet_initialize(const camera_metrics *const _camera_metrics, cons
     IWARN("ability::ability_bullet_initialize()::Initialize called multiple times");
     return false;
   }
-  state = (ability_bullet_state*)allocate_memory_linear(sizeof(ability_bullet_state), true);
+  state = (ability_bullet_state*)allocate_memory_linear(sizeof(ability_bullet_state), true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IERROR("ability::ability_bullet_initialize()::Failed to allocate state");
     return false;
@@ -102,42 +104,43 @@ void update_ability_bullet(ability& abl) {
     abl.mm_ex.f32[0] += (*state->in_ingame_info->delta_time);
   }
 
+  projectile_data_soa& prjs = get_projectile_pool();
+  const f32 angle_step = 360.0f / static_cast<f32>(abl.proj_slot_count);
+  const f32 move_dist = static_cast<f32>(abl.proj_speed) * (*state->in_ingame_info->delta_time);
+  const f32 overall_damage_multiplier = player->stats[CHARACTER_STATS_OVERALL_DAMAGE].buffer.f32[3];
+
   i32 index = 0;
-  for (projectile& prj : abl.projectiles) {
-    if (not prj.is_active) { continue; }
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
+    Vector2& position = prjs.position[slot];
+    Rectangle& collision = prjs.collision[slot];
 
     if (refresh_prj) {
-      prj.position = player->position;
+      position = player->position;
     }
-    const f32 angle_step = 360.0f / static_cast<f32>(abl.projectiles.size());
-
     const f32 current_angle_deg = angle_step * static_cast<f32>(index);
     const f32 current_angle_rad = current_angle_deg * DEG2RAD;
 
-    const f32 move_dist = static_cast<f32>(abl.proj_speed) * (*state->in_ingame_info->delta_time);
-
     Vector2 direction = {
       cosf(current_angle_rad) * move_dist,
       sinf(current_angle_rad) * move_dist
     };
-    prj.position.x += direction.x;
-    prj.position.y += direction.y;
+    position.x += direction.x;
+    position.y += direction.y;
 
-    prj.collision.x = prj.position.x - prj.collision.width  * .5f;
-    prj.collision.y = prj.position.y - prj.collision.height * .5f;
+    collision.x = position.x - collision.width  * .5f;
+    collision.y = position.y - collision.height * .5f;
 
-    f32 overall_damage_multiplier = player->stats[CHARACTER_STATS_OVERALL_DAMAGE].buffer.f32[3];
-
-    f64 final_damage_f = std::round(static_cast<f64>(overall_damage_multiplier) * static_cast<f64>(prj.damage));
+    f64 final_damage_f = std::round(static_cast<f64>(overall_damage_multiplier) * static_cast<f64>(prjs.damage[slot]));
 
     i16 final_damage = std::clamp(final_damage_f, -32768.0, 32767.0);
 
     event_fire(EVENT_CODE_DAMAGE_ANY_SPAWN_IF_COLLIDE, event_context(
-      static_cast<i16>(prj.collision.x), static_cast<i16>(prj.collision.y), static_cast<i16>(prj.collision.width), static_cast<i16>(prj.collision.height),
+      static_cast<i16>(collision.x), static_cast<i16>(collision.y), static_cast<i16>(collision.width), static_cast<i16>(collision.height),
       final_damage,
-      static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE)
+      static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE), static_cast<i16>(abl.id)
     ));
-    update_sprite(prj.animations.at(0), (*state->in_ingame_info->delta_time) );
+    update_sprite(prjs.animation(slot, 0), (*state->in_ingame_info->delta_time) );
     index++;
   }
 }
@@ -152,19 +155,23 @@ void render_ability_bullet(ability& abl){
   }
   const f32& aoe_scale = state->in_ingame_info->player_state_dynamic->stats.at(CHARACTER_STATS_AOE).buffer.f32[3];
 
-  for (size_t itr_000 = 0u; itr_000 < abl.projectiles.size(); ++itr_000) {
-    projectile& prj = abl.projectiles.at(itr_000);
-    if (not prj.is_active) { continue; }
+  projectile_data_soa& prjs = get_projectile_pool();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
+    projectile_animation& anim = prjs.animation(slot, prjs.active_sprite[slot]);
+    const spritesheet * const sheet = ss_get_spritesheet_by_enum(anim.sheet_id);
+    if (not sheet or sheet == nullptr) { continue; }
 
     Vector2 dim = Vector2 {
-      prj.animations.at(prj.active_sprite).current_frame_rect.width  * abl.proj_sprite_scale,
-      prj.animations.at(prj.active_sprite).current_frame_rect.height * abl.proj_sprite_scale
+      sheet->current_frame_rect.width  * abl.proj_sprite_scale,
+      sheet->current_frame_rect.height * abl.proj_sprite_scale
     };
     dim.x += (dim.x * aoe_scale);
     dim.y += (dim.y * aoe_scale);
-    prj.animations.at(prj.active_sprite).origin.x = dim.x / 2.f;
-    prj.animations.at(prj.active_sprite).origin.y = dim.y / 2.f;
-    play_sprite_on_site(prj.animations.at(prj.active_sprite), WHITE, Rectangle { prj.position.x, prj.position.y, dim.x, dim.y });
+    const Vector2 offset = projectile_render_offset(slot);
+    sprite_batch_play_sprite_pro(anim, SPRITE_LAYER_SCENE, Rectangle { prjs.position[slot].x + offset.x, prjs.position[slot].y + offset.y, dim.x, dim.y }, 
+      Vector2 { dim.x / 2.f, dim.y / 2.f }, 0.f, WHITE
+    );
   }
 }
 void refresh_ability_bullet(ability& abl) { 
@@ -180,28 +187,26 @@ void refresh_ability_bullet(ability& abl) {
     IWARN("ability::refresh_ability_bullet()::Ability projectile count exceed");
     return;
   }
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
   abl.animation_ids.push_back(SHEET_ID_FLAME_ENERGY_ANIMATION);
+  if (not reset_projectile_slots(abl, abl.proj_count)) {
+    return;
+  }
+  projectile_data_soa& prjs = get_projectile_pool();
 
-  for (int itr_000 = 0; itr_000 < abl.proj_count; ++itr_000) {
-    projectile& prj = abl.projectiles.emplace_back(projectile());
-    prj.collision = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.duration = abl.proj_duration;
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    prjs.collision[slot] = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
+    prjs.damage[slot] = abl.base_damage;
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+    prjs.duration[slot] = abl.proj_duration;
     for (size_t itr_111 = 0u; itr_111 < abl.animation_ids.size(); ++itr_111) {
       if (abl.animation_ids.at(itr_111) <= SHEET_ID_SPRITESHEET_UNSPECIFIED or abl.animation_ids.at(itr_111) >= SHEET_ID_SPRITESHEET_TYPE_MAX) {
         IWARN("ability::refresh_ability_bullet()::Ability sprite is not initialized or corrupted");
         return;
       }
-      spritesheet& spr = prj.animations.emplace_back(spritesheet()); 
-      spr.sheet_id = abl.animation_ids.at(itr_111);
-      set_sprite(spr, true, false);
-      spr.origin = VECTOR2( spr.coord.width * .5f,  spr.coord.height * .5f );
+      set_sprite(prjs.animation(slot, static_cast<i32>(itr_111)), abl.animation_ids.at(itr_111), true, false);
 
-      prj.active_sprite = 0;
+      prjs.active_sprite[slot] = 0;
     }
   }
 }
@@ -9,6 +9,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 typedef struct ability_codex_state {
   const camera_metrics* in_camera_metrics;
   const app_settings* in_settings;
@@ -25,14 +27,14 @@ static ability_codex_state * state = nullptr;
 #define CODEX_BOOK_DIM_SOURCE 32.f
 #define CODEX_BOOK_DIM_DEST 32.f
 
-#define PRJ_TARGET_ID_I32 mm_ex.i32[0]
-#define PRJ_TARGET_INDEX_I32 mm_ex.i32[1]
+#define PRJ_TARGET_ID_I32 i32[0]
+#define PRJ_TARGET_INDEX_I32 i32[1]
 
 bool ability_codex_initialize(const camera_metrics *const _camera_metrics, const app_settings *const _settings, const ingame_info *const _ingame_info) {
   if (state and state != nullptr) {
     return true;
   }
-  state = (ability_codex_state*)allocate_memory_linear(sizeof(ability_codex_state),true);
+  state = (ability_codex_state*)allocate_memory_linear(sizeof(ability_codex_state),true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IERROR("ability::ability_system_initialize()::Failed to allocate memory");
     return false;
@@ -93,7 +95,7 @@ void update_ability_codex(ability& abl) {
     IWARN("ability::update_codex()::Ability is not active or not initialized");
     return;
   }
-  if (not abl.p_owner or abl.p_owner == nullptr or not state->in_ingame_info or abl.projectiles.empty()) {
+  if (not abl.p_owner or abl.p_owner == nullptr or not state->in_ingame_info or abl.proj_slot_count <= 0) {
     return;
   }
   const player_state *const player = reinterpret_cast<player_state*>(abl.p_owner);
@@ -106,10 +108,11 @@ void update_ability_codex(ability& abl) {
   abl.position.x = book_position.x;
   abl.position.y = book_position.y;
 
-  projectile& prj = abl.projectiles[0];
-  spritesheet& sheet = prj.animations.at(prj.active_sprite);
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+  projectile_animation& anim = prjs.animation(slot, prjs.active_sprite[slot]);
 
-  update_sprite(sheet, (*state->in_ingame_info->delta_time) );
+  update_sprite(anim, (*state->in_ingame_info->delta_time) );
 
   if (abl.ability_cooldown_accumulator < abl.ability_cooldown_duration) {
     abl.ability_cooldown_accumulator += (*state->in_ingame_info->delta_time);
@@ -121,19 +124,23 @@ void update_ability_codex(ability& abl) {
     return;
   }
   const element_handle& near_spw_hnd = (*state->in_ingame_info->nearest_spawn_handle);
-  if (near_spw_hnd.index >= state->in_ingame_info->in_spawns->size() or near_spw_hnd.id != (*state->in_ingame_info->in_spawns)[near_spw_hnd.index].character_id) {
+  if (near_spw_hnd.index >= state->in_ingame_info->in_spawns->size() or near_spw_hnd.id != state->in_ingame_info->in_spawns->character_id[near_spw_hnd.index]) {
     return;
   }
-  const Character2D& nearest = (*state->in_ingame_info->in_spawns)[near_spw_hnd.index];
-  prj.PRJ_TARGET_ID_I32 = near_spw_hnd.id;
-  prj.PRJ_TARGET_INDEX_I32 = near_spw_hnd.index;
+  prjs.mm_ex[slot].PRJ_TARGET_ID_I32 = near_spw_hnd.id;
+  prjs.mm_ex[slot].PRJ_TARGET_INDEX_I32 = near_spw_hnd.index;
   
-  reset_sprite(sheet, true);
+  reset_sprite(anim, true);
 
-  i32 base_damage = static_cast<i16>(prj.damage);
+  i32 base_damage = static_cast<i16>(prjs.damage[slot]);
   i32 final_damage = base_damage + (base_damage * player->stats.at(CHARACTER_STATS_OVERALL_DAMAGE).buffer.f32[3]);
-  event_fire(EVENT_CODE_DAMAGE_SPAWN_BY_ID, event_context(nearest.character_id, final_damage));
-  event_fire(EVENT_CODE_HALT_SPAWN_MOVEMENT, event_context(static_cast<f32>(near_spw_hnd.id), static_cast<f32>(near_spw_hnd.index), sheet.frame_total / sheet.fps));
+  event_fire(EVENT_CODE_DAMAGE_SPAWN_BY_ID, event_context(near_spw_hnd.id, final_damage, static_cast<i32>(abl.id)));
+  data128 halt_data = data128(near_spw_hnd.id, static_cast<i32>(near_spw_hnd.index));
+  const spritesheet * const sheet = ss_get_spritesheet_by_enum(anim.sheet_id);
+  if (sheet and sheet != nullptr) {
+    halt_data.f32[2] = sheet->frame_total / sheet->fps;
+  }
+  event_fire(EVENT_CODE_HALT_SPAWN_MOVEMENT, event_context(halt_data));
 }
 
 void render_ability_codex(ability& abl) {
@@ -141,12 +148,14 @@ void render_ability_codex(ability& abl) {
     IWARN("ability::render_codex()::Ability type is incorrect. Expected: %d, Recieved:%d", ABILITY_ID_CODEX, abl.id);
     return;
   }
-  if (not abl.is_active or not abl.is_initialized or abl.projectiles.empty()) {
+  if (not abl.is_active or not abl.is_initialized or abl.proj_slot_count <= 0) {
     IWARN("ability::render_codex()::Ability is not active or not initialized");
     return;
   }
-  projectile& prj = abl.projectiles[0];
-  spritesheet& sheet = prj.animations.at(prj.active_sprite);
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+  projectile_animation& anim = prjs.animation(slot, prjs.active_sprite[slot]);
+  const data256& mm_ex = prjs.mm_ex[slot];
 
   {
     const Texture2D *const icon_tex = ss_get_texture_by_enum(TEX_ID_ASSET_ATLAS);
@@ -154,18 +163,20 @@ void render_ability_codex(ability& abl) {
     DrawTexturePro( (*icon_tex), abl.icon_src, codex_book_dest, VECTOR2(0.f, 0.f), 0.f, Color { 160u, 160u, 160u, 255u});
   }
 
-  if (not prj.is_active or sheet.is_played) { return; }
+  if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE) or anim.has_flag(PROJECTILE_ANIMATION_FLAG_PLAYED)) { return; }
 
-  if (static_cast<size_t>(prj.PRJ_TARGET_INDEX_I32) >= state->in_ingame_info->in_spawns->size() or 
-      prj.PRJ_TARGET_ID_I32 != (*state->in_ingame_info->in_spawns)[prj.PRJ_TARGET_INDEX_I32].character_id) 
+  if (static_cast<size_t>(mm_ex.PRJ_TARGET_INDEX_I32) >= state->in_ingame_info->in_spawns->size() or 
+      mm_ex.PRJ_TARGET_ID_I32 != state->in_ingame_info->in_spawns->character_id[mm_ex.PRJ_TARGET_INDEX_I32]) 
   {  
     return;
   }
-  Vector2 dim = Vector2 {sheet.current_frame_rect.width * abl.proj_sprite_scale, sheet.current_frame_rect.height * abl.proj_sprite_scale};
-  const Character2D& nearest = (*state->in_ingame_info->in_spawns)[static_cast<size_t>(prj.PRJ_TARGET_INDEX_I32)];
+  const spritesheet * const sheet = ss_get_spritesheet_by_enum(anim.sheet_id);
+  if (not sheet or sheet == nullptr) { return; }
+  Vector2 dim = Vector2 {sheet->current_frame_rect.width * abl.proj_sprite_scale, sheet->current_frame_rect.height * abl.proj_sprite_scale};
+  const Rectangle& nearest = state->in_ingame_info->in_spawns->collision[static_cast<size_t>(mm_ex.PRJ_TARGET_INDEX_I32)];
   Vector2 nearest_center = {
-    nearest.collision.x + nearest.collision.width * .5f,
-    nearest.collision.y + nearest.collision.height * .5f,
+    nearest.x + nearest.width * .5f,
+    nearest.y + nearest.height * .5f,
   };
   const Vector2 origin = Vector2 {dim.x * .5f, 0.f};
   const f32 rotation = get_movement_rotation(abl.position, nearest_center) + 270.f;
@@ -177,7 +188,7 @@ void render_ability_codex(ability& abl) {
     dim.x, 
     distance
   };
-  play_sprite_on_site_pro(sheet, dest, origin, rotation, WHITE);
+  play_sprite_on_site_pro(anim, dest, origin, rotation, WHITE);
 
   const Texture2D *const icon_tex = ss_get_texture_by_enum(TEX_ID_ASSET_ATLAS);
   Rectangle codex_book_dest = Rectangle { abl.position.x, abl.position.y, CODEX_BOOK_DIM_DEST, CODEX_BOOK_DIM_DEST };
@@ -198,27 +209,26 @@ void refresh_ability_codex(ability& abl) {
   // INFO: This ability has one projectile
   abl.proj_count = 1;
 
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
   abl.animation_ids.push_back(SHEET_ID_ABILITY_CODEX);
+  if (not reset_projectile_slots(abl, abl.proj_count)) {
+    return;
+  }
+  projectile_data_soa& prjs = get_projectile_pool();
 
-  for (size_t itr_000 = 0u; itr_000 < static_cast<size_t>(abl.proj_count); ++itr_000) {
-    projectile& prj = abl.projectiles.emplace_back(projectile());
-    prj.collision = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.duration = abl.proj_duration;
-    for (spritesheet_id sheet_id : abl.animation_ids) {
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    prjs.collision[slot] = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
+    prjs.damage[slot] = abl.base_damage;
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+    prjs.duration[slot] = abl.proj_duration;
+    for (size_t itr_111 = 0u; itr_111 < abl.animation_ids.size(); ++itr_111) {
+      const spritesheet_id sheet_id = abl.animation_ids.at(itr_111);
       if (sheet_id <= SHEET_ID_SPRITESHEET_UNSPECIFIED or sheet_id >= SHEET_ID_SPRITESHEET_TYPE_MAX) {
         IWARN("ability::refresh_ability_codex()::Ability sprite not initialized or corrupted");
         return;
       }
-      spritesheet& spr = prj.animations.emplace_back(spritesheet());
-      spr.sheet_id = sheet_id;
-      set_sprite(spr, false, false);
-      spr.origin = VECTOR2( spr.coord.width * .5f,  spr.coord.height * .5f );
-      prj.active_sprite = 0;
+      set_sprite(prjs.animation(slot, static_cast<i32>(itr_111)), sheet_id, false, false);
+      prjs.active_sprite[slot] = 0;
     }
   }
 }
@@ -6,10 +6,13 @@
 #include "core/fmath.h"
 #include "core/fmemory.h"
 #include "core/ftime.h"
+#include "core/frandom.h"
 #include "core/logger.h"
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 // INFO: vec_ex.f32[0] = projectiles new pos x
 //       vec_ex.f32[0] = projectiles new pos y
 //
@@ -33,7 +36,7 @@ bool ability_comet_initialize(const camera_metrics *const _camera_metrics, const
   if (state and state != nullptr) {
     return true;
   }
-  state = (ability_comet_state*)allocate_memory_linear(sizeof(ability_comet_state),true);
+  state = (ability_comet_state*)allocate_memory_linear(sizeof(ability_comet_state),true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IERROR("ability::ability_comet_initialize()::Failed to allocate state");
     return false;
@@ -107,46 +110,52 @@ void update_ability_comet(ability& abl) {
   }
   const Rectangle *const frustum = __builtin_addressof(state->in_camera_metrics->frustum);
 
-  for (projectile& prj : abl.projectiles) {
-    if (not prj.is_active) { continue; }
-    if (prj.active_sprite == 1 or vec2_equals(prj.position, pVECTOR2(prj.vec_ex.f32), .1)) {
-      if (prj.active_sprite == 0) {
-        prj.active_sprite = 1;
-        reset_sprite(prj.animations.at(prj.active_sprite), true);
+  projectile_data_soa& prjs = get_projectile_pool();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
+    i32& active_sprite = prjs.active_sprite[slot];
+    Vector2& position = prjs.position[slot];
+    Rectangle& collision = prjs.collision[slot];
+    data256& vec_ex = prjs.vec_ex[slot];
+
+    if (active_sprite == 1 or vec2_equals(position, pVECTOR2(vec_ex.f32), .1)) {
+      if (active_sprite == 0) {
+        active_sprite = 1;
+        reset_sprite(prjs.animation(slot, active_sprite), true);
       }
-      else if (prj.active_sprite == 1 and prj.animations.at(prj.active_sprite).is_played) {
-        reset_sprite(prj.animations.at(prj.active_sprite), false);
+      else if (active_sprite == 1 and prjs.animation(slot, active_sprite).has_flag(PROJECTILE_ANIMATION_FLAG_PLAYED)) {
+        reset_sprite(prjs.animation(slot, active_sprite), false);
         
-        const f32 rand = get_random(frustum->x, frustum->x + frustum->width);
-        prj.position = VECTOR2(rand, frustum->y - abl.proj_dim.y);
+        const f32 rand = random_range(RANDOM_STREAM_ABILITY, frustum->x, frustum->x + frustum->width);
+        position = VECTOR2(rand, frustum->y - abl.proj_dim.y);
         const Vector2 new_pos = {
-          (f32)get_random(frustum->x + frustum->width  * .1f, frustum->x + frustum->width  - frustum->width  * .1f),
-          (f32)get_random(frustum->y + frustum->height * .2f, frustum->y + frustum->height - frustum->height * .2f)
+          (f32)random_range(RANDOM_STREAM_ABILITY, frustum->x + frustum->width  * .1f, frustum->x + frustum->width  - frustum->width  * .1f),
+          (f32)random_range(RANDOM_STREAM_ABILITY, frustum->y + frustum->height * .2f, frustum->y + frustum->height - frustum->height * .2f)
         };
-        prj.vec_ex.f32[0] = new_pos.x;
-        prj.vec_ex.f32[1] = new_pos.y;
+        vec_ex.f32[0] = new_pos.x;
+        vec_ex.f32[1] = new_pos.y;
         
-        prj.active_sprite = 0;
-        prj.animations.at(prj.active_sprite).rotation = get_movement_rotation(prj.position, pVECTOR2(prj.vec_ex.f32)) + 270.f;
+        active_sprite = 0;
+        prjs.draw_state[slot].rotation = get_movement_rotation(position, pVECTOR2(vec_ex.f32)) + 270.f;
       }
-      else if (prj.active_sprite == 1 and prj.animations.at(prj.active_sprite).current_frame == 0) {
-        i16 base_damage = static_cast<i16>(prj.damage);
+      else if (active_sprite == 1 and prjs.animation(slot, active_sprite).current_frame == 0) {
+        i16 base_damage = static_cast<i16>(prjs.damage[slot]);
         i16 final_damage = base_damage + (base_damage * player->stats.at(CHARACTER_STATS_OVERALL_DAMAGE).buffer.f32[3]);
         event_fire(EVENT_CODE_DAMAGE_ANY_SPAWN_IF_COLLIDE, event_context(
-          static_cast<i16>(prj.position.x), static_cast<i16>(prj.position.y), static_cast<i16>(prj.collision.width * prj.mm_ex.f32[0]), static_cast<i16>(0),
-          final_damage, static_cast<i16>(COLLISION_TYPE_CIRCLE_RECTANGLE)
+          static_cast<i16>(position.x), static_cast<i16>(position.y), static_cast<i16>(collision.width * prjs.mm_ex[slot].f32[0]), static_cast<i16>(0),
+          final_damage, static_cast<i16>(COLLISION_TYPE_CIRCLE_RECTANGLE), static_cast<i16>(abl.id)
         ));
       }
     }
     else {
-      prj.active_sprite = 0;
-      prj.position = move_towards(prj.position, pVECTOR2(prj.vec_ex.f32), abl.proj_speed);
+      active_sprite = 0;
+      position = move_towards(position, pVECTOR2(vec_ex.f32), abl.proj_speed);
 
-      prj.collision.x = prj.position.x - prj.collision.width  * .5f;
-      prj.collision.y = prj.position.y - prj.collision.height * .5f;
+      collision.x = position.x - collision.width  * .5f;
+      collision.y = position.y - collision.height * .5f;
     }
 
-    update_sprite(prj.animations.at(prj.active_sprite), (*state->in_ingame_info->delta_time) );
+    update_sprite(prjs.animation(slot, active_sprite), (*state->in_ingame_info->delta_time) );
   }
 }
 void render_ability_comet(ability& abl){
@@ -158,24 +167,31 @@ void render_ability_comet(ability& abl){
     IWARN("ability::render_comet()::Ability is not active or not initialized");
     return;
   }
-  for (projectile& prj : abl.projectiles) {
-    if (not prj.is_active) { continue; }
+  projectile_data_soa& prjs = get_projectile_pool();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
+    projectile_animation& anim = prjs.animation(slot, prjs.active_sprite[slot]);
+    const spritesheet * const sheet = ss_get_spritesheet_by_enum(anim.sheet_id);
+    if (not sheet or sheet == nullptr) { continue; }
     Vector2 dim = ZEROVEC2;
-    if (prj.active_sprite == 1) {
+    f32 rotation = 0.f;
+    if (prjs.active_sprite[slot] == 1) {
       dim = Vector2 {
-        prj.animations.at(prj.active_sprite).current_frame_rect.width  * abl.proj_sprite_scale * prj.mm_ex.f32[0],
-        prj.animations.at(prj.active_sprite).current_frame_rect.height * abl.proj_sprite_scale * prj.mm_ex.f32[0]
+        sheet->current_frame_rect.width  * abl.proj_sprite_scale * prjs.mm_ex[slot].f32[0],
+        sheet->current_frame_rect.height * abl.proj_sprite_scale * prjs.mm_ex[slot].f32[0]
       };
     }
     else {
       dim = Vector2 {
-        prj.animations.at(prj.active_sprite).current_frame_rect.width  * abl.proj_sprite_scale,
-        prj.animations.at(prj.active_sprite).current_frame_rect.height * abl.proj_sprite_scale
+        sheet->current_frame_rect.width  * abl.proj_sprite_scale,
+        sheet->current_frame_rect.height * abl.proj_sprite_scale
       };
+      rotation = prjs.draw_state[slot].rotation;
     }
-    prj.animations.at(prj.active_sprite).origin.x = dim.x / 2.f;
-    prj.animations.at(prj.active_sprite).origin.y = dim.y / 2.f;
-    play_sprite_on_site(prj.animations.at(prj.active_sprite), WHITE, Rectangle { prj.position.x, prj.position.y, dim.x, dim.y });
+    const Vector2 offset = projectile_render_offset(slot);
+    sprite_batch_play_sprite_pro(anim, SPRITE_LAYER_SCENE, Rectangle { prjs.position[slot].x + offset.x, prjs.position[slot].y + offset.y, dim.x, dim.y }, 
+      Vector2 { dim.x / 2.f, dim.y / 2.f }, rotation, WHITE
+    );
   }
 }
 void refresh_ability_comet(ability& abl) {
@@ -187,44 +203,34 @@ void refresh_ability_comet(ability& abl) {
     IWARN("ability::refresh_ability_comet()::Ability projectile count exceed");
     return;
   }
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
   abl.animation_ids.push_back(SHEET_ID_FIREBALL_ANIMATION);
   abl.animation_ids.push_back(SHEET_ID_FIREBALL_EXPLOTION_ANIMATION);
+  if (not reset_projectile_slots(abl, abl.proj_count)) {
+    return;
+  }
+  projectile_data_soa& prjs = get_projectile_pool();
 
-  for (int itr_000 = 0; itr_000 < abl.proj_count; ++itr_000) {
-    projectile prj = projectile();
-    prj.collision = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.duration = abl.proj_duration;
-    prj.mm_ex.f32[0] = abl.mm_ex.f32[0];
-
-    spritesheet spr_fireball = spritesheet();
-    spr_fireball.sheet_id = abl.animation_ids.at(0);
-    set_sprite(spr_fireball, true, false);
-    spr_fireball.origin = VECTOR2( spr_fireball.coord.width * .5f,  spr_fireball.coord.height * .5f );
-    prj.animations.push_back(spr_fireball);
-
-    spritesheet spr_expl = spritesheet();
-    spr_expl.sheet_id = abl.animation_ids.at(1);
-    set_sprite(spr_expl, false, true);
-    spr_expl.origin = VECTOR2( spr_expl.coord.width * .5f,  spr_expl.coord.height * .5f );
-    prj.animations.push_back(spr_expl); 
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    prjs.collision[slot] = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
+    prjs.damage[slot] = abl.base_damage;
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+    prjs.duration[slot] = abl.proj_duration;
+    prjs.mm_ex[slot].f32[0] = abl.mm_ex.f32[0];
+
+    set_sprite(prjs.animation(slot, 0), abl.animation_ids.at(0), true, false);
+    set_sprite(prjs.animation(slot, 1), abl.animation_ids.at(1), false, true);
     
     const Rectangle *const frustum = __builtin_addressof(state->in_camera_metrics->frustum);
-    const f32 rand = get_random(frustum->x, frustum->x + frustum->width);
-    prj.position = VECTOR2(rand, frustum->y - abl.proj_dim.y);
+    const f32 rand = random_range(RANDOM_STREAM_ABILITY, frustum->x, frustum->x + frustum->width);
+    prjs.position[slot] = VECTOR2(rand, frustum->y - abl.proj_dim.y);
     Vector2 new_pos = {
-      (f32)get_random(frustum->x + frustum->width  * .1f, frustum->x + frustum->width  - frustum->width  * .1f),
-      (f32)get_random(frustum->y + frustum->height * .2f, frustum->y + frustum->height - frustum->height * .2f)
+      (f32)random_range(RANDOM_STREAM_ABILITY, frustum->x + frustum->width  * .1f, frustum->x + frustum->width  - frustum->width  * .1f),
+      (f32)random_range(RANDOM_STREAM_ABILITY, frustum->y + frustum->height * .2f, frustum->y + frustum->height - frustum->height * .2f)
     };
-    prj.vec_ex.f32[0] = new_pos.x;
-    prj.vec_ex.f32[1] = new_pos.y;
-    prj.active_sprite = 0;
-    prj.animations.at(prj.active_sprite).rotation = get_movement_rotation(prj.position, pVECTOR2(prj.vec_ex.f32)) + 270.f;
-
-    abl.projectiles.push_back(prj);
+    prjs.vec_ex[slot].f32[0] = new_pos.x;
+    prjs.vec_ex[slot].f32[1] = new_pos.y;
+    prjs.active_sprite[slot] = 0;
+    prjs.draw_state[slot].rotation = get_movement_rotation(prjs.position[slot], pVECTOR2(prjs.vec_ex[slot].f32)) + 270.f;
   }
 }
@@ -9,6 +9,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 typedef struct ability_fireball_state {
   const camera_metrics* in_camera_metrics;
   const app_settings* in_settings;
@@ -26,7 +28,7 @@ bool ability_fireball_initialize(const camera_metrics *const _camera_metrics, co
   if (state and state != nullptr) {
     return true;
   }
-  state = (ability_fireball_state*)allocate_memory_linear(sizeof(ability_fireball_state),true);
+  state = (ability_fireball_state*)allocate_memory_linear(sizeof(ability_fireball_state),true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IERROR("ability::ability_fireball_initialize()::Failed to allocate state");
     return false;
@@ -95,31 +97,34 @@ void update_ability_fireball(ability& abl) {
 
   if (abl.rotation > 360.f) abl.rotation = 0.f;
 
-  for (size_t itr_000 = 0u; itr_000 < abl.projectiles.size(); itr_000++) {
-    projectile& prj = abl.projectiles[itr_000];
-    if (not prj.is_active) { continue; }
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot_begin = abl.proj_slot_begin();
+  for (size_t slot = slot_begin; slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
+    Vector2& position = prjs.position[slot];
+    Rectangle& collision = prjs.collision[slot];
 
-    i16 angle = (i32)(((360.f / abl.projectiles.size()) * itr_000) + abl.rotation) % 360;
+    i16 angle = (i32)(((360.f / abl.proj_slot_count) * (slot - slot_begin)) + abl.rotation) % 360;
 
-    prj.position = get_a_point_of_a_circle( abl.position, (abl.level * 3.f) + player->collision.height + 15, angle);
-    prj.collision.x = prj.position.x - (prj.collision.width * .5f);
-    prj.collision.y = prj.position.y - (prj.collision.width * .5f);
+    position = get_a_point_of_a_circle( abl.position, (abl.level * 3.f) + player->collision.height + 15, angle);
+    collision.x = position.x - (collision.width * .5f);
+    collision.y = position.y - (collision.width * .5f);
     
-    const f32 prj_collision_width = prj.collision.width * aoe_scale;
-    const f32 prj_collision_height = prj.collision.height * aoe_scale;
+    const f32 prj_collision_width = collision.width * aoe_scale;
+    const f32 prj_collision_height = collision.height * aoe_scale;
     Rectangle prj_collision = Rectangle {
-      prj.collision.x - (prj_collision_width  * .5f),
-      prj.collision.y - (prj_collision_height * .5f),
+      collision.x - (prj_collision_width  * .5f),
+      collision.y - (prj_collision_height * .5f),
       prj_collision_width,
       prj_collision_height,
     };
-    i16 base_damage = static_cast<i16>(prj.damage);
+    i16 base_damage = static_cast<i16>(prjs.damage[slot]);
     i16 final_damage = base_damage + (base_damage * player->stats.at(CHARACTER_STATS_OVERALL_DAMAGE).buffer.f32[3]);
     event_fire(EVENT_CODE_DAMAGE_ANY_SPAWN_IF_COLLIDE, event_context(
       static_cast<i16>(prj_collision.x), static_cast<i16>(prj_collision.y), static_cast<i16>(prj_collision.width), static_cast<i16>(prj_collision.height),
-      final_damage, static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE)
+      final_damage, static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE), static_cast<i16>(abl.id)
     ));
-    update_sprite(prj.animations.at(0), (*state->in_ingame_info->delta_time) );
+    update_sprite(prjs.animation(slot, 0), (*state->in_ingame_info->delta_time) );
   }
 }
 
@@ -134,18 +139,23 @@ void render_ability_fireball(ability& abl){
   }
   const f32& aoe_scale = state->in_ingame_info->player_state_dynamic->stats.at(CHARACTER_STATS_AOE).buffer.f32[3];
 
-  for (projectile& prj : abl.projectiles) {
-    if (not prj.is_active) { continue; }
+  projectile_data_soa& prjs = get_projectile_pool();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
+    projectile_animation& anim = prjs.animation(slot, prjs.active_sprite[slot]);
+    const spritesheet * const sheet = ss_get_spritesheet_by_enum(anim.sheet_id);
+    if (not sheet or sheet == nullptr) { continue; }
     Vector2 dim = Vector2 {
-      prj.animations.at(prj.active_sprite).current_frame_rect.width  * abl.proj_sprite_scale,
-      prj.animations.at(prj.active_sprite).current_frame_rect.height * abl.proj_sprite_scale
+      sheet->current_frame_rect.width  * abl.proj_sprite_scale,
+      sheet->current_frame_rect.height * abl.proj_sprite_scale
     };
     dim.x += (dim.x * aoe_scale * .5f);
     dim.y += (dim.y * aoe_scale * .5f);
-    prj.animations.at(prj.active_sprite).origin.x = dim.x / 2.f;
-    prj.animations.at(prj.active_sprite).origin.y = dim.y / 2.f;
 
-    play_sprite_on_site(prj.animations.at(prj.active_sprite), WHITE, Rectangle { prj.position.x, prj.position.y, dim.x, dim.y });
+    const Vector2 offset = projectile_render_offset(slot);
+    sprite_batch_play_sprite_pro(anim, SPRITE_LAYER_SCENE, Rectangle { prjs.position[slot].x + offset.x, prjs.position[slot].y + offset.y, dim.x, dim.y }, 
+      Vector2 { dim.x / 2.f, dim.y / 2.f }, 0.f, WHITE
+    );
   }
 }
 
@@ -166,23 +176,21 @@ void refresh_ability_fireball(ability& abl) {
     IWARN("ability::refresh_ability_fireball()::Ability projectile count exceed");
     return;
   }
-  abl.projectiles.clear();
-  abl.projectiles.reserve(abl.proj_count);
   abl.animation_ids.clear();
   abl.animation_ids.push_back(SHEET_ID_FLAME_ENERGY_ANIMATION);
+  if (not reset_projectile_slots(abl, abl.proj_count)) {
+    return;
+  }
+  projectile_data_soa& prjs = get_projectile_pool();
 
-  for (i32 itr_000 = 0; itr_000 < abl.proj_count; ++itr_000) {
-    projectile& prj = abl.projectiles.emplace_back(projectile());
-    prj.collision = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.duration = abl.proj_duration;
-    for (spritesheet_id& sheet_id : abl.animation_ids) {
-      spritesheet& spr = prj.animations.emplace_back(spritesheet());
-      spr.sheet_id = sheet_id;
-      set_sprite(spr, true, false);
-      spr.origin = VECTOR2( spr.coord.width * .5f,  spr.coord.height * .5f );
-      prj.active_sprite = 0;
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    prjs.collision[slot] = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
+    prjs.damage[slot] = abl.base_damage;
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+    prjs.duration[slot] = abl.proj_duration;
+    for (size_t itr_111 = 0u; itr_111 < abl.animation_ids.size(); ++itr_111) {
+      set_sprite(prjs.animation(slot, static_cast<i32>(itr_111)), abl.animation_ids.at(itr_111), true, false);
+      prjs.active_sprite[slot] = 0;
     }
   }
 }
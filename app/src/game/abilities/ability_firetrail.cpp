@@ -1,4 +1,5 @@
 #include "ability_firetrail.h"
+#include <algorithm>
 #include <reasings.h>
 #include <loc_types.h>
 
@@ -8,6 +9,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 typedef struct ability_firetrail_state {
   const camera_metrics * in_camera_metrics;
   const app_settings * in_settings;
@@ -26,7 +29,7 @@ bool ability_firetrail_initialize(const camera_metrics *const _camera_metrics, c
   if (state and state != nullptr) {
     return true;
   }
-  state = (ability_firetrail_state*)allocate_memory_linear(sizeof(ability_firetrail_state),true);
+  state = (ability_firetrail_state*)allocate_memory_linear(sizeof(ability_firetrail_state),true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IWARN("ability_firetrail::ability_firetrail_initialize()::Failed to allocate state");
     return false;
@@ -113,22 +116,26 @@ void update_ability_firetrail(ability& abl) {
   f32& cd_accumulator = abl.ability_cooldown_accumulator;
   const f32& cd_duration = abl.ability_cooldown_duration - (cd_stat * abl.ability_cooldown_duration);
 
-  for (projectile& prj : abl.projectiles) {
-    if (prj.duration <= 0.f) {
+  projectile_data_soa& prjs = get_projectile_pool();
+  size_t free_slot = abl.proj_slot_end();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) {
+      free_slot = std::min(free_slot, slot);
       continue;
     }
-    i16 base_damage = static_cast<i16>(prj.damage);
+    const Rectangle& collision = prjs.collision[slot];
+    i16 base_damage = static_cast<i16>(prjs.damage[slot]);
     i16 final_damage = base_damage + (base_damage * player->stats.at(CHARACTER_STATS_OVERALL_DAMAGE).buffer.f32[3]);
     event_fire(EVENT_CODE_DAMAGE_ANY_SPAWN_IF_COLLIDE, event_context(
-      static_cast<i16>(prj.collision.x), static_cast<i16>(prj.collision.y), static_cast<i16>(prj.collision.width), static_cast<i16>(prj.collision.height), 
-      final_damage, static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE)
+      static_cast<i16>(collision.x), static_cast<i16>(collision.y), static_cast<i16>(collision.width), static_cast<i16>(collision.height), 
+      final_damage, static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE), static_cast<i16>(abl.id)
     ));
-    update_sprite(prj.animations.at(prj.active_sprite), (*state->in_ingame_info->delta_time) );
-    prj.duration -= (*state->in_ingame_info->delta_time) ;
+    update_sprite(prjs.animation(slot, prjs.active_sprite[slot]), (*state->in_ingame_info->delta_time) );
+    prjs.duration[slot] -= (*state->in_ingame_info->delta_time) ;
+    if (prjs.duration[slot] <= 0.f) { // INFO: Burnt out, the slot is free for the next trail piece
+      prjs.flags[slot] = PROJECTILE_FLAG_NONE;
+    }
   }
-  std::erase_if(abl.projectiles, [](projectile& prj){
-    return prj.duration <= 0.f;
-  });
 
   Rectangle last_placed_projectile_dest = Rectangle { 
     abl.vec_ex.f32[0] + abl.vec_ex.f32[2] * .25f, abl.vec_ex.f32[1] + abl.vec_ex.f32[3] * .5f,
@@ -143,38 +150,39 @@ void update_ability_firetrail(ability& abl) {
   };
 
   cd_accumulator += (*state->in_ingame_info->delta_time) ;
-  if (not CheckCollisionRecs(last_placed_projectile_dest, player_collision) and cd_duration < cd_accumulator) {
+  if (not CheckCollisionRecs(last_placed_projectile_dest, player_collision) and cd_duration < cd_accumulator and free_slot < abl.proj_slot_end()) {
     cd_accumulator = 0.f;
-    projectile prj = projectile();
-    prj.position = ability_position;
+    const size_t slot = free_slot;
+    prjs.position[slot] = ability_position;
 
-    prj.collision = Rectangle {
-      prj.position.x - (ability_projectile_dimentions.x * .5f), prj.position.y - ability_projectile_dimentions.y,
+    Rectangle& collision = prjs.collision[slot];
+    collision = Rectangle {
+      ability_position.x - (ability_projectile_dimentions.x * .5f), ability_position.y - ability_projectile_dimentions.y,
       ability_projectile_dimentions.x, ability_projectile_dimentions.y
     };
-    abl.vec_ex.f32[0] = prj.collision.x;
-    abl.vec_ex.f32[1] = prj.collision.y;
-    abl.vec_ex.f32[2] = prj.collision.width;
-    abl.vec_ex.f32[3] = prj.collision.height;
-
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.duration = abl.proj_duration;
-    prj.active_sprite = 0;
+    abl.vec_ex.f32[0] = collision.x;
+    abl.vec_ex.f32[1] = collision.y;
+    abl.vec_ex.f32[2] = collision.width;
+    abl.vec_ex.f32[3] = collision.height;
+
+    prjs.damage[slot] = abl.base_damage;
+    prjs.duration[slot] = abl.proj_duration;
+    prjs.active_sprite[slot] = 0;
     for (size_t itr_000 = 0u; itr_000 < abl.animation_ids.size(); ++itr_000) {
       if (abl.animation_ids.at(itr_000) <= SHEET_ID_SPRITESHEET_UNSPECIFIED or abl.animation_ids.at(itr_000) >= SHEET_ID_SPRITESHEET_TYPE_MAX) {
         return;
       }
-      spritesheet spr = spritesheet();
-      spr.sheet_id = abl.animation_ids.at(itr_000);
-      set_sprite(spr, true, false);
-      spr.coord.width = spr.current_frame_rect.width * abl.proj_sprite_scale;
-      spr.coord.height = spr.current_frame_rect.height * abl.proj_sprite_scale;
-      spr.origin = VECTOR2(spr.coord.width * .5f ,  spr.coord.height);
-
-      prj.animations.push_back(spr);
+      set_sprite(prjs.animation(slot, static_cast<i32>(itr_000)), abl.animation_ids.at(itr_000), true, false);
+    }
+    const spritesheet * const sheet = ss_get_spritesheet_by_enum(prjs.animation(slot, prjs.active_sprite[slot]).sheet_id);
+    if (not sheet or sheet == nullptr) {
+      return;
     }
-    abl.projectiles.push_back(prj);
+    projectile_draw_state& draw_ctx = prjs.draw_state[slot];
+    draw_ctx.coord.width = sheet->current_frame_rect.width * abl.proj_sprite_scale;
+    draw_ctx.coord.height = sheet->current_frame_rect.height * abl.proj_sprite_scale;
+    draw_ctx.origin = VECTOR2(draw_ctx.coord.width * .5f ,  draw_ctx.coord.height);
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
   }
 }
 
@@ -188,13 +196,13 @@ void render_ability_firetrail(ability& abl) {
     return;
   }
 
-  for (size_t itr_000 = 0u; itr_000 < abl.projectiles.size(); ++itr_000) {
-    projectile& prj = abl.projectiles.at(itr_000);
-    if (not prj.is_active) { continue; }
-    play_sprite_on_site(prj.animations.at(prj.active_sprite), WHITE, Rectangle { 
-      prj.position.x, prj.position.y, prj.animations.at(prj.active_sprite).coord.width, 
-      prj.animations.at(prj.active_sprite).coord.height
-    });
+  projectile_data_soa& prjs = get_projectile_pool();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
+    const projectile_draw_state& draw_ctx = prjs.draw_state[slot];
+    sprite_batch_play_sprite_pro(prjs.animation(slot, prjs.active_sprite[slot]), SPRITE_LAYER_SCENE, Rectangle { 
+      prjs.position[slot].x, prjs.position[slot].y, draw_ctx.coord.width, draw_ctx.coord.height
+    }, draw_ctx.origin, draw_ctx.rotation, WHITE);
   }
 }
 
@@ -212,6 +220,11 @@ void refresh_ability_firetrail(ability& abl) {
   abl.animation_ids.push_back(SHEET_ID_ABILITY_FIRETRAIL_LOOP_ANIMATION);
   abl.animation_ids.push_back(SHEET_ID_ABILITY_FIRETRAIL_END_ANIMATION);
 
+  // INFO: Trail pieces are placed as the player walks, the whole range is kept and a burnt out slot is reused
+  if (not reset_projectile_slots(abl, MAX_ABILITY_PROJECTILE_COUNT)) {
+    return;
+  }
+
   abl.vec_ex.f32[0] = -5000.f; // x INFO: Random numbers where player can't go, for placing first projectile. Maybe there is better way to do it but whatever.
   abl.vec_ex.f32[1] = -5000.f; // y
   abl.vec_ex.f32[2] = 0.f; // width
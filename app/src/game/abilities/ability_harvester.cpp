@@ -9,6 +9,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 enum harvester_phase { UNDEFINED, IDLE, BURST, RETURN, MAX };
 
 struct ability_harvester {
@@ -31,12 +33,12 @@ static ability_harvester * state = nullptr;
 #define HARVESTER_TRAIL_WIDTH state->in_settings->render_height * .15f
 #define HARVESTER_TRAIL_HEIGHT state->in_settings->render_height * .15f
 
-#define PRJ_TARGET_INDEX mm_ex.i32[0]
-#define PRJ_TARGET_ID mm_ex.i32[1]
-#define PRJ_PHASE mm_ex.i32[2]
+#define PRJ_TARGET_INDEX i32[0]
+#define PRJ_TARGET_ID i32[1]
+#define PRJ_PHASE i32[2]
 
-#define PRJ_TARGET_ORIGIN_X vec_ex.f32[0]
-#define PRJ_TARGET_ORIGIN_Y vec_ex.f32[1]
+#define PRJ_TARGET_ORIGIN_X f32[0]
+#define PRJ_TARGET_ORIGIN_Y f32[1]
 
 #define ANIM_IDX_EFFECT 0
 #define ANIM_IDX_HEAD   1
@@ -47,60 +49,54 @@ constexpr i32 ability_animation_count = 3;
 constexpr f32 burst_phase_duration = 1.1f;
 constexpr f32 arrival_threshold = 15.0f; 
 
-bool is_on_screen_spawn_valid(const std::vector<Character2D>& spawns, const element_handle* handle) {
+bool is_on_screen_spawn_valid(const spawn_data_soa& spawns, const element_handle* handle) {
   if (not handle) return false;
-  return handle->index < spawns.size() and spawns[handle->index].character_id == handle->id;
+  return handle->index < spawns.size() and spawns.character_id[handle->index] == handle->id;
 }
 
 void begin_idle(ability& abl) {
   abl.ability_cooldown_accumulator = 0.f;
-  projectile& prj = abl.projectiles[0];
-  prj.PRJ_TARGET_ID = 0;
-  prj.PRJ_TARGET_INDEX = std::numeric_limits<i32>::max();
-  prj.PRJ_PHASE = static_cast<i32>(harvester_phase::IDLE);
-  prj.accumulator = 0.f;
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+  prjs.mm_ex[slot].PRJ_TARGET_ID = 0;
+  prjs.mm_ex[slot].PRJ_TARGET_INDEX = std::numeric_limits<i32>::max();
+  prjs.mm_ex[slot].PRJ_PHASE = static_cast<i32>(harvester_phase::IDLE);
+  prjs.accumulator[slot] = 0.f;
 
   const player_state* player = reinterpret_cast<player_state*>(abl.p_owner);
   if (player) {
-    prj.position = player->position;
-    prj.PRJ_TARGET_ORIGIN_X = player->position.x;
-    prj.PRJ_TARGET_ORIGIN_Y = player->position.y;
-
-    prj.animations[ANIM_IDX_HEAD].coord.x = prj.position.x;
-    prj.animations[ANIM_IDX_HEAD].coord.y = prj.position.y;
-    prj.animations[ANIM_IDX_TRAIL].coord.x = prj.position.x;
-    prj.animations[ANIM_IDX_TRAIL].coord.y = prj.position.y;
-    prj.animations[ANIM_IDX_EFFECT].coord.x = prj.position.x;
-    prj.animations[ANIM_IDX_EFFECT].coord.y = prj.position.y;
+    Vector2& position = prjs.position[slot];
+    position = player->position;
+    prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_X = player->position.x;
+    prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_Y = player->position.y;
   }
 }
 
-void begin_burst(projectile& prj) {
-  prj.PRJ_PHASE = harvester_phase::BURST;
-  prj.accumulator = 0.f;
+void begin_burst(size_t slot) {
+  projectile_data_soa& prjs = get_projectile_pool();
+  prjs.mm_ex[slot].PRJ_PHASE = harvester_phase::BURST;
+  prjs.accumulator[slot] = 0.f;
 }
 
-void begin_return(ability& abl, const std::vector<Character2D>& spawns, const element_handle* handle) {
+void begin_return(ability& abl, const spawn_data_soa& spawns, const element_handle* handle) {
+  const size_t slot = abl.proj_slot_begin();
   if (is_on_screen_spawn_valid(spawns, handle)) {
-    abl.projectiles[0].PRJ_PHASE = harvester_phase::RETURN;
-    const Character2D& spw = spawns[handle->index];
-    projectile& prj = abl.projectiles[0];
+    projectile_data_soa& prjs = get_projectile_pool();
+    prjs.mm_ex[slot].PRJ_PHASE = harvester_phase::RETURN;
+    const Rectangle& spw_collision = spawns.collision[handle->index];
 
     Vector2 burst_pos {
-      spw.collision.x + spw.collision.width * .5f,
-      spw.collision.y + spw.collision.height * .5f
+      spw_collision.x + spw_collision.width * .5f,
+      spw_collision.y + spw_collision.height * .5f
     };
 
-    prj.animations[ANIM_IDX_EFFECT].coord.x = burst_pos.x;
-    prj.animations[ANIM_IDX_EFFECT].coord.y = burst_pos.y;
-
-    prj.PRJ_TARGET_ORIGIN_X = burst_pos.x;
-    prj.PRJ_TARGET_ORIGIN_Y = burst_pos.y;
+    prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_X = burst_pos.x;
+    prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_Y = burst_pos.y;
 
-    prj.position = burst_pos;
-    reset_sprite(prj.animations[ANIM_IDX_EFFECT], true);
+    prjs.position[slot] = burst_pos;
+    reset_sprite(prjs.animation(slot, ANIM_IDX_EFFECT), true);
   }
-  else begin_burst(abl.projectiles[0]);
+  else begin_burst(slot);
 }
 
 
@@ -109,7 +105,7 @@ bool ability_harvester_initialize(const camera_metrics *const _camera_metrics, c
     IWARN("ability::ability_harvester()::Initialize called multiple times");
     return false;
   }
-  state = (ability_harvester*)allocate_memory_linear(sizeof(ability_harvester), true);
+  state = (ability_harvester*)allocate_memory_linear(sizeof(ability_harvester), true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IERROR("ability::ability_harvester()::Failed to allocate state");
     return false;
@@ -164,49 +160,54 @@ void update_ability_harvester(ability& abl) {
   if (not abl.is_active or not abl.is_initialized or not abl.p_owner or abl.p_owner == nullptr) {
     return;
   }
-  if (abl.projectiles.empty() or abl.projectiles[0].animations.size() != ability_animation_count or not state->in_ingame_info->first_spawn_on_screen_handle) {
+  if (abl.proj_slot_count <= 0 or abl.animation_ids.size() != ability_animation_count or not state->in_ingame_info->first_spawn_on_screen_handle) {
     return;
   }
-  const std::vector<Character2D> * const spawns_ptr = state->in_ingame_info->in_spawns;
+  const spawn_data_soa * const spawns_ptr = state->in_ingame_info->in_spawns;
   const element_handle * const spw_on_screen = state->in_ingame_info->first_spawn_on_screen_handle;
-  projectile& prj = abl.projectiles[0];
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+  Vector2& position = prjs.position[slot];
+  data256& mm_ex = prjs.mm_ex[slot];
 
-  switch (static_cast<harvester_phase>(prj.PRJ_PHASE)) {
+  switch (static_cast<harvester_phase>(mm_ex.PRJ_PHASE)) {
     case IDLE: {
       if ( abl.ability_cooldown_accumulator < abl.ability_cooldown_duration) {
         abl.ability_cooldown_accumulator += (*state->in_ingame_info->delta_time);
         return;
       }
       if (is_on_screen_spawn_valid((*spawns_ptr), spw_on_screen)) {
-        prj.PRJ_TARGET_ID = spw_on_screen->id;
-        prj.PRJ_TARGET_INDEX = spw_on_screen->index;
-        begin_burst(prj);
+        mm_ex.PRJ_TARGET_ID = spw_on_screen->id;
+        mm_ex.PRJ_TARGET_INDEX = spw_on_screen->index;
+        begin_burst(slot);
       } 
       return;
     }
     case BURST: {
-      if (prj.accumulator > burst_phase_duration) {
+      if (prjs.accumulator[slot] > burst_phase_duration) {
         begin_return(abl, (*spawns_ptr), spw_on_screen);
         return;
       }
       if (not is_on_screen_spawn_valid( (*spawns_ptr), spw_on_screen)) {
         return;
       }
-      prj.accumulator += (*state->in_ingame_info->delta_time);
+      prjs.accumulator[slot] += (*state->in_ingame_info->delta_time);
 
-      //const f32 blink_t = static_cast<f32>(fast_sin(static_cast<f64>(prj.accumulator * idle_phase_blinking_frequency)));
+      //const f32 blink_t = static_cast<f32>(fast_sin(static_cast<f64>(prjs.accumulator[slot] * idle_phase_blinking_frequency)));
       //const i16 a_channel = static_cast<i16>(((blink_t + 1.0f) * 0.5f) * 200.0f);
-      event_fire(EVENT_CODE_SET_SPAWN_TINT, event_context(static_cast<i16>(spw_on_screen->id), static_cast<i16>(spw_on_screen->index), 255, 0, 0, 255));
+      data128 tint_data = data128(spw_on_screen->id, static_cast<i32>(spw_on_screen->index));
+      tint_data.u8[8] = 255u; tint_data.u8[9] = 0u; tint_data.u8[10] = 0u; tint_data.u8[11] = 255u;
+      event_fire(EVENT_CODE_SET_SPAWN_TINT, event_context(tint_data));
       return;
     }
     case RETURN: {
-      if (not prj.animations[ANIM_IDX_EFFECT].is_played) {
-        update_sprite(prj.animations[ANIM_IDX_EFFECT], (*state->in_ingame_info->delta_time));
+      if (not prjs.animation(slot, ANIM_IDX_EFFECT).has_flag(PROJECTILE_ANIMATION_FLAG_PLAYED)) {
+        update_sprite(prjs.animation(slot, ANIM_IDX_EFFECT), (*state->in_ingame_info->delta_time));
       }
       const player_state* player = reinterpret_cast<player_state*>(abl.p_owner);
 
-      const f32 dx = player->position.x - prj.position.x;
-      const f32 dy = player->position.y - prj.position.y;
+      const f32 dx = player->position.x - position.x;
+      const f32 dy = player->position.y - position.y;
       const f32 distance = sqrt(dx * dx + dy * dy);
 
       if (distance <= arrival_threshold) {
@@ -214,25 +215,15 @@ void update_ability_harvester(ability& abl) {
         return;
       } else {
         if (distance > 0.0001f) {
-          prj.position.x += (dx / distance) * (abl.proj_speed * (*state->in_ingame_info->delta_time));
-          prj.position.y += (dy / distance) * (abl.proj_speed * (*state->in_ingame_info->delta_time));
+          position.x += (dx / distance) * (abl.proj_speed * (*state->in_ingame_info->delta_time));
+          position.y += (dy / distance) * (abl.proj_speed * (*state->in_ingame_info->delta_time));
         }
       }
 
-      {
-        spritesheet& sheet = prj.animations[ANIM_IDX_HEAD];
-        sheet.coord.x = prj.position.x;
-        sheet.coord.y = prj.position.y;
-        update_sprite(sheet, (*state->in_ingame_info->delta_time));
-      }
-      {
-        spritesheet& sheet = prj.animations[ANIM_IDX_TRAIL];
-        sheet.coord.x = prj.position.x;
-        sheet.coord.y = prj.position.y;
-        sheet.rotation = get_movement_rotation(Vector2 { prj.PRJ_TARGET_ORIGIN_X, prj.PRJ_TARGET_ORIGIN_Y }, prj.position) + 280.f;
+      update_sprite(prjs.animation(slot, ANIM_IDX_HEAD), (*state->in_ingame_info->delta_time));
 
-        update_sprite(sheet, (*state->in_ingame_info->delta_time));
-      }
+      prjs.draw_state[slot].rotation = get_movement_rotation(Vector2 { prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_X, prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_Y }, position) + 280.f;
+      update_sprite(prjs.animation(slot, ANIM_IDX_TRAIL), (*state->in_ingame_info->delta_time));
       return;
     }
     default: {
@@ -248,19 +239,29 @@ void render_ability_harvester(ability& abl){
   if (not abl.is_active or not abl.is_initialized or not abl.p_owner) {
     return;
   }
-  if (abl.projectiles.empty() or abl.projectiles[0].animations.size() != ability_animation_count or not state->in_ingame_info->first_spawn_on_screen_handle) {
+  if (abl.proj_slot_count <= 0 or abl.animation_ids.size() != ability_animation_count or not state->in_ingame_info->first_spawn_on_screen_handle) {
     return;
   }
-  projectile& prj = abl.projectiles[0];
-
-  if (static_cast<harvester_phase>(prj.PRJ_PHASE) == harvester_phase::RETURN) {
-    spritesheet& sheet_effect = prj.animations[ANIM_IDX_EFFECT];
-    play_sprite_on_site_pro(sheet_effect, sheet_effect.coord, sheet_effect.origin, sheet_effect.rotation, sheet_effect.tint);
-    spritesheet& sheet_head = prj.animations[ANIM_IDX_HEAD];
-    play_sprite_on_site_pro(sheet_head, sheet_head.coord, sheet_head.origin, sheet_head.rotation, sheet_head.tint);
-
-    spritesheet& sheet_trail = prj.animations[ANIM_IDX_TRAIL];
-    play_sprite_on_site_pro(sheet_trail, sheet_trail.coord, sheet_trail.origin, sheet_trail.rotation, sheet_trail.tint);
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+
+  if (static_cast<harvester_phase>(prjs.mm_ex[slot].PRJ_PHASE) == harvester_phase::RETURN) {
+    const Vector2 offset = projectile_render_offset(slot);
+    const Vector2& position = prjs.position[slot];
+    // INFO: The effect stays where the burst hit, head and trail follow the projectile. Parts are layered on each other, the effect layer keeps their order
+    const Rectangle effect_dest = Rectangle { prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_X, prjs.vec_ex[slot].PRJ_TARGET_ORIGIN_Y, HARVESTER_EFFECT_WIDTH, HARVESTER_EFFECT_HEIGHT };
+    const Rectangle head_dest   = Rectangle { position.x, position.y, HARVESTER_HEAD_WIDTH, HARVESTER_HEAD_HEIGHT };
+    const Rectangle trail_dest  = Rectangle { position.x, position.y, HARVESTER_TRAIL_WIDTH, HARVESTER_TRAIL_HEIGHT };
+
+    sprite_batch_play_sprite_pro(prjs.animation(slot, ANIM_IDX_EFFECT), SPRITE_LAYER_EFFECT, rect_offset(effect_dest, offset), 
+      Vector2 { effect_dest.width * .5f, effect_dest.height * .5f }, 0.f, WHITE
+    );
+    sprite_batch_play_sprite_pro(prjs.animation(slot, ANIM_IDX_HEAD), SPRITE_LAYER_EFFECT, rect_offset(head_dest, offset), 
+      Vector2 { head_dest.width * .5f, head_dest.height * .5f }, 0.f, WHITE
+    );
+    sprite_batch_play_sprite_pro(prjs.animation(slot, ANIM_IDX_TRAIL), SPRITE_LAYER_EFFECT, rect_offset(trail_dest, offset), 
+      Vector2 { trail_dest.width * .5f, trail_dest.height * .5f }, prjs.draw_state[slot].rotation, WHITE
+    );
   }
 }
 void refresh_ability_harvester(ability& abl) {
@@ -272,49 +273,27 @@ void refresh_ability_harvester(ability& abl) {
     IWARN("ability::refresh_ability_harvester()::Ability is not initialized or activated");
     return;
   }
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
   abl.animation_ids.push_back(SHEET_ID_HARVESTER_EFFECT);
   abl.animation_ids.push_back(SHEET_ID_HARVESTER_HEAD);
   abl.animation_ids.push_back(SHEET_ID_HARVESTER_TRAIL);
   abl.proj_count = 1; // INFO: This ability has only 1 projectile
-
-  projectile& prj = abl.projectiles.emplace_back(projectile());
-  prj.collision = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
-  prj.damage = abl.base_damage;
-  prj.is_active = true;
-  prj.duration = abl.proj_duration;
-  prj.PRJ_PHASE = harvester_phase::IDLE;
-
-  {
-    spritesheet& sheet = prj.animations.emplace_back(spritesheet()); 
-    sheet.sheet_id = abl.animation_ids.at(ANIM_IDX_EFFECT);
-    set_sprite(sheet, false, false);
-
-    sheet.coord  = { 0.f, 0.f, HARVESTER_EFFECT_WIDTH, HARVESTER_EFFECT_HEIGHT };
-    sheet.origin = { sheet.coord.width * .5f, sheet.coord.height * .5f};
-  }
-
-  {
-    spritesheet& sheet = prj.animations.emplace_back(spritesheet()); 
-    sheet.sheet_id = abl.animation_ids.at(ANIM_IDX_HEAD);
-    set_sprite(sheet, true, true);
-
-    sheet.coord  = { 0.f, 0.f, HARVESTER_HEAD_WIDTH, HARVESTER_HEAD_HEIGHT };
-    sheet.origin = { sheet.coord.width * .5f, sheet.coord.height * .5f};
-  }
-
-  {
-    spritesheet& sheet = prj.animations.emplace_back(spritesheet()); 
-    sheet.sheet_id = abl.animation_ids.at(ANIM_IDX_TRAIL);
-    set_sprite(sheet, true, true);
-
-    sheet.coord  = { 0.f, 0.f, HARVESTER_TRAIL_WIDTH, HARVESTER_TRAIL_HEIGHT };
-    sheet.origin = { sheet.coord.width * .5f, sheet.coord.height * .5f};
+  if (not reset_projectile_slots(abl, abl.proj_count)) {
+    return;
   }
-
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+
+  prjs.collision[slot] = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
+  prjs.damage[slot] = abl.base_damage;
+  prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+  prjs.duration[slot] = abl.proj_duration;
+  prjs.mm_ex[slot].PRJ_PHASE = harvester_phase::IDLE;
+
+  set_sprite(prjs.animation(slot, ANIM_IDX_EFFECT), abl.animation_ids.at(ANIM_IDX_EFFECT), false, false);
+  set_sprite(prjs.animation(slot, ANIM_IDX_HEAD), abl.animation_ids.at(ANIM_IDX_HEAD), true, true);
+  set_sprite(prjs.animation(slot, ANIM_IDX_TRAIL), abl.animation_ids.at(ANIM_IDX_TRAIL), true, true);
   
-  prj.active_sprite = ANIM_IDX_HEAD;
+  prjs.active_sprite[slot] = ANIM_IDX_HEAD;
 }
 
@@ -1,6 +1,9 @@
 #include "ability_manager.h"
 
+#include "core/fmath.h"
 #include "core/fmemory.h"
+#include "core/fprofiler.h"
+#include "core/ftime.h"
 #include "core/logger.h"
 
 #include "ability_bullet.h"
@@ -17,6 +20,8 @@
 typedef struct ability_system_state {
   std::array<ability, ABILITY_ID_MAX> abilities;
   ability empty_ability;
+  memory_arena projectile_arena;
+  projectile_data_soa projectiles;
 
   const camera_metrics* in_camera_metrics;
   const app_settings* in_settings;
@@ -29,13 +34,19 @@ typedef struct ability_system_state {
 } ability_system_state;
 static ability_system_state * state = nullptr;
 
+// INFO: Every projectile array at its full size, plus the alignment padding between the twelve of them
+#define PROJECTILE_ARENA_CAPACITY (MAX_PROJECTILE_SLOT_COUNT * ( \
+  sizeof(Vector2) * 2u + sizeof(Rectangle) + sizeof(i32) * 2u + sizeof(u8) + \
+  sizeof(projectile_animation) * MAX_PROJECTILE_ANIMATION_COUNT + sizeof(projectile_draw_state) + \
+  sizeof(f32) * 2u + sizeof(data256) * 2u) + 12u * MEMORY_DEFAULT_ALIGNMENT)
+
 void register_ability(ability abl) { state->abilities.at(abl.id) = abl; }
 
 bool ability_system_initialize(const camera_metrics *const _camera_metrics, const app_settings *const _settings, const ingame_info *const _ingame_info) {
   if (state and state != nullptr) {
     return true;
   }
-  state = (ability_system_state*)allocate_memory_linear(sizeof(ability_system_state),true);
+  state = (ability_system_state*)allocate_memory_linear(sizeof(ability_system_state),true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IERROR("ability_manager::ability_system_initialize()::Failed to allocate memory");
     return false;
@@ -58,6 +69,40 @@ bool ability_system_initialize(const camera_metrics *const _camera_metrics, cons
   state->in_camera_metrics = _camera_metrics;
   state->in_ingame_info = _ingame_info;
 
+  if (not memory_arena_create(__builtin_addressof(state->projectile_arena), PROJECTILE_ARENA_CAPACITY, MEMORY_TAG_ABILITY)) {
+    IERROR("ability_manager::ability_system_initialize()::Failed to create projectile arena");
+    return false;
+  }
+  {
+    projectile_data_soa& prjs = state->projectiles;
+    memory_arena *const arena = __builtin_addressof(state->projectile_arena);
+    prjs.position          = arena_vector<Vector2>(arena_allocator<Vector2>(arena));
+    prjs.previous_position = arena_vector<Vector2>(arena_allocator<Vector2>(arena));
+    prjs.collision         = arena_vector<Rectangle>(arena_allocator<Rectangle>(arena));
+    prjs.damage            = arena_vector<i32>(arena_allocator<i32>(arena));
+    prjs.active_sprite     = arena_vector<i32>(arena_allocator<i32>(arena));
+    prjs.flags             = arena_vector<u8>(arena_allocator<u8>(arena));
+    prjs.animations        = arena_vector<projectile_animation>(arena_allocator<projectile_animation>(arena));
+    prjs.draw_state        = arena_vector<projectile_draw_state>(arena_allocator<projectile_draw_state>(arena));
+    prjs.accumulator       = arena_vector<f32>(arena_allocator<f32>(arena));
+    prjs.duration          = arena_vector<f32>(arena_allocator<f32>(arena));
+    prjs.vec_ex            = arena_vector<data256>(arena_allocator<data256>(arena));
+    prjs.mm_ex             = arena_vector<data256>(arena_allocator<data256>(arena));
+
+    prjs.position.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.previous_position.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.collision.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.damage.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.active_sprite.resize(MAX_PROJECTILE_SLOT_COUNT, -1);
+    prjs.flags.resize(MAX_PROJECTILE_SLOT_COUNT, PROJECTILE_FLAG_NONE);
+    prjs.animations.resize(MAX_PROJECTILE_SLOT_COUNT * MAX_PROJECTILE_ANIMATION_COUNT);
+    prjs.draw_state.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.accumulator.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.duration.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.vec_ex.resize(MAX_PROJECTILE_SLOT_COUNT);
+    prjs.mm_ex.resize(MAX_PROJECTILE_SLOT_COUNT);
+  }
+
   if(ability_bullet_initialize(_camera_metrics, _settings, _ingame_info)) {
     register_ability(get_ability_bullet());
   }
@@ -164,6 +209,14 @@ void refresh_ability(ability& abl) {
   }
 }
 void update_abilities(ability_play_system& system) {
+  PROFILE_FUNCTION();
+  projectile_data_soa& prjs = state->projectiles;
+  for (size_t slot = 0u; slot < prjs.size(); ++slot) {
+    prjs.previous_position[slot] = prjs.position[slot];
+    prjs.flags[slot] = prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)
+      ? (prjs.flags[slot] |  PROJECTILE_FLAG_INTERPOLATED)
+      : (prjs.flags[slot] & ~PROJECTILE_FLAG_INTERPOLATED);
+  }
   for (ability& abl : system.abilities) {
     switch (abl.id) {
       case ABILITY_ID_FIREBALL:  update_ability_fireball(abl); break;
@@ -200,6 +253,48 @@ void render_abilities(ability_play_system& system) {
   }
 }
 
+projectile_data_soa& get_projectile_pool(void) {
+  return state->projectiles;
+}
+bool reset_projectile_slots(ability& abl, i32 slot_count) {
+  if (abl.id <= ABILITY_ID_UNDEFINED or abl.id >= ABILITY_ID_MAX) {
+    IWARN("ability_manager::reset_projectile_slots()::Ability is not initialized");
+    return false;
+  }
+  if (slot_count < 0 or slot_count > MAX_ABILITY_PROJECTILE_COUNT) {
+    IWARN("ability_manager::reset_projectile_slots()::Ability projectile count exceed");
+    abl.proj_slot_count = 0;
+    return false;
+  }
+  projectile_data_soa& prjs = state->projectiles;
+  const size_t slot_begin = abl.proj_slot_begin();
+  for (size_t slot = slot_begin; slot < slot_begin + MAX_ABILITY_PROJECTILE_COUNT; ++slot) {
+    prjs.position[slot] = ZEROVEC2;
+    prjs.previous_position[slot] = ZEROVEC2;
+    prjs.collision[slot] = ZERORECT;
+    prjs.damage[slot] = 0;
+    prjs.active_sprite[slot] = -1;
+    prjs.flags[slot] = PROJECTILE_FLAG_NONE;
+    prjs.accumulator[slot] = 0.f;
+    prjs.duration[slot] = 0.f;
+    prjs.vec_ex[slot] = data256();
+    prjs.mm_ex[slot] = data256();
+    prjs.draw_state[slot] = projectile_draw_state();
+    for (i32 itr_000 = 0; itr_000 < MAX_PROJECTILE_ANIMATION_COUNT; ++itr_000) {
+      prjs.animation(slot, itr_000) = projectile_animation();
+    }
+  }
+  abl.proj_slot_count = slot_count;
+  return true;
+}
+Vector2 projectile_render_offset(size_t slot) {
+  const projectile_data_soa& prjs = state->projectiles;
+  if (not prjs.has_flag(slot, PROJECTILE_FLAG_INTERPOLATED)) {
+    return ZEROVEC2;
+  }
+  const Vector2 render_position = vec2_lerp(prjs.previous_position[slot], prjs.position[slot], get_simulation_alpha());
+  return Vector2 { render_position.x - prjs.position[slot].x, render_position.y - prjs.position[slot].y };
+}
 const ability& get_ability(ability_id _id) {
   if (_id <= ABILITY_ID_UNDEFINED or _id >= ABILITY_ID_MAX) {
     IWARN("ability_manager::get_ability()::Ability is not active or not initialized");
@@ -15,4 +15,16 @@ void refresh_ability(ability& abl);
 void update_abilities(ability_play_system& system);
 void render_abilities(ability_play_system& system);
 
+projectile_data_soa& get_projectile_pool(void);
+
+/**
+ * @brief Restores the ability's slots to defaults and takes the first slot_count of them. No allocation, the pool is sized on initialize
+ */
+bool reset_projectile_slots(ability& abl, i32 slot_count);
+
+/**
+ * @brief Distance between the interpolated and the simulated position. Zero for a projectile that was not active on the previous tick
+ */
+Vector2 projectile_render_offset(size_t slot);
+
 #endif
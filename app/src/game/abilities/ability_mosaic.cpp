@@ -8,6 +8,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 struct ability_mosaic_state {
   const camera_metrics* in_camera_metrics;
   const app_settings* in_settings;
@@ -26,7 +28,7 @@ bool ability_mosaic_initialize(const camera_metrics *const _camera_metrics, cons
   if (state && state != nullptr) {
     return false;
   }
-  state = (ability_mosaic_state*)allocate_memory_linear(sizeof(ability_mosaic_state), true);
+  state = (ability_mosaic_state*)allocate_memory_linear(sizeof(ability_mosaic_state), true, MEMORY_TAG_ABILITY);
   if (not state || state == nullptr) {
     return false;
   }
@@ -76,19 +78,19 @@ ability get_ability_mosaic_next_level(ability abl) {
   return abl;
 }
 
-static inline void mosaic_apply_visuals(spritesheet& spr, f32 health_perc) {
+static inline void mosaic_apply_visuals(projectile_draw_state& draw_ctx, f32 health_perc) {
   const f32 injured = 1.f - fmaxf(0.f, fminf(1.f, health_perc));
   const f32 r = 80.f + 175.f * injured;
   const f32 g = 200.f - 120.f * injured;
   const f32 b = 255.f - 155.f * injured;
-  spr.tint = Color{ (u8)r, (u8)g, (u8)b, 255u };
+  draw_ctx.tint = Color{ (u8)r, (u8)g, (u8)b, 255u };
 }
 
 void update_ability_mosaic(ability& abl) {
   if (abl.id != ABILITY_ID_SHATTERED_MOSAIC) {
     return;
   }
-  if (not abl.is_active or not abl.is_initialized or abl.projectiles.empty()) {
+  if (not abl.is_active or not abl.is_initialized or abl.proj_slot_count <= 0) {
     return;
   }
   if (not state->in_ingame_info or not state->in_ingame_info->player_state_dynamic or not state->in_ingame_info->delta_time) return;
@@ -114,16 +116,22 @@ void update_ability_mosaic(ability& abl) {
   abl.position.x = player.position.x;
   abl.position.y = player.position.y;
 
-  const size_t N = abl.projectiles.size();
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot_begin = abl.proj_slot_begin();
+  const size_t N = static_cast<size_t>(abl.proj_slot_count);
+  const f32 t = abl.vec_ex.f32[3];
+  const f32 ax = abl.vec_ex.f32[0];
+  const f32 ay = abl.vec_ex.f32[1];
+  const f32 overall_damage_multiplier = player.stats.at(CHARACTER_STATS_OVERALL_DAMAGE).buffer.f32[3];
   for (size_t i = 0u; i < N; ++i) {
-    projectile& prj = abl.projectiles[i];
-    spritesheet& spr = prj.animations[0];
-
-    const f32 t = abl.vec_ex.f32[3];
-    const f32 ax = abl.vec_ex.f32[0];
-    const f32 ay = abl.vec_ex.f32[1];
-    const f32 phx = prj.mm_ex.f32[0];
-    const f32 phy = prj.mm_ex.f32[1];
+    const size_t slot = slot_begin + i;
+    Vector2& position = prjs.position[slot];
+    Rectangle& collision = prjs.collision[slot];
+    data256& vec_ex = prjs.vec_ex[slot];
+    projectile_draw_state& draw_ctx = prjs.draw_state[slot];
+
+    const f32 phx = prjs.mm_ex[slot].f32[0];
+    const f32 phy = prjs.mm_ex[slot].f32[1];
     const f32 freq_x = 2.0f + 0.07f * (f32)(i % 11);
     const f32 freq_y = 3.0f + 0.11f * (f32)(i % 7);
     const f32 drift_x = 0.25f * ax * sinf((1.3f + 0.05f * (f32)(i % 13)) * t + phy);
@@ -132,29 +140,29 @@ void update_ability_mosaic(ability& abl) {
     const f32 nx = abl.position.x + ax * sinf(freq_x * t + phx) + drift_x;
     const f32 ny = abl.position.y + ay * cosf(freq_y * t + phy) + drift_y;
 
-    const Vector2 prev = Vector2{ prj.vec_ex.f32[0], prj.vec_ex.f32[1] };
+    const Vector2 prev = Vector2{ vec_ex.f32[0], vec_ex.f32[1] };
     const Vector2 curr = Vector2{ nx, ny };
 
-    prj.position.x = nx;
-    prj.position.y = ny;
-    prj.vec_ex.f32[0] = nx;
-    prj.vec_ex.f32[1] = ny;
+    position.x = nx;
+    position.y = ny;
+    vec_ex.f32[0] = nx;
+    vec_ex.f32[1] = ny;
 
-    spr.coord.x = prj.position.x;
-    spr.coord.y = prj.position.y;
-    spr.rotation = get_movement_rotation(prev, curr);
+    draw_ctx.coord.x = position.x;
+    draw_ctx.coord.y = position.y;
+    draw_ctx.rotation = get_movement_rotation(prev, curr);
 
-    prj.collision.x = prj.position.x - (prj.collision.width * 0.5f);
-    prj.collision.y = prj.position.y - (prj.collision.height * 0.5f);
+    collision.x = position.x - (collision.width * 0.5f);
+    collision.y = position.y - (collision.height * 0.5f);
 
-    mosaic_apply_visuals(spr, health_perc);
+    mosaic_apply_visuals(draw_ctx, health_perc);
 
-    i16 base_damage = static_cast<i16>(prj.damage);
-    i16 final_damage = base_damage + static_cast<i16>(base_damage * player.stats.at(CHARACTER_STATS_OVERALL_DAMAGE).buffer.f32[3]);
+    i16 base_damage = static_cast<i16>(prjs.damage[slot]);
+    i16 final_damage = base_damage + static_cast<i16>(base_damage * overall_damage_multiplier);
     event_fire(EVENT_CODE_DAMAGE_ANY_SPAWN_IF_COLLIDE, event_context(
-      static_cast<i16>(prj.collision.x), static_cast<i16>(prj.collision.y), static_cast<i16>(prj.collision.width), static_cast<i16>(prj.collision.height),
+      static_cast<i16>(collision.x), static_cast<i16>(collision.y), static_cast<i16>(collision.width), static_cast<i16>(collision.height),
       final_damage,
-      static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE)
+      static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE), static_cast<i16>(abl.id)
     ));
   }
 }
@@ -169,13 +177,13 @@ void render_ability_mosaic(ability& abl) {
   const atlas_texture * _tex = ss_get_atlas_texture_by_enum(ATLAS_TEX_ID_SCISSER_BLADE);
   if (not _tex) { return; }
 
-  for (size_t i = 0u; i < abl.projectiles.size(); ++i) {
-    projectile& prj = abl.projectiles[i];
-    spritesheet& draw_ctx = prj.animations[0];
+  projectile_data_soa& prjs = get_projectile_pool();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    const projectile_draw_state& draw_ctx = prjs.draw_state[slot];
     Rectangle src = _tex->source;
     src.width = 12.f;
     src.height = 12.f;
-    DrawTexturePro((*_tex->atlas_handle), src, draw_ctx.coord, draw_ctx.origin, draw_ctx.rotation, draw_ctx.tint);
+    sprite_batch_draw_texture((*_tex->atlas_handle), SPRITE_LAYER_SCENE, src, rect_offset(draw_ctx.coord, projectile_render_offset(slot)), draw_ctx.origin, draw_ctx.rotation, draw_ctx.tint);
   }
 }
 
@@ -186,31 +194,33 @@ void refresh_ability_mosaic(ability& abl) {
   if (not abl.is_active or not abl.is_initialized) {
     return;
   }
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
+  if (not reset_projectile_slots(abl, abl.proj_count)) {
+    return;
+  }
+  projectile_data_soa& prjs = get_projectile_pool();
 
   const Rectangle shard_size = {0.f, 0.f,
     abl.proj_dim.x * abl.proj_sprite_scale,
     abl.proj_dim.y * abl.proj_sprite_scale
   };
 
-  for (i32 k = 0; k < abl.proj_count; ++k) {
-    projectile& prj = abl.projectiles.emplace_back(projectile());
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.active_sprite = 0;
-    prj.mm_ex.f32[0] = 0.314f * (f32)(k + 1);
-    prj.mm_ex.f32[1] = 0.618f * (f32)(k + 3);
-    prj.vec_ex.f32[0] = abl.position.x;
-    prj.vec_ex.f32[1] = abl.position.y;
-
-    spritesheet& draw_ctx = prj.animations.emplace_back(spritesheet());
+  for (i32 k = 0; k < abl.proj_slot_count; ++k) {
+    const size_t slot = abl.proj_slot_begin() + static_cast<size_t>(k);
+    prjs.damage[slot] = abl.base_damage;
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+    prjs.active_sprite[slot] = 0;
+    prjs.mm_ex[slot].f32[0] = 0.314f * (f32)(k + 1);
+    prjs.mm_ex[slot].f32[1] = 0.618f * (f32)(k + 3);
+    prjs.vec_ex[slot].f32[0] = abl.position.x;
+    prjs.vec_ex[slot].f32[1] = abl.position.y;
+
+    projectile_draw_state& draw_ctx = prjs.draw_state[slot];
     draw_ctx.coord = shard_size;
     draw_ctx.origin = Vector2 { draw_ctx.coord.width * 0.5f, draw_ctx.coord.height * 0.5f };
     draw_ctx.tint = WHITE;
 
-    prj.collision.width  = shard_size.width  * abl.proj_collision_scale.x;
-    prj.collision.height = shard_size.height * abl.proj_collision_scale.y;
+    prjs.collision[slot].width  = shard_size.width  * abl.proj_collision_scale.x;
+    prjs.collision[slot].height = shard_size.height * abl.proj_collision_scale.y;
   }
 }
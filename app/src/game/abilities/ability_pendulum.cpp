@@ -9,6 +9,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 struct ability_pendulum_state {
   const camera_metrics* in_camera_metrics;
   const app_settings* in_settings;
@@ -39,7 +41,7 @@ bool ability_pendulum_initialize(const camera_metrics *const _camera_metrics, co
     IWARN("ability::ability_pendulum_initialize()::Initialize called multiple times");
     return false;
   }
-  state = (ability_pendulum_state*)allocate_memory_linear(sizeof(ability_pendulum_state), true);
+  state = (ability_pendulum_state*)allocate_memory_linear(sizeof(ability_pendulum_state), true, MEMORY_TAG_ABILITY);
   if (not state || state == nullptr) {
     IERROR("ability::ability_pendulum_initialize()::Failed to allocate state");
     return false;
@@ -91,7 +93,7 @@ void update_ability_pendulum(ability& abl) {
   if (abl.id != ABILITY_ID_PENDULUM) {
     return;
   }
-  if (not abl.is_active or not abl.is_initialized or not abl.p_owner or abl.projectiles.size() < 2) {
+  if (not abl.is_active or not abl.is_initialized or not abl.p_owner or abl.proj_slot_count < 2) {
     return;
   }
   if (abl.p_owner == nullptr or state->in_ingame_info == nullptr) return;
@@ -99,9 +101,12 @@ void update_ability_pendulum(ability& abl) {
   const f32 delta_time = *state->in_ingame_info->delta_time;
   abl.ability_cooldown_accumulator += delta_time;
 
-  auto update_blade = [&abl, &delta_time](projectile& prj, bool swing_backward) {
-    prj.accumulator += delta_time;
-    f32 cycle_time = std::fmod(prj.accumulator, abl.ability_cooldown_duration);
+  projectile_data_soa& prjs = get_projectile_pool();
+  auto update_blade = [&abl, &delta_time, &prjs](size_t slot, bool swing_backward) {
+    Vector2& position = prjs.position[slot];
+    Rectangle& collision = prjs.collision[slot];
+    prjs.accumulator[slot] += delta_time;
+    f32 cycle_time = std::fmod(prjs.accumulator[slot], abl.ability_cooldown_duration);
 
     f32 t = math_easing(cycle_time, 0.0f, 1.0f, abl.ability_cooldown_duration, EASE);
 
@@ -118,55 +123,41 @@ void update_ability_pendulum(ability& abl) {
     f32 vertical_offset = std::sin(t * 3.14159f) * DIP_Y;
     vertical_offset += 10.0f; 
 
-    prj.position.x = state->in_ingame_info->player_state_dynamic->position.x + current_offset_x + X_OFFSET;
-    prj.position.y = state->in_ingame_info->player_state_dynamic->position.y + vertical_offset + Y_OFFSET;
+    position.x = state->in_ingame_info->player_state_dynamic->position.x + current_offset_x + X_OFFSET;
+    position.y = state->in_ingame_info->player_state_dynamic->position.y + vertical_offset + Y_OFFSET;
     
-    prj.collision.x = prj.position.x - (prj.collision.width * 0.5f);
-    prj.collision.y = prj.position.y - (prj.collision.height * 0.5f);
+    collision.x = position.x - (collision.width * 0.5f);
+    collision.y = position.y - (collision.height * 0.5f);
 
-    spritesheet& draw_ctx = prj.animations[0];
+    projectile_draw_state& draw_ctx = prjs.draw_state[slot];
 
     draw_ctx.rotation = current_rotation; 
-    draw_ctx.coord.x = prj.position.x;
-    draw_ctx.coord.y = prj.position.y;
-
-    event_fire(EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT, event_context(
-      static_cast<i16>(prj.collision.x),      
-      static_cast<i16>(prj.collision.y),      
-      static_cast<i16>(prj.collision.width),  
-      static_cast<i16>(prj.collision.height), 
-      static_cast<i16>(abl.base_damage),      
-      static_cast<i16>(current_rotation),     
-      static_cast<i16>(draw_ctx.origin.x),
-      static_cast<i16>(draw_ctx.origin.y)
+    draw_ctx.coord.x = position.x;
+    draw_ctx.coord.y = position.y;
+
+    event_fire_payload(EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT, damage_rotated_rect_payload(
+      collision, draw_ctx.origin, current_rotation, abl.base_damage, static_cast<i32>(abl.id)
     ));
   };
 
-  update_blade(abl.projectiles[0], true);
-  update_blade(abl.projectiles[1], false);
+  update_blade(abl.proj_slot_begin(), true);
+  update_blade(abl.proj_slot_begin() + 1u, false);
 }
 
 void render_ability_pendulum(ability& abl) {
   if (abl.id != ABILITY_ID_PENDULUM) {
     return;
   }
-  if (not abl.is_active or not abl.is_initialized or abl.projectiles.empty()) {
+  if (not abl.is_active or not abl.is_initialized or abl.proj_slot_count < 2) {
     return;
   }
   const atlas_texture * _body_tex = ss_get_atlas_texture_by_enum(ATLAS_TEX_ID_CRIMSON_FANTASY_ORNATE_FRAME);
+  const projectile_data_soa& prjs = get_projectile_pool();
 
-  {
-    projectile& prj = abl.projectiles[0];
-    spritesheet& draw_ctx = prj.animations[0];
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    const projectile_draw_state& draw_ctx = prjs.draw_state[slot];
 
-    DrawTexturePro( (*_body_tex->atlas_handle), _body_tex->source, draw_ctx.coord, draw_ctx.origin, draw_ctx.rotation, draw_ctx.tint);
-  }
-
-  {
-    projectile& prj = abl.projectiles[1];
-    spritesheet& draw_ctx = prj.animations[0];
-    
-    DrawTexturePro( (*_body_tex->atlas_handle), _body_tex->source, draw_ctx.coord, draw_ctx.origin, draw_ctx.rotation, draw_ctx.tint);
+    sprite_batch_draw_texture( (*_body_tex->atlas_handle), SPRITE_LAYER_SCENE, _body_tex->source, rect_offset(draw_ctx.coord, projectile_render_offset(slot)), draw_ctx.origin, draw_ctx.rotation, draw_ctx.tint);
   }
 }
 
@@ -179,36 +170,20 @@ void refresh_ability_pendulum(ability& abl) {
     IWARN("ability::refresh_ability_pendulum()::Ability is not initialized or activated");
     return;
   }
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
-
-  const Rectangle blade_size = {0.f, 0.f, PENDULUM_BLADE_WIDTH, PENDULUM_BLADE_HEIGHT};
-  {
-    projectile& prj = abl.projectiles.emplace_back(projectile());
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.active_sprite = 0;
-
-    spritesheet& draw_ctx = prj.animations.emplace_back(spritesheet());
-    draw_ctx.coord = blade_size;
-    draw_ctx.origin = Vector2 { 
-      draw_ctx.coord.width * 0.5f, 
-      draw_ctx.coord.height * 0.5f 
-    };
-    draw_ctx.tint = WHITE;
-
-    prj.collision.width  = blade_size.width  * abl.proj_collision_scale.x;
-    prj.collision.height = blade_size.height * abl.proj_collision_scale.y;
+  // INFO: Two blades, swinging against each other
+  if (not reset_projectile_slots(abl, 2)) {
+    return;
   }
+  projectile_data_soa& prjs = get_projectile_pool();
 
-  {
-    projectile& prj = abl.projectiles.emplace_back(projectile());
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.active_sprite = 0;
+  const Rectangle blade_size = {0.f, 0.f, PENDULUM_BLADE_WIDTH, PENDULUM_BLADE_HEIGHT};
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    prjs.damage[slot] = abl.base_damage;
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+    prjs.active_sprite[slot] = 0;
 
-    spritesheet& draw_ctx = prj.animations.emplace_back(spritesheet());
+    projectile_draw_state& draw_ctx = prjs.draw_state[slot];
     draw_ctx.coord = blade_size;
     draw_ctx.origin = Vector2 { 
       draw_ctx.coord.width * 0.5f, 
@@ -216,8 +191,8 @@ void refresh_ability_pendulum(ability& abl) {
     };
     draw_ctx.tint = WHITE;
 
-    prj.collision.width  = blade_size.width  * abl.proj_collision_scale.x;
-    prj.collision.height = blade_size.height * abl.proj_collision_scale.y;
+    prjs.collision[slot].width  = blade_size.width  * abl.proj_collision_scale.x;
+    prjs.collision[slot].height = blade_size.height * abl.proj_collision_scale.y;
   }
 }
 
@@ -8,6 +8,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 #define RADIENCE_COLOR_TRANSPARENT  CLITERAL(Color){ 255, 255, 255, 0 }
 #define RADIENCE_COLOR_INNER_CIRCLE_BRIGHT_YARROW  CLITERAL(Color){ 253, 203, 110, 32 }
 #define RADIENCE_CIRCLE_RADIUS_CHANGE 50.f
@@ -51,7 +53,7 @@ bool ability_radience_initialize(const camera_metrics *const _camera_metrics, co
     IWARN("ability::ability_system_initialize()::Init called multiple times");
     return false;
   }
-  state = (ability_radience_state*)allocate_memory_linear(sizeof(ability_radience_state),true);
+  state = (ability_radience_state*)allocate_memory_linear(sizeof(ability_radience_state),true, MEMORY_TAG_ABILITY);
   if (not state or state == nullptr) {
     IERROR("ability::ability_system_initialize()::Failed to allocate memory");
     return false;
@@ -119,24 +121,27 @@ void update_ability_radience(ability& abl) {
   const player_state *const player = reinterpret_cast<player_state*>(abl.p_owner);
   abl.position = player->position;
 
-  projectile& prj = abl.projectiles.at(0);
-  if (not prj.is_active) { return; }
+  if (abl.proj_slot_count <= 0) { return; }
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+  if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { return; }
+  Rectangle& collision = prjs.collision[slot];
 
-  prj.position    = abl.position;
-  prj.collision.x = prj.position.x;
-  prj.collision.y = prj.position.y;
+  prjs.position[slot] = abl.position;
+  collision.x = abl.position.x;
+  collision.y = abl.position.y;
 
   //u16  frame_counter_max           = TARGET_FPS * 1;
-  //u16  circle_inner_radius_base    = prj.mm_ex.u16[0];
-  //u16  circle_outer_radius_base    = prj.mm_ex.u16[1];
-  //u16& frame_counter               = prj.mm_ex.u16[2];
-  //f32  circle_inner_radius_current = static_cast<f32>(prj.mm_ex.u16[3]);
-  //f32  circle_outer_radius_current = static_cast<f32>(prj.mm_ex.u16[4]);
+  //u16  circle_inner_radius_base    = prjs.mm_ex[slot].u16[0];
+  //u16  circle_outer_radius_base    = prjs.mm_ex[slot].u16[1];
+  //u16& frame_counter               = prjs.mm_ex[slot].u16[2];
+  //f32  circle_inner_radius_current = static_cast<f32>(prjs.mm_ex[slot].u16[3]);
+  //f32  circle_outer_radius_current = static_cast<f32>(prjs.mm_ex[slot].u16[4]);
 
-  f32  circle_inner_radius_base    = prj.vec_ex.f32[0];
-  f32  circle_outer_radius_base    = prj.vec_ex.f32[1];
-  f32& circle_inner_radius_current = prj.vec_ex.f32[2];
-  f32& circle_outer_radius_current = prj.vec_ex.f32[3];
+  f32  circle_inner_radius_base    = prjs.vec_ex[slot].f32[0];
+  f32  circle_outer_radius_base    = prjs.vec_ex[slot].f32[1];
+  f32& circle_inner_radius_current = prjs.vec_ex[slot].f32[2];
+  f32& circle_outer_radius_current = prjs.vec_ex[slot].f32[3];
   f32 distance_inner = circle_inner_radius_base * RADIENCE_CIRCLE_RADIUS_PULSE_SCALE;
   f32 distance_outer = circle_outer_radius_base * RADIENCE_CIRCLE_RADIUS_PULSE_SCALE;
   state->pulse_accumulator += (*state->in_ingame_info->delta_time);
@@ -162,13 +167,13 @@ void update_ability_radience(ability& abl) {
     }
     default:
   }
-  i16 base_damage = static_cast<i16>(prj.damage);
+  i16 base_damage = static_cast<i16>(prjs.damage[slot]);
   i16 final_damage = base_damage + (base_damage * player->stats.at(CHARACTER_STATS_OVERALL_DAMAGE).buffer.f32[3]);
   event_fire(EVENT_CODE_DAMAGE_ANY_SPAWN_IF_COLLIDE, event_context(
-    static_cast<i16>(prj.collision.x), static_cast<i16>(prj.collision.y), static_cast<i16>(prj.collision.width), static_cast<i16>(prj.collision.height),
-    final_damage, static_cast<i16>(COLLISION_TYPE_CIRCLE_RECTANGLE)
+    static_cast<i16>(collision.x), static_cast<i16>(collision.y), static_cast<i16>(collision.width), static_cast<i16>(collision.height),
+    final_damage, static_cast<i16>(COLLISION_TYPE_CIRCLE_RECTANGLE), static_cast<i16>(abl.id)
   ));
-  update_sprite(prj.animations.at(prj.active_sprite), (*state->in_ingame_info->delta_time) );
+  update_sprite(prjs.animation(slot, prjs.active_sprite[slot]), (*state->in_ingame_info->delta_time) );
 }
 
 void render_ability_radience(ability& abl){
@@ -183,27 +188,35 @@ void render_ability_radience(ability& abl){
   if (abl.p_owner == nullptr or state->in_ingame_info == nullptr) {
     return;
   }
-  if (not abl.projectiles.at(0).is_active) { return; }
-  projectile *const prj = __builtin_addressof(abl.projectiles.at(0));
+  if (abl.proj_slot_count <= 0) { return; }
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
+  if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { return; }
+  projectile_animation& anim = prjs.animation(slot, prjs.active_sprite[slot]);
+  const spritesheet * const sheet = ss_get_spritesheet_by_enum(anim.sheet_id);
+  const Vector2 offset = projectile_render_offset(slot);
   
-  Vector2 dim = Vector2 {
-    prj->animations.at(prj->active_sprite).current_frame_rect.width  * abl.proj_sprite_scale,
-    prj->animations.at(prj->active_sprite).current_frame_rect.height * abl.proj_sprite_scale
-  };
-  prj->animations.at(prj->active_sprite).origin.x = dim.x / 2.f;
-  prj->animations.at(prj->active_sprite).origin.y = dim.y / 2.f;
-  play_sprite_on_site(prj->animations.at(prj->active_sprite), WHITE, Rectangle { prj->position.x, prj->position.y, dim.x, dim.y });
+  if (sheet and sheet != nullptr) {
+    Vector2 dim = Vector2 {
+      sheet->current_frame_rect.width  * abl.proj_sprite_scale,
+      sheet->current_frame_rect.height * abl.proj_sprite_scale
+    };
+    sprite_batch_play_sprite_pro(anim, SPRITE_LAYER_SCENE, Rectangle { prjs.position[slot].x + offset.x, prjs.position[slot].y + offset.y, dim.x, dim.y }, 
+      Vector2 { dim.x / 2.f, dim.y / 2.f }, 0.f, WHITE
+    );
+  }
 
   //u16  frame_counter_max     = TARGET_FPS * 1;
-  //u16& circle_inner_radius_base = prj->mm_ex.u16[0];
-  //u16& circle_outer_radius_base = prj->mm_ex.u16[1];
-  //u16& frame_counter         = prj->mm_ex.u16[2];
-  f32 circle_inner_radius_current = static_cast<f32>(prj->vec_ex.f32[2]);
-  f32 circle_outer_radius_current = static_cast<f32>(prj->vec_ex.f32[3]);
-  //bool  is_increment = static_cast<bool>(prj->mm_ex.u16[5]);
+  //u16& circle_inner_radius_base = prjs.mm_ex[slot].u16[0];
+  //u16& circle_outer_radius_base = prjs.mm_ex[slot].u16[1];
+  //u16& frame_counter         = prjs.mm_ex[slot].u16[2];
+  f32 circle_inner_radius_current = static_cast<f32>(prjs.vec_ex[slot].f32[2]);
+  f32 circle_outer_radius_current = static_cast<f32>(prjs.vec_ex[slot].f32[3]);
+  //bool  is_increment = static_cast<bool>(prjs.mm_ex[slot].u16[5]);
 
-  DrawCircleGradient(prj->collision.x, prj->collision.y, circle_outer_radius_current, RADIENCE_COLOR_INNER_CIRCLE_BRIGHT_YARROW, RADIENCE_COLOR_TRANSPARENT);
-  DrawCircleGradient(prj->collision.x, prj->collision.y, circle_inner_radius_current, RADIENCE_COLOR_INNER_CIRCLE_BRIGHT_YARROW, RADIENCE_COLOR_TRANSPARENT);
+  const Rectangle& collision = prjs.collision[slot];
+  DrawCircleGradient(collision.x + offset.x, collision.y + offset.y, circle_outer_radius_current, RADIENCE_COLOR_INNER_CIRCLE_BRIGHT_YARROW, RADIENCE_COLOR_TRANSPARENT);
+  DrawCircleGradient(collision.x + offset.x, collision.y + offset.y, circle_inner_radius_current, RADIENCE_COLOR_INNER_CIRCLE_BRIGHT_YARROW, RADIENCE_COLOR_TRANSPARENT);
 }
 
 void refresh_ability_radience(ability& abl) { 
@@ -215,40 +228,38 @@ void refresh_ability_radience(ability& abl) {
     IWARN("ability::refresh_ability_radience()::Ability projectile count exceed");
     return;
   }
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
   abl.animation_ids.push_back(SHEET_ID_GENERIC_LIGHT);
+  // INFO: This ability has one projectile
+  if (not reset_projectile_slots(abl, 1)) {
+    return;
+  }
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot = abl.proj_slot_begin();
   
-  projectile& prj = abl.projectiles.emplace_back(projectile());
-  
-  prj.collision = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
-  prj.damage = abl.base_damage;
-  prj.is_active = true;
-  prj.duration = abl.proj_duration;
+  prjs.collision[slot] = Rectangle {0.f, 0.f, abl.proj_dim.x * abl.proj_collision_scale.x, abl.proj_dim.y * abl.proj_collision_scale.y};
+  prjs.damage[slot] = abl.base_damage;
+  prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+  prjs.duration[slot] = abl.proj_duration;
   for (size_t itr_000 = 0u; itr_000 < abl.animation_ids.size(); ++itr_000) {
     if (abl.animation_ids.at(itr_000) <= SHEET_ID_SPRITESHEET_UNSPECIFIED or abl.animation_ids.at(itr_000) >= SHEET_ID_SPRITESHEET_TYPE_MAX) {
       IWARN("ability::refresh_ability_radience()::One of spritesheets is not initialized or ability corrupted");
       return;
     }
-    spritesheet spr = spritesheet();
-    spr.sheet_id = abl.animation_ids.at(itr_000);
-    set_sprite(spr, true, false);
-    spr.origin = VECTOR2( spr.coord.width * .5f,  spr.coord.height * .5f );
-    prj.animations.push_back(spr); 
+    set_sprite(prjs.animation(slot, static_cast<i32>(itr_000)), abl.animation_ids.at(itr_000), true, false);
   }
   
-  prj.active_sprite = 0;
+  prjs.active_sprite[slot] = 0;
 
-  //u16& circle_inner_radius_base = prj.mm_ex.u16[0];
-  //u16& circle_outer_radius_base = prj.mm_ex.u16[1];
-  //u16& frame_counter            = prj.mm_ex.u16[2];
-  //f32  circle_inner_radius_current = static_cast<f32>(prj.mm_ex.u16[3]);
-  //f32  circle_outer_radius_current = static_cast<f32>(prj.mm_ex.u16[4]);
-  //u16&  is_increment            = prj.mm_ex.u16[5];
+  //u16& circle_inner_radius_base = prjs.mm_ex[slot].u16[0];
+  //u16& circle_outer_radius_base = prjs.mm_ex[slot].u16[1];
+  //u16& frame_counter            = prjs.mm_ex[slot].u16[2];
+  //f32  circle_inner_radius_current = static_cast<f32>(prjs.mm_ex[slot].u16[3]);
+  //f32  circle_outer_radius_current = static_cast<f32>(prjs.mm_ex[slot].u16[4]);
+  //u16&  is_increment            = prjs.mm_ex[slot].u16[5];
 
-  f32& circle_inner_radius_base = prj.vec_ex.f32[0];
-  f32& circle_outer_radius_base = prj.vec_ex.f32[1];
+  f32& circle_inner_radius_base = prjs.vec_ex[slot].f32[0];
+  f32& circle_outer_radius_base = prjs.vec_ex[slot].f32[1];
 
   circle_inner_radius_base = (abl.proj_dim.x * abl.proj_collision_scale.x * RADIENCE_CIRCLE_RADIUS_INNER_SCALE) + (abl.level * .1f);
   circle_outer_radius_base = (abl.proj_dim.x * abl.proj_collision_scale.x * RADIENCE_CIRCLE_RADIUS_OUTER_SCALE) + (abl.level * .1f);
@@ -8,6 +8,8 @@
 
 #include "game/spritesheet.h"
 
+#include "ability_manager.h"
+
 struct ability_scissor_state {
   const camera_metrics* in_camera_metrics;
   const app_settings* in_settings;
@@ -32,7 +34,7 @@ bool ability_scissor_initialize(const camera_metrics *const _camera_metrics, con
   if (state && state != nullptr) {
     return false;
   }
-  state = (ability_scissor_state*)allocate_memory_linear(sizeof(ability_scissor_state), true);
+  state = (ability_scissor_state*)allocate_memory_linear(sizeof(ability_scissor_state), true, MEMORY_TAG_ABILITY);
   if (not state || state == nullptr) {
     return false;
   }
@@ -82,12 +84,14 @@ void update_ability_scissor(ability& abl) {
   if (abl.id != ABILITY_ID_SCISSOR) {
     return;
   }
-  if (not abl.is_active or not abl.is_initialized or abl.projectiles.size() < 2) {
+  if (not abl.is_active or not abl.is_initialized or abl.proj_slot_count < 2) {
     return;
   }
   if (not state->in_ingame_info or not state->in_ingame_info->player_state_dynamic) return;
   
   const player_state& player = (*state->in_ingame_info->player_state_dynamic);
+  projectile_data_soa& prjs = get_projectile_pool();
+  const size_t slot_begin = abl.proj_slot_begin();
   
   const bool face_left = (player.w_direction == WORLD_DIRECTION_LEFT);
   const f32 back_offset_x = player.collision.width * 1.1f;
@@ -96,13 +100,14 @@ void update_ability_scissor(ability& abl) {
   abl.position.y = player.position.y + 20.0f;
 
   for (size_t i = 0u; i < 2; ++i) {
-    projectile& prj = abl.projectiles[i];
-    prj.position = abl.position;
-    prj.collision.x = prj.position.x - (prj.collision.width * 0.5f);
-    prj.collision.y = prj.position.y - (prj.collision.height * 0.5f);
-    spritesheet& spr = prj.animations[0];
-    spr.coord.x = prj.position.x;
-    spr.coord.y = prj.position.y;
+    const size_t slot = slot_begin + i;
+    Rectangle& collision = prjs.collision[slot];
+    prjs.position[slot] = abl.position;
+    collision.x = abl.position.x - (collision.width * 0.5f);
+    collision.y = abl.position.y - (collision.height * 0.5f);
+    projectile_draw_state& draw_ctx = prjs.draw_state[slot];
+    draw_ctx.coord.x = abl.position.x;
+    draw_ctx.coord.y = abl.position.y;
   }
   
   const bool has_valid_animation = player.current_anim_to_play.fps > 0.0001f;
@@ -130,13 +135,14 @@ void update_ability_scissor(ability& abl) {
     );
     abl.position.x = player.position.x + eased_offset;
     for (size_t i = 0u; i < 2; ++i) {
-      projectile& prj = abl.projectiles[i];
-      prj.position = abl.position;
-      prj.collision.x = prj.position.x - (prj.collision.width * 0.5f);
-      prj.collision.y = prj.position.y - (prj.collision.height * 0.5f);
-      spritesheet& spr = prj.animations[0];
-      spr.coord.x = prj.position.x;
-      spr.coord.y = prj.position.y;
+      const size_t slot = slot_begin + i;
+      Rectangle& collision = prjs.collision[slot];
+      prjs.position[slot] = abl.position;
+      collision.x = abl.position.x - (collision.width * 0.5f);
+      collision.y = abl.position.y - (collision.height * 0.5f);
+      projectile_draw_state& draw_ctx = prjs.draw_state[slot];
+      draw_ctx.coord.x = abl.position.x;
+      draw_ctx.coord.y = abl.position.y;
     }
     f32 opening_deg = 0.f;
     if (!is_returning) {
@@ -145,28 +151,22 @@ void update_ability_scissor(ability& abl) {
       opening_deg = math_easing(local_time, 0.f, (SCISSOR_SWING_MAX_DEG - 0.f), half_duration, SWING_EASE);
     }
 
-    abl.projectiles[0u].animations[0u].rotation =  opening_deg + 90.0f + dir_offset;
-    abl.projectiles[1u].animations[0u].rotation = -opening_deg + 90.0f + dir_offset;
+    prjs.draw_state[slot_begin].rotation      =  opening_deg + 90.0f + dir_offset;
+    prjs.draw_state[slot_begin + 1u].rotation = -opening_deg + 90.0f + dir_offset;
 
     for (size_t i = 0u; i < 2; ++i) {
-      projectile& prj = abl.projectiles[i];
-      spritesheet& spr = prj.animations[0u];
-      event_fire(EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT, event_context(
-        static_cast<i16>(prj.collision.x),
-        static_cast<i16>(prj.collision.y),
-        static_cast<i16>(prj.collision.width),
-        static_cast<i16>(prj.collision.height),
-        static_cast<i16>(abl.base_damage),
-        static_cast<i16>(spr.rotation),
-        static_cast<i16>(spr.origin.x),
-        static_cast<i16>(spr.origin.y)
+      const size_t slot = slot_begin + i;
+      const Rectangle& collision = prjs.collision[slot];
+      const projectile_draw_state& draw_ctx = prjs.draw_state[slot];
+      event_fire_payload(EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT, damage_rotated_rect_payload(
+        collision, draw_ctx.origin, draw_ctx.rotation, abl.base_damage, static_cast<i32>(abl.id)
       ));
     }
   } else {
     const f32 dir_offset = face_left ? 180.0f : 0.0f;
     abl.ability_cooldown_accumulator = 0.0f;
-    abl.projectiles[0u].animations[0u].rotation =  SCISSOR_SWING_MAX_DEG + 90.0f + dir_offset;
-    abl.projectiles[1u].animations[0u].rotation = -SCISSOR_SWING_MAX_DEG + 90.0f + dir_offset;
+    prjs.draw_state[slot_begin].rotation      =  SCISSOR_SWING_MAX_DEG + 90.0f + dir_offset;
+    prjs.draw_state[slot_begin + 1u].rotation = -SCISSOR_SWING_MAX_DEG + 90.0f + dir_offset;
   }
 }
 
@@ -185,14 +185,14 @@ void render_ability_scissor(ability& abl) {
     face_left = (state->in_ingame_info->player_state_dynamic->w_direction == WORLD_DIRECTION_LEFT);
   }
 
-  for (size_t i = 0u; i < abl.projectiles.size(); ++i) {
-    projectile& prj = abl.projectiles[i];
-    spritesheet& draw_ctx = prj.animations[0];
+  const projectile_data_soa& prjs = get_projectile_pool();
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    const projectile_draw_state& draw_ctx = prjs.draw_state[slot];
     Rectangle src = _body_tex->source;
     if (face_left) {
       src.width *= -1.f;
     }
-    DrawTexturePro((*_body_tex->atlas_handle), src, draw_ctx.coord, draw_ctx.origin, draw_ctx.rotation, draw_ctx.tint);
+    sprite_batch_draw_texture((*_body_tex->atlas_handle), SPRITE_LAYER_SCENE, src, rect_offset(draw_ctx.coord, projectile_render_offset(slot)), draw_ctx.origin, draw_ctx.rotation, draw_ctx.tint);
   }
 }
 
@@ -203,27 +203,28 @@ void refresh_ability_scissor(ability& abl) {
   if (not abl.is_active or not abl.is_initialized) {
     return;
   }
-  abl.projectiles.clear();
   abl.animation_ids.clear();
-  abl.projectiles.reserve(abl.proj_count);
+  if (not reset_projectile_slots(abl, 2)) {
+    return;
+  }
+  projectile_data_soa& prjs = get_projectile_pool();
 
   const Rectangle blade_size = {0.f, 0.f, 
     SCISSOR_BLADE_WIDTH * abl.proj_sprite_scale, 
     SCISSOR_BLADE_HEIGHT * abl.proj_sprite_scale
   };
-  for (int k = 0; k < 2; ++k) {
-    projectile& prj = abl.projectiles.emplace_back(projectile());
-    prj.damage = abl.base_damage;
-    prj.is_active = true;
-    prj.active_sprite = 0;
+  for (size_t slot = abl.proj_slot_begin(); slot < abl.proj_slot_end(); ++slot) {
+    prjs.damage[slot] = abl.base_damage;
+    prjs.flags[slot] = PROJECTILE_FLAG_ACTIVE;
+    prjs.active_sprite[slot] = 0;
 
-    spritesheet& draw_ctx = prj.animations.emplace_back(spritesheet());
+    projectile_draw_state& draw_ctx = prjs.draw_state[slot];
     draw_ctx.coord = blade_size;
     draw_ctx.origin = Vector2 { draw_ctx.coord.width * 0.5f, draw_ctx.coord.height * 0.635f };
     draw_ctx.tint = WHITE;
 
-    prj.collision.width  = blade_size.width  * abl.proj_collision_scale.x;
-    prj.collision.height = blade_size.height * abl.proj_collision_scale.y;
+    prjs.collision[slot].width  = blade_size.width  * abl.proj_collision_scale.x;
+    prjs.collision[slot].height = blade_size.height * abl.proj_collision_scale.y;
   }
 }
 
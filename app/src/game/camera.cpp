@@ -103,7 +103,7 @@ bool create_camera(i32 target_x, i32 target_y, i32 render_width, i32 render_heig
   if (state and state != nullptr) {
     return recreate_camera(target_x, target_y, render_width, render_height);
   }
-  state = (camera_system_state *)allocate_memory_linear(sizeof(camera_system_state), true);
+  state = (camera_system_state *)allocate_memory_linear(sizeof(camera_system_state), true, MEMORY_TAG_GAME);
   if (not state or state == nullptr) {
     IERROR("camera::create_camera()::State allocation failed");
     return false;
@@ -7,6 +7,8 @@
 #include "core/logger.h"
 #include "core/event.h"
 #include "core/ftime.h"
+#include "core/frandom.h"
+#include "core/fprofiler.h"
 
 #include "game/spritesheet.h"
 
@@ -16,7 +18,8 @@ typedef struct collectible_manager_system_state {
   const tilemap ** in_active_map;
   const ingame_info * in_ingame_info;
 
-  std::vector<loot_item> loots_on_the_map;
+  memory_arena loot_arena;
+  arena_vector<loot_item> loots_on_the_map; // NOTE: Lives in loot_arena, see collectible_manager_release_loots()
   i32 next_item_id {};
 
   collectible_manager_system_state(void) {
@@ -32,11 +35,13 @@ static collectible_manager_system_state * state = nullptr;
 #define LOOT_ITEM_SCALE 2.f
 #define LOOT_DROP_ANIMATION_DURATION .65f
 #define LOOT_GRAB_ANIMATION_CURVE_CONTROL_OFFSET 50.f
+#define LOOT_ARENA_ITEM_CAPACITY 4096
 
 bool collectible_manager_reinit(const camera_metrics * in_camera_metrics, const app_settings * in_app_settings, const tilemap ** const in_active_map_ptr, const ingame_info * in_ingame_info);
 bool collectible_manager_on_event(i32 code, [[__maybe_unused__]] event_context context);
 
 bool loot_item_on_loot(item_type type, i32 id, data128 context);
+void collectible_manager_release_loots(void);
 
 [[__nodiscard__]] bool collectible_manager_initialize(
 	const camera_metrics* _camera_metrics, 
@@ -47,13 +52,20 @@ bool loot_item_on_loot(item_type type, i32 id, data128 context);
 	if (state and state != nullptr) {
     return collectible_manager_reinit(_camera_metrics, in_app_settings, in_active_map_ptr, in_ingame_info);
   }
-  state = (collectible_manager_system_state *)allocate_memory_linear(sizeof(collectible_manager_system_state), true);
+  state = (collectible_manager_system_state *)allocate_memory_linear(sizeof(collectible_manager_system_state), true, MEMORY_TAG_GAME);
   if (not state or state == nullptr) {
     IERROR("collectible_manager::collectible_manager_initialize()::State allocation failed");
     return false;
   }
   *state = collectible_manager_system_state();
 
+  // INFO: Reserve plus its first doubling, which is allocated while the reserve is still held. Growths past that go to the heap
+  if (not memory_arena_create(__builtin_addressof(state->loot_arena), sizeof(loot_item) * LOOT_ARENA_ITEM_CAPACITY * 3u, MEMORY_TAG_GAME)) {
+    IERROR("collectible_manager::collectible_manager_initialize()::Loot arena creation failed");
+    return false;
+  }
+  collectible_manager_release_loots();
+
   event_register(EVENT_CODE_SPAWN_ITEM, collectible_manager_on_event);
 
   return collectible_manager_reinit(_camera_metrics, in_app_settings, in_active_map_ptr, in_ingame_info);
@@ -85,6 +97,7 @@ bool collectible_manager_reinit(const camera_metrics * in_camera_metrics, const
 }
 
 bool update_collectible_manager(void) {
+  PROFILE_FUNCTION();
   const player_state * _player = state->in_ingame_info->player_state_dynamic;
 
 	for (loot_item& item : state->loots_on_the_map) {
@@ -253,7 +266,7 @@ const loot_item * get_loot_by_id(i32 id) {
   IWARN("collectible_manager::get_loot_by_id()::Item cannot found");
 	return nullptr;
 }
-const std::vector<loot_item> * get_loots_pointer(void) {
+const arena_vector<loot_item> * get_loots_pointer(void) {
 	if (not state or state == nullptr) {
     IERROR("collectible_manager::get_loots_pointer()::State is not valid");
 		return nullptr;
@@ -286,9 +299,17 @@ void collectible_manager_state_clear(void) {
     IERROR("collectible_manager::collectible_manager_state_clear()::State is not valid");
 		return;
 	}
-  state->loots_on_the_map.clear();
+  collectible_manager_release_loots();
   state->next_item_id = 0;
 }
+/**
+ * @brief Drops every loot in one shot by resetting the arena. The vector gives up its storage first.
+ */
+void collectible_manager_release_loots(void) {
+  state->loots_on_the_map = arena_vector<loot_item>(arena_allocator<loot_item>(__builtin_addressof(state->loot_arena)));
+  memory_arena_reset(__builtin_addressof(state->loot_arena));
+  state->loots_on_the_map.reserve(LOOT_ARENA_ITEM_CAPACITY);
+}
 loot_item * create_loot_item(item_type type, Vector2 position, data128 context) {
   if (not state or state == nullptr) {
     IERROR("collectible_manager::create_loot_item()::State is invalid");
@@ -320,14 +341,14 @@ loot_item * create_loot_item(item_type type, Vector2 position, data128 context)
 
       {
         const i32 spread_x = static_cast<i32>(item.world_collision.width * 2.f);
-        const i32 offset_x = get_random(-spread_x, spread_x);
+        const i32 offset_x = random_range(RANDOM_STREAM_LOOT, -spread_x, spread_x);
         item.world_collision.x += static_cast<f32>(offset_x);
         item.sheet.coord.x = item.world_collision.x;
       }
 
       item.drop_control.buffer.f32[2] = position.x;
       item.drop_control.buffer.f32[3] = position.y;
-      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(get_random(2, 4));
+      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(random_range(RANDOM_STREAM_LOOT, 2, 4));
       item.mm_ex.f32[2] = item.world_collision.x + item.world_collision.width * .5f;
       item.mm_ex.f32[3] = static_cast<f32>(context.i16[0]) + static_cast<f32>(context.i16[1]) + item.world_collision.height * .5f;
 
@@ -356,14 +377,14 @@ loot_item * create_loot_item(item_type type, Vector2 position, data128 context)
 
       {
         const i32 spread_x = static_cast<i32>(item.world_collision.width * 2.f);
-        const i32 offset_x = get_random(-spread_x, spread_x);
+        const i32 offset_x = random_range(RANDOM_STREAM_LOOT, -spread_x, spread_x);
         item.world_collision.x += static_cast<f32>(offset_x);
         item.sheet.coord.x = item.world_collision.x;
       }
 
       item.drop_control.buffer.f32[2] = position.x;
       item.drop_control.buffer.f32[3] = position.y;
-      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(get_random(2, 4));
+      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(random_range(RANDOM_STREAM_LOOT, 2, 4));
       item.mm_ex.f32[2] = item.world_collision.x + item.world_collision.width * .5f;
       item.mm_ex.f32[3] = static_cast<f32>(context.i16[0]) + static_cast<f32>(context.i16[1]) + item.world_collision.height * .5f;
 
@@ -392,14 +413,14 @@ loot_item * create_loot_item(item_type type, Vector2 position, data128 context)
 
       {
         const i32 spread_x = static_cast<i32>(item.world_collision.width * 2.f);
-        const i32 offset_x = get_random(-spread_x, spread_x);
+        const i32 offset_x = random_range(RANDOM_STREAM_LOOT, -spread_x, spread_x);
         item.world_collision.x += static_cast<f32>(offset_x);
         item.sheet.coord.x = item.world_collision.x;
       }
 
       item.drop_control.buffer.f32[2] = position.x;
       item.drop_control.buffer.f32[3] = position.y;
-      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(get_random(2, 4));
+      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(random_range(RANDOM_STREAM_LOOT, 2, 4));
       item.mm_ex.f32[2] = item.world_collision.x + item.world_collision.width * .5f;
       item.mm_ex.f32[3] = static_cast<f32>(context.i16[0]) + static_cast<f32>(context.i16[1]) + item.world_collision.height * .5f;
 
@@ -428,14 +449,14 @@ loot_item * create_loot_item(item_type type, Vector2 position, data128 context)
 
       {
         const i32 spread_x = static_cast<i32>(item.world_collision.width * 2.f);
-        const i32 offset_x = get_random(-spread_x, spread_x);
+        const i32 offset_x = random_range(RANDOM_STREAM_LOOT, -spread_x, spread_x);
         item.world_collision.x += static_cast<f32>(offset_x);
         item.sheet.coord.x = item.world_collision.x;
       }
 
       item.drop_control.buffer.f32[2] = position.x;
       item.drop_control.buffer.f32[3] = position.y;
-      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(get_random(2, 4));
+      item.mm_ex.f32[1] = item.world_collision.height * static_cast<f32>(random_range(RANDOM_STREAM_LOOT, 2, 4));
       item.mm_ex.f32[2] = item.world_collision.x + item.world_collision.width * .5f;
       item.mm_ex.f32[3] = static_cast<f32>(context.i16[0]) + static_cast<f32>(context.i16[1]) + item.world_collision.height * .5f;
 
@@ -15,7 +15,7 @@ bool update_collectible_manager(void);
 bool render_collectible_manager(void);
 
 const loot_item * get_loot_by_id(i32 id);
-const std::vector<loot_item> * get_loots_pointer(void);
+const arena_vector<loot_item> * get_loots_pointer(void);
 
 loot_item * create_loot_item(item_type type, Vector2 position);
 
@@ -2,7 +2,11 @@
 #include <raylib.h>
 #include <defines.h>
 
+#include <cstring>
+#include <string>
+
 #include "core/fmemory.h"
+#include "core/fprofiler.h"
 #include "core/logger.h"
 
 #if USE_PAK_FORMAT
@@ -11,6 +15,7 @@
 
 typedef struct shader_system_state {
   std::array<fshader, SHADER_ID_MAX> shaders;
+  std::array<fshader_uniform, SHADER_UNIFORM_ID_MAX> uniforms;
   file_buffer null_file;
 
   shader_system_state(void) {}
@@ -18,16 +23,30 @@ typedef struct shader_system_state {
 
 static shader_system_state *state = nullptr;
 
+#if PROFILER_ENABLED
+  static const char * const shader_upload_counter_names[SHADER_ID_MAX] = {
+    "", "uploads progress_bar_mask", "uploads fade_transition", "uploads font_outline", "uploads post_process",
+    "uploads map_choice_image", "uploads spawn", "uploads sdf_text", "uploads chest_opening_spin_text"
+  };
+  static const char * const shader_skip_counter_names[SHADER_ID_MAX] = {
+    "", "skipped progress_bar_mask", "skipped fade_transition", "skipped font_outline", "skipped post_process",
+    "skipped map_choice_image", "skipped spawn", "skipped sdf_text", "skipped chest_opening_spin_text"
+  };
+#endif
+
 bool load_shader_pak(pak_file_id pak_id, i32 _vs_id, i32 _fs_id, shader_id _id);
 bool load_shader_disk(const char * _vs_path, const char * _fs_path, shader_id id);
+bool load_shader_pak_instanced(pak_file_id pak_id, i32 _fs_id, const char * value_name, shader_id _id);
+bool load_shader_disk_instanced(const char * _fs_path, const char * value_name, shader_id _id);
+bool load_shader_instanced_from_code(std::string fs_code, const char * value_name, shader_id _id);
 
-void shader_add_uniform(shader_id _id, const char *_name, ShaderUniformDataType _data_id);
+void shader_add_uniform(shader_uniform_id uniform_id, shader_id _id, const char *_name, ShaderUniformDataType _data_id);
 
 bool initialize_shader_system(void) {
   if (state and state != nullptr) {
     return true;
   }
-  state = (shader_system_state *)allocate_memory_linear(sizeof(shader_system_state), true);
+  state = (shader_system_state *)allocate_memory_linear(sizeof(shader_system_state), true, MEMORY_TAG_RESOURCE);
   if (not state or state == nullptr) {
     IERROR("fshader::initialize_shader_system()::State allocation failed");
     return false;
@@ -56,7 +75,7 @@ bool initialize_shader_system(void) {
       IWARN("fshader::initialize_shader_system()::map choice image shader cannot loaded");
       return false;
     }
-    if(not load_shader_pak(PAK_FILE_ASSET2, PAK_FILE_ASSET2_UNDEFINED, PAK_FILE_ASSET2_SDR_SPAWN, SHADER_ID_SPAWN)) {
+    if(not load_shader_pak_instanced(PAK_FILE_ASSET2, PAK_FILE_ASSET2_SDR_SPAWN, "spawn_id", SHADER_ID_SPAWN)) {
       IWARN("fshader::initialize_shader_system()::spawn shader cannot loaded");
       return false;
     }
@@ -89,7 +108,7 @@ bool initialize_shader_system(void) {
       IWARN("fshader::initialize_shader_system()::map choice image shader cannot loaded");
       return false;
     }
-    if(not load_shader_disk(0, "sdr_spawn.fs", SHADER_ID_SPAWN)) {
+    if(not load_shader_disk_instanced("sdr_spawn.fs", "spawn_id", SHADER_ID_SPAWN)) {
       IWARN("fshader::initialize_shader_system()::Spawn shader cannot loaded");
       return false;
     }
@@ -103,12 +122,10 @@ bool initialize_shader_system(void) {
     }
   #endif
 
-  shader_add_uniform(SHADER_ID_PROGRESS_BAR_MASK, "progress", SHADER_UNIFORM_FLOAT);
-  shader_add_uniform(SHADER_ID_PROGRESS_BAR_MASK, "tint", SHADER_UNIFORM_VEC4);
-  shader_add_uniform(SHADER_ID_FADE_TRANSITION, "process", SHADER_UNIFORM_FLOAT);
-  //shader_add_uniform(SHADER_ID_FONT_OUTLINE, "texture_size", SHADER_UNIFORM_VEC2);
-  shader_add_uniform(SHADER_ID_POST_PROCESS, "fade", SHADER_UNIFORM_FLOAT);
-  shader_add_uniform(SHADER_ID_SPAWN, "spawn_id", SHADER_UNIFORM_FLOAT);
+  shader_add_uniform(SHADER_UNIFORM_ID_PROGRESS_BAR_MASK_PROGRESS, SHADER_ID_PROGRESS_BAR_MASK, "progress", SHADER_UNIFORM_FLOAT);
+  shader_add_uniform(SHADER_UNIFORM_ID_PROGRESS_BAR_MASK_TINT, SHADER_ID_PROGRESS_BAR_MASK, "tint", SHADER_UNIFORM_VEC4);
+  shader_add_uniform(SHADER_UNIFORM_ID_FADE_TRANSITION_PROCESS, SHADER_ID_FADE_TRANSITION, "process", SHADER_UNIFORM_FLOAT);
+  shader_add_uniform(SHADER_UNIFORM_ID_POST_PROCESS_FADE, SHADER_ID_POST_PROCESS, "fade", SHADER_UNIFORM_FLOAT);
 
   return true;
 }
@@ -125,86 +142,79 @@ const fshader *get_shader_by_enum(shader_id _id) {
 
   return __builtin_addressof(state->shaders.at(_id));
 }
-i32 get_uniform_location(shader_id _id, const char * uni_name) {
-  if (_id >= SHADER_ID_MAX || _id <= SHADER_ID_UNSPECIFIED) {
-    IWARN("fshader::get_uniform_location()::Shader type out of bound");
-    return -1;
-  }
-  if (not uni_name or uni_name == nullptr) {
-    IWARN("fshader::get_uniform_location()::Uniform name is invalid");
-    return -1;
-  }
-  return GetShaderLocation(state->shaders.at(_id).handle, uni_name);
-}
-
-void set_shader_uniform(shader_id _id, const char* uni_name, data128 _data_pack) {
-  if (_id >= SHADER_ID_MAX || _id <= SHADER_ID_UNSPECIFIED) {
-    IWARN("fshader::set_shader_uniform()::Shader type out of bound");
+/**
+ * @brief Skips the upload when the shader already holds the value. Only the components of the uniform type are compared
+ */
+void set_shader_uniform(shader_uniform_id _id, data128 _data_pack) {
+  if (_id >= SHADER_UNIFORM_ID_MAX or _id <= SHADER_UNIFORM_ID_UNSPECIFIED) {
+    IWARN("fshader::set_shader_uniform()::Uniform id out of bound");
     return;
   }
-  if (not uni_name or uni_name == nullptr) {
-    IWARN("fshader::set_shader_uniform()::Uniform name is invalid");
-    return;
+  fshader_uniform& uniform = state->uniforms.at(_id);
+  if (uniform.location < 0) {
+    return; // INFO: Already warned while registering
   }
-  fshader& _shader = state->shaders.at(_id);
-  i32 uni_loc = GetShaderLocation(state->shaders.at(_id).handle, uni_name);
+  fshader& _shader = state->shaders.at(uniform.shader);
+  size_t compare_size = 0u;
 
-  if (uni_loc < 0) {
-    IWARN("fshader::set_shader_uniform()::Shader index out of bound");
+  switch (uniform.uni_data_type) {
+    case SHADER_UNIFORM_FLOAT:     compare_size = sizeof(f32) * 1u; break;
+    case SHADER_UNIFORM_VEC2:      compare_size = sizeof(f32) * 2u; break;
+    case SHADER_UNIFORM_VEC3:      compare_size = sizeof(f32) * 3u; break;
+    case SHADER_UNIFORM_VEC4:      compare_size = sizeof(f32) * 4u; break;
+    case SHADER_UNIFORM_INT:       compare_size = sizeof(i32) * 1u; break;
+    case SHADER_UNIFORM_IVEC2:     compare_size = sizeof(i32) * 2u; break;
+    case SHADER_UNIFORM_IVEC3:     compare_size = sizeof(i32) * 3u; break;
+    case SHADER_UNIFORM_IVEC4:     compare_size = sizeof(i32) * 4u; break;
+    case SHADER_UNIFORM_SAMPLER2D: compare_size = sizeof(void*);    break;
+    default: {
+      IWARN("fshader::set_shader_uniform()::Error while setting shader value");
+      return;
+    }
+  }
+  if (uniform.has_value and std::memcmp(__builtin_addressof(uniform.last_value), __builtin_addressof(_data_pack), compare_size) == 0) {
+    _shader.frame_stats.skip_count++;
     return;
   }
+  uniform.last_value = _data_pack;
+  uniform.has_value = true;
+  _shader.frame_stats.upload_count++;
 
-  ShaderUniformDataType data_id = _shader.locations.at(uni_loc).uni_data_type;
-  switch (data_id) {
-  case SHADER_UNIFORM_FLOAT: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.f32, data_id);
-    break;
-  }
-  case SHADER_UNIFORM_VEC2: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.f32, data_id);
-    break;
-  }
-  case SHADER_UNIFORM_VEC3: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.f32, data_id);
-    break;
-  }
-  case SHADER_UNIFORM_VEC4: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.f32, data_id);
-    break;
+  if (uniform.uni_data_type == SHADER_UNIFORM_SAMPLER2D) {
+    SetShaderValue(_shader.handle, uniform.location, uniform.last_value.address, uniform.uni_data_type);
   }
-  case SHADER_UNIFORM_INT: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.i32[0], data_id);
-    break;
+  else {
+    SetShaderValue(_shader.handle, uniform.location, __builtin_addressof(uniform.last_value), uniform.uni_data_type);
   }
-  case SHADER_UNIFORM_IVEC2: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.i32, data_id);
-    break;
-  }
-  case SHADER_UNIFORM_IVEC3: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.i32, data_id);
-    break;
-  }
-  case SHADER_UNIFORM_IVEC4: {
-    _shader.locations.at(uni_loc).data = _data_pack;
-    SetShaderValue(state->shaders.at(_id).handle, uni_loc, &state->shaders.at(_id).locations.at(uni_loc).data.i32, data_id);
-    break;
+}
+void set_shader_uniform_float(shader_uniform_id _id, f32 value) {
+  if (_id < SHADER_UNIFORM_ID_MAX and _id > SHADER_UNIFORM_ID_UNSPECIFIED and state->uniforms.at(_id).uni_data_type != SHADER_UNIFORM_FLOAT) {
+    IWARN("fshader::set_shader_uniform_float()::Uniform is not a float");
+    return;
   }
-  case SHADER_UNIFORM_SAMPLER2D: {
-    _shader.locations.at(uni_loc).data.address[0] = _data_pack.address;
-    SetShaderValue(state->shaders.at(_id).handle,  uni_loc, state->shaders.at(_id).locations.at(uni_loc).data.address, data_id);
-    break;
+  set_shader_uniform(_id, data128(value));
+}
+void set_shader_uniform_vec4(shader_uniform_id _id, Vector4 value) {
+  if (_id < SHADER_UNIFORM_ID_MAX and _id > SHADER_UNIFORM_ID_UNSPECIFIED and state->uniforms.at(_id).uni_data_type != SHADER_UNIFORM_VEC4) {
+    IWARN("fshader::set_shader_uniform_vec4()::Uniform is not a vec4");
+    return;
   }
-  default: {
-    IWARN("fshader::set_shader_uniform()::Error while setting shader value");
+  set_shader_uniform(_id, data128(value.x, value.y, value.z, value.w));
+}
+
+void shader_system_report_frame_stats(void) {
+  if (not state or state == nullptr) {
     return;
   }
+  for (size_t itr_000 = SHADER_ID_UNSPECIFIED + 1; itr_000 < SHADER_ID_MAX; ++itr_000) {
+    fshader& _shader = state->shaders.at(itr_000);
+    #if PROFILER_ENABLED
+      if (_shader.frame_stats.upload_count > 0u or _shader.frame_stats.skip_count > 0u) {
+        profiler_set_counter(shader_upload_counter_names[itr_000], static_cast<f64>(_shader.frame_stats.upload_count));
+        profiler_set_counter(shader_skip_counter_names[itr_000], static_cast<f64>(_shader.frame_stats.skip_count));
+      }
+    #endif
+    _shader.frame_stats = fshader_upload_stats();
   }
 }
 
@@ -221,16 +231,17 @@ bool load_shader_pak([[__maybe_unused__]] pak_file_id pak_id, [[__maybe_unused__
       return false;
     }
     else if (not vs_file or vs_file == nullptr) {
-      state->shaders.at(_id).handle = LoadShaderFromMemory(0, fs_file->content.c_str());
-      state->shaders.at(_id).total_locations = 0;
+      const std::string fs_code = std::string(fs_file->content); // INFO: Pak views are not null terminated
+      state->shaders.at(_id).handle = LoadShaderFromMemory(0, fs_code.c_str());
     }
     else if (not fs_file or fs_file == nullptr) {
-      state->shaders.at(_id).handle = LoadShaderFromMemory(vs_file->content.c_str(), 0);
-      state->shaders.at(_id).total_locations = 0;
+      const std::string vs_code = std::string(vs_file->content);
+      state->shaders.at(_id).handle = LoadShaderFromMemory(vs_code.c_str(), 0);
     }
     else if (vs_file && vs_file != nullptr && fs_file && fs_file != nullptr) {
-      state->shaders.at(_id).handle = LoadShaderFromMemory(vs_file->content.c_str(), fs_file->content.c_str());
-      state->shaders.at(_id).total_locations = 0;
+      const std::string vs_code = std::string(vs_file->content);
+      const std::string fs_code = std::string(fs_file->content);
+      state->shaders.at(_id).handle = LoadShaderFromMemory(vs_code.c_str(), fs_code.c_str());
     }
 
     if (IsShaderValid(state->shaders.at(_id).handle)) {
@@ -259,7 +270,6 @@ bool load_shader_disk([[__maybe_unused__]] const char * _vs_path, [[__maybe_unus
       return false;
     }
     state->shaders.at(id).handle = LoadShader(vs_path, fs_path);
-    state->shaders.at(id).total_locations = 0;
 
     if (IsShaderValid(state->shaders.at(id).handle)) {
       return true;
@@ -270,18 +280,113 @@ bool load_shader_disk([[__maybe_unused__]] const char * _vs_path, [[__maybe_unus
   #endif
 }
 
-void shader_add_uniform(shader_id _id, const char *_name, ShaderUniformDataType _data_id) {
+bool load_shader_pak_instanced([[__maybe_unused__]] pak_file_id pak_id, [[__maybe_unused__]] i32 _fs_id, [[__maybe_unused__]] const char * value_name, [[__maybe_unused__]] shader_id _id) {
+  #if USE_PAK_FORMAT
+    if (_id >= SHADER_ID_MAX or _id <= SHADER_ID_UNSPECIFIED) {
+      IWARN("fshader::load_shader_pak_instanced()::Shader type out of bound");
+      return false;
+    }
+    const file_buffer * fs_file = get_asset_file_buffer(pak_id, _fs_id);
+    if (not fs_file or fs_file == nullptr) {
+      return false;
+    }
+    return load_shader_instanced_from_code(std::string(fs_file->content), value_name, _id);
+  #else
+    return false;
+  #endif
+}
+bool load_shader_disk_instanced([[__maybe_unused__]] const char * _fs_path, [[__maybe_unused__]] const char * value_name, [[__maybe_unused__]] shader_id _id) {
+  #if not USE_PAK_FORMAT
+    if (_id >= SHADER_ID_MAX or _id <= SHADER_ID_UNSPECIFIED) {
+      IWARN("fshader::load_shader_disk_instanced()::Shader type out of bound");
+      return false;
+    }
+    const char *fs_path = shader_path(_fs_path);
+    if (not fs_path or not FileExists(fs_path)) {
+      IWARN("fshader::load_shader_disk_instanced()::Fragment path does not exist");
+      return false;
+    }
+    char * fs_text = LoadFileText(fs_path);
+    if (not fs_text or fs_text == nullptr) {
+      return false;
+    }
+    const std::string fs_code = std::string(fs_text);
+    UnloadFileText(fs_text);
+    return load_shader_instanced_from_code(fs_code, value_name, _id);
+  #else
+    return false;
+  #endif
+}
+/**
+ * @brief Pairs the fragment stage with an engine side vertex stage that hands it a per-sprite value from the z of each vertex.
+ * @brief The fragment stage's "uniform float <value_name>;" becomes the varying, so sprites with different values still share a draw call.
+ * @brief The sprite batch writes the value, see draw_texture_quad_instanced()
+ */
+bool load_shader_instanced_from_code(std::string fs_code, const char * value_name, shader_id _id) {
+  static const char * const instance_vs_body_330 =
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec4 vertexColor;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "out float INSTANCE_VALUE;\n"
+    "uniform mat4 mvp;\n"
+    "void main() {\n"
+    "  fragTexCoord = vertexTexCoord;\n"
+    "  fragColor = vertexColor;\n"
+    "  INSTANCE_VALUE = vertexPosition.z;\n"
+    "  gl_Position = mvp * vec4(vertexPosition.xy, 0.0, 1.0);\n"
+    "}\n";
+  static const char * const instance_vs_body_100 =
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec2 vertexTexCoord;\n"
+    "attribute vec4 vertexColor;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "varying highp float INSTANCE_VALUE;\n"
+    "uniform mat4 mvp;\n"
+    "void main() {\n"
+    "  fragTexCoord = vertexTexCoord;\n"
+    "  fragColor = vertexColor;\n"
+    "  INSTANCE_VALUE = vertexPosition.z;\n"
+    "  gl_Position = mvp * vec4(vertexPosition.xy, 0.0, 1.0);\n"
+    "}\n";
+
+  const bool is_glsl_330 = fs_code.find("#version 330") != std::string::npos;
+  const std::string uniform_declaration = std::string("uniform float ") + value_name + ";";
+  const size_t declaration_pos = fs_code.find(uniform_declaration);
+  if (declaration_pos == std::string::npos) {
+    IWARN("fshader::load_shader_instanced_from_code()::Fragment stage does not declare '%s', loading it without the instance value", uniform_declaration.c_str());
+    state->shaders.at(_id).handle = LoadShaderFromMemory(0, fs_code.c_str());
+    return IsShaderValid(state->shaders.at(_id).handle);
+  }
+  fs_code.replace(declaration_pos, uniform_declaration.size(), std::string(is_glsl_330 ? "in float " : "varying highp float ") + value_name + ";");
+
+  const std::string vs_code = std::string(is_glsl_330 ? "#version 330\n" : "#version 100\n") + 
+    "#define INSTANCE_VALUE " + value_name + "\n" + (is_glsl_330 ? instance_vs_body_330 : instance_vs_body_100);
+
+  state->shaders.at(_id).handle = LoadShaderFromMemory(vs_code.c_str(), fs_code.c_str());
+  state->shaders.at(_id).has_instance_value = true;
+  return IsShaderValid(state->shaders.at(_id).handle);
+}
+
+void shader_add_uniform(shader_uniform_id uniform_id, shader_id _id, const char *_name, ShaderUniformDataType _data_id) {
   if (_id >= SHADER_ID_MAX || _id <= SHADER_ID_UNSPECIFIED) {
     IWARN("fshader::shader_add_uniform()::Shader type out of bound");
     return;
   }
+  if (uniform_id >= SHADER_UNIFORM_ID_MAX || uniform_id <= SHADER_UNIFORM_ID_UNSPECIFIED) {
+    IWARN("fshader::shader_add_uniform()::Uniform id out of bound");
+    return;
+  }
   const i32 uniform_loc = GetShaderLocation(state->shaders.at(_id).handle, _name);
   if (uniform_loc < 0) {
-    IWARN("fshader::shader_add_uniform()::Shader uniform cannot found");
+    IWARN("fshader::shader_add_uniform()::Shader uniform %s cannot found", _name);
     return;
   }
-  state->shaders.at(_id).locations.at(uniform_loc).name = _name;
-  state->shaders.at(_id).locations.at(uniform_loc).uni_data_type = _data_id;
-
-  state->shaders.at(_id).total_locations++;
+  fshader_uniform& uniform = state->uniforms.at(uniform_id);
+  uniform.shader = _id;
+  uniform.location = uniform_loc;
+  uniform.uni_data_type = _data_id;
+  uniform.has_value = false;
 }
@@ -4,25 +4,44 @@
 
 #include <game/game_types.h>
 
-typedef struct fshader_location {
-  std::string name;
-  data128 data;
+/**
+ * @brief Location is resolved once at load, last_value mirrors what the GPU holds so repeated values are not uploaded again
+ */
+typedef struct fshader_uniform {
+  shader_id shader;
+  i32 location;
   ShaderUniformDataType uni_data_type;
-  fshader_location(void) {
-    this->name.clear();
-    this->data = data128();
+  data128 last_value;
+  bool has_value;
+  fshader_uniform(void) {
+    this->shader = SHADER_ID_UNSPECIFIED;
+    this->location = -1;
     this->uni_data_type = SHADER_UNIFORM_FLOAT;
+    this->last_value = data128();
+    this->has_value = false;
   }
-} fshader_location;
+} fshader_uniform;
+
+typedef struct fshader_upload_stats {
+  u32 upload_count;
+  u32 skip_count;
+  fshader_upload_stats(void) {
+    this->upload_count = 0u;
+    this->skip_count = 0u;
+  }
+} fshader_upload_stats;
 
+/**
+ * @brief has_instance_value: the vertex stage passes the z of each vertex to the fragment stage, see load_shader_instanced_from_code()
+ */
 typedef struct fshader {
-  i32 total_locations;
   Shader handle;
-  std::array<fshader_location, MAX_SHADER_LOCATION_SLOT> locations;
+  fshader_upload_stats frame_stats;
+  bool has_instance_value;
   fshader(void) {
-    this->total_locations = 0;
     this->handle = Shader { 0u, nullptr};
-    this->locations.fill(fshader_location());
+    this->frame_stats = fshader_upload_stats();
+    this->has_instance_value = false;
   }
 } fshader;
 
@@ -30,8 +49,14 @@ typedef struct fshader {
 
 const char* shader_path(const char* _path);
 const fshader* get_shader_by_enum(shader_id _id);
-i32 get_uniform_location(shader_id _id, const char * uni_name);
-void set_shader_uniform(shader_id _id, const char* uni_name, data128 _data_pack);
 
+void set_shader_uniform(shader_uniform_id _id, data128 _data_pack);
+void set_shader_uniform_float(shader_uniform_id _id, f32 value);
+void set_shader_uniform_vec4(shader_uniform_id _id, Vector4 value);
+
+/**
+ * @brief Uploads and skipped uploads of each shader since the last call, reported as profiler counters, then reset
+ */
+void shader_system_report_frame_stats(void);
 
 #endif
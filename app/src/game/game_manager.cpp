@@ -1,5 +1,6 @@
 #include "game_manager.h"
 #include <cmath>
+#include <chrono>
 #include <reasings.h>
 #include <settings.h>
 #include <save_game.h>
@@ -7,6 +8,9 @@
 #include <loc_types.h>
 
 #include "core/ftime.h"
+#include "core/frandom.h"
+#include "core/finput.h"
+#include "core/fprofiler.h"
 #include "core/event.h"
 #include "core/fmemory.h"
 #include "core/logger.h"
@@ -15,8 +19,10 @@
 #include "game/collectible_manager.h"
 #include "game/player.h"
 #include "game/spawn.h"
+#include "game/tilemap.h"
 #include "game/user_interface.h"
 #include "game/resource.h"
+#include "game/replay.h"
 
 struct game_manager_system_state {
   tilemap ** in_active_map;
@@ -61,6 +67,7 @@ struct game_manager_system_state {
   i32 next_item_id {};
 
   bool game_manager_initialized {};
+  std::array<f64, GM_UPDATE_STAGE_MAX> update_stage_times {};
 
   game_manager_system_state(void) {
     this->in_active_map = nullptr;
@@ -83,6 +90,12 @@ static game_manager_system_state * state = nullptr;
 #define MAX_GAME_RULE_LEVEL 5
 #define PLAYER_BASE_ATTACK_DURATION 0.8f
 
+#define GM_TIMED_UPDATE_STAGE(STAGE, CALL) { \
+  const auto stage_begin = std::chrono::steady_clock::now(); \
+  CALL; \
+  state->update_stage_times.at(STAGE) += std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - stage_begin).count(); \
+}
+
 #define FIRST_UPGRADABLE_GAME_RULE GAME_RULE_SPAWN_MULTIPLIER
 #define LAST_UPGRADABLE_GAME_RULE GAME_RULE_RESERVED_FOR_FUTURE_USE
 
@@ -95,6 +108,9 @@ void gm_set_character_stat_trait_value(character_stat& stat, data128 value);
 void gm_set_game_rule_trait_value(game_rule& stat, data128 value);
 void reset_ingame_info(void);
 void gm_update_player(void);
+void gm_update_simulation(void);
+bool gm_update_tick(void);
+void gm_damage_player_by_spawn_contact(void);
 void set_static_player_state_stat(character_stat_id stat_id, i32 level);
 void gm_refresh_stat_by_level(character_stat* stat, i32 level);
 [[__nodiscard__]] bool player_state_rebuild(void);
@@ -149,7 +165,7 @@ bool game_manager_initialize(const camera_metrics * in_camera_metrics, const app
     IERROR("game_manager::game_manager_initialize()::Map pointer is invalid");
     return false;
   }
-  state = (game_manager_system_state *)allocate_memory_linear(sizeof(game_manager_system_state), true);
+  state = (game_manager_system_state *)allocate_memory_linear(sizeof(game_manager_system_state), true, MEMORY_TAG_GAME);
   if (not state or state == nullptr) {
     IERROR("game_manager::game_manager_initialize()::State allocation failed");
     return false;
@@ -164,7 +180,7 @@ bool game_manager_initialize(const camera_metrics * in_camera_metrics, const app
     IERROR("game_manager::game_manager_initialize()::Ability system init returned false");
     return false;
   }
-  if (not spawn_system_initialize(in_camera_metrics, __builtin_addressof(state->game_info))) {
+  if (not spawn_system_initialize(in_camera_metrics, const_cast<const tilemap **>(in_active_map_ptr), __builtin_addressof(state->game_info))) {
     IERROR("game_manager::game_manager_initialize()::Spawn system init returned false");
     return false;
   }
@@ -499,11 +515,30 @@ void game_manager_cleanup_state(void) {
 }
 
 void update_game_manager(void) {
-  state->mouse_pos_screen = Vector2 { GetMousePosition().x * get_app_settings()->scale_ratio.at(0), GetMousePosition().y * get_app_settings()->scale_ratio.at(1)};
+  PROFILE_FUNCTION();
+  state->mouse_pos_screen = Vector2 { input_get_mouse_position().x * get_app_settings()->scale_ratio.at(0), input_get_mouse_position().y * get_app_settings()->scale_ratio.at(1)};
   state->mouse_pos_world = GetScreenToWorld2D(Vector2 {state->mouse_pos_screen.x,state->mouse_pos_screen.y}, state->in_camera_metrics->handle);
-  state->delta_time = delta_time_ingame();
   update_sound_system();
 
+  state->update_stage_times.fill(0.0);
+  state->delta_time = get_simulation_step();
+
+  replay_begin_update();
+  input_latch_releases();
+  const u32 tick_count = replay_resolve_tick_count(simulation_accumulate());
+  for (u32 itr_000 = 0u; itr_000 < tick_count; ++itr_000) {
+    const bool keep_ticking = gm_update_tick();
+    input_consume_releases();
+    if (not keep_ticking) {
+      break;
+    }
+  }
+  replay_end_update();
+}
+/**
+ * @brief One fixed step of the running stage. Returns false when the stage should not be ticked again this frame
+ */
+bool gm_update_tick(void) {
   switch (state->ingame_phase) {
     case INGAME_PLAY_PHASE_IDLE: {
       update_spawns_animation_only();
@@ -511,30 +546,20 @@ void update_game_manager(void) {
     }
     case INGAME_PLAY_PHASE_CLEAR_ZOMBIES: {
       if (not state->game_info.player_state_dynamic->is_dead) {
-        gm_update_player();
-        update_collectible_manager();
-
-        update_spawns(state->game_info.player_state_dynamic->position);
-        generate_in_game_info();
-        update_abilities(get_player_state()->ability_system);
+        gm_update_simulation();
         if (state->play_time <= 0.f) {
           gm_end_game(true);
         }
       }
       else {
         gm_end_game(false);
-        return;
+        return false;
       }
       break;
     }
     case INGAME_PLAY_PHASE_ESCAPE: {
       if (not state->game_info.player_state_dynamic->is_dead) {
-        gm_update_player();
-        update_collectible_manager();
-
-        update_spawns(state->game_info.player_state_dynamic->position);
-        generate_in_game_info();
-        update_abilities(get_player_state()->ability_system);
+        gm_update_simulation();
 
         const Character2D * const boss = get_spawn_by_id(state->stage_boss_id);
         if (boss) {
@@ -550,31 +575,47 @@ void update_game_manager(void) {
       }
       else {
         gm_end_game(false);
-        return;
+        return false;
       }
       break;
     }
     case INGAME_PLAY_PHASE_RESULTS: { 
-      
-      break;
+      return false;
     }
     default: {
       IWARN("game_manager::update_game_manager()::Unsupported in-game phase");
       gm_end_game(false);
       event_fire(EVENT_CODE_SCENE_MAIN_MENU, event_context());
+      return false;
     }
-    break;
   }
+  return true;
+}
+/**
+ * @brief Gameplay systems of a running stage, each one adds its time to update_stage_times
+ */
+void gm_update_simulation(void) {
+  GM_TIMED_UPDATE_STAGE(GM_UPDATE_STAGE_PLAYER, gm_update_player());
+  GM_TIMED_UPDATE_STAGE(GM_UPDATE_STAGE_COLLECTIBLES, update_collectible_manager());
+
+  GM_TIMED_UPDATE_STAGE(GM_UPDATE_STAGE_SPAWNS, update_spawns(state->game_info.player_state_dynamic->position));
+  GM_TIMED_UPDATE_STAGE(GM_UPDATE_STAGE_SPAWN_CONTACT, gm_damage_player_by_spawn_contact());
+  generate_in_game_info();
+  GM_TIMED_UPDATE_STAGE(GM_UPDATE_STAGE_ABILITIES, update_abilities(get_player_state()->ability_system));
+  GM_TIMED_UPDATE_STAGE(GM_UPDATE_STAGE_SPAWN_DAMAGE, resolve_spawn_damage());
 }
 void update_game_manager_debug(void) {
   state->mouse_pos_world = GetScreenToWorld2D(Vector2{
-    GetMousePosition().x * get_app_settings()->scale_ratio.at(0),
-    GetMousePosition().y * get_app_settings()->scale_ratio.at(1)
+    input_get_mouse_position().x * get_app_settings()->scale_ratio.at(0),
+    input_get_mouse_position().y * get_app_settings()->scale_ratio.at(1)
     }, 
     state->in_camera_metrics->handle
   );
+  state->delta_time = delta_time_ingame();
+  input_latch_releases();
 
   const player_update_results pur = update_player();
+  input_consume_releases();
   if (pur.is_success) { 
     player_move_player(pur.move_request);
   }
@@ -676,11 +717,14 @@ void gm_start_game() {
   state->ingame_phase = INGAME_PLAY_PHASE_CLEAR_ZOMBIES;
 }
 [[nodiscard]] bool gm_init_game(worldmap_stage stage, std::vector<character_trait>& _chosen_traits, ability_id starter_ability) {
+  std::vector<character_trait> traits = _chosen_traits;
+  replay_begin_game(stage, traits, starter_ability); // INFO: Playback replaces the seed, the traits and the starter ability with the recorded ones
+
   if (stage.spawn_on_begin > MAX_SPAWN_COUNT or stage.spawn_on_map_max > MAX_SPAWN_COUNT) {
     return false;
   }
   reset_ingame_info();
-  state->chosen_traits = _chosen_traits;
+  state->chosen_traits = traits;
   state->starter_ability = starter_ability;
 
   if (not player_state_rebuild()) {
@@ -743,6 +787,7 @@ void gm_start_game() {
 }
 
 void gm_end_game(bool is_win) {
+  replay_finish();
 
   state->is_win = is_win;
   state->ingame_phase = INGAME_PLAY_PHASE_RESULTS;
@@ -827,19 +872,19 @@ void gm_refresh_save_slot(void) {
   gm_save_game();
   gm_load_game(state->in_app_settings->active_save_slot);
 }
-void gm_damage_spawn_if_collide(data128 coll_data, i32 damage, collision_type coll_check) {
+void gm_damage_spawn_if_collide(data128 coll_data, i32 damage, collision_type coll_check, i32 source) {
   switch (coll_check) {
     case COLLISION_TYPE_RECTANGLE_RECTANGLE: {
       Rectangle rect = Rectangle { (f32)coll_data.i16[0],  (f32)coll_data.i16[1], (f32)coll_data.i16[2], (f32)coll_data.i16[3] };
 
-      damage_spawn_by_collision(rect, damage, coll_check);
+      queue_spawn_damage_by_collision(rect, damage, coll_check, source);
       return; 
     }
     case COLLISION_TYPE_CIRCLE_RECTANGLE: { 
       Vector2 circle_center = Vector2 { (f32)coll_data.i16[0],  (f32)coll_data.i16[1] };
       f32 circle_radius = (f32) coll_data.i16[2];
 
-      damage_spawn_by_collision(Rectangle {circle_center.x, circle_center.y, circle_radius, 0.f}, damage, coll_check);
+      queue_spawn_damage_by_collision(Rectangle {circle_center.x, circle_center.y, circle_radius, 0.f}, damage, coll_check, source);
       return; 
     }
     default: {
@@ -887,13 +932,13 @@ void populate_map_with_spawns(i32 min_count) {
   for (i32 itr_000 = 0; itr_000 < min_count && (spawn_trying_limit <= SPAWN_TRYING_LIMIT && spawn_trying_limit != 0); ) 
   {
     Vector2 position = Vector2 {
-      static_cast<f32>(get_random_ssl((i32)state->stage.spawning_areas.at(0).x, (i32)state->stage.spawning_areas.at(0).x + state->stage.spawning_areas.at(0).width)),
-      static_cast<f32>(get_random_ssl((i32)state->stage.spawning_areas.at(0).y, (i32)state->stage.spawning_areas.at(0).y + state->stage.spawning_areas.at(0).height))
+      static_cast<f32>(random_range(RANDOM_STREAM_SPAWN, (i32)state->stage.spawning_areas.at(0).x, (i32)state->stage.spawning_areas.at(0).x + state->stage.spawning_areas.at(0).width)),
+      static_cast<f32>(random_range(RANDOM_STREAM_SPAWN, (i32)state->stage.spawning_areas.at(0).y, (i32)state->stage.spawning_areas.at(0).y + state->stage.spawning_areas.at(0).height))
     };
     if (not CheckCollisionPointRec(position, state->in_camera_metrics->frustum) and spawn_character(Character2D(
-        SPAWN_TYPE_BROWN, //static_cast<i32>(get_random(SPAWN_TYPE_UNDEFINED+1, SPAWN_TYPE_MAX-2) >= 0),
+        SPAWN_TYPE_BROWN, //static_cast<i32>(random_range(RANDOM_STREAM_SPAWN, SPAWN_TYPE_UNDEFINED+1, SPAWN_TYPE_MAX-2) >= 0),
         static_cast<i32>(state->game_info.player_state_dynamic->level), 
-        static_cast<i32>(get_random_ssl(0, 100)), 
+        static_cast<i32>(random_range(RANDOM_STREAM_SPAWN, 0, 100)), 
         position
       ))) { 
         ++itr_000; 
@@ -907,8 +952,8 @@ i32 spawn_boss(void) {
   for (i32 boss_spawning_attemts = 0; boss_spawning_attemts < SPAWN_TRYING_LIMIT; ++boss_spawning_attemts) 
   {
     Vector2 position = Vector2 {
-      static_cast<f32>(get_random((i32)state->stage.spawning_areas.at(0).x, (i32)state->stage.spawning_areas.at(0).x + state->stage.spawning_areas.at(0).width)),
-      static_cast<f32>(get_random((i32)state->stage.spawning_areas.at(0).y, (i32)state->stage.spawning_areas.at(0).y + state->stage.spawning_areas.at(0).height))
+      static_cast<f32>(random_range(RANDOM_STREAM_SPAWN, (i32)state->stage.spawning_areas.at(0).x, (i32)state->stage.spawning_areas.at(0).x + state->stage.spawning_areas.at(0).width)),
+      static_cast<f32>(random_range(RANDOM_STREAM_SPAWN, (i32)state->stage.spawning_areas.at(0).y, (i32)state->stage.spawning_areas.at(0).y + state->stage.spawning_areas.at(0).height))
     };
     Character2D _boss = Character2D(SPAWN_TYPE_BOSS, GET_BOSS_LEVEL(state->stage.stage_level, state->stage.boss_scale), GET_BOSS_SCALE(state->stage.boss_scale), position);
 
@@ -957,26 +1002,30 @@ void reset_ingame_info(void) {
 
   state->game_rules = state->default_game_rules;
 }
+/**
+ * @brief Replaces the per spawn EVENT_CODE_DAMAGE_PLAYER_IF_COLLIDE dispatch. Player takes damage once per frame at most.
+ */
+void gm_damage_player_by_spawn_contact(void) {
+  if (not state->game_info.player_state_dynamic or state->game_info.player_state_dynamic == nullptr) {
+    return;
+  }
+  const spawn_contact_result contact = query_spawn_player_contact(state->game_info.player_state_dynamic->collision);
+  if (contact.contact_count <= 0) {
+    return;
+  }
+  player_take_damage(contact.damage);
+  event_fire(EVENT_CODE_BEGIN_CAMERA_SHAKE, event_context());
+}
 void gm_update_player(void) {
   if (state->game_info.player_state_dynamic and state->game_info.player_state_dynamic != nullptr and not state->game_info.player_state_dynamic->is_dead) {
     const player_update_results pur = update_player();
-    if (pur.is_success) { // TODO: Player-Map collision detection system
+    if (pur.is_success) {
       const Rectangle& pl_map_coll = state->game_info.player_state_dynamic->map_level_collision;
       const Rectangle new_x = Rectangle { pl_map_coll.x + pur.move_request.x, pl_map_coll.y,                      pl_map_coll.width, pl_map_coll.height };
       const Rectangle new_y = Rectangle { pl_map_coll.x,                      pl_map_coll.y + pur.move_request.y, pl_map_coll.width, pl_map_coll.height };
 
-      bool is_collided_x = false;
-      bool is_collided_y = false;
-      for (size_t itr_000 = 0; itr_000 < (*state->in_active_map)->collisions.size() ; ++itr_000) {
-        const Rectangle& map_coll = (*state->in_active_map)->collisions.at(itr_000).dest;
-
-        if(CheckCollisionRecs(map_coll, new_x)) {
-          is_collided_x = true;
-        }
-        if(CheckCollisionRecs(map_coll, new_y)) {
-          is_collided_y = true;
-        }
-      }
+      const bool is_collided_x = map_spatial_index_overlaps_collision(*state->in_active_map, new_x);
+      const bool is_collided_y = map_spatial_index_overlaps_collision(*state->in_active_map, new_y);
       if ( !is_collided_x && pur.move_request.x) {
         player_move_player(VECTOR2(pur.move_request.x, 0.f));
       }
@@ -1205,6 +1254,12 @@ void gm_set_game_rule_level_by_id(game_rule_id rule_id, i32 level) {
   }
   gm_refresh_game_rule_by_level(__builtin_addressof(state->game_rules.at(rule_id)), level);
 }
+/**
+ * @brief Milliseconds spent by each gameplay system over the ticks of the last update
+ */
+const std::array<f64, GM_UPDATE_STAGE_MAX>& gm_get_update_stage_times(void) {
+  return state->update_stage_times;
+}
 const ingame_info* gm_get_ingame_info(void){
   if (not state or state == nullptr) {
     IERROR("game_manager::gm_get_ingame_info()::State is not valid");
@@ -1529,6 +1584,9 @@ const ability& _get_ability(ability_id _id) {
 const std::array<ability, ABILITY_ID_MAX>& _get_all_abilities(void) {
   return get_all_abilities();
 }
+const projectile_data_soa& _get_projectile_pool(void) {
+  return get_projectile_pool();
+}
 const Character2D * _get_spawn_by_id(i32 _id) {
   return get_spawn_by_id(_id);
 }
@@ -1583,6 +1641,7 @@ void _get_next_level(ability& abl) {
 }
 void _set_player_position(Vector2 position) {
   get_player_state()->position = position;
+  get_player_state()->previous_position = position;
   get_player_state()->collision.x = position.x - state->game_info.player_state_dynamic->collision.width * .5f;
   get_player_state()->collision.y = position.y - state->game_info.player_state_dynamic->collision.height * .5f;
 }
@@ -1612,13 +1671,13 @@ bool game_manager_on_event(i32 code, event_context context) {
         static_cast<i16>(context.data.i16[2]),
         static_cast<i16>(context.data.i16[3])
       );
-      gm_damage_spawn_if_collide(coll_data, static_cast<i32>(context.data.i16[4]), static_cast<collision_type>(context.data.i16[5]));
+      gm_damage_spawn_if_collide(coll_data, static_cast<i32>(context.data.i16[4]), static_cast<collision_type>(context.data.i16[5]), static_cast<i32>(context.data.i16[6]));
       return true;
     }
     case EVENT_CODE_KILL_ALL_SPAWNS: {
-      std::vector<Character2D>::const_iterator spw_iter = state->game_info.in_spawns->begin();
-      for (; spw_iter != state->game_info.in_spawns->end(); spw_iter++) {
-        damage_spawn(spw_iter->character_id, spw_iter->health_max);
+      const spawn_data_soa * const spawns = state->game_info.in_spawns;
+      for (size_t itr_000 = 0u; itr_000 < spawns->size(); ++itr_000) {
+        damage_spawn(spawns->character_id[itr_000], spawns->stats[itr_000].health_max);
       }
       return true;
     }
@@ -11,6 +11,17 @@
 
 #define GM_ITEM_COUNT_CHESTS_SCROLL 20
 
+typedef enum gm_update_stage {
+  GM_UPDATE_STAGE_UNDEFINED,
+  GM_UPDATE_STAGE_PLAYER,
+  GM_UPDATE_STAGE_COLLECTIBLES,
+  GM_UPDATE_STAGE_SPAWNS,
+  GM_UPDATE_STAGE_SPAWN_CONTACT,
+  GM_UPDATE_STAGE_ABILITIES,
+  GM_UPDATE_STAGE_SPAWN_DAMAGE,
+  GM_UPDATE_STAGE_MAX,
+} gm_update_stage;
+
 struct sigil_upgrade_result {
     enum E_result {
         UNDEFINED,
@@ -53,6 +64,7 @@ bool get_b_player_have_upgrade_points(void);
 void set_dynamic_player_have_ability_upgrade_points(bool _b);
 
 const ingame_info* gm_get_ingame_info(void);
+const std::array<f64, GM_UPDATE_STAGE_MAX>& gm_get_update_stage_times(void);
 const std::vector<character_trait>& gm_get_character_traits_all(void);
 const std::array<item_data, ITEM_TYPE_MAX>& gm_get_default_items(void);
 const std::array<sigil_slot, SIGIL_SLOT_MAX>& gm_get_sigil_slots(void);
@@ -66,7 +78,7 @@ void gm_end_game(bool is_win);
 void gm_save_game(void);
 void gm_load_game(save_slot_id slot_id);
 void gm_refresh_save_slot(void);
-void gm_damage_spawn_if_collide(data128 coll_data, i32 damage, collision_type coll_check);
+void gm_damage_spawn_if_collide(data128 coll_data, i32 damage, collision_type coll_check, i32 source);
 void gm_damage_player_if_collide(data128 coll_data, i32 damage, collision_type coll_check);
 bool gm_refresh_game_rule_by_level(game_rule * rule, i32 level);
 bool gm_refresh_sigil(item_data * sigil);
@@ -89,6 +101,7 @@ void    _set_player_position(Vector2 position);
 void    _get_next_level(ability& abl);
 const ability& _get_ability(ability_id _id);
 const std::array<ability, ABILITY_ID_MAX>& _get_all_abilities(void);
+const projectile_data_soa& _get_projectile_pool(void);
 const Character2D * _get_spawn_by_id(i32 _id);
 const player_state * gm_get_player_state(void);
 f32 gm_get_player_sprite_scale(void);
@@ -5,6 +5,7 @@
 
 #include <string>
 #include <array>
+#include <list>
 #include <raylib.h>
 
 #include "defines.h"
@@ -29,15 +30,18 @@
 #define WHITE_ROCK CLITERAL(Color) {245, 246, 250,255}
 #define CLEAR_BACKGROUND_COLOR BLACK
 
-#define MAX_SHADER_LOCATION_SLOT 16
 #define MAX_SHADER_LOCATION_NAME_LENGTH 16
 
 #define UI_FONT_SPACING 1
 
 #define MAX_SLIDER_OPTION_SLOT 16
 
+#define MAX_COMBAT_FEEDBACK_FLOATING_TEXT_LENGTH 16
+#define MAX_COMBAT_FEEDBACK_FLOATING_TEXT_COUNT 512
+
 #define MAX_Z_INDEX_SLOT 10
 #define MAX_Y_INDEX_SLOT 10
+#define MAP_SPATIAL_CELL_SIZE 512.f
 
 #define MAX_UPDATE_ABILITY_PANEL_COUNT 3
 #define MAX_UPDATE_PASSIVE_PANEL_COUNT 3
@@ -49,6 +53,11 @@
 
 #define MAX_ABILITY_LEVEL 7
 #define MAX_ABILITY_PROJECTILE_COUNT 32
+#define MAX_PROJECTILE_ANIMATION_COUNT 3
+#define MAX_PROJECTILE_SLOT_COUNT (ABILITY_ID_MAX * MAX_ABILITY_PROJECTILE_COUNT)
+
+// INFO: Damage sources are ability ids, values past ABILITY_ID_MAX belong to non-ability damage
+#define DAMAGE_SOURCE_PLAYER_ATTACK ABILITY_ID_MAX
 
 #define MAX_STAT_UPGRADE_TIER 5
 #define MAX_ABILITY_PLAYER_CAN_HAVE_IN_THE_SAME_TIME 6
@@ -218,6 +227,14 @@ enum tilemap_prop_types {
   TILEMAP_PROP_TYPE_MAX,
 };
 
+enum map_spatial_kind {
+  MAP_SPATIAL_KIND_UNDEFINED,
+  MAP_SPATIAL_KIND_PROP_STATIC,
+  MAP_SPATIAL_KIND_PROP_SPRITE,
+  MAP_SPATIAL_KIND_COLLISION,
+  MAP_SPATIAL_KIND_MAX,
+};
+
 enum ingame_play_phases {
   INGAME_PLAY_PHASE_UNDEFINED,
   INGAME_PLAY_PHASE_IDLE,
@@ -465,6 +482,31 @@ struct damage_deal_result {
   }
 };
 
+/**
+ * @brief Payload of EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT, too wide for a data128
+ */
+struct damage_rotated_rect_payload {
+  Rectangle rect;
+  Vector2 origin;
+  f32 rotation;
+  i32 damage;
+  i32 source;
+  damage_rotated_rect_payload(void) {
+    this->rect = Rectangle {0.f, 0.f, 0.f, 0.f};
+    this->origin = Vector2 {0.f, 0.f};
+    this->rotation = 0.f;
+    this->damage = 0;
+    this->source = 0;
+  }
+  damage_rotated_rect_payload(Rectangle rect, Vector2 origin, f32 rotation, i32 damage, i32 source) : damage_rotated_rect_payload() {
+    this->rect = rect;
+    this->origin = origin;
+    this->rotation = rotation;
+    this->damage = damage;
+    this->source = source;
+  }
+};
+
 struct spritesheet {
   spritesheet_id sheet_id;
   texture_id tex_id;
@@ -519,6 +561,25 @@ struct tile_symbol {
   }
 };
 
+/**
+ * @brief Every layer of one tile, stored side by side
+ */
+struct tilemap_cell {
+  tile_symbol layers[MAX_TILEMAP_LAYERS];
+};
+
+/**
+ * @brief Row-major and layer-interleaved, so a row walk is sequential and one cache line holds all layers of neighbouring tiles
+ */
+struct tilemap_tile_storage {
+  std::array<tilemap_cell, MAX_TILEMAP_TILESLOT> cells;
+
+  tilemap_cell& cell(i32 x, i32 y) { return this->cells[static_cast<size_t>(y) * MAX_TILEMAP_TILESLOT_X + static_cast<size_t>(x)]; }
+  const tilemap_cell& cell(i32 x, i32 y) const { return this->cells[static_cast<size_t>(y) * MAX_TILEMAP_TILESLOT_X + static_cast<size_t>(x)]; }
+  tile_symbol& at(i32 layer, i32 x, i32 y) { return this->cell(x, y).layers[layer]; }
+  const tile_symbol& at(i32 layer, i32 x, i32 y) const { return this->cell(x, y).layers[layer]; }
+};
+
 struct tilesheet {
   tilesheet_type sheet_id;
   atlas_texture atlas_source;
@@ -669,9 +730,11 @@ struct tilemap_prop_address {
     tilemap_prop_static* prop_static;
     tilemap_prop_sprite* prop_sprite;
   } data;
+  i32 y_key; // INFO: Bottom edge of the prop, kept only by the y based render queues
   tilemap_prop_address(void) {
     this->type = TILEMAP_PROP_TYPE_UNDEFINED;
     this->data.prop_sprite = nullptr;
+    this->y_key = 0;
   }
   tilemap_prop_address(tilemap_prop_static* _prop) : tilemap_prop_address() {
     this->data.prop_static = _prop;
@@ -718,6 +781,44 @@ struct map_collision {
   }
 };
 
+struct map_spatial_ref {
+  map_spatial_kind kind;
+  i32 id;
+  Rectangle bounds;
+  map_spatial_ref(void) {
+    this->kind = MAP_SPATIAL_KIND_UNDEFINED;
+    this->id = I32_MAX;
+    this->bounds = ZERORECT;
+  }
+  map_spatial_ref(map_spatial_kind _kind, i32 _id, Rectangle _bounds) : map_spatial_ref() {
+    this->kind = _kind;
+    this->id = _id;
+    this->bounds = _bounds;
+  }
+};
+
+/**
+ * @brief Uniform grid over the map. Every prop and collision is filed in each cell its bounds touch, anything outside the map
+ * @brief lands in the border cells. slot_by_id maps a map_id or coll_id to its index in the matching vector of the tilemap.
+ * @brief Collision rects are also packed cell by cell into collision_rects, collision_cell_start has one more entry than cells
+ */
+struct map_spatial_index {
+  std::vector<std::vector<map_spatial_ref>> cells;
+  std::array<std::vector<u32>, MAP_SPATIAL_KIND_MAX> slot_by_id;
+  std::vector<u32> collision_cell_start;
+  std::vector<Rectangle> collision_rects;
+  Vector2 origin;
+  i32 cell_count_axis;
+  map_spatial_index(void) {
+    this->cells = std::vector<std::vector<map_spatial_ref>>();
+    this->slot_by_id.fill(std::vector<u32>());
+    this->collision_cell_start = std::vector<u32>();
+    this->collision_rects = std::vector<Rectangle>();
+    this->origin = ZEROVEC2;
+    this->cell_count_axis = 0;
+  }
+};
+
 struct tilemap {
   i32 index;
   std::array<std::string, MAX_TILEMAP_LAYERS> filename;
@@ -729,15 +830,16 @@ struct tilemap {
   i32 map_dim_total;
   i32 map_dim;
   i32 tile_size;
-  tile_symbol tiles[MAX_TILEMAP_LAYERS][MAX_TILEMAP_TILESLOT_X][MAX_TILEMAP_TILESLOT_Y];
+  tilemap_tile_storage tiles;
   std::vector<tilemap_prop_static> static_props;
   std::vector<tilemap_prop_sprite> sprite_props;
-  std::array<std::vector<tilemap_prop_address>, MAX_Z_INDEX_SLOT> render_z_index_queue;
-  std::array<std::vector<tilemap_prop_address>, MAX_Y_INDEX_SLOT> render_y_based_queue;
+  memory_arena render_queue_arena; // INFO: Both render queues live here, refresh_render_queue() frees them in one reset
+  std::array<arena_vector<tilemap_prop_address>, MAX_Z_INDEX_SLOT> render_z_index_queue;
+  std::array<arena_vector<tilemap_prop_address>, MAX_Y_INDEX_SLOT> render_y_based_queue;
   std::vector<map_collision> collisions;
+  map_spatial_index spatial_index;
   bool is_initialized;
   tilemap(void) {
-    zero_memory(tiles, sizeof(tile_symbol) * MAX_TILEMAP_LAYERS * MAX_TILEMAP_TILESLOT_X * MAX_TILEMAP_TILESLOT_Y);
     this->index = 0;
     this->filename.fill(std::string());
     this->propfile = std::string();
@@ -750,9 +852,11 @@ struct tilemap {
     this->tile_size = 0;
     this->static_props = std::vector<tilemap_prop_static>();
     this->sprite_props = std::vector<tilemap_prop_sprite>();
-    this->render_z_index_queue.fill(std::vector<tilemap_prop_address>());
-    this->render_y_based_queue.fill(std::vector<tilemap_prop_address>());
+    this->render_queue_arena = memory_arena();
+    this->render_z_index_queue.fill(arena_vector<tilemap_prop_address>());
+    this->render_y_based_queue.fill(arena_vector<tilemap_prop_address>());
     this->collisions = std::vector<map_collision>();
+    this->spatial_index = map_spatial_index();
     this->is_initialized = false;
   }
 };
@@ -888,7 +992,7 @@ struct combat_feedback_floating_text {
   atlas_texture_id background_tex_id;
   f32 bg_tex_scale;
   ::font_type font_type; 
-  std::string text;
+  std::array<char, MAX_COMBAT_FEEDBACK_FLOATING_TEXT_LENGTH> text; // NOTE: Inline so a pool block holds the whole text, longer texts are cut
   Vector2 initial;
   Vector2 target;
   Vector2 interpolate;
@@ -907,7 +1011,7 @@ struct combat_feedback_floating_text {
     this->background_tex_id = ATLAS_TEX_ID_UNSPECIFIED;
     this->bg_tex_scale = 0.f;
     this->font_type = FONT_TYPE_UNDEFINED;
-    this->text = std::string();
+    this->text.fill('\0');
     this->initial = ZEROVEC2;
     this->target = ZEROVEC2;
     this->interpolate = ZEROVEC2;
@@ -929,7 +1033,9 @@ struct combat_feedback_floating_text {
     this->background_tex_id = bg_tex_id;
     this->bg_tex_scale = bg_tex_scale;
     this->font_type = _font_type;
-    this->text = _text;
+    if (_text and _text != nullptr) {
+      std::string_view(_text).copy(this->text.data(), this->text.size() - 1u);
+    }
     this->initial = _start_pos;
     this->target = _end_pos;
     this->duration = _duration;
@@ -939,8 +1045,12 @@ struct combat_feedback_floating_text {
   }
 };
 
+/**
+ * @brief Queue nodes come from the pool once user_interface_system_initialize() creates it, the heap only takes the overflow
+ */
 struct floating_text_display_system_state {
-  std::vector<combat_feedback_floating_text> queue;
+  memory_pool pool;
+  std::list<combat_feedback_floating_text, pool_allocator<combat_feedback_floating_text>> queue;
   i32 next_cfft_id;
   f32 duration_min;
   f32 duration_max;
@@ -948,7 +1058,8 @@ struct floating_text_display_system_state {
   f32 scale_max;
 
   floating_text_display_system_state(void) {
-    this->queue = std::vector<combat_feedback_floating_text>();
+    this->pool = memory_pool();
+    this->queue = std::list<combat_feedback_floating_text, pool_allocator<combat_feedback_floating_text>>();
     this->next_cfft_id = 0;
     this->duration_min = 0.f;
     this->duration_max = 0.f;
@@ -963,6 +1074,16 @@ struct floating_text_display_system_state {
   }
 };
 
+/**
+ * @brief Aggregated spawn-player contact of one frame. Damage belongs to the lowest indexed spawn in contact.
+ */
+struct spawn_contact_result {
+  i32 contact_count {};
+  i32 damage {};
+  i32 spawn_id {};
+  spawn_contact_result(void) {};
+};
+
 struct element_handle {
   i32 id {};
   size_t index {};
@@ -1029,37 +1150,162 @@ struct Character2D {
   }
 };
 
+enum spawn_state_flag {
+  SPAWN_FLAG_NONE        = 0,
+  SPAWN_FLAG_INITIALIZED = 1 << 0,
+  SPAWN_FLAG_DEAD        = 1 << 1,
+  SPAWN_FLAG_DAMAGABLE   = 1 << 2,
+  SPAWN_FLAG_ON_SCREEN   = 1 << 3,
+  SPAWN_FLAG_INVISIBLE   = 1 << 4,
+  SPAWN_FLAG_MOVE_HALTED = 1 << 5,
+};
+
 /**
- * @brief vec_ex buffer summary: {f32[0], f32[1]}, {f32[2], f32[3]} = {target x, target y}, {explosion.x, explosion.y}
- * @brief mm_ex buffer  summary: {u16[0]} = {counter, }
+ * @brief Cold spawn data, only touched by render and by animation updates
  */
-struct projectile {
-  i32 id {};
-  std::vector<spritesheet> animations;
-  i32 active_sprite {};
-  Vector2 position {};
-  Rectangle collision {};
-  world_direction direction;
+struct spawn_animation_data {
+  spritesheet move_right_animation;
+  spritesheet move_left_animation;
+  spritesheet take_damage_right_animation;
+  spritesheet take_damage_left_animation;
+  spritesheet death_effect_animation;
+  spawn_movement_animations last_played_animation;
+  Color tint {};
 
-  // 128 byte buffer
-  data256 vec_ex;
-  data256 mm_ex;
+  spawn_animation_data(void) {
+    this->last_played_animation = SPAWN_ZOMBIE_ANIMATION_UNDEFINED;
+  }
+};
 
-  i32 damage {};
-  f32 accumulator {};
-  f32 duration {};
-  bool is_active {};
+/**
+ * @brief Cold spawn data, only touched on damage, death and loot drop
+ * @param buffer.i32[1] = SPAWN_LEVEL
+ * @param buffer.i32[2] = SPAWN_RND_SCALE
+ */
+struct spawn_stat_data {
+  spawn_type type;
+  i32 health_max {};
+  i32 health_current {};
+  f32 rotation {};
+  f32 scale {};
+  f32 damage_break_time {};
+  condition_halt_movement cond_halt_move {};
+  data128 buffer;
 
-  projectile(void) {
-    this->active_sprite = -1;
-    this->direction = WORLD_DIRECTION_UNDEFINED;
+  spawn_stat_data(void) {
+    this->type = SPAWN_TYPE_UNDEFINED;
   }
 };
 
+/**
+ * @brief Structure-of-arrays spawn storage. All arrays share the same index.
+ * Hot arrays are streamed by movement and collision every frame,
+ * cold arrays are only touched by render, damage and death paths.
+ */
+struct spawn_data_soa {
+  // Hot
+  std::vector<i32> character_id;
+  std::vector<Vector2> position;
+  std::vector<Rectangle> collision;
+  std::vector<f32> speed;
+  std::vector<i32> damage;
+  std::vector<world_direction> w_direction;
+  std::vector<u8> flags;
+
+  // Cold
+  std::vector<spawn_animation_data> animation;
+  std::vector<spawn_stat_data> stats;
+  std::vector<Vector2> previous_position; // INFO: Position at the start of the last simulation tick, for render interpolation
+
+  size_t size(void) const { return this->character_id.size(); }
+  bool empty(void) const { return this->character_id.empty(); }
+  bool has_flag(size_t index, spawn_state_flag flag) const { return (this->flags[index] & flag) != 0; }
+};
+
+enum projectile_state_flag {
+  PROJECTILE_FLAG_NONE         = 0,
+  PROJECTILE_FLAG_ACTIVE       = 1 << 0,
+  PROJECTILE_FLAG_INTERPOLATED = 1 << 1, // INFO: Was active on the previous tick, so previous_position is valid
+};
+
+enum projectile_animation_flag {
+  PROJECTILE_ANIMATION_FLAG_NONE      = 0,
+  PROJECTILE_ANIMATION_FLAG_STARTED   = 1 << 0,
+  PROJECTILE_ANIMATION_FLAG_PLAYED    = 1 << 1,
+  PROJECTILE_ANIMATION_FLAG_LOOPED    = 1 << 2,
+  PROJECTILE_ANIMATION_FLAG_PLAY_ONCE = 1 << 3,
+};
+
+/**
+ * @brief Playback state of one projectile sprite. Frame size, fps and texture are read from the resource sheet by sheet_id,
+ * see ss_get_spritesheet_by_enum(). Column and row are derived from current_frame.
+ */
+struct projectile_animation {
+  spritesheet_id sheet_id;
+  i32 current_frame;
+  f32 time_accumulator;
+  u8 flags;
+
+  projectile_animation(void) {
+    this->sheet_id = SHEET_ID_SPRITESHEET_UNSPECIFIED;
+    this->current_frame = 0;
+    this->time_accumulator = 0.f;
+    this->flags = PROJECTILE_ANIMATION_FLAG_NONE;
+  }
+  bool has_flag(projectile_animation_flag flag) const { return (this->flags & flag) != 0; }
+};
+
+/**
+ * @brief Where a projectile is drawn, for abilities that keep it across ticks rather than computing it in render
+ */
+struct projectile_draw_state {
+  Rectangle coord;
+  Vector2 origin;
+  f32 rotation;
+  Color tint;
+
+  projectile_draw_state(void) {
+    this->coord = ZERORECT;
+    this->origin = ZEROVEC2;
+    this->rotation = 0.f;
+    this->tint = WHITE;
+  }
+};
+
+/**
+ * @brief Structure-of-arrays projectile storage shared by every ability. All arrays share the same slot index
+ * and are sized once to MAX_PROJECTILE_SLOT_COUNT in the ability manager's arena, an ability owns the slots starting at ability::proj_slot_begin().
+ * Hot arrays are streamed by every ability update, cold arrays are only touched by their own ability and render.
+ * An animation slot holds the sheet id and frame state of its sprite, MAX_PROJECTILE_ANIMATION_COUNT per projectile. The sheet itself stays in the resource.
+ * @brief vec_ex buffer summary: {f32[0], f32[1]}, {f32[2], f32[3]} = {target x, target y}, {explosion.x, explosion.y}
+ * @brief mm_ex buffer  summary: {u16[0]} = {counter, }
+ */
+struct projectile_data_soa {
+  // Hot
+  arena_vector<Vector2> position;
+  arena_vector<Vector2> previous_position; // INFO: Position on the previous simulation tick, for render interpolation
+  arena_vector<Rectangle> collision;
+  arena_vector<i32> damage;
+  arena_vector<i32> active_sprite;
+  arena_vector<u8> flags;
+
+  // Cold
+  arena_vector<projectile_animation> animations;
+  arena_vector<projectile_draw_state> draw_state;
+  arena_vector<f32> accumulator;
+  arena_vector<f32> duration;
+  arena_vector<data256> vec_ex;
+  arena_vector<data256> mm_ex;
+
+  size_t size(void) const { return this->flags.size(); }
+  bool has_flag(size_t slot, projectile_state_flag flag) const { return (this->flags[slot] & flag) != 0; }
+  projectile_animation& animation(size_t slot, i32 anim_index) { return this->animations[slot * MAX_PROJECTILE_ANIMATION_COUNT + anim_index]; }
+  const projectile_animation& animation(size_t slot, i32 anim_index) const { return this->animations[slot * MAX_PROJECTILE_ANIMATION_COUNT + anim_index]; }
+};
+
 struct ability {
   ability_id id {};
   i32 display_name_loc_text_id {};
-  std::vector<projectile> projectiles;
   std::vector<spritesheet_id> animation_ids;
   void* p_owner;
   std::array<ability_upgradables, ABILITY_UPG_MAX> upgradables;
@@ -1073,6 +1319,7 @@ struct ability {
   Vector2 proj_collision_scale {};
   f32 proj_duration {};
   i32 proj_count {};
+  i32 proj_slot_count {}; // INFO: Pool slots in use, set on refresh
   i32 proj_speed {};
   i32 level {};
   i32 base_damage {};
@@ -1109,6 +1356,8 @@ struct ability {
     this->proj_dim = proj_dim;
     this->icon_src = icon_src;
   }
+  size_t proj_slot_begin(void) const { return static_cast<size_t>(this->id) * MAX_ABILITY_PROJECTILE_COUNT; }
+  size_t proj_slot_end(void) const { return this->proj_slot_begin() + static_cast<size_t>(this->proj_slot_count); }
 };
 
 struct ability_play_system {
@@ -1232,6 +1481,7 @@ struct player_state {
   world_direction w_direction;
   character_attack_combo combo_type;
   Vector2 position;
+  Vector2 previous_position; // INFO: Position at the start of the last simulation tick, for render interpolation
   player_animation_state anim_state;
   f32 damage_break_duration;
   f32 damage_break_accumulator;
@@ -1277,6 +1527,7 @@ struct player_state {
     this->w_direction = WORLD_DIRECTION_UNDEFINED;
     this->combo_type = CHARACTER_ATTACK_COMBO_UNDEFINED;
     this->position = ZEROVEC2;
+    this->previous_position = ZEROVEC2;
     this->anim_state = PL_ANIM_STATE_UNDEFINED;
     this->damage_break_duration = 0.f;
     this->damage_break_accumulator = 0.f;
@@ -1330,12 +1581,12 @@ struct game_rule {
 struct ingame_info {
   const player_state * player_state_dynamic;
   const player_state * player_state_static;
-  const std::vector<Character2D>* in_spawns;
+  const spawn_data_soa* in_spawns;
   const Vector2* mouse_pos_world;
   const Vector2* mouse_pos_screen;
   const ingame_play_phases* ingame_phase;
   const std::vector<character_trait>* chosen_traits;
-  const std::vector<loot_item> * loots_on_the_map;
+  const arena_vector<loot_item> * loots_on_the_map;
   const worldmap_stage * current_map_info;
   const std::array<game_rule, GAME_RULE_MAX> * game_rules;
   const i32 * collected_coins;
@@ -6,6 +6,8 @@
 #include "core/fmemory.h"
 #include "core/logger.h"
 #include "core/fmath.h"
+#include "core/finput.h"
+#include "core/ftime.h"
 
 //#include "loc_types.h"
 
@@ -53,7 +55,7 @@ bool player_system_initialize(const camera_metrics* in_camera_metrics,const app_
     player_system_reinit();
     return true;
   }
-  state = (player_system_state*)allocate_memory_linear(sizeof(player_system_state), true);
+  state = (player_system_state*)allocate_memory_linear(sizeof(player_system_state), true, MEMORY_TAG_GAME);
   if (not state or state == nullptr) {
     IERROR("player::player_system_initialize()::Failed to allocate player system");
     return false;
@@ -174,6 +176,7 @@ player_update_results update_player(void) {
   if (not state or state == nullptr or state->dynamic_player.is_dead) return results;
 
   player_state& _player = state->dynamic_player;
+  _player.previous_position = _player.position;
 
   if (_player.anim_state <= PL_ANIM_STATE_UNDEFINED or _player.anim_state >= PL_ANIM_STATE_MAX) {
     _player.anim_state = PL_ANIM_STATE_IDLE;
@@ -181,17 +184,17 @@ player_update_results update_player(void) {
 
   player_damage_break_update();
 
-  if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+  if (input_is_action_released(INPUT_ACTION_ATTACK)) {
     player_attack_init();
   }
-  if (IsKeyReleased(KEY_SPACE)) {
+  if (input_is_action_released(INPUT_ACTION_ROLL)) {
     player_roll_init();
   }
   player_update_movement(results.move_request);
   player_update_attack();
   player_update_sprite();
 
-  const i32 elapsed_time = static_cast<i32>(GetTime());
+  const i32 elapsed_time = static_cast<i32>(ftime_get_app_time());
   i32& last_time_hp_regen_fired = state->dynamic_player.stats[CHARACTER_STATS_HP_REGEN].mm_ex.i32[0];
   const i32& hp_max = state->dynamic_player.stats[CHARACTER_STATS_HEALTH].buffer.i32[3];
   i32& hp_current = state->dynamic_player.health_current;
@@ -219,8 +222,14 @@ bool render_player(void) {
   const Rectangle& frame_rect = state->dynamic_player.current_anim_to_play.current_frame_rect;
   
   if(_sheet.sheet_id > SHEET_ID_SPRITESHEET_UNSPECIFIED and _sheet.sheet_id < SHEET_ID_SPRITESHEET_TYPE_MAX) {
-    play_sprite_on_site_ex(_sheet, Rectangle {frame_rect.x + _sheet.offset.x, frame_rect.y + _sheet.offset.y, frame_rect.width, frame_rect.height}, 
-      state->dynamic_player.current_anim_to_play.coord, 
+    const Vector2 render_position = vec2_lerp(state->dynamic_player.previous_position, state->dynamic_player.position, get_simulation_alpha());
+    const Rectangle dest = Rectangle {
+      _sheet.coord.x + (render_position.x - state->dynamic_player.position.x),
+      _sheet.coord.y + (render_position.y - state->dynamic_player.position.y),
+      _sheet.coord.width, _sheet.coord.height
+    };
+    sprite_batch_play_sprite_ex(_sheet, SPRITE_LAYER_SCENE, Rectangle {frame_rect.x + _sheet.offset.x, frame_rect.y + _sheet.offset.y, frame_rect.width, frame_rect.height}, 
+      dest, 
       state->dynamic_player.current_anim_to_play.origin, 
       state->dynamic_player.current_anim_to_play.rotation, 
       WHITE
@@ -438,7 +447,8 @@ void player_update_attack(void) {
       static_cast<i16>(damage_area.width),
       static_cast<i16>(damage_area.height),
       final_damage,
-      static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE)
+      static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE),
+      static_cast<i16>(DAMAGE_SOURCE_PLAYER_ATTACK)
     ));
   }
 }
@@ -526,16 +536,16 @@ void player_update_movement(Vector2& move_delta) {
 Vector2 get_player_direction(void) {
   Vector2 out_delta = ZEROVEC2;
 
-  if (IsKeyDown(KEY_W)) {
+  if (input_is_action_down(INPUT_ACTION_MOVE_UP)) {
     out_delta.y += DIRECTION_VECTOR_UP.y;
   }
-  if (IsKeyDown(KEY_A)) {
+  if (input_is_action_down(INPUT_ACTION_MOVE_LEFT)) {
     out_delta.x += DIRECTION_VECTOR_LEFT.x;
   }
-  if (IsKeyDown(KEY_S)) {
+  if (input_is_action_down(INPUT_ACTION_MOVE_DOWN)) {
     out_delta.y += DIRECTION_VECTOR_DOWN.y;
   }
-  if (IsKeyDown(KEY_D)) {
+  if (input_is_action_down(INPUT_ACTION_MOVE_RIGHT)) {
     out_delta.x += DIRECTION_VECTOR_RIGHT.x;
   }
   return vec2_normalize(out_delta);
@@ -648,6 +658,7 @@ bool player_system_on_event(i32 code, event_context context) {
         case EVENT_CODE_PLAYER_SET_POSITION: {
           state->dynamic_player.position.x = context.data.f32[0]; 
           state->dynamic_player.position.y = context.data.f32[1]; 
+          state->dynamic_player.previous_position = state->dynamic_player.position;
           state->dynamic_player.collision.x = state->dynamic_player.position.x; 
           state->dynamic_player.collision.y = state->dynamic_player.position.y; 
           return true;
@@ -0,0 +1,514 @@
+#include "replay.h"
+#include <cmath>
+#include <cstring>
+
+#include "core/finput.h"
+#include "core/fmemory.h"
+#include "core/frandom.h"
+#include "core/ftime.h"
+#include "core/logger.h"
+
+#include "game_manager.h"
+
+// INFO: Bytes each record takes in the file, see replay_write_file()
+#define REPLAY_TRAIT_RECORD_SIZE (sizeof(i32) * 4u + sizeof(data128))
+#define REPLAY_FRAME_RECORD_SIZE (sizeof(u8) * 3u + sizeof(f32) * 2u)
+#define REPLAY_CHOICE_RECORD_SIZE (sizeof(u32) + sizeof(i32) + sizeof(u8))
+#define REPLAY_CHECKSUM_RECORD_SIZE (sizeof(u32) + sizeof(u64))
+
+/**
+ * @brief Input and tick count of one update_game_manager() call
+ */
+struct replay_frame {
+  u8 tick_count;
+  u8 down_bits;
+  u8 released_bits;
+  Vector2 mouse_position;
+};
+
+struct replay_ability_choice {
+  u32 frame;
+  i32 ability;
+  u8 is_new;
+};
+
+struct replay_checksum {
+  u32 frame;
+  u64 hash;
+};
+
+typedef struct replay_system_state {
+  replay_mode mode;
+  bool active; // INFO: Armed until gm_init_game(), active until replay_finish()
+  std::string path;
+  input_source previous_input_source;
+
+  u64 seed;
+  i32 map_id;
+  i32 spawn_on_begin;
+  i32 spawn_on_map_max;
+  f32 simulation_step;
+  i32 starter_ability;
+  std::vector<character_trait> traits;
+  std::vector<replay_frame> frames;
+  std::vector<replay_ability_choice> choices;
+  std::vector<replay_checksum> checksums;
+
+  u32 frame_index;
+  size_t next_choice;
+  size_t next_checksum;
+  replay_stats stats;
+
+  replay_system_state(void) {
+    this->mode = REPLAY_MODE_NONE;
+    this->active = false;
+    this->path = std::string();
+    this->previous_input_source = INPUT_SOURCE_DEVICE;
+    this->seed = 0u;
+    this->map_id = 0;
+    this->spawn_on_begin = 0;
+    this->spawn_on_map_max = 0;
+    this->simulation_step = 0.f;
+    this->starter_ability = ABILITY_ID_UNDEFINED;
+    this->frame_index = 0u;
+    this->next_choice = 0u;
+    this->next_checksum = 0u;
+    this->stats = replay_stats();
+  }
+} replay_system_state;
+
+static replay_system_state * state = nullptr;
+
+/**
+ * @brief Fixed width little endian fields, so a file stays readable by later builds as long as the version matches
+ */
+struct replay_writer {
+  std::vector<u8> bytes;
+  template <typename T> void put(T value) {
+    const size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, __builtin_addressof(value), sizeof(T));
+  }
+};
+struct replay_reader {
+  const u8 * data;
+  size_t size;
+  size_t offset;
+  bool failed;
+  template <typename T> T get(void) {
+    T value {};
+    if (failed or offset + sizeof(T) > size) {
+      failed = true;
+      return value;
+    }
+    std::memcpy(__builtin_addressof(value), data + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+  }
+};
+
+u64 replay_compute_checksum(void);
+bool replay_write_file(void);
+bool replay_read_file(const char * path);
+void replay_reset_run(void);
+
+bool replay_system_initialize(void) {
+  if (state and state != nullptr) {
+    return true;
+  }
+  state = (replay_system_state *)allocate_memory_linear(sizeof(replay_system_state), true, MEMORY_TAG_GAME);
+  if (not state or state == nullptr) {
+    IERROR("replay::replay_system_initialize()::State allocation failed");
+    return false;
+  }
+  *state = replay_system_state();
+  return true;
+}
+
+bool replay_arm_recording(const char * path) {
+  if (not state or state == nullptr or not path or path == nullptr) {
+    return false;
+  }
+  if (state->active) {
+    IWARN("replay::replay_arm_recording()::A replay is already running");
+    return false;
+  }
+  replay_reset_run();
+  state->mode = REPLAY_MODE_RECORD;
+  state->path = path;
+  return true;
+}
+bool replay_arm_playback(const char * path) {
+  if (not state or state == nullptr or not path or path == nullptr) {
+    return false;
+  }
+  if (state->active) {
+    IWARN("replay::replay_arm_playback()::A replay is already running");
+    return false;
+  }
+  replay_reset_run();
+  if (not replay_read_file(path)) {
+    IWARN("replay::replay_arm_playback()::Replay file '%s' could not be read", path);
+    replay_reset_run();
+    return false;
+  }
+  state->mode = REPLAY_MODE_PLAYBACK;
+  state->path = path;
+  state->stats.seed = state->seed;
+  state->stats.map_id = state->map_id;
+  state->stats.frame_count = static_cast<u32>(state->frames.size());
+  return true;
+}
+void replay_disarm(void) {
+  if (not state or state == nullptr) {
+    return;
+  }
+  if (state->active and state->mode == REPLAY_MODE_PLAYBACK) {
+    input_set_source(state->previous_input_source);
+  }
+  replay_reset_run();
+}
+
+replay_mode replay_get_mode(void) {
+  if (not state or state == nullptr) {
+    return REPLAY_MODE_NONE;
+  }
+  return state->mode;
+}
+bool replay_is_playing(void) {
+  return state and state != nullptr and state->active and state->mode == REPLAY_MODE_PLAYBACK;
+}
+const replay_stats * replay_get_stats(void) {
+  if (not state or state == nullptr) {
+    return nullptr;
+  }
+  return &state->stats;
+}
+
+bool replay_begin_game(worldmap_stage& stage, std::vector<character_trait>& traits, ability_id& starter_ability) {
+  if (not state or state == nullptr or state->mode == REPLAY_MODE_NONE) {
+    return false;
+  }
+  state->frame_index = 0u;
+  state->next_choice = 0u;
+  state->next_checksum = 0u;
+
+  if (state->mode == REPLAY_MODE_RECORD) {
+    random_set_seed(random_get_seed()); // INFO: Rewinds the streams, rolls made in the menus before the run do not matter
+    state->seed = random_get_seed();
+    state->map_id = stage.map_id;
+    state->spawn_on_begin = stage.spawn_on_begin;
+    state->spawn_on_map_max = stage.spawn_on_map_max;
+    state->simulation_step = get_simulation_step();
+    state->starter_ability = starter_ability;
+    state->traits = traits;
+    state->frames.clear();
+    state->choices.clear();
+    state->checksums.clear();
+    state->active = true;
+    state->stats = replay_stats();
+    state->stats.seed = state->seed;
+    state->stats.map_id = state->map_id;
+    return true;
+  }
+  if (stage.map_id != state->map_id) {
+    IWARN("replay::replay_begin_game()::Recorded map %d differs from the stage map %d, playback is cancelled", state->map_id, stage.map_id);
+    replay_reset_run();
+    return false;
+  }
+  random_set_seed(state->seed);
+  stage.spawn_on_begin = state->spawn_on_begin;
+  stage.spawn_on_map_max = state->spawn_on_map_max;
+  starter_ability = static_cast<ability_id>(state->starter_ability);
+  traits = state->traits;
+  if (state->simulation_step > 0.f) {
+    set_simulation_tick_rate(static_cast<i32>(std::lround(1.f / state->simulation_step)));
+  }
+  state->previous_input_source = input_get_source();
+  input_set_source(INPUT_SOURCE_SCRIPTED);
+  state->active = true;
+  return true;
+}
+
+/**
+ * @brief Playback applies the ability choices made before this frame and feeds the recorded input to the scripted source
+ */
+void replay_begin_update(void) {
+  if (not replay_is_playing()) {
+    return;
+  }
+  if (state->frame_index >= state->frames.size()) {
+    replay_finish();
+    return;
+  }
+  while (state->next_choice < state->choices.size() and state->choices.at(state->next_choice).frame <= state->frame_index) {
+    const replay_ability_choice& choice = state->choices.at(state->next_choice++);
+    if (choice.is_new) {
+      _add_ability(static_cast<ability_id>(choice.ability));
+    }
+    else {
+      upgrade_ability_by_id(static_cast<ability_id>(choice.ability));
+    }
+    set_dynamic_player_have_ability_upgrade_points(false);
+  }
+  const replay_frame& frame = state->frames.at(state->frame_index);
+  input_frame input = input_frame();
+  for (size_t itr_000 = INPUT_ACTION_UNDEFINED + 1; itr_000 < INPUT_ACTION_MAX; ++itr_000) {
+    input.down.at(itr_000)     = (frame.down_bits     >> itr_000) & 1u;
+    input.released.at(itr_000) = (frame.released_bits >> itr_000) & 1u;
+  }
+  input.mouse_position = frame.mouse_position;
+  input_set_scripted_frame(input);
+}
+/**
+ * @brief Called after the releases are latched. Recording stores what the ticks of this frame will read, playback returns the recorded tick count.
+ */
+u32 replay_resolve_tick_count(u32 tick_count) {
+  if (not state or state == nullptr or not state->active) {
+    return tick_count;
+  }
+  if (state->mode == REPLAY_MODE_PLAYBACK) {
+    return state->frames.at(state->frame_index).tick_count;
+  }
+  replay_frame frame = replay_frame();
+  frame.tick_count = static_cast<u8>(tick_count);
+  for (size_t itr_000 = INPUT_ACTION_UNDEFINED + 1; itr_000 < INPUT_ACTION_MAX; ++itr_000) {
+    const input_action action = static_cast<input_action>(itr_000);
+    frame.down_bits     |= static_cast<u8>(input_is_action_down(action)) << itr_000;
+    frame.released_bits |= static_cast<u8>(input_is_action_released(action)) << itr_000;
+  }
+  frame.mouse_position = input_get_mouse_position();
+  state->frames.push_back(frame);
+  return tick_count;
+}
+void replay_end_update(void) {
+  if (not state or state == nullptr or not state->active) {
+    return;
+  }
+  const u32 frame = state->frame_index++;
+  state->stats.frames_played = state->frame_index;
+  if ((frame + 1u) % REPLAY_CHECKSUM_INTERVAL != 0u) {
+    return;
+  }
+  const u64 hash = replay_compute_checksum();
+  if (state->mode == REPLAY_MODE_RECORD) {
+    state->checksums.push_back(replay_checksum { frame, hash });
+    state->stats.checksum_count++;
+    return;
+  }
+  while (state->next_checksum < state->checksums.size() and state->checksums.at(state->next_checksum).frame < frame) {
+    state->next_checksum++;
+  }
+  if (state->next_checksum >= state->checksums.size() or state->checksums.at(state->next_checksum).frame != frame) {
+    return;
+  }
+  state->stats.checksum_count++;
+  if (state->checksums.at(state->next_checksum).hash != hash) {
+    if (state->stats.first_divergent_frame < 0) {
+      state->stats.first_divergent_frame = static_cast<i32>(frame);
+      IWARN("replay::replay_end_update()::Replay diverged at frame %u", frame);
+    }
+    state->stats.checksum_mismatch_count++;
+  }
+  state->next_checksum++;
+}
+void replay_record_ability_choice(ability_id id, bool is_new) {
+  if (not state or state == nullptr or not state->active or state->mode != REPLAY_MODE_RECORD) {
+    return;
+  }
+  state->choices.push_back(replay_ability_choice { state->frame_index, static_cast<i32>(id), static_cast<u8>(is_new) });
+}
+
+bool replay_finish(void) {
+  if (not state or state == nullptr or not state->active) {
+    return false;
+  }
+  bool result = true;
+  if (state->mode == REPLAY_MODE_RECORD) {
+    state->stats.frame_count = static_cast<u32>(state->frames.size());
+    result = replay_write_file();
+    if (not result) {
+      IWARN("replay::replay_finish()::Replay file '%s' could not be written", state->path.c_str());
+    }
+  }
+  else {
+    input_set_source(state->previous_input_source);
+    IINFO("replay::replay_finish()::%u / %u frames played, %u checksums compared, %u mismatched",
+      state->stats.frames_played, state->stats.frame_count, state->stats.checksum_count, state->stats.checksum_mismatch_count
+    );
+  }
+  const replay_stats stats = state->stats;
+  replay_reset_run();
+  state->stats = stats; // INFO: Kept for the caller to report
+  return result;
+}
+
+/**
+ * @brief FNV-1a over the player and every spawn. Cheap enough to run each REPLAY_CHECKSUM_INTERVAL updates.
+ */
+u64 replay_compute_checksum(void) {
+  u64 hash = 0xCBF29CE484222325ull;
+  auto mix = [&hash](const void * data, size_t size) {
+    const u8 * bytes = static_cast<const u8 *>(data);
+    for (size_t itr_000 = 0u; itr_000 < size; ++itr_000) {
+      hash ^= bytes[itr_000];
+      hash *= 0x100000001B3ull;
+    }
+  };
+  const ingame_info * const info = gm_get_ingame_info();
+  if (not info or info == nullptr) {
+    return hash;
+  }
+  if (info->player_state_dynamic) {
+    const player_state& player = (*info->player_state_dynamic);
+    mix(&player.position, sizeof(player.position));
+    mix(&player.health_current, sizeof(player.health_current));
+    mix(&player.level, sizeof(player.level));
+    mix(&player.exp_current, sizeof(player.exp_current));
+  }
+  if (info->in_spawns) {
+    const spawn_data_soa& spawns = (*info->in_spawns);
+    const u64 count = static_cast<u64>(spawns.size());
+    mix(&count, sizeof(count));
+    for (size_t itr_000 = 0u; itr_000 < spawns.size(); ++itr_000) {
+      mix(&spawns.character_id[itr_000], sizeof(i32));
+      mix(&spawns.position[itr_000], sizeof(Vector2));
+      mix(&spawns.stats[itr_000].health_current, sizeof(spawns.stats[itr_000].health_current));
+    }
+  }
+  return hash;
+}
+
+bool replay_write_file(void) {
+  replay_writer w = replay_writer();
+  w.bytes.reserve(64u + state->frames.size() * REPLAY_FRAME_RECORD_SIZE + state->checksums.size() * REPLAY_CHECKSUM_RECORD_SIZE);
+
+  w.put<u32>(REPLAY_FILE_MAGIC);
+  w.put<u32>(REPLAY_FILE_VERSION);
+  w.put<u64>(state->seed);
+  w.put<i32>(state->map_id);
+  w.put<i32>(state->spawn_on_begin);
+  w.put<i32>(state->spawn_on_map_max);
+  w.put<f32>(state->simulation_step);
+  w.put<i32>(state->starter_ability);
+  w.put<u32>(static_cast<u32>(state->traits.size()));
+  w.put<u32>(static_cast<u32>(state->frames.size()));
+  w.put<u32>(static_cast<u32>(state->choices.size()));
+  w.put<u32>(static_cast<u32>(state->checksums.size()));
+
+  for (const character_trait& trait : state->traits) {
+    w.put<i32>(trait.unique_id);
+    w.put<i32>(static_cast<i32>(trait.affected_context));
+    w.put<i32>(trait.context_id);
+    w.put<i32>(trait.point);
+    w.put<data128>(trait.ingame_ops);
+  }
+  for (const replay_frame& frame : state->frames) {
+    w.put<u8>(frame.tick_count);
+    w.put<u8>(frame.down_bits);
+    w.put<u8>(frame.released_bits);
+    w.put<f32>(frame.mouse_position.x);
+    w.put<f32>(frame.mouse_position.y);
+  }
+  for (const replay_ability_choice& choice : state->choices) {
+    w.put<u32>(choice.frame);
+    w.put<i32>(choice.ability);
+    w.put<u8>(choice.is_new);
+  }
+  for (const replay_checksum& checksum : state->checksums) {
+    w.put<u32>(checksum.frame);
+    w.put<u64>(checksum.hash);
+  }
+  return SaveFileData(state->path.c_str(), w.bytes.data(), static_cast<i32>(w.bytes.size()));
+}
+bool replay_read_file(const char * path) {
+  i32 data_size = 0;
+  u8 * data = LoadFileData(path, &data_size);
+  if (not data or data == nullptr) {
+    return false;
+  }
+  replay_reader r = replay_reader { data, static_cast<size_t>(data_size), 0u, false };
+
+  if (r.get<u32>() != REPLAY_FILE_MAGIC or r.get<u32>() != REPLAY_FILE_VERSION) {
+    IWARN("replay::replay_read_file()::File is not a replay of this version");
+    UnloadFileData(data);
+    return false;
+  }
+  state->seed = r.get<u64>();
+  state->map_id = r.get<i32>();
+  state->spawn_on_begin = r.get<i32>();
+  state->spawn_on_map_max = r.get<i32>();
+  state->simulation_step = r.get<f32>();
+  state->starter_ability = r.get<i32>();
+  const u32 trait_count = r.get<u32>();
+  const u32 frame_count = r.get<u32>();
+  const u32 choice_count = r.get<u32>();
+  const u32 checksum_count = r.get<u32>();
+
+  // INFO: Counts come from the file, they are not trusted to size anything until the records they promise are all there
+  const u64 record_bytes = 
+    static_cast<u64>(trait_count)    * REPLAY_TRAIT_RECORD_SIZE  + 
+    static_cast<u64>(frame_count)    * REPLAY_FRAME_RECORD_SIZE  + 
+    static_cast<u64>(choice_count)   * REPLAY_CHOICE_RECORD_SIZE + 
+    static_cast<u64>(checksum_count) * REPLAY_CHECKSUM_RECORD_SIZE;
+  if (r.failed or record_bytes > static_cast<u64>(r.size - r.offset)) {
+    IWARN("replay::replay_read_file()::Record counts exceed the file size");
+    UnloadFileData(data);
+    return false;
+  }
+  state->traits.reserve(trait_count);
+  for (u32 itr_000 = 0u; itr_000 < trait_count and not r.failed; ++itr_000) {
+    character_trait trait = character_trait();
+    trait.unique_id = r.get<i32>();
+    trait.affected_context = static_cast<character_trait_type>(r.get<i32>());
+    trait.context_id = r.get<i32>();
+    trait.point = r.get<i32>();
+    trait.ingame_ops = r.get<data128>();
+    state->traits.push_back(trait);
+  }
+  state->frames.reserve(frame_count);
+  for (u32 itr_000 = 0u; itr_000 < frame_count and not r.failed; ++itr_000) {
+    replay_frame frame = replay_frame();
+    frame.tick_count = r.get<u8>();
+    frame.down_bits = r.get<u8>();
+    frame.released_bits = r.get<u8>();
+    frame.mouse_position.x = r.get<f32>();
+    frame.mouse_position.y = r.get<f32>();
+    state->frames.push_back(frame);
+  }
+  state->choices.reserve(choice_count);
+  for (u32 itr_000 = 0u; itr_000 < choice_count and not r.failed; ++itr_000) {
+    replay_ability_choice choice = replay_ability_choice();
+    choice.frame = r.get<u32>();
+    choice.ability = r.get<i32>();
+    choice.is_new = r.get<u8>();
+    state->choices.push_back(choice);
+  }
+  state->checksums.reserve(checksum_count);
+  for (u32 itr_000 = 0u; itr_000 < checksum_count and not r.failed; ++itr_000) {
+    replay_checksum checksum = replay_checksum();
+    checksum.frame = r.get<u32>();
+    checksum.hash = r.get<u64>();
+    state->checksums.push_back(checksum);
+  }
+  UnloadFileData(data);
+
+  if (r.failed) {
+    IWARN("replay::replay_read_file()::File is truncated");
+    return false;
+  }
+  return true;
+}
+void replay_reset_run(void) {
+  state->mode = REPLAY_MODE_NONE;
+  state->active = false;
+  state->path.clear();
+  state->traits.clear();
+  state->frames.clear();
+  state->choices.clear();
+  state->checksums.clear();
+  state->frame_index = 0u;
+  state->next_choice = 0u;
+  state->next_checksum = 0u;
+  state->stats = replay_stats();
+}
@@ -0,0 +1,65 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "game_types.h"
+
+#define REPLAY_FILE_LOCATION "./replay.irp"
+#define REPLAY_FILE_MAGIC 0x50524E49u // INFO: "INRP"
+#define REPLAY_FILE_VERSION 1u
+#define REPLAY_CHECKSUM_INTERVAL 60u // INFO: In updates, see replay_end_update()
+
+typedef enum replay_mode {
+  REPLAY_MODE_NONE,
+  REPLAY_MODE_RECORD,
+  REPLAY_MODE_PLAYBACK,
+  REPLAY_MODE_MAX,
+} replay_mode;
+
+typedef struct replay_stats {
+  u64 seed;
+  i32 map_id;
+  u32 frame_count;
+  u32 frames_played;
+  u32 checksum_count;
+  u32 checksum_mismatch_count;
+  i32 first_divergent_frame;
+  replay_stats(void) {
+    this->seed = 0u;
+    this->map_id = 0;
+    this->frame_count = 0u;
+    this->frames_played = 0u;
+    this->checksum_count = 0u;
+    this->checksum_mismatch_count = 0u;
+    this->first_divergent_frame = -1;
+  }
+} replay_stats;
+
+[[__nodiscard__]] bool replay_system_initialize(void);
+
+/**
+ * @brief Arming takes effect on the next gm_init_game(). Recording reseeds the random streams there and keeps the seed,
+ * @brief playback loads the file now and replaces the seed, the traits and the starter ability of the run with the recorded ones.
+ */
+bool replay_arm_recording(const char * path);
+bool replay_arm_playback(const char * path);
+void replay_disarm(void);
+
+replay_mode replay_get_mode(void);
+bool replay_is_playing(void);
+const replay_stats * replay_get_stats(void);
+
+/**
+ * @brief Hooks of the game manager. A frame is one update_game_manager() call, with the recorded tick count and input of that call.
+ */
+bool replay_begin_game(worldmap_stage& stage, std::vector<character_trait>& traits, ability_id& starter_ability);
+void replay_begin_update(void);
+u32 replay_resolve_tick_count(u32 tick_count);
+void replay_end_update(void);
+void replay_record_ability_choice(ability_id id, bool is_new);
+
+/**
+ * @brief Writes the recording, or reports the playback. Either way the replay is disarmed afterwards.
+ */
+bool replay_finish(void);
+
+#endif
@@ -2,9 +2,30 @@
 #include <core/fmemory.h>
 #include <core/logger.h>
 
+#include <core/fjob.h>
 #include <tools/pak_parser.h>
 #include <game/spritesheet.h>
 
+/**
+ * @brief Decoded on a worker, uploaded on the main thread by resource_flush_decode_requests()
+ */
+typedef struct resource_decode_request {
+  const file_buffer * file;
+  texture_id tex_id;
+  image_type img_type;
+  Vector2 new_size;
+  bool resize;
+  Image decoded;
+  resource_decode_request(void) {
+    this->file = nullptr;
+    this->tex_id = TEX_ID_UNSPECIFIED;
+    this->img_type = IMAGE_TYPE_UNSPECIFIED;
+    this->new_size = ZEROVEC2;
+    this->resize = false;
+    this->decoded = ZERO_IMAGE;
+  }
+} resource_decode_request;
+
 typedef struct resource_system_state {
   std::array<Texture2D, TEX_ID_MAX> textures;
   std::array<atlas_texture, ATLAS_TEX_ID_MAX> atlas_textures;
@@ -25,6 +46,8 @@ typedef struct resource_system_state {
   std::vector<tilemap_prop_static> tilemap_props_buildings;
   std::vector<tilemap_prop_sprite> tilemap_props_sprite;
 
+  std::vector<resource_decode_request> decode_requests;
+
   i32 next_prop_id {};
   resource_system_state(void) {
     this->textures.fill(Texture2D {0u, 0, 0, 0, 0});
@@ -42,13 +65,17 @@ void load_texture_disk(const char * _path, bool resize, Vector2 new_size, textur
 bool load_image_disk(const char * _path, bool resize, Vector2 new_size, image_type type);
 #endif
 
+void resource_flush_decode_requests(void);
+void resource_decode_job(u32 job_index, void* user_data);
+Texture2D resource_upload_texture(Image img);
+
 void load_texture_from_atlas(atlas_texture_id _id, Rectangle texture_area);
 void load_spritesheet(texture_id _source_tex, spritesheet_id handle_id, Vector2 offset, i32 _fps, i32 _frame_width, i32 _frame_height, i32 _total_row, i32 _total_col);
 void load_tilesheet(tilesheet_type _sheet_sheet_type, atlas_texture_id _atlas_tex_id, i32 _tile_count_x, i32 _tile_count_y, i32 _tile_size);
 
 bool resource_system_initialize(void) {
   if (state and state != nullptr) return false;
-  state = (resource_system_state*)allocate_memory_linear(sizeof(resource_system_state), true);
+  state = (resource_system_state*)allocate_memory_linear(sizeof(resource_system_state), true, MEMORY_TAG_RESOURCE);
   if (not state or state == nullptr) {
     IERROR("resource::allocate_memory_linear()::State allocation failed");
     return false;
@@ -106,6 +133,7 @@ bool resource_system_initialize(void) {
   load_texture_pak(PAK_FILE_ASSET1, PAK_FILE_SIGIL_TOTAL_TRAIT_POINT,          false, VECTOR2(0.f, 0.f), TEX_ID_SIGIL_TOTAL_TRAIT_POINT,);
   load_texture_pak(PAK_FILE_ASSET1, PAK_FILE_SIGIL_VITAL_SIGIL_EFFECTIVENESS,  false, VECTOR2(0.f, 0.f), TEX_ID_SIGIL_VITAL_SIGIL_EFFECTIVENESS,);
 
+  resource_flush_decode_requests();
   #else
 
     load_texture_disk("atlas.png", false, VECTOR2(0.f, 0.f), TEX_ID_ASSET_ATLAS);
@@ -729,9 +757,11 @@ bool resource_system_initialize(void) {
     // Sprites
   }
 
+  #if not HEADLESS_BUILD
   SetTextureFilter(state->textures.at(TEX_ID_ASSET_ATLAS), TEXTURE_FILTER_POINT);
   SetTextureFilter(state->textures.at(TEX_ID_GAME_START_LOADING_SCREEN), TEXTURE_FILTER_ANISOTROPIC_16X);
   SetTextureFilter(state->textures.at(TEX_ID_WORLDMAP_WO_CLOUDS), TEXTURE_FILTER_ANISOTROPIC_16X);
+  #endif
 
   return true;
 }
@@ -790,21 +820,18 @@ void load_texture_pak([[__maybe_unused__]] pak_file_id pak_id, [[__maybe_unused_
     IWARN("resource::load_texture_pak()::texture type out of bound");
     return;
   }
-  Texture2D tex = ZERO_TEXTURE;
-
+  // INFO: Pak lookups are not thread safe, so the file is resolved here and only decoding is deferred
   const file_buffer * const file = get_asset_file_buffer(pak_id, file_id);
   if (not file or file == nullptr or not file->is_success) {
     IERROR("resource::load_texture_pak()::File id %d does not exist", file_id);
     return;
   }
-  Image img = LoadImageFromMemory(file->file_extension.c_str(), reinterpret_cast<const u8*>(file->content.data()), file->content.size());
-  if (resize) {
-    ImageResize(&img, new_size.x, new_size.y);
-  }
-  tex = LoadTextureFromImage(img);
-  UnloadImage(img);
-  
-  state->textures.at(_id) = tex;
+  resource_decode_request request = resource_decode_request();
+  request.file = file;
+  request.tex_id = _id;
+  request.resize = resize;
+  request.new_size = new_size;
+  state->decode_requests.push_back(request);
   #endif
 }
 bool load_image_pak(
@@ -815,24 +842,74 @@ bool load_image_pak(
     IWARN("resource::load_image_pak()::Image type out of bound");
     return false;
   }
-  Image img = ZERO_IMAGE;
-
   const file_buffer * const file = get_asset_file_buffer(pak_id, file_id);
   if (not file or file == nullptr or not file->is_success) {
     IERROR("resource::load_image_pak()::File:%d does not exist", file_id);
     return false;
   }
-  img = LoadImageFromMemory(file->file_extension.c_str(), reinterpret_cast<const u8 *>(file->content.data()), file->content.size());
-  if (resize) {
-    ImageResize(&img, new_size.x, new_size.y);
-  }
-  
-  state->images.at(type) = img;
+  resource_decode_request request = resource_decode_request();
+  request.file = file;
+  request.img_type = type;
+  request.resize = resize;
+  request.new_size = new_size;
+  state->decode_requests.push_back(request);
   return true;
   #else
     return false;
   #endif
 }
+/**
+ * @brief Decodes every queued request over the job system, then uploads them one by one on the calling thread
+ */
+void resource_flush_decode_requests(void) {
+  if (state->decode_requests.empty()) {
+    return;
+  }
+  const f64 decode_begin = GetTime();
+  job_dispatch(static_cast<u32>(state->decode_requests.size()), resource_decode_job, __builtin_addressof(state->decode_requests));
+  const f64 decode_end = GetTime();
+
+  for (resource_decode_request& request : state->decode_requests) {
+    if (not request.decoded.data or request.decoded.data == nullptr) {
+      IERROR("resource::resource_flush_decode_requests()::File id %d cannot be decoded", request.file->file_id);
+      continue;
+    }
+    if (request.tex_id > TEX_ID_UNSPECIFIED and request.tex_id < TEX_ID_MAX) {
+      state->textures.at(request.tex_id) = resource_upload_texture(request.decoded);
+      UnloadImage(request.decoded);
+    }
+    else if (request.img_type > IMAGE_TYPE_UNSPECIFIED and request.img_type < IMAGE_TYPE_MAX) {
+      state->images.at(request.img_type) = request.decoded;
+    }
+    request.decoded = ZERO_IMAGE;
+  }
+  IINFO("resource::resource_flush_decode_requests()::%zu images decoded in %.2f ms, uploaded in %.2f ms", 
+    state->decode_requests.size(), (decode_end - decode_begin) * 1000.0, (GetTime() - decode_end) * 1000.0
+  );
+  state->decode_requests.clear();
+  state->decode_requests.shrink_to_fit();
+}
+/**
+ * @brief CPU only, runs on workers. Must not log or touch the pak parser.
+ */
+void resource_decode_job(u32 job_index, void* user_data) {
+  std::vector<resource_decode_request>& requests = *static_cast<std::vector<resource_decode_request>*>(user_data);
+  resource_decode_request& request = requests.at(job_index);
+
+  request.decoded = LoadImageFromMemory(
+    request.file->file_extension.c_str(), reinterpret_cast<const u8 *>(request.file->content.data()), static_cast<i32>(request.file->content.size())
+  );
+  if (request.resize and request.decoded.data and request.decoded.data != nullptr) {
+    ImageResize(&request.decoded, request.new_size.x, request.new_size.y);
+  }
+}
+Texture2D resource_upload_texture(Image img) {
+  #if HEADLESS_BUILD
+    return Texture2D {0u, img.width, img.height, img.mipmaps, img.format};
+  #else
+    return LoadTextureFromImage(img);
+  #endif
+}
 void load_texture_disk(
   [[__maybe_unused__]] const char * _path, [[__maybe_unused__]] bool resize, [[__maybe_unused__]] Vector2 new_size, [[__maybe_unused__]] texture_id _id
 ) {
@@ -6,6 +6,11 @@
 
 bool resource_system_initialize(void);
 
+/**
+ * @brief Main thread only. Stubbed in headless builds, the texture keeps the image size but has no GPU handle.
+ */
+Texture2D resource_upload_texture(Image img);
+
 const char* rs_path(const char *filename);
 const char* map_layer_path(const char *filename);
 const atlas_texture* get_atlas_texture_by_enum(atlas_texture_id _id);
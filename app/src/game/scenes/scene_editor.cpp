@@ -164,7 +164,7 @@ void se_begin_fadein(data128 data, void(*on_change_complete)(ui_fade_type, data1
   if (state and state != nullptr) {
     return begin_scene_editor(fade_in);
   }
-  state = (scene_editor_state*)allocate_memory_linear(sizeof(scene_editor_state), true);
+  state = (scene_editor_state*)allocate_memory_linear(sizeof(scene_editor_state), true, MEMORY_TAG_SCENE);
   if (not state or state == nullptr) {
     IERROR("scene_editor::initialize_scene_editor()::State allocation failed!");
     return false;
@@ -953,6 +953,7 @@ constexpr void editor_update_mouse_bindings(void) {
         if (state->b_dragging_map_element) {
           prop->dest.x = state->mouse_pos_world.x;
           prop->dest.y = state->mouse_pos_world.y;
+          _refresh_prop_bounds_cur_map(prop);
         }
         break;
       }
@@ -971,6 +972,7 @@ constexpr void editor_update_mouse_bindings(void) {
           prop->sprite.coord.x = state->mouse_pos_world.x;
           prop->sprite.coord.y = state->mouse_pos_world.y;
           state->selected_prop_sprite_map_prop_address->sprite.coord = prop->sprite.coord;
+          _refresh_prop_bounds_cur_map(prop);
         }
         break;
       }
@@ -1168,7 +1170,7 @@ constexpr bool scene_editor_scale_slider_on_left_button_trigger(void) {
   if (state->selected_prop_static_map_prop_address != nullptr) {
     tilemap_prop_static *const map_prop_ptr = state->selected_prop_static_map_prop_address;
     map_prop_ptr->scale -= .15f;
-    
+    _refresh_prop_bounds_cur_map(map_prop_ptr);
     return true;
   }
   if (state->selected_prop_sprite_map_prop_address != nullptr) {
@@ -1179,6 +1181,7 @@ constexpr bool scene_editor_scale_slider_on_left_button_trigger(void) {
     map_prop_ptr->sprite.coord.height = map_prop_ptr->sprite.current_frame_rect.height * map_prop_ptr->scale;
     map_prop_ptr->sprite.origin.x = map_prop_ptr->sprite.coord.width  * .5f;
     map_prop_ptr->sprite.origin.y = map_prop_ptr->sprite.coord.height * .5f;
+    _refresh_prop_bounds_cur_map(map_prop_ptr);
     return true;
   }
 
@@ -1192,6 +1195,7 @@ constexpr bool scene_editor_scale_slider_on_right_button_trigger(void) {
   if (state->selected_prop_static_map_prop_address != nullptr) {
     tilemap_prop_static *const map_prop_ptr = state->selected_prop_static_map_prop_address;
     map_prop_ptr->scale += .15f;
+    _refresh_prop_bounds_cur_map(map_prop_ptr);
     return true;
   }
   if (state->selected_prop_sprite_map_prop_address != nullptr) {
@@ -1202,6 +1206,7 @@ constexpr bool scene_editor_scale_slider_on_right_button_trigger(void) {
     map_prop_ptr->sprite.coord.height = map_prop_ptr->sprite.current_frame_rect.height * map_prop_ptr->scale;
     map_prop_ptr->sprite.origin.x = map_prop_ptr->sprite.coord.width  * .5f;
     map_prop_ptr->sprite.origin.y = map_prop_ptr->sprite.coord.height * .5f;
+    _refresh_prop_bounds_cur_map(map_prop_ptr);
     return true;
   }
 
@@ -8,12 +8,15 @@
 #include "core/event.h"
 #include "core/fmemory.h"
 #include "core/ftime.h"
+#include "core/frandom.h"
 #include "core/logger.h"
 
 #include "game/game_manager.h"
+#include "game/replay.h"
 #include "game/user_interface.h"
 #include "game/world.h"
 #include "game/camera.h"
+#include "game/spritesheet.h"
 
 enum sig_ingame_state {
   SCENE_INGAME_STATE_UNDEFINED,
@@ -191,7 +194,7 @@ void start_game(void);
   if (state and state != nullptr) {
     return begin_scene_in_game(fade_in);
   }
-  state = (scene_in_game_state *)allocate_memory_linear(sizeof(scene_in_game_state), true);
+  state = (scene_in_game_state *)allocate_memory_linear(sizeof(scene_in_game_state), true, MEMORY_TAG_SCENE);
   if (not state or state == nullptr) {
     IERROR("scene_in_game::initialize_scene_in_game()::State allocation failed!");
     return false;
@@ -371,8 +374,12 @@ void update_scene_in_game(void) {
           break; 
         }
         case INGAME_PLAY_PHASE_CLEAR_ZOMBIES: {
-          if (not state->in_ingame_info->player_state_dynamic->is_player_have_ability_upgrade_points) {
-            const Vector2& player_pos = state->in_ingame_info->player_state_dynamic->position;
+          if (not state->in_ingame_info->player_state_dynamic->is_player_have_ability_upgrade_points or replay_is_playing()) { // INFO: Playback applies the recorded choice itself
+            update_map( delta_time_ingame() );
+            update_game_manager();
+
+            const player_state& player = (*state->in_ingame_info->player_state_dynamic);
+            const Vector2 player_pos = vec2_lerp(player.previous_position, player.position, get_simulation_alpha());
             const Rectangle& cam_bounds = state->cam_bounds;
             const Vector2 frustum_half = Vector2 { state->in_camera_metrics->frustum.width * .5f, state->in_camera_metrics->frustum.height * .5f };
             Vector2 cam_target = { player_pos.x, player_pos.y };
@@ -381,8 +388,6 @@ void update_scene_in_game(void) {
               Vector2 { cam_bounds.width - frustum_half.x, cam_bounds.height - frustum_half.y }  // Map right down 
             );
             event_fire(EVENT_CODE_CAMERA_SET_TARGET, event_context(cam_target.x, cam_target.y));
-            update_map( (*state->in_ingame_info->delta_time) );
-            update_game_manager();
           }
           break;
         }
@@ -426,7 +431,6 @@ void render_scene_in_game(void) {
     render_map();
     const f32 f32_bottom_of_the_screen = state->in_camera_metrics->frustum.y + state->in_camera_metrics->frustum.height;
     const f32 f32_top_of_the_screen    = state->in_camera_metrics->frustum.y;
-    const f32 f32_player_texture_begin = state->in_ingame_info->player_state_dynamic->collision.y + state->in_ingame_info->player_state_dynamic->collision.height;
 
     const i32 bottom_of_the_screen = static_cast<i32>(
       std::clamp(f32_bottom_of_the_screen, static_cast<f32>(std::numeric_limits<i32>::min()), static_cast<f32>(std::numeric_limits<i32>::max()))
@@ -434,13 +438,11 @@ void render_scene_in_game(void) {
     const i32 top_of_the_screen    = static_cast<i32>(
       std::clamp(f32_top_of_the_screen, static_cast<f32>(std::numeric_limits<i32>::min()), static_cast<f32>(std::numeric_limits<i32>::max()))
     );
-    const i32 player_texture_begin = static_cast<i32>(
-      std::clamp(f32_player_texture_begin, static_cast<f32>(std::numeric_limits<i32>::min()), static_cast<f32>(std::numeric_limits<i32>::max()))
-    );
-    
-    _render_props_y_based(top_of_the_screen, player_texture_begin);
+    // INFO: Y-based props, player, spawns and projectiles go into one batch, its scene layer draws them by depth in one pass
+    sprite_batch_begin();
+    _render_props_y_based(top_of_the_screen, bottom_of_the_screen);
     render_game();
-    _render_props_y_based(player_texture_begin, bottom_of_the_screen);
+    sprite_batch_flush();
 
     switch ( (*state->in_ingame_info->ingame_phase) ) {
       case INGAME_PLAY_PHASE_IDLE: { break; }
@@ -518,7 +520,7 @@ void render_interface_in_game(void) {
       switch ( (*state->in_ingame_info->ingame_phase) ) {
         case INGAME_PLAY_PHASE_IDLE: { break; }
         case INGAME_PLAY_PHASE_CLEAR_ZOMBIES: {
-          if (get_b_player_have_upgrade_points()) {
+          if (get_b_player_have_upgrade_points() and not replay_is_playing()) {
             if (state->is_upgrade_choices_ready) {
               Rectangle dest = Rectangle {SIG_BASE_RENDER_WIDTH * .25f, SIG_BASE_RENDER_HEIGHT * .5f, SIG_BASE_RENDER_WIDTH * .25f, SIG_BASE_RENDER_HEIGHT * .5f };
               f32 dest_x_buffer = dest.x;
@@ -572,7 +574,9 @@ void render_interface_in_game(void) {
         WHITE, false, false, "world_pos {%.1f, %.1f}", state->in_ingame_info->mouse_pos_world->x, state->in_ingame_info->mouse_pos_world->y
       );
       if(static_cast<size_t>(state->hovered_spawn) < state->in_ingame_info->in_spawns->size()){
-          const Character2D *const spawn = __builtin_addressof(state->in_ingame_info->in_spawns->at(state->hovered_spawn));
+          const spawn_data_soa *const spawns = state->in_ingame_info->in_spawns;
+          const size_t spw_index = static_cast<size_t>(state->hovered_spawn);
+          const Rectangle& spw_collision = spawns->collision.at(spw_index);
           panel *const pnl = __builtin_addressof(state->debug_info_panel);
           pnl->dest = Rectangle { mouse_pos_screen.x, mouse_pos_screen.y,  SIG_BASE_RENDER_WIDTH * .4f, SIG_BASE_RENDER_HEIGHT * .3f};
           i32 font_size = 1;
@@ -584,32 +588,32 @@ void render_interface_in_game(void) {
           {
             gui_label_format(
               FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-              WHITE, false, false, "Id: %d", spawn->character_id
+              WHITE, false, false, "Id: %d", spawns->character_id.at(spw_index)
             );
             debug_info_position_buffer.y += line_height;
             gui_label_format(
               FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-              WHITE, false, false, "Collision: {%.1f, %.1f, %.1f, %.1f}", spawn->collision.x, spawn->collision.y, spawn->collision.width, spawn->collision.height
+              WHITE, false, false, "Collision: {%.1f, %.1f, %.1f, %.1f}", spw_collision.x, spw_collision.y, spw_collision.width, spw_collision.height
             );
             debug_info_position_buffer.y += line_height;
             gui_label_format(
               FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-              WHITE, false, false, "Position: {%.1f, %.1f}", spawn->position.x, spawn->position.y
+              WHITE, false, false, "Position: {%.1f, %.1f}", spawns->position.at(spw_index).x, spawns->position.at(spw_index).y
             );
             debug_info_position_buffer.y += line_height;
             gui_label_format(
               FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-              WHITE, false, false, "Health: %d", spawn->health_current
+              WHITE, false, false, "Health: %d", spawns->stats.at(spw_index).health_current
             );
             debug_info_position_buffer.y += line_height;
             gui_label_format(
               FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-              WHITE, false, false, "Scale: %.1f", spawn->scale
+              WHITE, false, false, "Scale: %.1f", spawns->stats.at(spw_index).scale
             );
             debug_info_position_buffer.y += line_height;
             gui_label_format(
               FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-              WHITE, false, false, "Speed: %.1f", spawn->speed
+              WHITE, false, false, "Speed: %.1f", spawns->speed.at(spw_index)
             );
           }
           EndScissorMode();
@@ -624,20 +628,22 @@ void render_interface_in_game(void) {
           i32 font_size = 1;
           i32 line_height = SIG_BASE_RENDER_HEIGHT * .05f;
           Vector2 debug_info_position_buffer = VECTOR2(pnl->dest.x, pnl->dest.y);
-          if (state->hovered_projectile >= 0 && static_cast<size_t>(state->hovered_projectile) < abl->projectiles.size()) {
-            const projectile* const prj = __builtin_addressof(abl->projectiles.at(state->hovered_projectile));
+          if (state->hovered_projectile >= 0 && state->hovered_projectile < abl->proj_slot_count) {
+            const projectile_data_soa& prjs = _get_projectile_pool();
+            const size_t slot = abl->proj_slot_begin() + static_cast<size_t>(state->hovered_projectile);
+            const Rectangle& collision = prjs.collision.at(slot);
 
             gui_panel((*pnl), pnl->dest, false);
             BeginScissorMode(pnl->dest.x, pnl->dest.y, pnl->dest.width, pnl->dest.height);
             {
               gui_label_format(
                 FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-                WHITE, false, false, "Collision: {%.1f, %.1f, %.1f, %.1f}", prj->collision.x, prj->collision.y, prj->collision.width, prj->collision.height
+                WHITE, false, false, "Collision: {%.1f, %.1f, %.1f, %.1f}", collision.x, collision.y, collision.width, collision.height
               );
               debug_info_position_buffer.y += line_height;
               gui_label_format(
                 FONT_TYPE_REGULAR, font_size, debug_info_position_buffer.x, debug_info_position_buffer.y, 
-                WHITE, false, false, "Rotation: %.1f", prj->animations.at(prj->active_sprite).rotation
+                WHITE, false, false, "Rotation: %.1f", prjs.draw_state.at(slot).rotation
               );
             }
             EndScissorMode();
@@ -704,8 +710,7 @@ void in_game_update_mouse_bindings(void) {
       size_t _remaining_enemies = state->in_ingame_info->in_spawns->size();
 
       for (size_t itr_000 = 0u; itr_000 < _remaining_enemies; ++itr_000) {
-        const Character2D *const spawn = __builtin_addressof(state->in_ingame_info->in_spawns->at(itr_000));
-        if (spawn and CheckCollisionPointRec( (*mouse_pos_world), spawn->collision)) {
+        if (CheckCollisionPointRec( (*mouse_pos_world), state->in_ingame_info->in_spawns->collision.at(itr_000))) {
           state->hovered_spawn = itr_000;
         }
       }
@@ -713,15 +718,16 @@ void in_game_update_mouse_bindings(void) {
       state->hovered_ability = ABILITY_ID_UNDEFINED;
       state->hovered_projectile = I32_MAX;
 
+      const projectile_data_soa& prjs = _get_projectile_pool();
       for (size_t itr_000 = 0u; itr_000 < player->ability_system.abilities.size(); ++itr_000) {
         const ability *const abl = __builtin_addressof(player->ability_system.abilities.at(itr_000));
         if(not abl or abl == nullptr or not abl->is_active or not abl->is_initialized) { continue; }
 
-        for (size_t itr_111 = 0u; itr_111 < abl->projectiles.size(); itr_111++) {
-          const projectile *const prj = __builtin_addressof(abl->projectiles.at(itr_111));
-          if (not prj or prj == nullptr or not prj->is_active) { continue; }
+        for (size_t itr_111 = 0u; itr_111 < static_cast<size_t>(abl->proj_slot_count); itr_111++) {
+          const size_t slot = abl->proj_slot_begin() + itr_111;
+          if (not prjs.has_flag(slot, PROJECTILE_FLAG_ACTIVE)) { continue; }
 
-          if (CheckCollisionPointRec( (*mouse_pos_world), prj->collision)) {
+          if (CheckCollisionPointRec( (*mouse_pos_world), prjs.collision.at(slot))) {
             state->hovered_ability = abl->id;
             state->hovered_projectile = itr_111;
             break;
@@ -1031,7 +1037,7 @@ void prepare_ability_upgrade_state(void) {
   for (size_t itr_000 = 0u; itr_000 < MAX_UPDATE_ABILITY_PANEL_COUNT; ++itr_000) {
     panel& pnl = state->ability_upg_panels.at(itr_000);
     if(pnl.buffer.u16[0] <= 0 or pnl.buffer.u16[0] >= ABILITY_ID_MAX) {
-      pnl.buffer.u16[0] = get_random(ABILITY_ID_UNDEFINED + 1, ABILITY_ID_MAX - 1);
+      pnl.buffer.u16[0] = random_range(RANDOM_STREAM_UI, ABILITY_ID_UNDEFINED + 1, ABILITY_ID_MAX - 1); // INFO: Offer is not replayed, only the choice is
     }
     if (pnl.buffer.u16[0] < 0 or pnl.buffer.u16[0] >= state->in_ingame_info->player_state_dynamic->ability_system.abilities.size()) {
       continue;
@@ -1055,7 +1061,10 @@ void prepare_ability_upgrade_state(void) {
 void end_ability_upgrade_state(u16 which_panel_chosen) {
   const ability *const new_ability = __builtin_addressof(state->ability_upgrade_choices.at(which_panel_chosen));
 
-  if (new_ability->level >= MAX_ABILITY_LEVEL or new_ability->level < 1) {
+  const bool is_new = new_ability->level >= MAX_ABILITY_LEVEL or new_ability->level < 1;
+  replay_record_ability_choice(new_ability->id, is_new);
+
+  if (is_new) {
     _add_ability(new_ability->id);
   }
   else {
@@ -1179,7 +1188,7 @@ void sig_update_chest_sequence(void) {
   chest_opening_sequence_control& seq = state->chest_intro_ctrl;
   switch (seq.sequence) {
     case seq.CHEST_OPENING_SEQUENCE_CHEST_IN: {
-      seq.accumulator += (*state->in_ingame_info->delta_time);
+      seq.accumulator += delta_time_ingame();
       if (seq.accumulator > seq.duration) {
         seq.accumulator = seq.duration;
       }
@@ -1208,7 +1217,7 @@ void sig_update_chest_sequence(void) {
     }
     case seq.CHEST_OPENING_SEQUENCE_CHEST_OPEN: {
       if (not seq.sheet_chest.is_played) {
-        ui_update_sprite(seq.sheet_chest, (*state->in_ingame_info->delta_time) );
+        ui_update_sprite(seq.sheet_chest, delta_time_ingame() );
         return;
       }
       else {
@@ -1218,7 +1227,7 @@ void sig_update_chest_sequence(void) {
     }
     case seq.CHEST_OPENING_SEQUENCE_READY: {
       if(seq.accumulator < seq.duration) {
-        seq.accumulator += (*state->in_ingame_info->delta_time );
+        seq.accumulator += delta_time_ingame();
         return;
       }
       if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) {
@@ -1228,7 +1237,7 @@ void sig_update_chest_sequence(void) {
     }
     case seq.CHEST_OPENING_SEQUENCE_SPIN: {
       if(seq.accumulator < seq.duration) {
-        seq.accumulator += (*state->in_ingame_info->delta_time);
+        seq.accumulator += delta_time_ingame();
       }
       else if (seq.accumulator > seq.duration) {
         seq.accumulator = seq.duration;
@@ -1239,20 +1248,20 @@ void sig_update_chest_sequence(void) {
       seq.mm_ex.f32[0] += EaseSineInOut(
         seq.accumulator, 
         0.f,
-        (*state->in_ingame_info->delta_time) * (*state->in_ingame_info->game_rules)[GAME_RULE_CHEST_SCROLL_SPEED].mm_ex.f32[3], 
+        delta_time_ingame() * (*state->in_ingame_info->game_rules)[GAME_RULE_CHEST_SCROLL_SPEED].mm_ex.f32[3], 
         seq.duration
       );
       return;
     }
     case seq.CHEST_OPENING_SEQUENCE_RESULT: {
       if(seq.accumulator < seq.duration) {
-        seq.accumulator += (*state->in_ingame_info->delta_time);
+        seq.accumulator += delta_time_ingame();
       }
       else if (seq.accumulator > seq.duration) {
         seq.accumulator = seq.duration;
       }
       seq.mm_ex.f32[1] = EaseSineInOut(seq.accumulator, seq.mm_ex.f32[0], -seq.mm_ex.f32[2], seq.duration);
-      ui_update_sprite(seq.sheets_background.at(0), (*state->in_ingame_info->delta_time) );
+      ui_update_sprite(seq.sheets_background.at(0), delta_time_ingame() );
       return;
     }
     default: {
@@ -1367,7 +1376,7 @@ void sig_populate_the_chest_for_chest_seq(std::vector<item_type>& item_tex_to_sc
   //const std::array<item_data, ITEM_TYPE_MAX>& _defaults = gm_get_default_items(); 
 
   for (i32 itr_000 = 0; itr_000 < GM_ITEM_COUNT_CHESTS_SCROLL ; itr_000++) {
-    i32 rand_index = static_cast<i32>(get_random_ssl(M_ITEM_TYPE_COMMON_SIGIL_START, M_ITEM_TYPE_SIGIL_END));
+    i32 rand_index = static_cast<i32>(random_range(RANDOM_STREAM_LOOT, M_ITEM_TYPE_COMMON_SIGIL_START, M_ITEM_TYPE_SIGIL_END));
     rand_index = std::clamp(rand_index, static_cast<i32>(M_ITEM_TYPE_COMMON_SIGIL_START), static_cast<i32>(M_ITEM_TYPE_SIGIL_END));
     texs.push_back(static_cast<item_type>(rand_index));
   }
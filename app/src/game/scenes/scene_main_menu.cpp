@@ -279,7 +279,7 @@ void chosen_trait_button_on_click(i32 index);
   if (state and state != nullptr) {
     return begin_scene_main_menu(fade_in);
   }
-  state = (main_menu_scene_state *)allocate_memory_linear(sizeof(main_menu_scene_state), true);
+  state = (main_menu_scene_state *)allocate_memory_linear(sizeof(main_menu_scene_state), true, MEMORY_TAG_SCENE);
   if (not state or state == nullptr) {
     IERROR("scene_main_menu::initialize_scene_main_menu()::State allocation failed");
     return false;
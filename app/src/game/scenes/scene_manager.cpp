@@ -3,6 +3,7 @@
 
 #include "core/event.h"
 #include "core/fmemory.h"
+#include "core/fprofiler.h"
 #include "core/logger.h"
 
 #include "game/scenes/scene_in_game.h"
@@ -29,7 +30,7 @@ bool scene_manager_initialize(const app_settings * _in_app_settings) {
   if (state and state != nullptr) {
     return scene_manager_reinit();
   }
-  state = (scene_manager_system_state *)allocate_memory_linear(sizeof(scene_manager_system_state), true);
+  state = (scene_manager_system_state *)allocate_memory_linear(sizeof(scene_manager_system_state), true, MEMORY_TAG_SCENE);
   if (not state or state == nullptr) {
     IERROR("scene_manager::scene_manager_initialize()::State allocation failed");
     return false;
@@ -52,6 +53,7 @@ bool scene_manager_reinit(void) {
 }
 
 void update_scene_scene(void) {
+  PROFILE_FUNCTION();
   switch (state->scene_data) {
     case SCENE_TYPE_MAIN_MENU: update_scene_main_menu();     break;
     case SCENE_TYPE_IN_GAME:   update_scene_in_game();       break;
@@ -63,6 +65,7 @@ void update_scene_scene(void) {
   }
 }
 void render_scene_world(void) {
+  PROFILE_FUNCTION();
   switch (state->scene_data) {
     case SCENE_TYPE_MAIN_MENU: render_scene_main_menu();     break;
     case SCENE_TYPE_IN_GAME:   render_scene_in_game();       break;
@@ -74,6 +77,7 @@ void render_scene_world(void) {
   }
 }
 void render_scene_interface(void) {
+  PROFILE_FUNCTION();
   switch (state->scene_data) {
     case SCENE_TYPE_IN_GAME:   render_interface_in_game();   break;
     case SCENE_TYPE_MAIN_MENU: render_interface_main_menu(); break;
@@ -1,14 +1,18 @@
 #include "spawn.h"
-#include <unordered_map>
+#include <tuple>
+#include <algorithm>
 
 #include "core/event.h"
+#include "core/fjob.h"
 #include "core/fmath.h"
 #include "core/fmemory.h"
+#include "core/fprofiler.h"
 #include "core/logger.h"
 #include "core/ftime.h"
+#include "core/frandom.h"
 
 #include "spritesheet.h"
-#include "fshader.h"
+#include "tilemap.h"
 #include <cmath>
 
 constexpr i32 SPAWN_ID_NEXT_START = 1;
@@ -23,7 +27,7 @@ constexpr i32 SPAWN_BASE_SPEED = 50;
 const f32 MAP_X = -3000.0f;
 const f32 MAP_Y = -3000.0f; // Assuming square bounds
 const f32 MAP_WIDTH = 6000.0f;  // Total width (-3000 to 3000)
-const f32 MAP_HEIGHT = 6000.0f; 
+const f32 MAP_HEIGHT = 6000.0f;
 
 #define SPAWN_SCALE_INCREASE_BY_LEVEL(LEVEL) LEVEL * .1
 
@@ -31,74 +35,259 @@ const f32 MAP_HEIGHT = 6000.0f;
 #define SPAWN_DAMAGE_CURVE(LEVEL, SCALE, TYPE) (SPAWN_BASE_DAMAGE + (SPAWN_BASE_DAMAGE * ((SCALE * 0.45f) + (LEVEL * 0.55f) + (TYPE * 0.35f)) * level_curve[LEVEL] * 0.002f))
 #define SPAWN_SPEED_CURVE(LEVEL, SCALE, TYPE)  (SPAWN_BASE_SPEED + ((SPAWN_BASE_SPEED * (LEVEL + (LEVEL * 0.2f)) + (TYPE + (TYPE * 0.25f))) / SCALE))
 
-#define GET_SPW_EXP(CHARACTER)  level_curve[CHARACTER->buffer.i32[1]] * (static_cast<f32>(CHARACTER->type) / static_cast<f32>(SPAWN_TYPE_MAX)) * (CHARACTER->scale / SPAWN_RND_SCALE_MAX)
-#define GET_SPW_COIN(CHARACTER) level_curve[CHARACTER->buffer.i32[1]] * (static_cast<f32>(CHARACTER->type) / static_cast<f32>(SPAWN_TYPE_MAX)) * (CHARACTER->scale / SPAWN_RND_SCALE_MAX)
+#define GET_SPW_EXP(STATS)  level_curve[STATS.buffer.i32[1]] * (static_cast<f32>(STATS.type) / static_cast<f32>(SPAWN_TYPE_MAX)) * (STATS.scale / SPAWN_RND_SCALE_MAX)
+#define GET_SPW_COIN(STATS) level_curve[STATS.buffer.i32[1]] * (static_cast<f32>(STATS.type) / static_cast<f32>(SPAWN_TYPE_MAX)) * (STATS.scale / SPAWN_RND_SCALE_MAX)
 
-struct SpatialGrid1D {
+constexpr size_t SPATIAL_GRID_MAX_PENDING = 64u;
+
+/**
+ * @brief Counting-sort uniform grid. Holds indices into spawn_system_state::spawns, laid out contiguously by cell.
+ * Rebuilt once per frame by rebuild(), indices added in between are kept in 'pending' until the next rebuild.
+ */
+struct SpatialGridFlat {
   i32 cols;
   i32 rows;
   f32 cell_size;
   Vector2 world_origin;
-  std::vector<std::vector<Character2D*>> cells;
-
-  SpatialGrid1D(i32 width, i32 height, f32 size, Vector2 origin) : cols(width), rows(height), cell_size(size), world_origin(origin) {
-    cells.resize(cols * rows);
+  std::vector<u32> cell_start;
+  std::vector<u32> cell_count;
+  std::vector<u32> indices;   // NOTE: Units ordered by cell, ascending inside a cell
+  std::vector<u32> unit_cell; // NOTE: Cell of each unit at the last rebuild
+  std::vector<u32> pending;
+
+  SpatialGridFlat(i32 width, i32 height, f32 size, Vector2 origin) : cols(width), rows(height), cell_size(size), world_origin(origin) {
+    cell_start.resize(static_cast<size_t>(cols * rows) + 1u, 0u);
+    cell_count.resize(static_cast<size_t>(cols * rows), 0u);
+  }
+  void reserve(size_t capacity) {
+    indices.reserve(capacity);
+    unit_cell.reserve(capacity);
+    pending.reserve(SPATIAL_GRID_MAX_PENDING);
   }
   inline i32 get_index(Vector2 pos) const {
     i32 x = static_cast<i32>((pos.x - world_origin.x) / cell_size);
     i32 y = static_cast<i32>((pos.y - world_origin.y) / cell_size);
-    
+
     x = std::max(0, std::min(x, cols - 1));
     y = std::max(0, std::min(y, rows - 1));
 
     return (y * cols) + x;
   }
-  void insert(Character2D* unit) {
-    i32 idx = get_index(unit->position);
-    cells[idx].push_back(unit);
-  }
-  void remove(Character2D* unit, Vector2 current_pos) {
-    i32 idx = get_index(current_pos);
-    std::vector<Character2D*>& bucket = cells[idx];
-    
-    for (size_t i = 0; i < bucket.size(); ++i) {
-      if (bucket[i] == unit) {
-        bucket[i] = bucket.back();
-        bucket.pop_back();
-        return;
-      }
-    }
+  inline const u32 * cell_begin(i32 cell) const {
+    return indices.data() + cell_start[cell];
   }
-  void update(Character2D* unit, Vector2 old_pos) {
-    i32 old_idx = get_index(old_pos);
-    i32 new_idx = get_index(unit->position);
-    if (old_idx != new_idx) {
-      std::vector<Character2D*>& old_bucket = cells[old_idx];
-      for (size_t i = 0; i < old_bucket.size(); ++i) {
-        if (old_bucket[i] == unit) {
-          old_bucket[i] = old_bucket.back();
-          old_bucket.pop_back();
-          break;
-        }
-      }
-      cells[new_idx].push_back(unit);
+  inline const u32 * cell_end(i32 cell) const {
+    return indices.data() + cell_start[cell] + cell_count[cell];
+  }
+  /**
+   * @brief Returns true when the pending list is full and the caller should rebuild.
+   */
+  bool insert(u32 unit) {
+    pending.push_back(unit);
+    return pending.size() >= SPATIAL_GRID_MAX_PENDING;
+  }
+  void rebuild(const std::vector<Vector2>& positions) {
+    const size_t unit_count = positions.size();
+    const size_t cell_total = cell_count.size();
+
+    std::fill(cell_count.begin(), cell_count.end(), 0u);
+    unit_cell.resize(unit_count);
+    indices.resize(unit_count);
+    pending.clear();
+
+    for (size_t itr_000 = 0; itr_000 < unit_count; ++itr_000) {
+      const u32 cell = static_cast<u32>(get_index(positions[itr_000]));
+      unit_cell[itr_000] = cell;
+      cell_count[cell]++;
+    }
+    u32 offset = 0u;
+    for (size_t itr_000 = 0; itr_000 < cell_total; ++itr_000) {
+      cell_start[itr_000] = offset;
+      offset += cell_count[itr_000];
+    }
+    cell_start[cell_total] = offset;
+
+    // INFO: cell_start is used as a write cursor here, then restored below
+    for (size_t itr_000 = 0; itr_000 < unit_count; ++itr_000) {
+      indices[cell_start[unit_cell[itr_000]]++] = static_cast<u32>(itr_000);
+    }
+    for (size_t itr_000 = 0; itr_000 < cell_total; ++itr_000) {
+      cell_start[itr_000] -= cell_count[itr_000];
     }
   }
   void clear() {
-    for (auto& bucket : cells) {
-      bucket.clear(); 
+    std::fill(cell_start.begin(), cell_start.end(), 0u);
+    std::fill(cell_count.begin(), cell_count.end(), 0u);
+    indices.clear();
+    unit_cell.clear();
+    pending.clear();
+  }
+};
+
+constexpr u32 SPAWN_HANDLE_SLOT_BITS = 14u;
+constexpr u32 SPAWN_HANDLE_SLOT_MASK = (1u << SPAWN_HANDLE_SLOT_BITS) - 1u;
+constexpr u32 SPAWN_HANDLE_GENERATION_MASK = 0xFFFFu;
+constexpr u32 SPAWN_HANDLE_INVALID_INDEX = std::numeric_limits<u32>::max();
+
+static_assert(MAX_SPAWN_COUNT <= SPAWN_HANDLE_SLOT_MASK + 1u, "Spawn handle slot bits cannot address MAX_SPAWN_COUNT");
+
+/**
+ * @brief Slot pool behind spawn ids. An id packs a slot and the slot's generation,
+ * so resolving an id is one array lookup and ids of removed spawns fail the generation check.
+ * Generations start at 1, which keeps every live id at or above SPAWN_ID_NEXT_START.
+ */
+struct spawn_handle_pool {
+  std::vector<u32> slot_to_index;
+  std::vector<u16> slot_generation;
+  std::vector<u32> free_slots;
+
+  void reserve(size_t capacity) {
+    slot_to_index.reserve(capacity);
+    slot_generation.reserve(capacity);
+    free_slots.reserve(capacity);
+  }
+  static inline i32 make_id(u32 slot, u16 generation) {
+    return static_cast<i32>((static_cast<u32>(generation) << SPAWN_HANDLE_SLOT_BITS) | slot);
+  }
+  static inline u32 slot_of(i32 id) {
+    return static_cast<u32>(id) & SPAWN_HANDLE_SLOT_MASK;
+  }
+  /**
+   * @brief Returns -1 if every slot is in use.
+   */
+  i32 acquire(u32 dense_index) {
+    u32 slot = 0u;
+    if (not free_slots.empty()) {
+      slot = free_slots.back();
+      free_slots.pop_back();
+    }
+    else if (slot_to_index.size() <= SPAWN_HANDLE_SLOT_MASK) {
+      slot = static_cast<u32>(slot_to_index.size());
+      slot_to_index.push_back(SPAWN_HANDLE_INVALID_INDEX);
+      slot_generation.push_back(1u);
     }
+    else {
+      return -1;
+    }
+    slot_to_index[slot] = dense_index;
+    return make_id(slot, slot_generation[slot]);
+  }
+  void release(i32 id) {
+    const u32 slot = slot_of(id);
+    slot_to_index[slot] = SPAWN_HANDLE_INVALID_INDEX;
+    u16 next_generation = static_cast<u16>((slot_generation[slot] + 1u) & SPAWN_HANDLE_GENERATION_MASK);
+    slot_generation[slot] = (next_generation == 0u) ? 1u : next_generation;
+    free_slots.push_back(slot);
   }
+  inline void relocate(i32 id, u32 dense_index) {
+    slot_to_index[slot_of(id)] = dense_index;
+  }
+  /**
+   * @brief Returns SPAWN_HANDLE_INVALID_INDEX for unknown or stale ids.
+   */
+  inline u32 resolve(i32 id) const {
+    if (id < SPAWN_ID_NEXT_START) {
+      return SPAWN_HANDLE_INVALID_INDEX;
+    }
+    const u32 slot = slot_of(id);
+    const u32 generation = static_cast<u32>(id) >> SPAWN_HANDLE_SLOT_BITS;
+    if (slot >= slot_to_index.size() or slot_generation[slot] != generation) {
+      return SPAWN_HANDLE_INVALID_INDEX;
+    }
+    return slot_to_index[slot];
+  }
+  void clear() {
+    slot_to_index.clear();
+    slot_generation.clear();
+    free_slots.clear();
+  }
+};
+
+constexpr u32 SPAWN_JOB_MIN_UNIT_COUNT = 256u;
+
+typedef enum spawn_move_intent_flag {
+  SPAWN_MOVE_INTENT_NONE    = 0,
+  SPAWN_MOVE_INTENT_APPLY_X = 1 << 0,
+  SPAWN_MOVE_INTENT_APPLY_Y = 1 << 1,
+} spawn_move_intent_flag;
+
+/**
+ * @brief Result of the parallel phase of update_spawns(). Written only by the job that owns the spawn.
+ */
+struct spawn_move_intent {
+  Vector2 position;
+  f32 distance;
+  u8 flags;
+};
+
+struct spawn_intent_job_context {
+  Vector2 player_position;
+  f32 delta_time;
+  f32 follow_distance_sq;
+};
+
+typedef enum spawn_damage_request_type {
+  SPAWN_DAMAGE_REQUEST_UNDEFINED,
+  SPAWN_DAMAGE_REQUEST_BY_ID,
+  SPAWN_DAMAGE_REQUEST_COLLISION,
+  SPAWN_DAMAGE_REQUEST_ROTATED_RECT,
+  SPAWN_DAMAGE_REQUEST_MAX,
+} spawn_damage_request_type;
+
+/**
+ * @brief One queued damage command, kept until resolve_spawn_damage(). Geometry is copied since spawns may move or die before the resolve.
+ */
+struct spawn_damage_request {
+  spawn_damage_request_type type;
+  collision_type coll_type;
+  Rectangle rect;
+  Vector2 origin;
+  f32 rotation;
+  i32 target_id;
+  i32 damage;
+  i32 source;
+};
+
+/**
+ * @brief Spawn that a request touched. Order is the position of the hit in the frame, hits are applied in that order.
+ */
+struct spawn_damage_hit {
+  u32 index;
+  i32 source;
+  i32 damage;
+  u32 order;
+};
+
+struct spawn_damage_text {
+  Vector2 position;
+  f32 amount;
+};
+
+struct spawn_loot_drop {
+  spawn_type type;
+  i32 exp;
+  i32 coin;
+  data128 context;
 };
 
 typedef struct spawn_system_state {
-  std::vector<Character2D> spawns; // NOTE: See also clean-up function
+  spawn_data_soa spawns; // NOTE: See also clean-up function
   const camera_metrics * in_camera_metrics;
+  const tilemap ** in_active_map;
   const ingame_info * in_ingame_info;
-  i32 next_spawn_id {};
   f32 spawn_follow_distance {};
-  SpatialGrid1D spatial_grid;
-  std::unordered_map<i32, size_t> spawn_id_to_index_map;
+  SpatialGridFlat spatial_grid;
+  spawn_handle_pool handles;
+  std::vector<spawn_move_intent> move_intents;
+  std::vector<u32> job_range_bounds; // NOTE: Offsets into spatial_grid.indices, cut at cell boundaries
+  spawn_intent_job_context intent_job_context;
+  Character2D spawn_by_id_buffer;
+
+  std::vector<spawn_damage_request> damage_requests;
+  std::vector<spawn_damage_hit> damage_hits;
+  std::vector<spawn_damage_text> damage_texts; // NOTE: Batched outputs of the damage pass, see spawn_flush_damage_outputs()
+  std::vector<spawn_loot_drop> loot_drops;
+  i32 death_count {};
 
   element_handle nearest_spawn_handle;
   element_handle first_spawn_on_screen_handle;
@@ -110,33 +299,61 @@ typedef struct spawn_system_state {
     Vector2 { MAP_X, MAP_Y }
   ) {
     this->in_camera_metrics = nullptr;
+    this->in_active_map = nullptr;
     this->in_ingame_info = nullptr;
-    this->next_spawn_id = SPAWN_ID_NEXT_START;
   }
 } spawn_system_state;
 
 static spawn_system_state * state = nullptr;
 
-void spawn_play_anim(Character2D& spawn, spawn_movement_animations sheet);
+void spawn_play_anim(size_t index, spawn_movement_animations sheet);
 void remove_spawn(i32 index);
 void register_spawn_animation(Character2D& spawn, spawn_movement_animations movement);
-void update_spawn_animation(Character2D& spawn);
-void spawn_item(std::vector<std::tuple<item_type, i32, data128>> items, data128 context);
+void update_spawn_animation(spawn_animation_data& anim);
+void spawn_item(const arena_vector<std::tuple<item_type, i32, data128>>& items, data128 context);
+
+void spawn_soa_push(const Character2D& character);
+void spawn_soa_swap_remove(size_t index);
+void spawn_soa_gather(size_t index, Character2D& out);
+void spawn_soa_clear(void);
+void spawn_soa_reserve(size_t capacity);
+
+void spawn_compute_intent(u32 spw_index, const spawn_intent_job_context& ctx);
+void spawn_compute_intents_job(u32 job_index, void* user_data);
+void spawn_build_job_ranges(void);
+
+damage_deal_result apply_spawn_damage(u32 index, i32 damage);
+void spawn_collect_damage_hits(const spawn_damage_request& request, u32& order);
+void spawn_flush_damage_outputs(void);
+
+static inline void spawn_set_flag(size_t index, spawn_state_flag flag, bool value) {
+  if (value) { state->spawns.flags[index] |= static_cast<u8>(flag); }
+  else { state->spawns.flags[index] &= static_cast<u8>(~flag); }
+}
+/**
+ * @brief Distance from the simulated position to where the spawn is drawn this frame
+ */
+static inline Vector2 spawn_render_offset(size_t index) {
+  const Vector2 interpolated = vec2_lerp(state->spawns.previous_position[index], state->spawns.position[index], get_simulation_alpha());
+  return vec2_subtract(interpolated, state->spawns.position[index]);
+}
 
 bool spawn_on_event(i32 code, event_context context);
 
-bool spawn_system_initialize(const camera_metrics* _camera_metrics, const ingame_info* _ingame_info) {
+bool spawn_system_initialize(const camera_metrics* _camera_metrics, const tilemap ** const in_active_map_ptr, const ingame_info* _ingame_info) {
   if (state and state != nullptr) {
+    state->in_active_map = in_active_map_ptr;
     clean_up_spawn_state();
     return true;
   }
-  state = (spawn_system_state *)allocate_memory_linear(sizeof(spawn_system_state), true);
+  state = (spawn_system_state *)allocate_memory_linear(sizeof(spawn_system_state), true, MEMORY_TAG_SPAWN);
   if (not state or state == nullptr) {
     IERROR("spawn::spawn_system_initialize()::Spawn system init failed");
     return false;
   }
   *state = spawn_system_state();
   state->in_camera_metrics = _camera_metrics;
+  state->in_active_map = in_active_map_ptr;
   state->in_ingame_info = _ingame_info;
 
   event_register(EVENT_CODE_SET_SPAWN_FOLLOW_DISTANCE, spawn_on_event);
@@ -145,129 +362,107 @@ bool spawn_system_initialize(const camera_metrics* _camera_metrics, const ingame
   event_register(EVENT_CODE_DAMAGE_SPAWN_BY_ID, spawn_on_event);
   event_register(EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT, spawn_on_event);
 
-  state->spawns.reserve(MAX_SPAWN_COUNT);
+  spawn_soa_reserve(MAX_SPAWN_COUNT);
+  state->spatial_grid.reserve(MAX_SPAWN_COUNT);
+  state->handles.reserve(MAX_SPAWN_COUNT);
+  state->move_intents.reserve(MAX_SPAWN_COUNT);
+  state->job_range_bounds.reserve(static_cast<size_t>(state->spatial_grid.cols * state->spatial_grid.rows) + 1u);
+  state->damage_requests.reserve(MAX_PROJECTILE_SLOT_COUNT);
+  state->damage_hits.reserve(MAX_SPAWN_COUNT);
+  state->damage_texts.reserve(MAX_SPAWN_COUNT);
+  state->loot_drops.reserve(MAX_SPAWN_COUNT);
   return true;
 }
 
+/**
+ * @brief Immediate damage, used where a deferred hit would land too late, e.g. killing every spawn at once. Outputs are flushed right away.
+ */
 damage_deal_result damage_spawn(i32 _id, i32 damage) {
-  auto it = state->spawn_id_to_index_map.find(_id);
-  if (it == state->spawn_id_to_index_map.end()) {
-    return DAMAGE_DEAL_RESULT_ERROR;
-  }
-  size_t index = it->second;
+  const u32 index = state->handles.resolve(_id);
   if (index >= state->spawns.size()) {
     return DAMAGE_DEAL_RESULT_ERROR;
   }
-  Character2D* character = &state->spawns[index];
-
-  if (not character or character == nullptr) return DAMAGE_DEAL_RESULT_ERROR;
-
-  if (character->type >= SPAWN_TYPE_MAX or character->type <= SPAWN_TYPE_UNDEFINED) {
-    (*character) = Character2D();
-    return DAMAGE_DEAL_RESULT_ERROR;
+  const damage_deal_result result = apply_spawn_damage(index, damage);
+  spawn_flush_damage_outputs();
+  return result;
+}
+void queue_spawn_damage_by_id(i32 _id, i32 damage, i32 source) {
+  spawn_damage_request request = spawn_damage_request();
+  request.type = SPAWN_DAMAGE_REQUEST_BY_ID;
+  request.target_id = _id;
+  request.damage = damage;
+  request.source = source;
+  state->damage_requests.push_back(request);
+}
+void queue_spawn_damage_by_collision(Rectangle rect, i32 damage, collision_type coll_type, i32 source) {
+  if (coll_type != COLLISION_TYPE_RECTANGLE_RECTANGLE and coll_type != COLLISION_TYPE_CIRCLE_RECTANGLE) {
+    IWARN("spawn::queue_spawn_damage_by_collision()::Unsupported collision type");
+    return;
   }
-  if (not character->is_damagable) { return damage_deal_result(DAMAGE_DEAL_RESULT_IN_DAMAGE_BREAKE, 0, character->health_current); }
-
-  if(character->health_current - damage > 0 && character->health_current - damage < MAX_SPAWN_HEALTH) {
-    character->is_damagable = false;
-    character->damage_break_time = character->take_damage_left_animation.fps / static_cast<f32>(TARGET_FPS);
-    character->health_current -= damage;
-
-    event_fire(EVENT_CODE_SPAWN_COMBAT_FEEDBACK_FLOATING_TEXT, event_context(
-      static_cast<f32>(character->collision.x + character->collision.width * .5f), 
-      static_cast<f32>(character->collision.y - character->collision.height * .15f),
-      static_cast<f32>(damage)
-    ));
-    return damage_deal_result(DAMAGE_DEAL_RESULT_SUCCESS, damage, character->health_current);
-  }
-  const i32 remaining_health = character->health_current;
-  character->health_current = 0;
-  character->is_dead = true;
-  character->is_damagable = false;
-  character->damage_break_time = character->take_damage_left_animation.fps / static_cast<f32>(TARGET_FPS);
-  event_fire(EVENT_CODE_PLAY_SOUND_GROUP, event_context(SOUNDGROUP_ID_ZOMBIE_DIE, static_cast<i32>(true)));
-  event_fire(EVENT_CODE_ADD_CURRENCY_SOULS, event_context(static_cast<i32>(1)));
-
-  data128 context = data128(
-    static_cast<i16>(character->collision.x + character->collision.width  * .5f), // INFO: Position x
-    static_cast<i16>(character->collision.y + character->collision.height * .5f), // INFO: Position y
-    static_cast<i16>(character->collision.y + character->collision.height * .5f), // INFO: Loot drop animation position y begin
-    static_cast<i16>(character->collision.height * .5f) // INFO: Loot drop animation position y change
-  );
+  spawn_damage_request request = spawn_damage_request();
+  request.type = SPAWN_DAMAGE_REQUEST_COLLISION;
+  request.coll_type = coll_type;
+  request.rect = rect;
+  request.damage = damage;
+  request.source = source;
+  state->damage_requests.push_back(request);
+}
+void queue_spawn_damage_rotated_rect(Rectangle rect, i32 damage, f32 rotation, Vector2 origin, i32 source) {
+  spawn_damage_request request = spawn_damage_request();
+  request.type = SPAWN_DAMAGE_REQUEST_ROTATED_RECT;
+  request.rect = rect;
+  request.origin = origin;
+  request.rotation = rotation;
+  request.damage = damage;
+  request.source = source;
+  state->damage_requests.push_back(request);
+}
+/**
+ * @brief Resolves every request queued since the last call. A source hits a spawn at most once per pass, the first queued hit wins.
+ * @brief Spawns that were already hit stay in damage break, so the per spawn cooldown still applies across sources and frames.
+ */
+void resolve_spawn_damage(void) {
+  if (not state or state == nullptr) {
+    IERROR("spawn::resolve_spawn_damage()::State is not valid");
+    return;
+  }
+  if (state->damage_requests.empty()) {
+    return;
+  }
+  std::vector<spawn_damage_hit>& hits = state->damage_hits;
+  hits.clear();
 
-  using DropInfo = std::tuple<item_type, i32, data128>;
-  using DropInfoVector = std::vector<DropInfo>;
-
-  switch (character->type) {
-    case SPAWN_TYPE_BROWN: {
-      spawn_item(DropInfoVector({
-          DropInfo(ITEM_TYPE_EXPERIENCE, 100, data128(static_cast<i32>(GET_SPW_EXP(character)))),
-          DropInfo(ITEM_TYPE_COIN, 65, data128(static_cast<i32>(GET_SPW_COIN(character)))),
-        }), 
-        context
-      );
-      break;
-    }
-    case SPAWN_TYPE_ORANGE: {
-      spawn_item(DropInfoVector({
-          DropInfo(ITEM_TYPE_EXPERIENCE, 100, data128(static_cast<i32>(GET_SPW_EXP(character)))),
-          DropInfo(ITEM_TYPE_COIN, 65, data128(static_cast<i32>(GET_SPW_COIN(character)))),
-        }), 
-        context
-      );
-      break;
-    }
-    case SPAWN_TYPE_YELLOW: {
-      spawn_item(DropInfoVector({
-          DropInfo(ITEM_TYPE_EXPERIENCE, 100, data128(static_cast<i32>(GET_SPW_EXP(character)))),
-          DropInfo(ITEM_TYPE_COIN, 65, data128(static_cast<i32>(GET_SPW_COIN(character)))),
-        }), 
-        context
-      );
-      break;
-    }
-    case SPAWN_TYPE_RED: {
-      spawn_item(DropInfoVector({
-          DropInfo(ITEM_TYPE_EXPERIENCE, 100, data128(static_cast<i32>(GET_SPW_EXP(character)))),
-          DropInfo(ITEM_TYPE_COIN, 65, data128(static_cast<i32>(GET_SPW_COIN(character)))),
-        }), 
-        context
-      );
-      break;
-    }
-    case SPAWN_TYPE_BOSS: {
-      spawn_item(DropInfoVector({DropInfo(ITEM_TYPE_CHEST, 100, data128())}), context);
-      break;
-    }
-    default: {}
+  u32 order = 0u;
+  for (const spawn_damage_request& request : state->damage_requests) {
+    spawn_collect_damage_hits(request, order);
   }
-  event_fire(EVENT_CODE_SPAWN_COMBAT_FEEDBACK_FLOATING_TEXT, event_context(
-    static_cast<f32>(character->collision.x + character->collision.width * .5f), 
-    static_cast<f32>(character->collision.y - character->collision.height * .15f),
-    static_cast<f32>(remaining_health)
-  ));
-  return damage_deal_result(DAMAGE_DEAL_RESULT_SUCCESS, remaining_health, 0);
-}
-damage_deal_result damage_spawn_by_collision(Rectangle rect, i32 damage, collision_type coll_type) {
-  Vector2 min_pos, max_pos;
-  switch (coll_type) {
-    case COLLISION_TYPE_RECTANGLE_RECTANGLE: {
-      min_pos = { rect.x, rect.y };
-      max_pos = { rect.x + rect.width, rect.y + rect.height };
-      break;
-    }
-    case COLLISION_TYPE_CIRCLE_RECTANGLE: {
-      float radius = rect.width;
-      min_pos = { rect.x - radius, rect.y - radius };
-      max_pos = { rect.x + radius, rect.y + radius };
-      break;
-    }
-    default: {
-      return DAMAGE_DEAL_RESULT_ERROR;
-    }
+  state->damage_requests.clear();
+
+  std::sort(hits.begin(), hits.end(), [](const spawn_damage_hit& lhs, const spawn_damage_hit& rhs) {
+    if (lhs.index != rhs.index) { return lhs.index < rhs.index; }
+    if (lhs.source != rhs.source) { return lhs.source < rhs.source; }
+    return lhs.order < rhs.order;
+  });
+  hits.erase(std::unique(hits.begin(), hits.end(), [](const spawn_damage_hit& lhs, const spawn_damage_hit& rhs) {
+    return lhs.index == rhs.index and lhs.source == rhs.source;
+  }), hits.end());
+  std::sort(hits.begin(), hits.end(), [](const spawn_damage_hit& lhs, const spawn_damage_hit& rhs) {
+    return lhs.order < rhs.order;
+  });
+
+  for (const spawn_damage_hit& hit : hits) {
+    apply_spawn_damage(hit.index, hit.damage);
   }
+  hits.clear();
 
-  SpatialGrid1D& grid = state->spatial_grid;
+  spawn_flush_damage_outputs();
+}
+/**
+ * @brief Calls fn with the index of every spawn whose grid cell overlaps the area, plus the ones not yet placed in the grid
+ */
+template <typename Fn>
+static inline void spawn_for_each_in_area(Vector2 min_pos, Vector2 max_pos, Fn&& fn) {
+  const SpatialGridFlat& grid = state->spatial_grid;
 
   i32 start_x = static_cast<i32>((min_pos.x - grid.world_origin.x) / grid.cell_size);
   i32 start_y = static_cast<i32>((min_pos.y - grid.world_origin.y) / grid.cell_size);
@@ -282,60 +477,207 @@ damage_deal_result damage_spawn_by_collision(Rectangle rect, i32 damage, collisi
   for (i32 y = start_y; y <= end_y; ++y) {
     i32 row_offset = y * grid.cols;
     for (i32 x = start_x; x <= end_x; ++x) {
-      i32 cell_index = row_offset + x;
-      
-      const std::vector<Character2D*>& bucket = grid.cells[cell_index];
-      for (Character2D* neighbor : bucket) {
-            
-        if (coll_type == COLLISION_TYPE_RECTANGLE_RECTANGLE) {
-          if (CheckCollisionRecs(neighbor->collision, rect)) {
-            damage_spawn(neighbor->character_id, damage);
+      const u32 * end = grid.cell_end(row_offset + x);
+      for (const u32 * itr = grid.cell_begin(row_offset + x); itr != end; ++itr) {
+        fn(*itr);
+      }
+    }
+  }
+  for (u32 neighbor : grid.pending) {
+    fn(neighbor);
+  }
+}
+void spawn_collect_damage_hits(const spawn_damage_request& request, u32& order) {
+  std::vector<spawn_damage_hit>& hits = state->damage_hits;
+  const std::vector<Rectangle>& collisions = state->spawns.collision;
+  const Rectangle& rect = request.rect;
+
+  auto push_hit = [&](u32 index) {
+    hits.push_back(spawn_damage_hit { index, request.source, request.damage, order++ });
+  };
+  switch (request.type) {
+    case SPAWN_DAMAGE_REQUEST_BY_ID: {
+      const u32 index = state->handles.resolve(request.target_id);
+      if (index < state->spawns.size()) {
+        push_hit(index);
+      }
+      return;
+    }
+    case SPAWN_DAMAGE_REQUEST_COLLISION: {
+      if (request.coll_type == COLLISION_TYPE_RECTANGLE_RECTANGLE) {
+        spawn_for_each_in_area(Vector2 { rect.x, rect.y }, Vector2 { rect.x + rect.width, rect.y + rect.height }, [&](u32 neighbor) {
+          if (CheckCollisionRecs(collisions[neighbor], rect)) {
+            push_hit(neighbor);
           }
-        } 
-        else if (coll_type == COLLISION_TYPE_CIRCLE_RECTANGLE) {
-          if (CheckCollisionCircleRec(Vector2{rect.x, rect.y}, rect.width, neighbor->collision)) {
-            damage_spawn(neighbor->character_id, damage);
+        });
+      }
+      else if (request.coll_type == COLLISION_TYPE_CIRCLE_RECTANGLE) {
+        const f32 radius = rect.width;
+        spawn_for_each_in_area(Vector2 { rect.x - radius, rect.y - radius }, Vector2 { rect.x + radius, rect.y + radius }, [&](u32 neighbor) {
+          if (CheckCollisionCircleRec(Vector2{rect.x, rect.y}, radius, collisions[neighbor])) {
+            push_hit(neighbor);
           }
-        }
+        });
       }
+      return;
+    }
+    case SPAWN_DAMAGE_REQUEST_ROTATED_RECT: {
+      const Rectangle search_aabb = get_rotated_rect_aabb(rect, request.rotation, request.origin);
+      const Vector2 min_pos = Vector2{ search_aabb.x, search_aabb.y };
+      const Vector2 max_pos = Vector2{ search_aabb.x + search_aabb.width, search_aabb.y + search_aabb.height };
+
+      spawn_for_each_in_area(min_pos, max_pos, [&](u32 neighbor) {
+        if (!CheckCollisionRecs(search_aabb, collisions[neighbor])) {
+          return;
+        }
+        if (check_collision_sat(rect, request.rotation, request.origin, collisions[neighbor])) {
+          push_hit(neighbor);
+        }
+      });
+      return;
+    }
+    default: {
+      IWARN("spawn::spawn_collect_damage_hits()::Unsupported request type");
+      return;
     }
   }
-  return DAMAGE_DEAL_RESULT_SUCCESS; 
 }
+/**
+ * @brief Changes the spawn right away, floating texts, death count and loot are left in the output buffers for spawn_flush_damage_outputs()
+ */
+damage_deal_result apply_spawn_damage(u32 index, i32 damage) {
+  spawn_data_soa& spawns = state->spawns;
+  spawn_stat_data& stats = spawns.stats[index];
+  const Rectangle& collision = spawns.collision[index];
+
+  if (stats.type >= SPAWN_TYPE_MAX or stats.type <= SPAWN_TYPE_UNDEFINED) {
+    spawns.flags[index] = SPAWN_FLAG_NONE;
+    return DAMAGE_DEAL_RESULT_ERROR;
+  }
+  if (not spawns.has_flag(index, SPAWN_FLAG_DAMAGABLE)) { return damage_deal_result(DAMAGE_DEAL_RESULT_IN_DAMAGE_BREAKE, 0, stats.health_current); }
 
-damage_deal_result damage_spawn_rotated_rect(Rectangle rect, i32 damage, f32 rotation, Vector2 origin) {
-  Rectangle search_aabb = get_rotated_rect_aabb(rect, rotation, origin);
-  Vector2 min_pos = Vector2{ search_aabb.x, search_aabb.y };
-  Vector2 max_pos = Vector2{ search_aabb.x + search_aabb.width, search_aabb.y + search_aabb.height };
+  const Vector2 text_position = Vector2 { collision.x + collision.width * .5f, collision.y - collision.height * .15f };
 
-  SpatialGrid1D& grid = state->spatial_grid;
+  if(stats.health_current - damage > 0 && stats.health_current - damage < MAX_SPAWN_HEALTH) {
+    spawn_set_flag(index, SPAWN_FLAG_DAMAGABLE, false);
+    stats.damage_break_time = spawns.animation[index].take_damage_left_animation.fps / static_cast<f32>(TARGET_FPS);
+    stats.health_current -= damage;
 
-  i32 start_x = static_cast<i32>((min_pos.x - grid.world_origin.x) / grid.cell_size);
-  i32 start_y = static_cast<i32>((min_pos.y - grid.world_origin.y) / grid.cell_size);
-  i32 end_x   = static_cast<i32>((max_pos.x - grid.world_origin.x) / grid.cell_size);
-  i32 end_y   = static_cast<i32>((max_pos.y - grid.world_origin.y) / grid.cell_size);
+    state->damage_texts.push_back(spawn_damage_text { text_position, static_cast<f32>(damage) });
+    return damage_deal_result(DAMAGE_DEAL_RESULT_SUCCESS, damage, stats.health_current);
+  }
+  const i32 remaining_health = stats.health_current;
+  stats.health_current = 0;
+  spawn_set_flag(index, SPAWN_FLAG_DEAD, true);
+  spawn_set_flag(index, SPAWN_FLAG_DAMAGABLE, false);
+  stats.damage_break_time = spawns.animation[index].take_damage_left_animation.fps / static_cast<f32>(TARGET_FPS);
+  state->death_count++;
+
+  spawn_loot_drop drop = spawn_loot_drop();
+  drop.type = stats.type;
+  drop.exp = static_cast<i32>(GET_SPW_EXP(stats));
+  drop.coin = static_cast<i32>(GET_SPW_COIN(stats));
+  drop.context = data128(
+    static_cast<i16>(collision.x + collision.width  * .5f), // INFO: Position x
+    static_cast<i16>(collision.y + collision.height * .5f), // INFO: Position y
+    static_cast<i16>(collision.y + collision.height * .5f), // INFO: Loot drop animation position y begin
+    static_cast<i16>(collision.height * .5f) // INFO: Loot drop animation position y change
+  );
+  state->loot_drops.push_back(drop);
 
-  start_x = std::max(0, start_x);
-  start_y = std::max(0, start_y);
-  end_x   = std::min(grid.cols - 1, end_x);
-  end_y   = std::min(grid.rows - 1, end_y);
+  state->damage_texts.push_back(spawn_damage_text { text_position, static_cast<f32>(remaining_health) });
+  return damage_deal_result(DAMAGE_DEAL_RESULT_SUCCESS, remaining_health, 0);
+}
+/**
+ * @brief Emits the side effects of every hit applied since the last flush. Deaths of one pass share a single sound and currency event.
+ */
+void spawn_flush_damage_outputs(void) {
+  for (const spawn_damage_text& text : state->damage_texts) {
+    event_post(EVENT_CODE_SPAWN_COMBAT_FEEDBACK_FLOATING_TEXT, event_context(text.position.x, text.position.y, text.amount));
+  }
+  state->damage_texts.clear();
+
+  if (state->death_count > 0) {
+    event_post(EVENT_CODE_PLAY_SOUND_GROUP, event_context(SOUNDGROUP_ID_ZOMBIE_DIE, static_cast<i32>(true)));
+    event_fire(EVENT_CODE_ADD_CURRENCY_SOULS, event_context(static_cast<i32>(state->death_count)));
+    state->death_count = 0;
+  }
+
+  using DropInfo = std::tuple<item_type, i32, data128>;
+  using DropInfoVector = arena_vector<DropInfo>;
+  const arena_allocator<DropInfo> frame_alloc = arena_allocator<DropInfo>(get_frame_arena());
+
+  for (const spawn_loot_drop& drop : state->loot_drops) {
+    // INFO: Drop lists are dead once spawn_item() returns, so a death wave doesn't pile them up in the frame arena
+    memory_arena_scope drop_scope = memory_arena_scope(get_frame_arena());
+    switch (drop.type) {
+      case SPAWN_TYPE_BROWN:
+      case SPAWN_TYPE_ORANGE:
+      case SPAWN_TYPE_YELLOW:
+      case SPAWN_TYPE_RED: {
+        spawn_item(DropInfoVector({
+            DropInfo(ITEM_TYPE_EXPERIENCE, 100, data128(drop.exp)),
+            DropInfo(ITEM_TYPE_COIN, 65, data128(drop.coin)),
+          }, frame_alloc),
+          drop.context
+        );
+        break;
+      }
+      case SPAWN_TYPE_BOSS: {
+        spawn_item(DropInfoVector({DropInfo(ITEM_TYPE_CHEST, 100, data128())}, frame_alloc), drop.context);
+        break;
+      }
+      default: {}
+    }
+  }
+  state->loot_drops.clear();
+}
+
+spawn_contact_result query_spawn_player_contact(Rectangle player_collision) {
+  spawn_contact_result result = spawn_contact_result();
+  if (not state or state == nullptr) {
+    IERROR("spawn::query_spawn_player_contact()::State is not valid");
+    return result;
+  }
+  const SpatialGridFlat& grid = state->spatial_grid;
+  const spawn_data_soa& spawns = state->spawns;
+  u32 first_index = SPAWN_HANDLE_INVALID_INDEX;
+
+  auto test_neighbor = [&](u32 neighbor) {
+    if (not spawns.has_flag(neighbor, SPAWN_FLAG_INITIALIZED) or spawns.has_flag(neighbor, SPAWN_FLAG_DEAD)) {
+      return;
+    }
+    if (not CheckCollisionRecs(spawns.collision[neighbor], player_collision)) {
+      return;
+    }
+    result.contact_count++;
+    if (neighbor < first_index) {
+      first_index = neighbor;
+    }
+  };
+  // INFO: Spawns are bucketed by their top-left corner and are smaller than a cell, so one extra cell on the min side is enough
+  const i32 start_x = std::max(0,             static_cast<i32>((player_collision.x - grid.cell_size - grid.world_origin.x) / grid.cell_size));
+  const i32 start_y = std::max(0,             static_cast<i32>((player_collision.y - grid.cell_size - grid.world_origin.y) / grid.cell_size));
+  const i32 end_x   = std::min(grid.cols - 1, static_cast<i32>((player_collision.x + player_collision.width  - grid.world_origin.x) / grid.cell_size));
+  const i32 end_y   = std::min(grid.rows - 1, static_cast<i32>((player_collision.y + player_collision.height - grid.world_origin.y) / grid.cell_size));
 
   for (i32 y = start_y; y <= end_y; ++y) {
     i32 row_offset = y * grid.cols;
     for (i32 x = start_x; x <= end_x; ++x) {
-      i32 cell_index = row_offset + x;
-      const std::vector<Character2D*>& bucket = grid.cells[cell_index];
-      for (Character2D* neighbor : bucket) {
-        if (!CheckCollisionRecs(search_aabb, neighbor->collision)) {
-          continue;
-        }
-        if (check_collision_sat(rect, rotation, origin, neighbor->collision)) {
-          damage_spawn(neighbor->character_id, damage);
-        }
+      const u32 * end = grid.cell_end(row_offset + x);
+      for (const u32 * itr = grid.cell_begin(row_offset + x); itr != end; ++itr) {
+        test_neighbor(*itr);
       }
     }
   }
-  return DAMAGE_DEAL_RESULT_SUCCESS;
+  for (u32 neighbor : grid.pending) {
+    test_neighbor(neighbor);
+  }
+  if (first_index != SPAWN_HANDLE_INVALID_INDEX) {
+    result.damage = spawns.damage[first_index];
+    result.spawn_id = spawns.character_id[first_index];
+  }
+  return result;
 }
 
 i32 spawn_character(Character2D _character) {
@@ -348,7 +690,7 @@ i32 spawn_character(Character2D _character) {
   _character.health_max = SPAWN_HEALTH_CURVE(_character.buffer.i32[1], _character.scale, static_cast<f32>(_character.type));
   _character.damage = SPAWN_DAMAGE_CURVE(_character.buffer.i32[1], _character.scale, static_cast<f32>(_character.type));
   _character.speed =  SPAWN_SPEED_CURVE(_character.buffer.i32[1], _character.scale, static_cast<f32>(_character.type));
-  
+
   _character.health_current = _character.health_max;
 
   register_spawn_animation(_character, SPAWN_ZOMBIE_ANIMATION_MOVE_LEFT);
@@ -358,44 +700,57 @@ i32 spawn_character(Character2D _character) {
   _character.collision.height = _character.move_left_animation.current_frame_rect.height * _character.scale;
   _character.collision.x = _character.position.x;
   _character.collision.y = _character.position.y;
- 
+
   register_spawn_animation(_character, SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT);
   register_spawn_animation(_character, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT);
   register_spawn_animation(_character, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT);
-  
+
   _character.death_effect_animation.sheet_id = SHEET_ID_SPAWN_EXPLOSION;
   set_sprite(_character.death_effect_animation, false, true);
 
   _character.tint = WHITE;
   _character.w_direction = WORLD_DIRECTION_RIGHT;
   _character.last_played_animation = SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT;
-  _character.character_id = state->next_spawn_id++;
   _character.initialized = true;
 
-  i32 center_x = static_cast<i32>((_character.position.x - state->spatial_grid.world_origin.x) / state->spatial_grid.cell_size);
-  i32 center_y = static_cast<i32>((_character.position.y - state->spatial_grid.world_origin.y) / state->spatial_grid.cell_size);
+  SpatialGridFlat& grid = state->spatial_grid;
+  const std::vector<Rectangle>& collisions = state->spawns.collision;
+  i32 center_x = static_cast<i32>((_character.position.x - grid.world_origin.x) / grid.cell_size);
+  i32 center_y = static_cast<i32>((_character.position.y - grid.world_origin.y) / grid.cell_size);
 
   for (i32 y = center_y - 1; y <= center_y + 1; ++y) {
-    if (y < 0 or y >= state->spatial_grid.rows) continue;
+    if (y < 0 or y >= grid.rows) continue;
 
     for (i32 x = center_x - 1; x <= center_x + 1; ++x) {
-      if (x < 0 or x >= state->spatial_grid.cols) continue;
+      if (x < 0 or x >= grid.cols) continue;
 
-      i32 cell_index = (y * state->spatial_grid.cols) + x;
-      const std::vector<Character2D*>& bucket = state->spatial_grid.cells[cell_index];
+      const i32 cell_index = (y * grid.cols) + x;
+      const u32 * end = grid.cell_end(cell_index);
 
-      for (const Character2D* neighbor : bucket) {
-        if (CheckCollisionRecs(neighbor->collision, _character.collision)) {
+      for (const u32 * itr = grid.cell_begin(cell_index); itr != end; ++itr) {
+        if (CheckCollisionRecs(collisions[*itr], _character.collision)) {
           return -1;
         }
       }
     }
   }
-  state->spawns.push_back(_character);
-  SpatialGrid1D& grid = state->spatial_grid;
+  for (u32 neighbor : grid.pending) {
+    if (CheckCollisionRecs(collisions[neighbor], _character.collision)) {
+      return -1;
+    }
+  }
+  const u32 new_index = static_cast<u32>(state->spawns.size());
+  _character.character_id = state->handles.acquire(new_index);
+  if (_character.character_id < SPAWN_ID_NEXT_START) {
+    IWARN("spawn::spawn_character()::Spawn handle pool is exhausted");
+    return -1;
+  }
+  spawn_soa_push(_character);
 
-  Character2D* new_spawn_ptr = &state->spawns.back();
-  grid.insert(new_spawn_ptr);
+  // INFO: Bursts from map population go through pending, and re-sort the grid in batches
+  if (grid.insert(new_index)) {
+    grid.rebuild(state->spawns.position);
+  }
 
   if (_character.collision.width >= CELL_SIZE or _character.collision.height >= CELL_SIZE) {
     IWARN("spawn::spawn_character::Character size is bigger than cell size");
@@ -404,278 +759,320 @@ i32 spawn_character(Character2D _character) {
   return _character.character_id;
 }
 
+void spawn_compute_intent(u32 spw_index, const spawn_intent_job_context& ctx) {
+  const spawn_data_soa& spawns = state->spawns;
+  const SpatialGridFlat& grid = state->spatial_grid;
+  spawn_move_intent& intent = state->move_intents[spw_index];
+  intent.flags = SPAWN_MOVE_INTENT_NONE;
+
+  if (not spawns.has_flag(spw_index, SPAWN_FLAG_INITIALIZED) or spawns.has_flag(spw_index, SPAWN_FLAG_DEAD)) {
+    return;
+  }
+  const Vector2 position = spawns.position[spw_index];
+  intent.distance = vec2_distance_sq(position, ctx.player_position);
+
+  if (intent.distance >= ctx.follow_distance_sq or spawns.has_flag(spw_index, SPAWN_FLAG_MOVE_HALTED)) {
+    return;
+  }
+  const Vector2 new_position = move_towards(position, ctx.player_position, spawns.speed[spw_index] * ctx.delta_time);
+  intent.position = new_position;
+
+  bool x0_collide = false;
+  bool y0_collide = false;
+
+  const Rectangle spw_col = spawns.collision[spw_index];
+  const Rectangle x0 = {spw_col.x, new_position.y, spw_col.width, spw_col.height};
+  const Rectangle y0 = {new_position.x, spw_col.y, spw_col.width, spw_col.height};
+
+  i32 center_x = static_cast<i32>((position.x - grid.world_origin.x) / grid.cell_size);
+  i32 center_y = static_cast<i32>((position.y - grid.world_origin.y) / grid.cell_size);
+
+  // INFO: Walls first, they are fewer than the neighbors. A spawn already overlapping a wall is let walk out of it
+  const tilemap *const map = (state->in_active_map and state->in_active_map != nullptr) ? *state->in_active_map : nullptr;
+  if (map and map != nullptr and not map_spatial_index_overlaps_collision(map, spw_col)) {
+    x0_collide = map_spatial_index_overlaps_collision(map, x0);
+    y0_collide = map_spatial_index_overlaps_collision(map, y0);
+    if (x0_collide && y0_collide) goto collision_resolution;
+  }
+
+  for (i32 y = center_y - 1; y <= center_y + 1; ++y) {
+    if (y < 0 or y >= grid.rows) continue;
+
+    for (i32 x = center_x - 1; x <= center_x + 1; ++x) {
+      if (x < 0 or x >= grid.cols) continue;
+      const i32 cell_index = (y * grid.cols) + x;
+      const u32 * end = grid.cell_end(cell_index);
+
+      for (const u32 * itr = grid.cell_begin(cell_index); itr != end; ++itr) {
+        if (*itr == spw_index) {
+          continue;
+        }
+        const Rectangle& neighbor_col = spawns.collision[*itr];
+
+        if (!x0_collide && CheckCollisionRecs(neighbor_col, x0)) {
+          x0_collide = true;
+        }
+        if (!y0_collide && CheckCollisionRecs(neighbor_col, y0)) {
+          y0_collide = true;
+        }
+
+        if (x0_collide && y0_collide) goto collision_resolution;
+      }
+    }
+  }
+  for (u32 neighbor : grid.pending) {
+    if (neighbor == spw_index) {
+      continue;
+    }
+    const Rectangle& neighbor_col = spawns.collision[neighbor];
+    if (!x0_collide && CheckCollisionRecs(neighbor_col, x0)) { x0_collide = true; }
+    if (!y0_collide && CheckCollisionRecs(neighbor_col, y0)) { y0_collide = true; }
+  }
+  collision_resolution:;
+
+  if (!x0_collide) {
+    intent.flags |= SPAWN_MOVE_INTENT_APPLY_Y;
+  }
+  if (!y0_collide) {
+    intent.flags |= SPAWN_MOVE_INTENT_APPLY_X;
+  }
+}
+
+void spawn_compute_intents_job(u32 job_index, void* user_data) {
+  PROFILE_FUNCTION();
+  (void)user_data;
+  const SpatialGridFlat& grid = state->spatial_grid;
+  const u32 begin = state->job_range_bounds[job_index];
+  const u32 end = state->job_range_bounds[job_index + 1u];
+
+  for (u32 itr_000 = begin; itr_000 < end; ++itr_000) {
+    spawn_compute_intent(grid.indices[itr_000], state->intent_job_context);
+  }
+}
+
+void spawn_build_job_ranges(void) {
+  const SpatialGridFlat& grid = state->spatial_grid;
+  std::vector<u32>& bounds = state->job_range_bounds;
+  const u32 unit_count = static_cast<u32>(grid.indices.size());
+  const u32 target = std::max(SPAWN_JOB_MIN_UNIT_COUNT, unit_count / (job_system_thread_count() * 4u) + 1u);
+
+  bounds.clear();
+  bounds.push_back(0u);
+
+  u32 accumulated = 0u;
+  for (size_t cell = 0; cell < grid.cell_count.size(); ++cell) {
+    accumulated += grid.cell_count[cell];
+    if (accumulated >= target) {
+      bounds.push_back(grid.cell_start[cell + 1u]);
+      accumulated = 0u;
+    }
+  }
+  if (bounds.back() != unit_count) {
+    bounds.push_back(unit_count);
+  }
+}
+
 bool update_spawns(Vector2 player_position) {
-  if (not state or state == nullptr) { 
+  PROFILE_FUNCTION();
+  if (not state or state == nullptr) {
     IERROR("spawn::update_spawns()::State is not valid");
-    return false; 
+    return false;
   }
   f32 max_spawn_distance = static_cast<f32>(std::numeric_limits<i32>::max());
-  
+
   state->first_spawn_on_screen_handle.id = 0;
   state->first_spawn_on_screen_handle.index = std::numeric_limits<i32>::max();
   state->nearest_spawn_handle.id = 0;
   state->nearest_spawn_handle.index = std::numeric_limits<i32>::max();
 
-  for (size_t spw_index = 0; spw_index < state->spawns.size(); spw_index++) {
-    Character2D& spw = state->spawns[spw_index];
-    if (not spw.initialized) { 
-      continue; 
+  spawn_data_soa& spawns = state->spawns;
+  const f32 dt = *state->in_ingame_info->delta_time;
+
+  // INFO: Phase one. Intended moves are computed in parallel against the positions of the previous frame,
+  // each job writes only the intents of its own spawns, so the result does not depend on the thread count.
+  state->intent_job_context = spawn_intent_job_context {player_position, dt, state->spawn_follow_distance * state->spawn_follow_distance};
+  state->move_intents.resize(spawns.size());
+  spawn_build_job_ranges();
+  job_dispatch(static_cast<u32>(state->job_range_bounds.size() - 1u), spawn_compute_intents_job, nullptr);
+
+  for (u32 pending_index : state->spatial_grid.pending) {
+    spawn_compute_intent(pending_index, state->intent_job_context);
+  }
+
+  // INFO: Phase two. Intents are applied and events are fired in index order on the calling thread.
+  for (size_t spw_index = 0; spw_index < spawns.size(); spw_index++) {
+    spawns.previous_position[spw_index] = spawns.position[spw_index]; // INFO: Before any early out, a spawn that stops moving must not keep lerping from a stale position
+    if (not spawns.has_flag(spw_index, SPAWN_FLAG_INITIALIZED)) {
+      continue;
     }
-    if (not spw.is_damagable) {
-      if (spw.damage_break_time >= 0) {
-        spw.damage_break_time -= (*state->in_ingame_info->delta_time);
+    if (not spawns.has_flag(spw_index, SPAWN_FLAG_DAMAGABLE)) {
+      spawn_stat_data& stats = spawns.stats[spw_index];
+      if (stats.damage_break_time >= 0) {
+        stats.damage_break_time -= dt;
       }
       else {
-        spw.is_damagable = true;
-        reset_sprite(spw.take_damage_left_animation, true);
-        reset_sprite(spw.take_damage_right_animation, true);
+        spawn_set_flag(spw_index, SPAWN_FLAG_DAMAGABLE, true);
+        reset_sprite(spawns.animation[spw_index].take_damage_left_animation, true);
+        reset_sprite(spawns.animation[spw_index].take_damage_right_animation, true);
       }
     }
 
-    if (spw.is_dead ) {
-      if (spw.is_on_screen) {
-        update_sprite(spw.death_effect_animation, (*state->in_ingame_info->delta_time) );
-        update_spawn_animation(spw);
-      }
-      else {
-        spw.initialized = false; // INFO: Forcing to remove
+    if (spawns.has_flag(spw_index, SPAWN_FLAG_DEAD)) {
+      if (not spawns.has_flag(spw_index, SPAWN_FLAG_ON_SCREEN)) {
+        spawn_set_flag(spw_index, SPAWN_FLAG_INITIALIZED, false); // INFO: Forcing to remove
       }
-      continue; 
+      continue;
     }
-
-    f32 distance = vec2_distance_sq(spw.position, player_position);
-    f32 follow_dist = state->spawn_follow_distance * state->spawn_follow_distance;
-    
-    if (distance < follow_dist && !spw.cond_halt_move.is_active) {
-      const f32 dt = *state->in_ingame_info->delta_time;
-      SpatialGrid1D& grid = state->spatial_grid;
-      Vector2 old_position = spw.position;
-
-      Vector2 new_position = move_towards(spw.position, player_position, spw.speed * dt);
-
-      bool x0_collide = false;
-      bool y0_collide = false;
-  
-      const Rectangle spw_col = spw.collision;
-      const Rectangle x0 = {spw_col.x, new_position.y, spw_col.width, spw_col.height};
-      const Rectangle y0 = {new_position.x, spw_col.y, spw_col.width, spw_col.height};
-  
-    
-      i32 center_x = static_cast<i32>((spw.position.x - grid.world_origin.x) / grid.cell_size);
-      i32 center_y = static_cast<i32>((spw.position.y - grid.world_origin.y) / grid.cell_size);
-
-      for (i32 y = center_y - 1; y <= center_y + 1; ++y) {
-        if (y < 0 or y >= grid.rows) continue;
-
-        for (i32 x = center_x - 1; x <= center_x + 1; ++x) {
-          if (x < 0 or x >= grid.cols) continue;
-          i32 cell_index = (y * grid.cols) + x;
-
-          const std::vector<Character2D*>& bucket = grid.cells[cell_index];
-
-          for (const Character2D* neighbor : bucket) {
-            if (neighbor == &spw) { 
-              continue; 
-            }
-
-            if (!x0_collide && CheckCollisionRecs(neighbor->collision, x0)) {
-              x0_collide = true;
-            }
-            if (!y0_collide && CheckCollisionRecs(neighbor->collision, y0)) {
-              y0_collide = true;
-            }
-
-            if (x0_collide && y0_collide) goto collision_resolution;
-          }
-        }
-      }
-      collision_resolution:; 
-      
-      if (!x0_collide) {
-        spw.position.y = new_position.y;
-        spw.collision.y = spw.position.y;
-      }
-      if (!y0_collide) {
-        spw.w_direction = (spw.position.x > new_position.x) ? WORLD_DIRECTION_LEFT : WORLD_DIRECTION_RIGHT;
-        spw.position.x = new_position.x;
-        spw.collision.x = spw.position.x;
-      }
-
-      state->spatial_grid.update(&spw, old_position);
+    Vector2& position = spawns.position[spw_index];
+    Rectangle& collision = spawns.collision[spw_index];
+    const spawn_move_intent& intent = state->move_intents[spw_index];
+    const f32 distance = intent.distance;
+
+    if (intent.flags & SPAWN_MOVE_INTENT_APPLY_Y) {
+      position.y = intent.position.y;
+      collision.y = position.y;
+    }
+    if (intent.flags & SPAWN_MOVE_INTENT_APPLY_X) {
+      spawns.w_direction[spw_index] = (position.x > intent.position.x) ? WORLD_DIRECTION_LEFT : WORLD_DIRECTION_RIGHT;
+      position.x = intent.position.x;
+      collision.x = position.x;
     }
 
-    if (spw.cond_halt_move.is_active) {
-      if (spw.cond_halt_move.accumulator > spw.cond_halt_move.duration) {
-        spw.cond_halt_move.accumulator = 0.f;
-        spw.cond_halt_move.duration = 0.f;
-        spw.cond_halt_move.is_active = false;
+    if (spawns.has_flag(spw_index, SPAWN_FLAG_MOVE_HALTED)) {
+      condition_halt_movement& halt = spawns.stats[spw_index].cond_halt_move;
+      if (halt.accumulator > halt.duration) {
+        halt.accumulator = 0.f;
+        halt.duration = 0.f;
+        spawn_set_flag(spw_index, SPAWN_FLAG_MOVE_HALTED, false);
       }
-      else spw.cond_halt_move.accumulator += (*state->in_ingame_info->delta_time);
+      else halt.accumulator += dt;
     }
 
-    update_spawn_animation(spw);
-
-    // WARN: This event fires 'clean_up_spawn_state()' function if player die from damage
-    event_fire(EVENT_CODE_DAMAGE_PLAYER_IF_COLLIDE, event_context(
-      static_cast<i16>(spw.collision.x), static_cast<i16>(spw.collision.y), static_cast<i16>(spw.collision.width), static_cast<i16>(spw.collision.height),
-      static_cast<i16>(spw.damage),
-      static_cast<i16>(COLLISION_TYPE_RECTANGLE_RECTANGLE)
-    ));
-    // WARN: This event fires 'clean_up_spawn_state()' function if player die from damage
+    const bool is_on_screen = CheckCollisionRecs(collision, state->in_camera_metrics->frustum);
+    spawn_set_flag(spw_index, SPAWN_FLAG_ON_SCREEN, is_on_screen);
 
-    if (state->spawns.empty()) {
-      break;
-    }
-    spw.is_on_screen = CheckCollisionRecs(spw.collision, state->in_camera_metrics->frustum);
-
-    if (spw.is_on_screen and state->first_spawn_on_screen_handle.id < SPAWN_ID_NEXT_START) {
-      state->first_spawn_on_screen_handle.id = spw.character_id;
+    if (is_on_screen and state->first_spawn_on_screen_handle.id < SPAWN_ID_NEXT_START) {
+      state->first_spawn_on_screen_handle.id = spawns.character_id[spw_index];
       state->first_spawn_on_screen_handle.index = spw_index;
     }
     if (distance < max_spawn_distance) {
-      state->nearest_spawn_handle.id = spw.character_id;
+      state->nearest_spawn_handle.id = spawns.character_id[spw_index];
       state->nearest_spawn_handle.index = spw_index;
       max_spawn_distance = distance;
     }
   }
-  for (size_t itr_000 = state->spawns.size(); itr_000-- > 0;) {
-    const Character2D& spw = state->spawns[itr_000];
+
+  // INFO: Cold pass. Animations are advanced in one contiguous sweep
+  for (size_t spw_index = 0; spw_index < spawns.size(); spw_index++) {
+    if (not spawns.has_flag(spw_index, SPAWN_FLAG_INITIALIZED)) {
+      continue;
+    }
+    spawn_animation_data& anim = spawns.animation[spw_index];
+    if (spawns.has_flag(spw_index, SPAWN_FLAG_DEAD)) {
+      update_sprite(anim.death_effect_animation, dt);
+    }
+    update_spawn_animation(anim);
+  }
+
+  for (size_t itr_000 = spawns.size(); itr_000-- > 0;) {
     bool should_be_deleted = false;
-    if (not spw.initialized) {
+    if (not spawns.has_flag(itr_000, SPAWN_FLAG_INITIALIZED)) {
       should_be_deleted = true;
     }
-    if (spw.is_dead) {
-      if (spw.take_damage_left_animation.is_played or spw.take_damage_right_animation.is_played) {
-        should_be_deleted = spw.death_effect_animation.is_played;  
+    if (spawns.has_flag(itr_000, SPAWN_FLAG_DEAD)) {
+      const spawn_animation_data& anim = spawns.animation[itr_000];
+      if (anim.take_damage_left_animation.is_played or anim.take_damage_right_animation.is_played) {
+        should_be_deleted = anim.death_effect_animation.is_played;
       }
-      if (not spw.death_effect_animation.is_started) {
+      if (not anim.death_effect_animation.is_started) {
         should_be_deleted = true;
       }
     }
     if (not should_be_deleted) {
       continue;
     }
-
-    Character2D* ptr_to_remove = &state->spawns[itr_000];
-    state->spatial_grid.remove(ptr_to_remove, ptr_to_remove->position);
-
-    if (itr_000 != state->spawns.size() - 1u) {
-
-      Character2D& moved_spawn = state->spawns.back();
-
-      SpatialGrid1D& grid = state->spatial_grid;
-      i32 last_spawn_grid_idx = grid.get_index(moved_spawn.position);
-
-      if (last_spawn_grid_idx != -1) {
-        std::vector<Character2D*>& bucket = grid.cells[last_spawn_grid_idx];
-
-        for (size_t k = 0u; k < bucket.size(); ++k) {
-          if (bucket[k] == &moved_spawn) {
-            bucket[k] = bucket.back();
-            bucket.pop_back();
-            break; 
-          }
-        }
-      }
-
-      std::swap(state->spawns[itr_000], state->spawns.back());
-
-      i32 moved_id = state->spawns[itr_000].character_id;
-      state->spawn_id_to_index_map[moved_id] = itr_000;
-
-      if (last_spawn_grid_idx != -1) {
-        grid.cells[last_spawn_grid_idx].push_back(&state->spawns[itr_000]);
-      }
-    }
-
-    i32 dead_spawn_id = state->spawns.back().character_id;
-    state->spawn_id_to_index_map.erase(dead_spawn_id);
-    state->spawns.pop_back();
-  }
-
-  state->spawn_id_to_index_map.clear();
-  for (size_t i = 0u; i < state->spawns.size(); ++i) {
-    state->spawn_id_to_index_map[state->spawns[i].character_id] = i;
+    remove_spawn(static_cast<i32>(itr_000));
   }
+  state->spatial_grid.rebuild(spawns.position);
   return true;
 }
 void update_spawns_animation_only(void) {
 
-  for (auto& character : state->spawns) {
-    update_spawn_animation(character);
+  for (spawn_animation_data& anim : state->spawns.animation) {
+    update_spawn_animation(anim);
   }
 
 }
 
 bool render_spawns(void) {
+  PROFILE_FUNCTION();
   if (not state or state == nullptr) {
     IERROR("spawn::render_spawns()::State is not valid");
     return false;
   }
-  
-  for (Character2D& _character : state->spawns) {
-    if (_character.initialized) {
+  const spawn_data_soa& spawns = state->spawns;
 
-      if(not _character.is_dead and not _character.is_invisible) 
-      {
-        BeginShaderMode(get_shader_by_enum(SHADER_ID_SPAWN)->handle);
-        set_shader_uniform(SHADER_ID_SPAWN, "spawn_id", data128(static_cast<f32>(_character.character_id)));
+  for (size_t spw_index = 0; spw_index < spawns.size(); spw_index++) {
+    if (not spawns.has_flag(spw_index, SPAWN_FLAG_INITIALIZED)) {
+      continue;
+    }
+    const world_direction w_direction = spawns.w_direction[spw_index];
+    const bool is_invisible = spawns.has_flag(spw_index, SPAWN_FLAG_INVISIBLE);
 
-        if(_character.is_damagable)
+    if(not spawns.has_flag(spw_index, SPAWN_FLAG_DEAD) and not is_invisible)
+    {
+      if(spawns.has_flag(spw_index, SPAWN_FLAG_DAMAGABLE))
+      {
+        switch (w_direction)
         {
-          switch (_character.w_direction) 
-          {
-            case WORLD_DIRECTION_LEFT: spawn_play_anim(_character, SPAWN_ZOMBIE_ANIMATION_MOVE_LEFT);
-            break;
-            case WORLD_DIRECTION_RIGHT:spawn_play_anim(_character, SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT);
+          case WORLD_DIRECTION_LEFT: spawn_play_anim(spw_index, SPAWN_ZOMBIE_ANIMATION_MOVE_LEFT);
+          break;
+          case WORLD_DIRECTION_RIGHT:spawn_play_anim(spw_index, SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT);
+          break;
+          default: {
+            IWARN("spawn::render_spawns()::Unsupported direction");
             break;
-            default: {
-              IWARN("spawn::render_spawns()::Unsupported direction");
-              break;
-            }
           }
-        }	
-        else 
-        {
-          (_character.w_direction == WORLD_DIRECTION_LEFT) 
-            ? spawn_play_anim(_character, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT)
-            : spawn_play_anim(_character, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT);
         }
-        EndShaderMode();
-      } 
-      else 
+      }
+      else
       {
-        if (not _character.is_invisible) {
-          BeginShaderMode(get_shader_by_enum(SHADER_ID_SPAWN)->handle);
-          set_shader_uniform(SHADER_ID_SPAWN, "spawn_id", data128(static_cast<f32>(_character.character_id)));
-
-          if (_character.w_direction == WORLD_DIRECTION_LEFT) {
-            spawn_play_anim(_character, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT);
-          }
-          else {
-            spawn_play_anim(_character, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT);
-          }
-          EndShaderMode();
+        (w_direction == WORLD_DIRECTION_LEFT)
+          ? spawn_play_anim(spw_index, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT)
+          : spawn_play_anim(spw_index, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT);
+      }
+    }
+    else
+    {
+      if (not is_invisible) {
+        if (w_direction == WORLD_DIRECTION_LEFT) {
+          spawn_play_anim(spw_index, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT);
+        }
+        else {
+          spawn_play_anim(spw_index, SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT);
         }
-
-        const f32 death_effect_height = state->in_camera_metrics->frustum.height * DEATH_EFFECT_HEIGHT_SCALE;
-        const f32 death_effect_wh_ratio = _character.death_effect_animation.current_frame_rect.width / _character.death_effect_animation.current_frame_rect.height;
-        const f32 death_effect_width = death_effect_height * death_effect_wh_ratio;
-
-        play_sprite_on_site(_character.death_effect_animation, WHITE, Rectangle {
-          _character.position.x + (_character.collision.width  * .5f) - (death_effect_width  * .5f), 
-          _character.position.y + (_character.collision.height * .5f) - (death_effect_height * .5f),
-          death_effect_height, 
-          death_effect_width
-        });
       }
+
+      spritesheet& death_effect = state->spawns.animation[spw_index].death_effect_animation;
+      const Vector2 position = vec2_add(spawns.position[spw_index], spawn_render_offset(spw_index));
+      const Rectangle& collision = spawns.collision[spw_index];
+      const f32 death_effect_height = state->in_camera_metrics->frustum.height * DEATH_EFFECT_HEIGHT_SCALE;
+      const f32 death_effect_wh_ratio = death_effect.current_frame_rect.width / death_effect.current_frame_rect.height;
+      const f32 death_effect_width = death_effect_height * death_effect_wh_ratio;
+
+      sprite_batch_play_sprite(death_effect, SPRITE_LAYER_EFFECT, SHADER_ID_UNSPECIFIED, WHITE, Rectangle {
+        position.x + (collision.width  * .5f) - (death_effect_width  * .5f),
+        position.y + (collision.height * .5f) - (death_effect_height * .5f),
+        death_effect_height,
+        death_effect_width
+      });
     }
   }
 
   return true;
 }
 
-std::vector<Character2D>* get_spawns(void) {
+const spawn_data_soa* get_spawns(void) {
   if (not state or state == nullptr) {
     IERROR("spawn::get_spawns()::State was null");
     return nullptr;
@@ -688,16 +1085,13 @@ const Character2D * get_spawn_by_id(i32 _id) {
     IERROR("spawn::get_spawn_by_id()::State is invalid");
     return nullptr;
   }
-  auto it = state->spawn_id_to_index_map.find(_id);
-  if (it == state->spawn_id_to_index_map.end()) {
-    return nullptr;
-  }
-  size_t index = it->second;
+  const u32 index = state->handles.resolve(_id);
   if (index >= state->spawns.size()) {
     return nullptr;
   }
+  spawn_soa_gather(index, state->spawn_by_id_buffer);
 
-  return __builtin_addressof(state->spawns.at(index));;
+  return __builtin_addressof(state->spawn_by_id_buffer);
 }
 const element_handle * get_nearest_spawn(void) {
   return &state->nearest_spawn_handle;
@@ -707,34 +1101,62 @@ const element_handle * get_first_spawn_on_screen(void) {
 }
 
 void clean_up_spawn_state(void) {
-  state->spawns.clear(); 
+  spawn_soa_clear();
   state->spatial_grid.clear();
-  state->spawn_id_to_index_map.clear();
-  state->next_spawn_id = SPAWN_ID_NEXT_START;
+  state->handles.clear();
+  state->damage_requests.clear();
+  state->damage_hits.clear();
+  state->damage_texts.clear();
+  state->loot_drops.clear();
+  state->death_count = 0;
 }
 
-void spawn_play_anim(Character2D& spawn, spawn_movement_animations movement) {
-  Rectangle dest = spawn.collision;
+#if HEADLESS_BUILD
+/**
+ * @brief Rebuilds the spatial grid from the current positions without updating any spawn, so the headless runner can time the rebuild alone
+ */
+void spawn_rebuild_spatial_grid(void) {
+  state->spatial_grid.rebuild(state->spawns.position);
+}
+#endif
+
+/**
+ * @brief Queued into the scene's sprite batch, see render_scene_in_game(). Spawn shader reads the spawn id from the vertices,
+ * @brief so every spawn stays in the same draw call. Slot alone is unique among the live spawns, the 16 generation bits
+ * @brief are folded into 10 on top of it to keep reused slots apart. 24 bits in total, exact as a float.
+ */
+void spawn_play_anim(size_t index, spawn_movement_animations movement) {
+  spawn_animation_data& anim = state->spawns.animation[index];
+  const Vector2 offset = spawn_render_offset(index);
+  const Rectangle dest = Rectangle {
+    state->spawns.collision[index].x + offset.x, state->spawns.collision[index].y + offset.y,
+    state->spawns.collision[index].width, state->spawns.collision[index].height
+  };
+  const Color tint = anim.tint;
+  const u32 handle = static_cast<u32>(state->spawns.character_id[index]);
+  const u32 generation = (handle >> SPAWN_HANDLE_SLOT_BITS) & SPAWN_HANDLE_GENERATION_MASK;
+  const u32 folded_generation = (generation ^ (generation >> 10u)) & 0x3FFu;
+  const f32 spawn_id = static_cast<f32>((folded_generation << SPAWN_HANDLE_SLOT_BITS) | (handle & SPAWN_HANDLE_SLOT_MASK));
 
   switch (movement) {
     case SPAWN_ZOMBIE_ANIMATION_MOVE_LEFT: {
-      play_sprite_on_site(spawn.move_left_animation, spawn.tint, dest);
-      spawn.last_played_animation = SPAWN_ZOMBIE_ANIMATION_MOVE_LEFT;
+      sprite_batch_play_sprite(anim.move_left_animation, SPRITE_LAYER_SCENE, SHADER_ID_SPAWN, tint, dest, spawn_id);
+      anim.last_played_animation = SPAWN_ZOMBIE_ANIMATION_MOVE_LEFT;
       break;
     }
     case SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT: {
-      play_sprite_on_site(spawn.move_right_animation, spawn.tint, dest);
-      spawn.last_played_animation = SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT;
+      sprite_batch_play_sprite(anim.move_right_animation, SPRITE_LAYER_SCENE, SHADER_ID_SPAWN, tint, dest, spawn_id);
+      anim.last_played_animation = SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT;
       break;
     }
     case SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT:  {
-      play_sprite_on_site(spawn.take_damage_left_animation, spawn.tint, dest);
-      spawn.last_played_animation = SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT;
+      sprite_batch_play_sprite(anim.take_damage_left_animation, SPRITE_LAYER_SCENE, SHADER_ID_SPAWN, tint, dest, spawn_id);
+      anim.last_played_animation = SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT;
       break;
     }
     case SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT:  {
-      play_sprite_on_site(spawn.take_damage_right_animation, spawn.tint, dest);
-      spawn.last_played_animation = SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT;
+      sprite_batch_play_sprite(anim.take_damage_right_animation, SPRITE_LAYER_SCENE, SHADER_ID_SPAWN, tint, dest, spawn_id);
+      anim.last_played_animation = SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT;
       break;
     }
     default: {
@@ -743,22 +1165,22 @@ void spawn_play_anim(Character2D& spawn, spawn_movement_animations movement) {
     }
   }
 }
-void update_spawn_animation(Character2D& spawn) {
-  switch (spawn.last_played_animation) {
+void update_spawn_animation(spawn_animation_data& anim) {
+  switch (anim.last_played_animation) {
     case SPAWN_ZOMBIE_ANIMATION_MOVE_LEFT: {
-      update_sprite(spawn.move_left_animation, (*state->in_ingame_info->delta_time) );
+      update_sprite(anim.move_left_animation, (*state->in_ingame_info->delta_time) );
       break;
     }
     case SPAWN_ZOMBIE_ANIMATION_MOVE_RIGHT: {
-      update_sprite(spawn.move_right_animation, (*state->in_ingame_info->delta_time) );
+      update_sprite(anim.move_right_animation, (*state->in_ingame_info->delta_time) );
       break;
     }
     case SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_LEFT:  {
-      update_sprite(spawn.take_damage_left_animation, (*state->in_ingame_info->delta_time) );
+      update_sprite(anim.take_damage_left_animation, (*state->in_ingame_info->delta_time) );
       break;
     }
     case SPAWN_ZOMBIE_ANIMATION_TAKE_DAMAGE_RIGHT:  {
-      update_sprite(spawn.take_damage_right_animation, (*state->in_ingame_info->delta_time) );
+      update_sprite(anim.take_damage_right_animation, (*state->in_ingame_info->delta_time) );
       break;
     }
     default: {
@@ -767,11 +1189,11 @@ void update_spawn_animation(Character2D& spawn) {
     }
   }
 }
-void spawn_item(std::vector<std::tuple<item_type, i32, data128>> items, data128 context) {
-  for (auto& item : items) {
+void spawn_item(const arena_vector<std::tuple<item_type, i32, data128>>& items, data128 context) {
+  for (const auto& item : items) {
     auto [ type, chance, item_values ] = item;
 
-    if (get_random_ssl(0, 100) < chance) {
+    if (random_range(RANDOM_STREAM_LOOT, 0, 100) < chance) {
       event_fire(EVENT_CODE_SPAWN_ITEM, event_context(static_cast<i16>(type), context.i16[0], context.i16[1], context.i16[2], context.i16[3], item_values.i16[0]));
     }
   }
@@ -782,19 +1204,150 @@ void remove_spawn(i32 index) {
     IWARN("spawn::remove_spawn()::Index is out of bounds");
     return;
   }
-  Character2D& victim = state->spawns[index];
+  spawn_data_soa& spawns = state->spawns;
+  const size_t last = spawns.size() - 1u;
 
-  state->spatial_grid.remove(&victim, victim.position);
-  state->spawn_id_to_index_map.erase(victim.character_id);
+  state->handles.release(spawns.character_id[index]);
+
+  if (static_cast<size_t>(index) != last) {
+    spawn_soa_swap_remove(index);
+    state->handles.relocate(spawns.character_id[index], static_cast<u32>(index));
+    return;
+  }
+  spawn_soa_swap_remove(index);
+}
 
-  if (static_cast<size_t>(index) != state->spawns.size() - 1) {
-    Character2D& moved_spawn = state->spawns.back();
-    state->spatial_grid.remove(&moved_spawn, moved_spawn.position);
-    std::swap(state->spawns[index], state->spawns.back());
-    state->spawn_id_to_index_map[moved_spawn.character_id] = index;
-    state->spatial_grid.insert(&state->spawns[index]);
+void spawn_soa_push(const Character2D& character) {
+  spawn_data_soa& spawns = state->spawns;
+
+  spawns.character_id.push_back(character.character_id);
+  spawns.position.push_back(character.position);
+  spawns.collision.push_back(character.collision);
+  spawns.speed.push_back(character.speed);
+  spawns.damage.push_back(character.damage);
+  spawns.w_direction.push_back(character.w_direction);
+
+  u8 flags = SPAWN_FLAG_NONE;
+  if (character.initialized)           flags |= SPAWN_FLAG_INITIALIZED;
+  if (character.is_dead)               flags |= SPAWN_FLAG_DEAD;
+  if (character.is_damagable)          flags |= SPAWN_FLAG_DAMAGABLE;
+  if (character.is_on_screen)          flags |= SPAWN_FLAG_ON_SCREEN;
+  if (character.is_invisible)          flags |= SPAWN_FLAG_INVISIBLE;
+  if (character.cond_halt_move.is_active) flags |= SPAWN_FLAG_MOVE_HALTED;
+  spawns.flags.push_back(flags);
+
+  spawn_animation_data anim = spawn_animation_data();
+  anim.move_right_animation        = character.move_right_animation;
+  anim.move_left_animation         = character.move_left_animation;
+  anim.take_damage_right_animation = character.take_damage_right_animation;
+  anim.take_damage_left_animation  = character.take_damage_left_animation;
+  anim.death_effect_animation      = character.death_effect_animation;
+  anim.last_played_animation       = character.last_played_animation;
+  anim.tint                        = character.tint;
+  spawns.animation.push_back(anim);
+
+  spawn_stat_data stats = spawn_stat_data();
+  stats.type              = character.type;
+  stats.health_max        = character.health_max;
+  stats.health_current    = character.health_current;
+  stats.rotation          = character.rotation;
+  stats.scale             = character.scale;
+  stats.damage_break_time = character.damage_break_time;
+  stats.cond_halt_move    = character.cond_halt_move;
+  stats.buffer            = character.buffer;
+  spawns.stats.push_back(stats);
+  spawns.previous_position.push_back(character.position);
+}
+/**
+ * @brief Swaps the element with the last one in every array and pops the back. Grid and id map are not touched.
+ */
+void spawn_soa_swap_remove(size_t index) {
+  spawn_data_soa& spawns = state->spawns;
+  const size_t last = spawns.size() - 1u;
+
+  if (index != last) {
+    spawns.character_id[index] = spawns.character_id[last];
+    spawns.position[index]     = spawns.position[last];
+    spawns.collision[index]    = spawns.collision[last];
+    spawns.speed[index]        = spawns.speed[last];
+    spawns.damage[index]       = spawns.damage[last];
+    spawns.w_direction[index]  = spawns.w_direction[last];
+    spawns.flags[index]        = spawns.flags[last];
+    spawns.animation[index]    = spawns.animation[last];
+    spawns.stats[index]        = spawns.stats[last];
+    spawns.previous_position[index] = spawns.previous_position[last];
   }
-  state->spawns.pop_back();
+  spawns.character_id.pop_back();
+  spawns.position.pop_back();
+  spawns.collision.pop_back();
+  spawns.speed.pop_back();
+  spawns.damage.pop_back();
+  spawns.w_direction.pop_back();
+  spawns.flags.pop_back();
+  spawns.animation.pop_back();
+  spawns.stats.pop_back();
+  spawns.previous_position.pop_back();
+}
+void spawn_soa_gather(size_t index, Character2D& out) {
+  const spawn_data_soa& spawns = state->spawns;
+  const spawn_animation_data& anim = spawns.animation[index];
+  const spawn_stat_data& stats = spawns.stats[index];
+
+  out.character_id                = spawns.character_id[index];
+  out.position                    = spawns.position[index];
+  out.collision                   = spawns.collision[index];
+  out.speed                       = spawns.speed[index];
+  out.damage                      = spawns.damage[index];
+  out.w_direction                 = spawns.w_direction[index];
+  out.initialized                 = spawns.has_flag(index, SPAWN_FLAG_INITIALIZED);
+  out.is_dead                     = spawns.has_flag(index, SPAWN_FLAG_DEAD);
+  out.is_damagable                = spawns.has_flag(index, SPAWN_FLAG_DAMAGABLE);
+  out.is_on_screen                = spawns.has_flag(index, SPAWN_FLAG_ON_SCREEN);
+  out.is_invisible                = spawns.has_flag(index, SPAWN_FLAG_INVISIBLE);
+  out.move_right_animation        = anim.move_right_animation;
+  out.move_left_animation         = anim.move_left_animation;
+  out.take_damage_right_animation = anim.take_damage_right_animation;
+  out.take_damage_left_animation  = anim.take_damage_left_animation;
+  out.death_effect_animation      = anim.death_effect_animation;
+  out.last_played_animation       = anim.last_played_animation;
+  out.tint                        = anim.tint;
+  out.type                        = stats.type;
+  out.health_max                  = stats.health_max;
+  out.health_current              = stats.health_current;
+  out.rotation                    = stats.rotation;
+  out.scale                       = stats.scale;
+  out.damage_break_time           = stats.damage_break_time;
+  out.cond_halt_move              = stats.cond_halt_move;
+  out.cond_halt_move.is_active    = spawns.has_flag(index, SPAWN_FLAG_MOVE_HALTED);
+  out.buffer                      = stats.buffer;
+}
+void spawn_soa_clear(void) {
+  spawn_data_soa& spawns = state->spawns;
+
+  spawns.character_id.clear();
+  spawns.position.clear();
+  spawns.collision.clear();
+  spawns.speed.clear();
+  spawns.damage.clear();
+  spawns.w_direction.clear();
+  spawns.flags.clear();
+  spawns.animation.clear();
+  spawns.stats.clear();
+  spawns.previous_position.clear();
+}
+void spawn_soa_reserve(size_t capacity) {
+  spawn_data_soa& spawns = state->spawns;
+
+  spawns.character_id.reserve(capacity);
+  spawns.position.reserve(capacity);
+  spawns.collision.reserve(capacity);
+  spawns.speed.reserve(capacity);
+  spawns.damage.reserve(capacity);
+  spawns.w_direction.reserve(capacity);
+  spawns.flags.reserve(capacity);
+  spawns.animation.reserve(capacity);
+  spawns.stats.reserve(capacity);
+  spawns.previous_position.reserve(capacity);
 }
 
 void register_spawn_animation(Character2D& spawn, spawn_movement_animations movement) {
@@ -952,52 +1505,42 @@ bool spawn_on_event(i32 code, event_context context) {
       return true;
     }
     case EVENT_CODE_SET_SPAWN_TINT: {
-      const i16& spw_id = context.data.i16[0];
-      const i16& spw_index = context.data.i16[1];
-      if (static_cast<size_t>(spw_index) >= state->spawns.size() or state->spawns[spw_index].character_id != spw_id) {
+      const i32 spw_id = context.data.i32[0];
+      const i32 spw_index = context.data.i32[1];
+      if (spw_index < 0 or static_cast<size_t>(spw_index) >= state->spawns.size() or state->spawns.character_id[spw_index] != spw_id) {
         return false;
       }
-      state->spawns[spw_index].tint = Color { 
-        static_cast<u8>(context.data.i16[2]), 
-        static_cast<u8>(context.data.i16[3]), 
-        static_cast<u8>(context.data.i16[4]), 
-        static_cast<u8>(context.data.i16[5])
+      state->spawns.animation[spw_index].tint = Color { 
+        context.data.u8[8], context.data.u8[9], context.data.u8[10], context.data.u8[11]
       };
       return true;
     }
     case EVENT_CODE_HALT_SPAWN_MOVEMENT: {
-      const i32 spw_id = static_cast<i32>(context.data.f32[0]);
-      const i32 spw_index = static_cast<i32>(context.data.f32[1]);
+      const i32 spw_id = context.data.i32[0];
+      const i32 spw_index = context.data.i32[1];
       const f32 duration = context.data.f32[2];
       if (spw_index < 0 or static_cast<size_t>(spw_index) >= state->spawns.size()) {
         return false;
       }
-      if (state->spawns[spw_index].character_id != spw_id) {
+      if (state->spawns.character_id[spw_index] != spw_id) {
         return false;
       }
-      state->spawns[spw_index].cond_halt_move.is_active = true;
-      state->spawns[spw_index].cond_halt_move.duration = duration;
-      state->spawns[spw_index].cond_halt_move.accumulator = 0.f;
+      spawn_set_flag(spw_index, SPAWN_FLAG_MOVE_HALTED, true);
+      state->spawns.stats[spw_index].cond_halt_move.duration = duration;
+      state->spawns.stats[spw_index].cond_halt_move.accumulator = 0.f;
       return true;
     }
     case EVENT_CODE_DAMAGE_SPAWN_BY_ID: {
-      damage_spawn(context.data.i32[0], context.data.i32[1]);
+      queue_spawn_damage_by_id(context.data.i32[0], context.data.i32[1], context.data.i32[2]);
       return true;
     }
     case EVENT_CODE_DAMAGE_SPAWN_ROTATED_RECT: {
-      const Rectangle rect = {
-        static_cast<f32>(context.data.i16[0]), 
-        static_cast<f32>(context.data.i16[1]), 
-        static_cast<f32>(context.data.i16[2]), 
-        static_cast<f32>(context.data.i16[3])
-      };
-      const i32 damage = static_cast<i32>(context.data.i16[4]);
-      const f32 rotation = static_cast<i32>(context.data.i16[5]);
-      const Vector2 origin = {
-        static_cast<f32>(context.data.i16[6]), 
-        static_cast<f32>(context.data.i16[7])
-      };
-      damage_spawn_rotated_rect(rect, damage, rotation, origin);
+      const damage_rotated_rect_payload * const payload = event_payload<damage_rotated_rect_payload>(context);
+      if (not payload or payload == nullptr) {
+        IWARN("spawn::spawn_on_event()::Rotated rect damage payload is not valid");
+        return false;
+      }
+      queue_spawn_damage_rotated_rect(payload->rect, payload->damage, payload->rotation, payload->origin, payload->source);
       return true;
     }
     default: {
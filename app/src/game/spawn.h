@@ -3,23 +3,30 @@
 
 #include "game_types.h"
 
-[[nodiscard]] bool spawn_system_initialize(const camera_metrics* _camera_metrics, const ingame_info* _ingame_info);
+[[nodiscard]] bool spawn_system_initialize(const camera_metrics* _camera_metrics, const tilemap ** const in_active_map_ptr, const ingame_info* _ingame_info);
 
 bool update_spawns(Vector2 player_position);
 void update_spawns_animation_only(void);
 bool render_spawns(void);
 
-std::vector<Character2D>* get_spawns(void);
+const spawn_data_soa* get_spawns(void);
 const Character2D * get_spawn_by_id(i32 _id);
 const element_handle * get_nearest_spawn(void);
 const element_handle * get_first_spawn_on_screen(void);
 
 i32 spawn_character(Character2D _character);
 damage_deal_result damage_spawn(i32 _id, i32 damage);
-damage_deal_result damage_spawn_by_collision(Rectangle rect, i32 damage, collision_type coll_type);
-damage_deal_result damage_spawn_rotated_rect(Rectangle rect, i32 damage, f32 rotation, Vector2 origin);
+void queue_spawn_damage_by_id(i32 _id, i32 damage, i32 source);
+void queue_spawn_damage_by_collision(Rectangle rect, i32 damage, collision_type coll_type, i32 source);
+void queue_spawn_damage_rotated_rect(Rectangle rect, i32 damage, f32 rotation, Vector2 origin, i32 source);
+void resolve_spawn_damage(void);
+spawn_contact_result query_spawn_player_contact(Rectangle player_collision);
 
 void clean_up_spawn_state(void);
 
+#if HEADLESS_BUILD
+void spawn_rebuild_spatial_grid(void);
+#endif
+
 
 #endif
@@ -1,11 +1,61 @@
 #include "spritesheet.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 
+#include "rlgl.h"
+
+#include "core/fmemory.h"
 #include "core/logger.h"
 
+#include "game/fshader.h"
 #include "game/resource.h"
 
+typedef struct sprite_draw_command {
+  u64 sort_key;
+  sprite_layer layer;
+  shader_id shader;
+  f32 instance_value;
+  Texture2D texture;
+  Rectangle source;
+  Rectangle dest;
+  Vector2 origin;
+  f32 rotation;
+  Color tint;
+} sprite_draw_command;
+
+typedef struct sprite_sort_entry {
+  u64 key;
+  u32 command;
+} sprite_sort_entry;
+
+typedef struct sprite_batch_state {
+  std::vector<sprite_draw_command> commands;
+  std::vector<sprite_sort_entry> sort_entries;
+  std::vector<sprite_sort_entry> sort_scratch;
+  sprite_batch_stats stats;
+  sprite_batch_backend backend;
+  bool is_recording;
+
+  sprite_batch_state(void) {
+    this->commands = std::vector<sprite_draw_command>();
+    this->sort_entries = std::vector<sprite_sort_entry>();
+    this->sort_scratch = std::vector<sprite_sort_entry>();
+    this->stats = sprite_batch_stats();
+    this->backend = SPRITE_BATCH_BACKEND_UNDEFINED;
+    this->is_recording = false;
+  }
+} sprite_batch_state;
+
+static sprite_batch_state * batch_state = nullptr;
+
 constexpr void render_sprite(const spritesheet * sheet,const Color _tint,const Rectangle dest);
 constexpr void render_sprite_pro(const spritesheet * sheet, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint);
+void sprite_batch_push(sprite_layer layer, shader_id shader, f32 instance_value, const Texture2D& texture, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint);
+void sprite_batch_sort(void);
+const spritesheet * begin_projectile_animation(projectile_animation& anim);
+Rectangle projectile_animation_source(const spritesheet& sheet, const projectile_animation& anim);
+void draw_texture_quad_instanced(const Texture2D& texture, Rectangle source, Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint, const f32 instance_value);
  
 void update_sprite(spritesheet& sheet, f32 delta_time) {
   if (sheet.fps <= 0.f) {
@@ -100,6 +150,36 @@ void play_sprite_on_site_pro(spritesheet& sheet, const Rectangle dest, const Vec
   };
   render_sprite_pro(sheet, source, dest, origin, rotation, _tint);
 }
+/**
+ * @brief Applies the play_once rule and marks the animation started. Returns the resource sheet to draw from, or nullptr to skip
+ */
+const spritesheet * begin_projectile_animation(projectile_animation& anim) {
+  if (anim.has_flag(PROJECTILE_ANIMATION_FLAG_PLAY_ONCE) and anim.has_flag(PROJECTILE_ANIMATION_FLAG_PLAYED) and not anim.has_flag(PROJECTILE_ANIMATION_FLAG_STARTED)) { 
+    return nullptr; 
+  }
+  const spritesheet * const _sheet_ptr = get_spritesheet_by_enum(anim.sheet_id);
+  if (not _sheet_ptr or _sheet_ptr == nullptr or not _sheet_ptr->tex_handle or _sheet_ptr->col_total <= 0) { 
+    return nullptr; 
+  }
+  anim.flags |= PROJECTILE_ANIMATION_FLAG_STARTED;
+  return _sheet_ptr;
+}
+Rectangle projectile_animation_source(const spritesheet& sheet, const projectile_animation& anim) {
+  const i32 col = anim.current_frame % sheet.col_total;
+  const i32 row = anim.current_frame / sheet.col_total;
+  return Rectangle {
+    sheet.offset.x + col * std::abs(sheet.current_frame_rect.width), 
+    sheet.offset.y + row * std::abs(sheet.current_frame_rect.height),
+    sheet.current_frame_rect.width, 
+    sheet.current_frame_rect.height
+  };
+}
+void play_sprite_on_site_pro(projectile_animation& anim, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint) {
+  const spritesheet * const _sheet_ptr = begin_projectile_animation(anim);
+  if (not _sheet_ptr or _sheet_ptr == nullptr) { return; }
+
+  render_sprite_pro((*_sheet_ptr), projectile_animation_source(*_sheet_ptr, anim), dest, origin, rotation, _tint);
+}
 void play_sprite_on_site_ex(spritesheet& sheet, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint) {
   if (sheet.play_once and sheet.is_played and not sheet.is_started) { return; }
 
@@ -180,6 +260,383 @@ void reset_sprite(spritesheet& sheet, bool _retrospective) {
     sheet.is_started = false;
   }
 }
+void set_sprite(projectile_animation& anim, spritesheet_id _id, bool _loop_animation, bool _lock_after_finish) {
+  const spritesheet * const _sheet_ptr = get_spritesheet_by_enum(_id);
+  if (not _sheet_ptr or _sheet_ptr == nullptr) {
+    IERROR("spritesheet::set_sprite()::Sheet resourse pointer is not valid");
+    return;
+  }
+  anim = projectile_animation();
+  anim.sheet_id = _id;
+  if (_loop_animation) { anim.flags |= PROJECTILE_ANIMATION_FLAG_LOOPED; }
+  if (_lock_after_finish) { anim.flags |= PROJECTILE_ANIMATION_FLAG_PLAY_ONCE; }
+}
+/**
+ * @brief Advances by whole frames like update_sprite(). A finished sheet that doesn't loop stops on its first frame and is marked played
+ */
+void update_sprite(projectile_animation& anim, f32 delta_time) {
+  const spritesheet * const _sheet_ptr = get_spritesheet_by_enum(anim.sheet_id);
+  if (not _sheet_ptr or _sheet_ptr == nullptr or _sheet_ptr->fps <= 0.f) {
+    IWARN("spritesheet::update_sprite()::Sheet is not meant to be playable");
+    return;
+  }
+  if (not anim.has_flag(PROJECTILE_ANIMATION_FLAG_STARTED) or (anim.has_flag(PROJECTILE_ANIMATION_FLAG_PLAYED) and anim.has_flag(PROJECTILE_ANIMATION_FLAG_PLAY_ONCE))) {
+    return;
+  }
+  const i32 frame_count = _sheet_ptr->col_total * _sheet_ptr->row_total;
+  const f32 time_per_frame = 1.0f / _sheet_ptr->fps;
+  anim.time_accumulator += delta_time;
+
+  while (anim.time_accumulator >= time_per_frame) {
+    anim.time_accumulator -= time_per_frame;
+    anim.current_frame++;
+    if (anim.current_frame >= frame_count) {
+      reset_sprite(anim, false);
+      if (not anim.has_flag(PROJECTILE_ANIMATION_FLAG_LOOPED)) {
+        anim.flags &= static_cast<u8>(~PROJECTILE_ANIMATION_FLAG_STARTED);
+        anim.flags |= PROJECTILE_ANIMATION_FLAG_PLAYED;
+      }
+      return;
+    }
+  }
+}
+void reset_sprite(projectile_animation& anim, bool _retrospective) {
+  anim.time_accumulator = 0.f;
+  anim.current_frame = 0;
+
+  if (_retrospective) {
+    anim.flags &= static_cast<u8>(~(PROJECTILE_ANIMATION_FLAG_STARTED | PROJECTILE_ANIMATION_FLAG_PLAYED));
+  }
+}
+bool sprite_batch_initialize(sprite_batch_backend backend) {
+  if (backend <= SPRITE_BATCH_BACKEND_UNDEFINED or backend >= SPRITE_BATCH_BACKEND_MAX) {
+    IERROR("spritesheet::sprite_batch_initialize()::Backend is out of bound");
+    return false;
+  }
+  if (batch_state and batch_state != nullptr) {
+    batch_state->backend = backend;
+    return true;
+  }
+  batch_state = (sprite_batch_state *)allocate_memory_linear(sizeof(sprite_batch_state), true, MEMORY_TAG_RESOURCE);
+  if (not batch_state or batch_state == nullptr) {
+    IERROR("spritesheet::sprite_batch_initialize()::State allocation failed");
+    return false;
+  }
+  *batch_state = sprite_batch_state();
+  batch_state->backend = backend;
+  batch_state->commands.reserve(SPRITE_BATCH_RESERVE_COUNT);
+  batch_state->sort_entries.reserve(SPRITE_BATCH_RESERVE_COUNT);
+  batch_state->sort_scratch.reserve(SPRITE_BATCH_RESERVE_COUNT);
+  return true;
+}
+void sprite_batch_begin(void) {
+  if (not batch_state or batch_state == nullptr) {
+    return;
+  }
+  if (batch_state->is_recording) {
+    IWARN("spritesheet::sprite_batch_begin()::Previous batch was not flushed");
+  }
+  batch_state->commands.clear();
+  batch_state->is_recording = true;
+}
+/**
+ * @brief Same playback rules as play_sprite_on_site(). Draws immediately when there is no open batch
+ */
+void sprite_batch_play_sprite(spritesheet& sheet, sprite_layer layer, shader_id shader, Color _tint, const Rectangle dest, f32 instance_value) {
+  if (not batch_state or batch_state == nullptr or not batch_state->is_recording) {
+    if (shader > SHADER_ID_UNSPECIFIED and shader < SHADER_ID_MAX) {
+      const fshader * const _shader = get_shader_by_enum(shader);
+      BeginShaderMode(_shader->handle);
+      if (_shader->has_instance_value) {
+        if (not (sheet.play_once and sheet.is_played and not sheet.is_started) and sheet.tex_handle != nullptr) {
+          sheet.is_started = true;
+          sheet.tint = _tint;
+          draw_texture_quad_instanced((*sheet.tex_handle), 
+            Rectangle { sheet.current_frame_rect.x + sheet.offset.x, sheet.current_frame_rect.y + sheet.offset.y, sheet.current_frame_rect.width, sheet.current_frame_rect.height },
+            dest, sheet.origin, sheet.rotation, _tint, instance_value
+          );
+        }
+      }
+      else {
+        play_sprite_on_site(sheet, _tint, dest);
+      }
+      EndShaderMode();
+    }
+    else {
+      play_sprite_on_site(sheet, _tint, dest);
+    }
+    return;
+  }
+  if (sheet.play_once and sheet.is_played and not sheet.is_started) { 
+    return; 
+  }
+  if (not sheet.tex_handle or sheet.tex_handle == nullptr) {
+    return;
+  }
+  sheet.is_started = true;
+  sheet.tint = _tint;
+
+  sprite_batch_push(layer, shader, instance_value, (*sheet.tex_handle), 
+    Rectangle { sheet.current_frame_rect.x + sheet.offset.x, sheet.current_frame_rect.y + sheet.offset.y, sheet.current_frame_rect.width, sheet.current_frame_rect.height },
+    dest, sheet.origin, sheet.rotation, _tint
+  );
+}
+/**
+ * @brief Same playback rules as play_sprite_on_site_pro()
+ */
+void sprite_batch_play_sprite_pro(spritesheet& sheet, sprite_layer layer, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint) {
+  if (not batch_state or batch_state == nullptr or not batch_state->is_recording) {
+    play_sprite_on_site_pro(sheet, dest, origin, rotation, _tint);
+    return;
+  }
+  if (sheet.play_once and sheet.is_played and not sheet.is_started) { return; }
+  if (not sheet.tex_handle or sheet.tex_handle == nullptr) { return; }
+
+  sheet.is_started = true;
+
+  sprite_batch_push(layer, SHADER_ID_UNSPECIFIED, 0.f, (*sheet.tex_handle), 
+    Rectangle { sheet.current_frame_rect.x + sheet.offset.x, sheet.current_frame_rect.y + sheet.offset.y, sheet.current_frame_rect.width, sheet.current_frame_rect.height },
+    dest, origin, rotation, _tint
+  );
+}
+/**
+ * @brief Same playback rules as play_sprite_on_site_ex()
+ */
+void sprite_batch_play_sprite_ex(spritesheet& sheet, sprite_layer layer, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint) {
+  if (not batch_state or batch_state == nullptr or not batch_state->is_recording) {
+    play_sprite_on_site_ex(sheet, source, dest, origin, rotation, _tint);
+    return;
+  }
+  if (sheet.play_once and sheet.is_played and not sheet.is_started) { return; }
+  if (not sheet.tex_handle or sheet.tex_handle == nullptr) { return; }
+
+  sheet.is_started = true;
+
+  sprite_batch_push(layer, SHADER_ID_UNSPECIFIED, 0.f, (*sheet.tex_handle), source, dest, origin, rotation, _tint);
+}
+/**
+ * @brief Same playback rules as sprite_batch_play_sprite_pro(), the frame is cut from the resource sheet
+ */
+void sprite_batch_play_sprite_pro(projectile_animation& anim, sprite_layer layer, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint) {
+  if (not batch_state or batch_state == nullptr or not batch_state->is_recording) {
+    play_sprite_on_site_pro(anim, dest, origin, rotation, _tint);
+    return;
+  }
+  const spritesheet * const _sheet_ptr = begin_projectile_animation(anim);
+  if (not _sheet_ptr or _sheet_ptr == nullptr) { return; }
+
+  sprite_batch_push(layer, SHADER_ID_UNSPECIFIED, 0.f, (*_sheet_ptr->tex_handle), projectile_animation_source(*_sheet_ptr, anim), dest, origin, rotation, _tint);
+}
+void sprite_batch_draw_texture(const Texture2D& texture, sprite_layer layer, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint) {
+  if (not batch_state or batch_state == nullptr or not batch_state->is_recording) {
+    DrawTexturePro(texture, source, dest, origin, rotation, _tint);
+    return;
+  }
+  sprite_batch_push(layer, SHADER_ID_UNSPECIFIED, 0.f, texture, source, dest, origin, rotation, _tint);
+}
+/**
+ * @brief Sort key is computed once here and kept by value. Layer on the top byte, texture and shader on the low bytes.
+ * @brief Scene sprites put the depth of the quad's bottom edge in between
+ */
+void sprite_batch_push(sprite_layer layer, shader_id shader, f32 instance_value, const Texture2D& texture, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint) {
+  u64 sort_key = (static_cast<u64>(texture.id & 0xFFFFu) << 8) | static_cast<u64>(static_cast<u8>(shader));
+  sort_key |= static_cast<u64>(layer) << 56;
+  if (layer == SPRITE_LAYER_SCENE) {
+    const f32 bottom = std::clamp(dest.y - origin.y + dest.height, -8388608.f, 8388607.f);
+    const u64 depth = static_cast<u64>(static_cast<i64>(bottom) + 8388608); // INFO: 24 bits, offset so negative values keep their order
+    sort_key |= depth << 32;
+  }
+
+  batch_state->commands.push_back(sprite_draw_command {
+    sort_key, layer, shader, instance_value, texture, source, dest, origin, rotation, _tint
+  });
+}
+void sprite_batch_flush(void) {
+  if (not batch_state or batch_state == nullptr or not batch_state->is_recording) {
+    return;
+  }
+  batch_state->is_recording = false;
+  batch_state->stats = sprite_batch_stats();
+  const std::vector<sprite_draw_command>& commands = batch_state->commands;
+
+  sprite_batch_sort();
+  const bool will_draw = batch_state->backend == SPRITE_BATCH_BACKEND_RAYLIB;
+  shader_id active_shader = SHADER_ID_UNSPECIFIED;
+  bool is_active_shader_instanced = false;
+  u32 active_texture = 0u;
+
+  for (const sprite_sort_entry& entry : batch_state->sort_entries) {
+    const sprite_draw_command& cmd = commands[entry.command];
+    if (cmd.shader != active_shader) {
+      if (will_draw and active_shader != SHADER_ID_UNSPECIFIED) {
+        EndShaderMode();
+      }
+      is_active_shader_instanced = false;
+      if (will_draw and cmd.shader != SHADER_ID_UNSPECIFIED) {
+        const fshader * const _shader = get_shader_by_enum(cmd.shader);
+        BeginShaderMode(_shader->handle);
+        is_active_shader_instanced = _shader->has_instance_value;
+      }
+      active_shader = cmd.shader;
+      batch_state->stats.shader_switch_count++;
+    }
+    if (cmd.texture.id != active_texture) {
+      active_texture = cmd.texture.id;
+      batch_state->stats.texture_switch_count++;
+    }
+    if (will_draw and is_active_shader_instanced) {
+      draw_texture_quad_instanced(cmd.texture, cmd.source, cmd.dest, cmd.origin, cmd.rotation, cmd.tint, cmd.instance_value);
+    }
+    else if (will_draw) {
+      DrawTexturePro(cmd.texture, cmd.source, cmd.dest, cmd.origin, cmd.rotation, cmd.tint);
+    }
+    batch_state->stats.quad_count++;
+  }
+  if (will_draw and active_shader != SHADER_ID_UNSPECIFIED) {
+    EndShaderMode();
+  }
+  batch_state->commands.clear();
+}
+/**
+ * @brief Same quad as DrawTexturePro(), but every vertex carries instance_value in its z. Instanced shaders read it from there
+ * @brief and draw at z 0, so quads with different values stay in one raylib batch as long as texture and shader match
+ */
+void draw_texture_quad_instanced(const Texture2D& texture, Rectangle source, Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint, const f32 instance_value) {
+  if (texture.id == 0u or texture.width <= 0 or texture.height <= 0) {
+    return;
+  }
+  const f32 width = static_cast<f32>(texture.width);
+  const f32 height = static_cast<f32>(texture.height);
+  bool flip_x = false;
+  if (source.width < 0.f) { 
+    flip_x = true; 
+    source.width *= -1.f; 
+  }
+  if (source.height < 0.f) {
+    source.y -= source.height;
+  }
+  dest.width = std::abs(dest.width);
+  dest.height = std::abs(dest.height);
+
+  Vector2 top_left = ZEROVEC2;
+  Vector2 top_right = ZEROVEC2;
+  Vector2 bottom_left = ZEROVEC2;
+  Vector2 bottom_right = ZEROVEC2;
+  if (rotation == 0.f) {
+    const f32 x = dest.x - origin.x;
+    const f32 y = dest.y - origin.y;
+    top_left     = Vector2 { x, y };
+    top_right    = Vector2 { x + dest.width, y };
+    bottom_left  = Vector2 { x, y + dest.height };
+    bottom_right = Vector2 { x + dest.width, y + dest.height };
+  }
+  else {
+    const f32 sin_rotation = std::sin(rotation * DEG2RAD);
+    const f32 cos_rotation = std::cos(rotation * DEG2RAD);
+    const f32 dx = -origin.x;
+    const f32 dy = -origin.y;
+    top_left     = Vector2 { dest.x + dx * cos_rotation - dy * sin_rotation, dest.y + dx * sin_rotation + dy * cos_rotation };
+    top_right    = Vector2 { dest.x + (dx + dest.width) * cos_rotation - dy * sin_rotation, dest.y + (dx + dest.width) * sin_rotation + dy * cos_rotation };
+    bottom_left  = Vector2 { dest.x + dx * cos_rotation - (dy + dest.height) * sin_rotation, dest.y + dx * sin_rotation + (dy + dest.height) * cos_rotation };
+    bottom_right = Vector2 { 
+      dest.x + (dx + dest.width) * cos_rotation - (dy + dest.height) * sin_rotation, dest.y + (dx + dest.width) * sin_rotation + (dy + dest.height) * cos_rotation 
+    };
+  }
+  const f32 u_left   = (flip_x ? source.x + source.width : source.x) / width;
+  const f32 u_right  = (flip_x ? source.x : source.x + source.width) / width;
+  const f32 v_top    = source.y / height;
+  const f32 v_bottom = (source.y + source.height) / height;
+
+  rlSetTexture(texture.id);
+  rlBegin(RL_QUADS);
+    rlColor4ub(_tint.r, _tint.g, _tint.b, _tint.a);
+    rlNormal3f(0.f, 0.f, 1.f);
+    rlTexCoord2f(u_left, v_top);
+    rlVertex3f(top_left.x, top_left.y, instance_value);
+    rlTexCoord2f(u_left, v_bottom);
+    rlVertex3f(bottom_left.x, bottom_left.y, instance_value);
+    rlTexCoord2f(u_right, v_bottom);
+    rlVertex3f(bottom_right.x, bottom_right.y, instance_value);
+    rlTexCoord2f(u_right, v_top);
+    rlVertex3f(top_right.x, top_right.y, instance_value);
+  rlEnd();
+  rlSetTexture(0u);
+}
+/**
+ * @brief Both paths are stable, so sprites sharing a key keep the order they were played in. Scenes are mostly played
+ * @brief in nearly sorted order, props come from the y sorted map queue, so an insertion sort finishes in about one pass.
+ * @brief Few descents do not bound the moves, two sorted runs back to back have one descent and quadratic moves, so the
+ * @brief insertion sort has a move budget. Past it, or with too many descents, a byte-wise radix sort runs, skipping the
+ * @brief bytes every key shares. Insertion never reorders equal keys, so the radix pass can pick up where it stopped
+ */
+void sprite_batch_sort(void) {
+  std::vector<sprite_sort_entry>& entries = batch_state->sort_entries;
+  std::vector<sprite_sort_entry>& scratch = batch_state->sort_scratch;
+  const std::vector<sprite_draw_command>& commands = batch_state->commands;
+  entries.clear();
+
+  size_t descent_count = 0u;
+  for (size_t itr_000 = 0u; itr_000 < commands.size(); ++itr_000) {
+    entries.push_back(sprite_sort_entry {commands[itr_000].sort_key, static_cast<u32>(itr_000)});
+    if (itr_000 > 0u and commands[itr_000 - 1u].sort_key > commands[itr_000].sort_key) {
+      descent_count++;
+    }
+  }
+  if (descent_count == 0u) {
+    batch_state->stats.is_insertion_sorted = true;
+    return;
+  }
+  if (descent_count * SPRITE_BATCH_INSERTION_SORT_DIV <= entries.size()) {
+    size_t shift_budget = entries.size() * SPRITE_BATCH_INSERTION_SHIFT_BUDGET;
+    bool is_sorted = true;
+    for (size_t itr_000 = 1u; itr_000 < entries.size() and is_sorted; ++itr_000) {
+      const sprite_sort_entry entry = entries[itr_000];
+      size_t itr_111 = itr_000;
+      for (; itr_111 > 0u and entries[itr_111 - 1u].key > entry.key; --itr_111) {
+        if (shift_budget == 0u) {
+          is_sorted = false;
+          break;
+        }
+        entries[itr_111] = entries[itr_111 - 1u];
+        shift_budget--;
+      }
+      entries[itr_111] = entry;
+    }
+    if (is_sorted) {
+      batch_state->stats.is_insertion_sorted = true;
+      return;
+    }
+  }
+  u64 varying_bits = 0u;
+  for (const sprite_sort_entry& entry : entries) {
+    varying_bits |= entry.key ^ entries.front().key;
+  }
+  scratch.resize(entries.size());
+  for (u32 shift = 0u; shift < 64u; shift += 8u) {
+    if (((varying_bits >> shift) & 0xFFu) == 0u) {
+      continue;
+    }
+    std::array<u32, 257> offsets = {};
+    for (const sprite_sort_entry& entry : entries) {
+      offsets[((entry.key >> shift) & 0xFFu) + 1u]++;
+    }
+    for (size_t itr_000 = 1u; itr_000 < offsets.size(); ++itr_000) {
+      offsets[itr_000] += offsets[itr_000 - 1u];
+    }
+    for (const sprite_sort_entry& entry : entries) {
+      scratch[offsets[(entry.key >> shift) & 0xFFu]++] = entry;
+    }
+    entries.swap(scratch);
+  }
+}
+const sprite_batch_stats& sprite_batch_get_stats(void) {
+  static const sprite_batch_stats empty_stats = sprite_batch_stats();
+  if (not batch_state or batch_state == nullptr) {
+    return empty_stats;
+  }
+  return batch_state->stats;
+}
+
 const Texture2D* ss_get_texture_by_enum(texture_id _id) {
   return get_texture_by_enum(_id);
 }
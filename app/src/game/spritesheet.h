@@ -4,6 +4,42 @@
 
 #include "game_types.h"
 
+#define SPRITE_BATCH_RESERVE_COUNT 4096u
+#define SPRITE_BATCH_INSERTION_SORT_DIV 32u // INFO: Insertion sort while at most one in this many neighbors is out of order
+#define SPRITE_BATCH_INSERTION_SHIFT_BUDGET 8u // INFO: ...and gives up once it has moved entries this many times the entry count
+
+/**
+ * @brief Batched sprites are drawn in layer order, then grouped by texture and shader.
+ * @brief Scene layer is depth sorted first, by the bottom edge of each quad, so props, player, spawns and projectiles overlap correctly.
+ * @brief Spawn sheets share the asset atlas and the spawn shader, so spawns only break the batch where a prop or the player is between them
+ */
+typedef enum sprite_layer {
+  SPRITE_LAYER_UNDEFINED,
+  SPRITE_LAYER_SCENE,
+  SPRITE_LAYER_EFFECT,
+  SPRITE_LAYER_MAX,
+} sprite_layer;
+
+typedef enum sprite_batch_backend {
+  SPRITE_BATCH_BACKEND_UNDEFINED,
+  SPRITE_BATCH_BACKEND_RAYLIB,
+  SPRITE_BATCH_BACKEND_RECORDING, // INFO: Counts what would be drawn, without touching the GPU
+  SPRITE_BATCH_BACKEND_MAX,
+} sprite_batch_backend;
+
+typedef struct sprite_batch_stats {
+  u32 quad_count;
+  u32 shader_switch_count;
+  u32 texture_switch_count;
+  bool is_insertion_sorted;
+  sprite_batch_stats(void) {
+    this->quad_count = 0u;
+    this->shader_switch_count = 0u;
+    this->texture_switch_count = 0u;
+    this->is_insertion_sorted = false;
+  }
+} sprite_batch_stats;
+
 void set_sprite(spritesheet& sheet, bool _loop_animation, bool _lock_after_finish);
 void update_sprite(spritesheet& sheet, f32 delta_time);
 void play_sprite_on_site(spritesheet& sheet, Color _tint, const Rectangle dest);
@@ -14,6 +50,33 @@ void draw_sprite_on_site_by_id(spritesheet_id _id, Color _tint, Vector2 pos, Vec
 void stop_sprite(spritesheet& sheet, bool reset);
 void reset_sprite(spritesheet& sheet, bool _retrospective);
 
+/**
+ * @brief Same playback rules as the spritesheet versions, on the frame state a projectile keeps per sprite
+ */
+void set_sprite(projectile_animation& anim, spritesheet_id _id, bool _loop_animation, bool _lock_after_finish);
+void update_sprite(projectile_animation& anim, f32 delta_time);
+void reset_sprite(projectile_animation& anim, bool _retrospective);
+void play_sprite_on_site_pro(projectile_animation& anim, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint);
+
+[[__nodiscard__]] bool sprite_batch_initialize(sprite_batch_backend backend);
+
+/**
+ * @brief Sprites played between begin and flush are queued, then drawn at flush with as few batch breaks as possible.
+ * @brief instance_value reaches shaders loaded with an instance value through the vertices, so it never breaks the batch.
+ */
+void sprite_batch_begin(void);
+void sprite_batch_play_sprite(spritesheet& sheet, sprite_layer layer, shader_id shader, Color _tint, const Rectangle dest, f32 instance_value = 0.f);
+void sprite_batch_play_sprite_pro(spritesheet& sheet, sprite_layer layer, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint);
+void sprite_batch_play_sprite_ex(spritesheet& sheet, sprite_layer layer, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint);
+void sprite_batch_play_sprite_pro(projectile_animation& anim, sprite_layer layer, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint);
+void sprite_batch_draw_texture(const Texture2D& texture, sprite_layer layer, const Rectangle source, const Rectangle dest, const Vector2 origin, const f32 rotation, const Color _tint);
+void sprite_batch_flush(void);
+
+/**
+ * @brief Totals of the last flush. Every texture or shader switch is a draw call on the raylib backend
+ */
+const sprite_batch_stats& sprite_batch_get_stats(void);
+
 // Exposed functions from resource.h
 const Texture2D* ss_get_texture_by_enum(texture_id _id);
 const atlas_texture* ss_get_atlas_texture_by_enum(atlas_texture_id _id);
@@ -1,5 +1,6 @@
 #include "tilemap.h"
 #include <algorithm>
+#include <cmath>
 #include "core/fmemory.h"
 #include "core/logger.h"
 
@@ -24,9 +25,59 @@
 #define COLL_MEMBER_PARSE_TOP_LIMIT 99
 
 #define TOTAL_NUMBER_OF_TILES_TO_THE_HEIGHT 18
+#define TILEMAP_CHUNK_VERIFY_TOLERANCE .01f
+
+typedef struct tilemap_chunk_draw {
+  Rectangle source;
+  Rectangle dest;
+  tilemap_chunk_draw(void) {
+    this->source = ZERORECT;
+    this->dest = ZERORECT;
+  }
+  tilemap_chunk_draw(Rectangle _source, Rectangle _dest) : tilemap_chunk_draw() {
+    this->source = _source;
+    this->dest = _dest;
+  }
+} tilemap_chunk_draw;
+
+typedef struct tilemap_chunk {
+  RenderTexture2D target;
+  std::vector<tilemap_chunk_draw> recorded_draws;
+  bool is_baked;
+  tilemap_chunk(void) {
+    this->target = RenderTexture2D {};
+    this->recorded_draws = std::vector<tilemap_chunk_draw>();
+    this->is_baked = false;
+  }
+} tilemap_chunk;
+
+typedef struct tilemap_chunk_cache_state {
+  std::array<tilemap_chunk, TILEMAP_CHUNK_COUNT_AXIS * TILEMAP_CHUNK_COUNT_AXIS> chunks;
+  const tilemap * baked_map;
+  i32 chunk_count_axis;
+  tilemap_chunk_backend backend;
+  bool has_dirty_chunk;
+  tilemap_chunk_cache_state(void) {
+    this->chunks.fill(tilemap_chunk());
+    this->baked_map = nullptr;
+    this->chunk_count_axis = 0;
+    this->backend = TILEMAP_CHUNK_BACKEND_UNDEFINED;
+    this->has_dirty_chunk = false;
+  }
+} tilemap_chunk_cache_state;
+
+static tilemap_chunk_cache_state * chunk_state = nullptr;
 
 void map_to_str(tilemap *const map, tilemap_stringtify_package *const out_package);
 void str_to_map(tilemap *const map, tilemap_stringtify_package *const out_package);
+void render_tile_range(const tilemap *const _tilemap, const tilesheet *const sheet, i32 start_x, i32 start_y, i32 end_x, i32 end_y);
+void tilemap_chunk_bake(const tilemap *const _tilemap, const tilesheet *const sheet, i32 chunk_index);
+const std::vector<tilemap_prop_address>& collect_visible_props(const tilemap *const _tilemap, Rectangle camera_view, bool is_y_based);
+Rectangle map_spatial_bounds(const tilemap *const map, map_spatial_kind kind, u32 slot);
+void map_spatial_file(map_spatial_index& index, const map_spatial_ref& ref);
+void map_spatial_unfile(map_spatial_index& index, map_spatial_kind kind, i32 id);
+void map_spatial_pack_collisions(map_spatial_index& index);
+bool map_spatial_insert_unpacked(tilemap *const map, map_spatial_kind kind, u32 slot);
 
 bool create_tilemap(const tilesheet_type _type, const Vector2 _position, const i32 _grid_size, const i32 _tile_size, tilemap *const out_tilemap) {
   if (not out_tilemap or out_tilemap == nullptr) {
@@ -60,32 +111,12 @@ bool create_tilemap(const tilesheet_type _type, const Vector2 _position, const i
     out_tilemap->position.y - (out_tilemap->map_dim * out_tilemap->tile_size) / 2.f
   };
 
-  for (int layer = 0; layer < MAX_TILEMAP_LAYERS; ++layer) {
-    for (u16 i = 0; i < out_tilemap->map_dim_total; ++i) {
-      u16 x_axis = i % out_tilemap->map_dim;
-      u16 y_axis = i / out_tilemap->map_dim;
-      switch (layer) {
-        case 0: { 
-          out_tilemap->tiles[layer][x_axis][y_axis] = sheet->tile_symbols[1][0];
-          break; 
-        }
-        case 1: { 
-          out_tilemap->tiles[layer][x_axis][y_axis] = sheet->tile_symbols[0][0];
-          break; 
-        }
-        case 2: { 
-          out_tilemap->tiles[layer][x_axis][y_axis] = sheet->tile_symbols[0][0];
-          break; 
-        }
-        case 3: { 
-          out_tilemap->tiles[layer][x_axis][y_axis] = sheet->tile_symbols[0][0];
-          break; 
-        }
-        default:{
-          out_tilemap->tiles[layer][x_axis][y_axis] = sheet->tile_symbols[0][0];
-        }
-        break;
-      }
+  for (i32 i = 0; i < out_tilemap->map_dim_total; ++i) {
+    tilemap_cell& cell = out_tilemap->tiles.cell(i % out_tilemap->map_dim, i / out_tilemap->map_dim);
+
+    cell.layers[0] = sheet->tile_symbols[1][0];
+    for (i32 layer = 1; layer < MAX_TILEMAP_LAYERS; ++layer) {
+      cell.layers[layer] = sheet->tile_symbols[0][0];
     }
   }
     
@@ -149,78 +180,101 @@ void render_tilemap(const tilemap *const _tilemap, Rectangle camera_view) {
   end_x = end_x < 0 ? 0 : (end_x > _tilemap->map_dim ? _tilemap->map_dim : end_x);
   end_y = end_y < 0 ? 0 : (end_y > _tilemap->map_dim ? _tilemap->map_dim : end_y);
 
-  for (i32 y = start_y; y < end_y; ++y) {
-    for (i32 x = start_x; x < end_x; ++x) {
-      const i16 x_pos = _tilemap->position.x + x * _tilemap->tile_size;
-      const i16 y_pos = _tilemap->position.y + y * _tilemap->tile_size;
-      const Rectangle tile_dest = Rectangle { (f32) x_pos, (f32) y_pos, (f32) _tilemap->tile_size, (f32) _tilemap->tile_size};
-      
-      render_tile(_tilemap->tiles[0][x][y], tile_dest, sheet);
-      render_tile(_tilemap->tiles[1][x][y], tile_dest, sheet);
-      render_tile(_tilemap->tiles[2][x][y], tile_dest, sheet);
-      render_tile(_tilemap->tiles[3][x][y], tile_dest, sheet);
-      render_tile(_tilemap->tiles[4][x][y], tile_dest, sheet);
-    }
-  }
+  const bool is_cache_usable = chunk_state and chunk_state != nullptr 
+    and chunk_state->backend == TILEMAP_CHUNK_BACKEND_RAYLIB and chunk_state->baked_map == _tilemap;
 
-  for (size_t itr_000 = 0; itr_000 < _tilemap->render_z_index_queue.size(); ++itr_000) {
-    for (size_t itr_111 = 0; itr_111 < _tilemap->render_z_index_queue[itr_000].size(); ++itr_111) 
-    {
-      const tilemap_prop_address *const _queue_prop_ptr = __builtin_addressof(_tilemap->render_z_index_queue[itr_000][itr_111]);
-      if (_queue_prop_ptr->type <= TILEMAP_PROP_TYPE_UNDEFINED or _queue_prop_ptr->type >= TILEMAP_PROP_TYPE_MAX) {
-        continue;
-      }
-      if (_queue_prop_ptr->type == TILEMAP_PROP_TYPE_SPRITE) {
+  if (not is_cache_usable) {
+    render_tile_range(_tilemap, sheet, start_x, start_y, end_x, end_y);
+  }
+  else if (start_x < end_x and start_y < end_y) {
+    const i32 chunk_start_x = start_x / TILEMAP_CHUNK_DIM;
+    const i32 chunk_start_y = start_y / TILEMAP_CHUNK_DIM;
+    const i32 chunk_end_x = (end_x - 1) / TILEMAP_CHUNK_DIM + 1;
+    const i32 chunk_end_y = (end_y - 1) / TILEMAP_CHUNK_DIM + 1;
+
+    for (i32 chunk_y = chunk_start_y; chunk_y < chunk_end_y; ++chunk_y) {
+      for (i32 chunk_x = chunk_start_x; chunk_x < chunk_end_x; ++chunk_x) {
+        const tilemap_chunk& chunk = chunk_state->chunks.at(chunk_y * chunk_state->chunk_count_axis + chunk_x);
+        const i32 tile_x = chunk_x * TILEMAP_CHUNK_DIM;
+        const i32 tile_y = chunk_y * TILEMAP_CHUNK_DIM;
+
+        if (not chunk.is_baked) {
+          render_tile_range(_tilemap, sheet, 
+            std::max(start_x, tile_x), std::max(start_y, tile_y), 
+            std::min(end_x, tile_x + TILEMAP_CHUNK_DIM), std::min(end_y, tile_y + TILEMAP_CHUNK_DIM)
+          );
+          continue;
+        }
+        const f32 width = static_cast<f32>(chunk.target.texture.width);
+        const f32 height = static_cast<f32>(chunk.target.texture.height);
+        const f32 scale = static_cast<f32>(_tilemap->tile_size) / static_cast<f32>(sheet->tile_size);
         
-        if (_queue_prop_ptr->data.prop_static == nullptr) continue;
-        tilemap_prop_sprite *const map_prop_ptr = _queue_prop_ptr->data.prop_sprite;
-        if (not map_prop_ptr->is_initialized) continue;
-
-        if (not CheckCollisionRecs(camera_view, map_prop_ptr->sprite.coord)) { continue; }
-
-        play_sprite_on_site(map_prop_ptr->sprite, map_prop_ptr->sprite.tint, map_prop_ptr->sprite.coord);
-        continue;
+        DrawTexturePro(chunk.target.texture, Rectangle { 0.f, 0.f, width, -height }, Rectangle {
+            _tilemap->position.x + static_cast<f32>(tile_x * _tilemap->tile_size),
+            _tilemap->position.y + static_cast<f32>(tile_y * _tilemap->tile_size),
+            width * scale, height * scale
+          }, ZEROVEC2, 0.f, WHITE
+        );
       }
-      if (_queue_prop_ptr->type != TILEMAP_PROP_TYPE_SPRITE) {
-        if (_queue_prop_ptr->data.prop_sprite == nullptr) continue;
-        
-        const tilemap_prop_static *const map_prop_ptr = _queue_prop_ptr->data.prop_static;
-        if (not map_prop_ptr->is_initialized) continue;
-        
-        Rectangle prop_rect = map_prop_ptr->dest;
-        prop_rect.width *= map_prop_ptr->scale;
-        prop_rect.height *= map_prop_ptr->scale;
+    }
+  }
 
-        if (not CheckCollisionRecs(camera_view, prop_rect)) { continue; }
+  const std::vector<tilemap_prop_address>& visible_props = collect_visible_props(_tilemap, camera_view, false);
+  for (size_t itr_000 = 0; itr_000 < visible_props.size(); ++itr_000) {
+    const tilemap_prop_address *const _queue_prop_ptr = __builtin_addressof(visible_props.at(itr_000));
+    if (_queue_prop_ptr->type <= TILEMAP_PROP_TYPE_UNDEFINED or _queue_prop_ptr->type >= TILEMAP_PROP_TYPE_MAX) {
+      continue;
+    }
+    if (_queue_prop_ptr->type == TILEMAP_PROP_TYPE_SPRITE) {
       
-        const Texture2D *const tex = get_texture_by_enum(map_prop_ptr->tex_id); 
-        if (not tex or tex == nullptr) {
-          IERROR("tilemap::render_tilemap()::Prop tex resource is invalid");
-          continue;
-        }
+      if (_queue_prop_ptr->data.prop_static == nullptr) continue;
+      tilemap_prop_sprite *const map_prop_ptr = _queue_prop_ptr->data.prop_sprite;
+      if (not map_prop_ptr->is_initialized) continue;
+
+      if (not CheckCollisionRecs(camera_view, map_prop_ptr->sprite.coord)) { continue; }
+
+      play_sprite_on_site(map_prop_ptr->sprite, map_prop_ptr->sprite.tint, map_prop_ptr->sprite.coord);
+      continue;
+    }
+    if (_queue_prop_ptr->type != TILEMAP_PROP_TYPE_SPRITE) {
+      if (_queue_prop_ptr->data.prop_sprite == nullptr) continue;
       
-        const Vector2 origin = VECTOR2(prop_rect.width * .5f, prop_rect.height * .5f);
+      const tilemap_prop_static *const map_prop_ptr = _queue_prop_ptr->data.prop_static;
+      if (not map_prop_ptr->is_initialized) continue;
       
-        DrawTexturePro(*tex, map_prop_ptr->source, prop_rect, origin, map_prop_ptr->rotation, map_prop_ptr->tint);
-        
-        #if DEBUG_COLLISIONS
-          Rectangle coll_dest = Rectangle {
-            prop_rect.x - origin.x,
-            prop_rect.y - origin.y,
-            prop_rect.width,
-            prop_rect.height
-          };
-          DrawRectangleLines(
-            static_cast<i32>(coll_dest.x), 
-            static_cast<i32>(coll_dest.y), 
-            static_cast<i32>(coll_dest.width), 
-            static_cast<i32>(coll_dest.height), 
-            WHITE
-          );
-        #endif
+      Rectangle prop_rect = map_prop_ptr->dest;
+      prop_rect.width *= map_prop_ptr->scale;
+      prop_rect.height *= map_prop_ptr->scale;
 
+      if (not CheckCollisionRecs(camera_view, prop_rect)) { continue; }
+    
+      const Texture2D *const tex = get_texture_by_enum(map_prop_ptr->tex_id); 
+      if (not tex or tex == nullptr) {
+        IERROR("tilemap::render_tilemap()::Prop tex resource is invalid");
         continue;
       }
+    
+      const Vector2 origin = VECTOR2(prop_rect.width * .5f, prop_rect.height * .5f);
+    
+      DrawTexturePro(*tex, map_prop_ptr->source, prop_rect, origin, map_prop_ptr->rotation, map_prop_ptr->tint);
+      
+      #if DEBUG_COLLISIONS
+        Rectangle coll_dest = Rectangle {
+          prop_rect.x - origin.x,
+          prop_rect.y - origin.y,
+          prop_rect.width,
+          prop_rect.height
+        };
+        DrawRectangleLines(
+          static_cast<i32>(coll_dest.x), 
+          static_cast<i32>(coll_dest.y), 
+          static_cast<i32>(coll_dest.width), 
+          static_cast<i32>(coll_dest.height), 
+          WHITE
+        );
+      #endif
+
+      continue;
     }
   }
 }
@@ -229,75 +283,74 @@ void render_props_y_based_all(const tilemap *const _tilemap, Rectangle camera_vi
     IWARN("tilemap::render_props_y_based_all()::Provided map was null");
     return;
   }
-  for (size_t itr_000 = 0; itr_000 < _tilemap->render_y_based_queue.size(); ++itr_000) {
-    for (size_t itr_111 = 0; itr_111 < _tilemap->render_y_based_queue.at(itr_000).size(); ++itr_111) {
-      const tilemap_prop_address *const _queue_prop_ptr = __builtin_addressof(_tilemap->render_y_based_queue.at(itr_000).at(itr_111));
-      if (_queue_prop_ptr->type <= TILEMAP_PROP_TYPE_UNDEFINED or _queue_prop_ptr->type >= TILEMAP_PROP_TYPE_MAX) {
-        continue;
-      }
-      if (_queue_prop_ptr->type == TILEMAP_PROP_TYPE_SPRITE) 
-      {
-        if (_queue_prop_ptr->data.prop_static == nullptr) continue;
-        tilemap_prop_sprite *const map_prop_ptr = _queue_prop_ptr->data.prop_sprite;
-        if (not map_prop_ptr->is_initialized) continue;
-        if (not CheckCollisionRecs(camera_view, map_prop_ptr->sprite.coord)) { continue; }
-
-        if (map_prop_ptr->sprite.coord.y < start_y) {
-          continue;
-        }
-        else if (map_prop_ptr->sprite.coord.y > end_y) {
-          break;
-        }
+  const std::vector<tilemap_prop_address>& visible_props = collect_visible_props(_tilemap, camera_view, true);
+  for (size_t itr_000 = 0; itr_000 < visible_props.size(); ++itr_000) {
+    const tilemap_prop_address *const _queue_prop_ptr = __builtin_addressof(visible_props.at(itr_000));
+    if (_queue_prop_ptr->type <= TILEMAP_PROP_TYPE_UNDEFINED or _queue_prop_ptr->type >= TILEMAP_PROP_TYPE_MAX) {
+      continue;
+    }
+    if (_queue_prop_ptr->type == TILEMAP_PROP_TYPE_SPRITE) 
+    {
+      if (_queue_prop_ptr->data.prop_static == nullptr) continue;
+      tilemap_prop_sprite *const map_prop_ptr = _queue_prop_ptr->data.prop_sprite;
+      if (not map_prop_ptr->is_initialized) continue;
+      if (not CheckCollisionRecs(camera_view, map_prop_ptr->sprite.coord)) { continue; }
 
-        play_sprite_on_site(map_prop_ptr->sprite, map_prop_ptr->sprite.tint, map_prop_ptr->sprite.coord);
+      if (map_prop_ptr->sprite.coord.y < start_y) {
         continue;
       }
-      else
-      {
-        if (_queue_prop_ptr->data.prop_sprite == nullptr) continue;
+      else if (map_prop_ptr->sprite.coord.y > end_y) {
+        continue; // INFO: Visible props of every z-index slot are in one list, a later slot may still be in the band
+      }
 
-        const tilemap_prop_static *const map_prop_ptr = _queue_prop_ptr->data.prop_static;
-        if (not map_prop_ptr->is_initialized) continue;
+      sprite_batch_play_sprite(map_prop_ptr->sprite, SPRITE_LAYER_SCENE, SHADER_ID_UNSPECIFIED, map_prop_ptr->sprite.tint, map_prop_ptr->sprite.coord);
+      continue;
+    }
+    else
+    {
+      if (_queue_prop_ptr->data.prop_sprite == nullptr) continue;
 
-        Rectangle prop_rect = map_prop_ptr->dest;
-        prop_rect.width *= map_prop_ptr->scale;
-        prop_rect.height *= map_prop_ptr->scale;
+      const tilemap_prop_static *const map_prop_ptr = _queue_prop_ptr->data.prop_static;
+      if (not map_prop_ptr->is_initialized) continue;
 
-        if (not CheckCollisionRecs(camera_view, prop_rect)) { continue; }
-      
-        const Texture2D *const tex = get_texture_by_enum(map_prop_ptr->tex_id);
-        if (not tex or tex == nullptr) {
-          IERROR("tilemap::render_props_y_based_all()::Prop tex resource is invalid");
-          continue;
-        }
-      
-        const Vector2 origin = VECTOR2(prop_rect.width * .5f, prop_rect.height * .5f);
-      
-        if (map_prop_ptr->dest.y + (prop_rect.height * .5f) < start_y) {
-          continue;
-        }
-        else if (map_prop_ptr->dest.y + (prop_rect.height * .5f) > end_y) {
-          break;
-        }
-        DrawTexturePro( (*tex), map_prop_ptr->source, prop_rect, origin, map_prop_ptr->rotation, map_prop_ptr->tint);
+      Rectangle prop_rect = map_prop_ptr->dest;
+      prop_rect.width *= map_prop_ptr->scale;
+      prop_rect.height *= map_prop_ptr->scale;
 
-        #if DEBUG_COLLISIONS
-          Rectangle coll_dest = Rectangle {
-            prop_rect.x - origin.x,
-            prop_rect.y - origin.y,
-            prop_rect.width,
-            prop_rect.height
-          };
-          DrawRectangleLines(
-            static_cast<i32>(coll_dest.x), 
-            static_cast<i32>(coll_dest.y), 
-            static_cast<i32>(coll_dest.width), 
-            static_cast<i32>(coll_dest.height), 
-            WHITE
-          );
-        #endif
+      if (not CheckCollisionRecs(camera_view, prop_rect)) { continue; }
+    
+      const Texture2D *const tex = get_texture_by_enum(map_prop_ptr->tex_id);
+      if (not tex or tex == nullptr) {
+        IERROR("tilemap::render_props_y_based_all()::Prop tex resource is invalid");
         continue;
       }
+    
+      const Vector2 origin = VECTOR2(prop_rect.width * .5f, prop_rect.height * .5f);
+    
+      if (map_prop_ptr->dest.y + (prop_rect.height * .5f) < start_y) {
+        continue;
+      }
+      else if (map_prop_ptr->dest.y + (prop_rect.height * .5f) > end_y) {
+        continue;
+      }
+      sprite_batch_draw_texture( (*tex), SPRITE_LAYER_SCENE, map_prop_ptr->source, prop_rect, origin, map_prop_ptr->rotation, map_prop_ptr->tint);
+
+      #if DEBUG_COLLISIONS
+        Rectangle coll_dest = Rectangle {
+          prop_rect.x - origin.x,
+          prop_rect.y - origin.y,
+          prop_rect.width,
+          prop_rect.height
+        };
+        DrawRectangleLines(
+          static_cast<i32>(coll_dest.x), 
+          static_cast<i32>(coll_dest.y), 
+          static_cast<i32>(coll_dest.width), 
+          static_cast<i32>(coll_dest.height), 
+          WHITE
+        );
+      #endif
+      continue;
     }
   }
 
@@ -403,9 +456,10 @@ void render_mainmenu(const tilemap *const _tilemap, Rectangle camera_view, const
       }
       const i32 x_pos = map_position.x + x * dynamic_tile_size;
       const i32 y_pos = map_position.y + y * dynamic_tile_size;
+      const tilemap_cell& cell = _tilemap->tiles.cell(x, y);
       
       for (i32 itr_000 = 0; itr_000 < MAX_TILEMAP_LAYERS; ++itr_000) {
-        render_tile(_tilemap->tiles[itr_000][x][y], Rectangle { 
+        render_tile(cell.layers[itr_000], Rectangle { 
           static_cast<f32>(x_pos), static_cast<f32>(y_pos), 
           static_cast<f32>(dynamic_tile_size), static_cast<f32>(dynamic_tile_size)}, 
           sheet
@@ -494,6 +548,9 @@ void render_tilesheet(const tilesheet *const sheet, f32 zoom) {
 }
 
 void render_tile(const tile_symbol& symbol, const Rectangle& dest, const tilesheet *const sheet) {
+  DrawTexturePro( (*sheet->atlas_handle), get_tile_source_rect(symbol, sheet), dest, ZEROVEC2, 0.f, WHITE);
+}
+Rectangle get_tile_source_rect(const tile_symbol& symbol, const tilesheet *const sheet) {
   const i32 c0    = symbol.c[0];
   const i32 c1    = symbol.c[1];
   const i32 x     = c0 - TILEMAP_TILE_START_SYMBOL;
@@ -501,12 +558,478 @@ void render_tile(const tile_symbol& symbol, const Rectangle& dest, const tileshe
   const i32 x_pos = x * sheet->tile_size;
   const i32 y_pos = y * sheet->tile_size;
 
-  DrawTexturePro( (*sheet->atlas_handle), Rectangle {
+  return Rectangle {
     static_cast<f32>(x_pos), 
     static_cast<f32>(y_pos), 
     static_cast<f32>(sheet->tile_size), 
-    static_cast<f32>(sheet->tile_size) }, dest, ZEROVEC2, 0.f, WHITE
-  );
+    static_cast<f32>(sheet->tile_size)
+  };
+}
+/**
+ * @brief Per-tile path of render_tilemap(), the range is in tiles and already clamped to the map
+ */
+void render_tile_range(const tilemap *const _tilemap, const tilesheet *const sheet, i32 start_x, i32 start_y, i32 end_x, i32 end_y) {
+  for (i32 y = start_y; y < end_y; ++y) {
+    for (i32 x = start_x; x < end_x; ++x) {
+      const i16 x_pos = _tilemap->position.x + x * _tilemap->tile_size;
+      const i16 y_pos = _tilemap->position.y + y * _tilemap->tile_size;
+      const Rectangle tile_dest = Rectangle { (f32) x_pos, (f32) y_pos, (f32) _tilemap->tile_size, (f32) _tilemap->tile_size};
+      const tilemap_cell& cell = _tilemap->tiles.cell(x, y);
+      
+      for (i32 layer = 0; layer < MAX_TILEMAP_LAYERS; ++layer) {
+        render_tile(cell.layers[layer], tile_dest, sheet);
+      }
+    }
+  }
+}
+
+bool tilemap_chunk_cache_initialize(tilemap_chunk_backend backend) {
+  if (backend <= TILEMAP_CHUNK_BACKEND_UNDEFINED or backend >= TILEMAP_CHUNK_BACKEND_MAX) {
+    IERROR("tilemap::tilemap_chunk_cache_initialize()::Backend is out of bound");
+    return false;
+  }
+  if (chunk_state and chunk_state != nullptr) {
+    chunk_state->backend = backend;
+    tilemap_chunk_cache_invalidate_all();
+    return true;
+  }
+  chunk_state = (tilemap_chunk_cache_state *)allocate_memory_linear(sizeof(tilemap_chunk_cache_state), true, MEMORY_TAG_WORLD);
+  if (not chunk_state or chunk_state == nullptr) {
+    IERROR("tilemap::tilemap_chunk_cache_initialize()::State allocation failed");
+    return false;
+  }
+  *chunk_state = tilemap_chunk_cache_state();
+  chunk_state->backend = backend;
+  return true;
+}
+void tilemap_chunk_cache_sync(const tilemap *const _tilemap) {
+  if (not chunk_state or chunk_state == nullptr or not _tilemap or _tilemap == nullptr) {
+    return;
+  }
+  if (chunk_state->baked_map != _tilemap) {
+    chunk_state->baked_map = _tilemap;
+    chunk_state->chunk_count_axis = std::min((_tilemap->map_dim + TILEMAP_CHUNK_DIM - 1) / TILEMAP_CHUNK_DIM, TILEMAP_CHUNK_COUNT_AXIS);
+    tilemap_chunk_cache_invalidate_all();
+  }
+  if (not chunk_state->has_dirty_chunk) {
+    return;
+  }
+  const tilesheet *const sheet = get_tilesheet_by_enum(TILESHEET_TYPE_MAP);
+  if (not sheet or sheet == nullptr) {
+    IWARN("tilemap::tilemap_chunk_cache_sync()::Sheet resource is invalid");
+    return;
+  }
+  const i32 chunk_count = chunk_state->chunk_count_axis * chunk_state->chunk_count_axis;
+  for (i32 itr_000 = 0; itr_000 < chunk_count; ++itr_000) {
+    if (not chunk_state->chunks.at(itr_000).is_baked) {
+      tilemap_chunk_bake(_tilemap, sheet, itr_000);
+    }
+  }
+  chunk_state->has_dirty_chunk = false;
+}
+void tilemap_chunk_cache_invalidate_tile(const tilemap *const _tilemap, i32 x, i32 y) {
+  if (not chunk_state or chunk_state == nullptr or chunk_state->baked_map != _tilemap) {
+    return;
+  }
+  const i32 chunk_x = x / TILEMAP_CHUNK_DIM;
+  const i32 chunk_y = y / TILEMAP_CHUNK_DIM;
+  if (x < 0 or y < 0 or chunk_x >= chunk_state->chunk_count_axis or chunk_y >= chunk_state->chunk_count_axis) {
+    return;
+  }
+  chunk_state->chunks.at(chunk_y * chunk_state->chunk_count_axis + chunk_x).is_baked = false;
+  chunk_state->has_dirty_chunk = true;
+}
+void tilemap_chunk_cache_invalidate_all(void) {
+  if (not chunk_state or chunk_state == nullptr) {
+    return;
+  }
+  for (tilemap_chunk& chunk : chunk_state->chunks) {
+    chunk.is_baked = false;
+  }
+  chunk_state->has_dirty_chunk = true;
+}
+u32 tilemap_chunk_cache_baked_count(void) {
+  if (not chunk_state or chunk_state == nullptr) {
+    return 0u;
+  }
+  u32 baked_count = 0u;
+  for (i32 itr_000 = 0; itr_000 < chunk_state->chunk_count_axis * chunk_state->chunk_count_axis; ++itr_000) {
+    baked_count += chunk_state->chunks.at(itr_000).is_baked ? 1u : 0u;
+  }
+  return baked_count;
+}
+u32 tilemap_chunk_cache_verify(const tilemap *const _tilemap) {
+  if (not chunk_state or chunk_state == nullptr or chunk_state->backend != TILEMAP_CHUNK_BACKEND_RECORDING) {
+    IWARN("tilemap::tilemap_chunk_cache_verify()::Cache is not recording");
+    return 0u;
+  }
+  const tilesheet *const sheet = get_tilesheet_by_enum(TILESHEET_TYPE_MAP);
+  if (not sheet or sheet == nullptr or not _tilemap or _tilemap == nullptr or chunk_state->baked_map != _tilemap) {
+    IWARN("tilemap::tilemap_chunk_cache_verify()::Map is not the baked one");
+    return static_cast<u32>(TILEMAP_CHUNK_COUNT_AXIS * TILEMAP_CHUNK_COUNT_AXIS);
+  }
+  const f32 scale = static_cast<f32>(_tilemap->tile_size) / static_cast<f32>(sheet->tile_size);
+  auto is_near = [](f32 lhs, f32 rhs) { return lhs - rhs < TILEMAP_CHUNK_VERIFY_TOLERANCE and rhs - lhs < TILEMAP_CHUNK_VERIFY_TOLERANCE; };
+  u32 mismatch_count = 0u;
+
+  for (i32 itr_000 = 0; itr_000 < chunk_state->chunk_count_axis * chunk_state->chunk_count_axis; ++itr_000) {
+    const tilemap_chunk& chunk = chunk_state->chunks.at(itr_000);
+    const i32 tile_x = (itr_000 % chunk_state->chunk_count_axis) * TILEMAP_CHUNK_DIM;
+    const i32 tile_y = (itr_000 / chunk_state->chunk_count_axis) * TILEMAP_CHUNK_DIM;
+    const i32 end_x = std::min(tile_x + TILEMAP_CHUNK_DIM, _tilemap->map_dim);
+    const i32 end_y = std::min(tile_y + TILEMAP_CHUNK_DIM, _tilemap->map_dim);
+    const size_t expected_count = static_cast<size_t>((end_x - tile_x) * (end_y - tile_y) * MAX_TILEMAP_LAYERS);
+
+    if (not chunk.is_baked or chunk.recorded_draws.size() != expected_count) {
+      mismatch_count++;
+      continue;
+    }
+    size_t draw_index = 0u;
+    bool is_matching = true;
+    for (i32 y = tile_y; y < end_y and is_matching; ++y) {
+      for (i32 x = tile_x; x < end_x and is_matching; ++x) {
+        const i16 x_pos = _tilemap->position.x + x * _tilemap->tile_size; // INFO: Same as render_tile_range()
+        const i16 y_pos = _tilemap->position.y + y * _tilemap->tile_size;
+        const tilemap_cell& cell = _tilemap->tiles.cell(x, y);
+
+        for (i32 layer = 0; layer < MAX_TILEMAP_LAYERS and is_matching; ++layer) {
+          const tilemap_chunk_draw& draw = chunk.recorded_draws.at(draw_index++);
+          const Rectangle source = get_tile_source_rect(cell.layers[layer], sheet);
+          const Vector2 dest = Vector2 {
+            _tilemap->position.x + static_cast<f32>(tile_x * _tilemap->tile_size) + draw.dest.x * scale,
+            _tilemap->position.y + static_cast<f32>(tile_y * _tilemap->tile_size) + draw.dest.y * scale
+          };
+          is_matching = is_near(draw.source.x, source.x) and is_near(draw.source.y, source.y)
+            and is_near(draw.source.width, source.width) and is_near(draw.source.height, source.height)
+            and is_near(dest.x, static_cast<f32>(x_pos)) and is_near(dest.y, static_cast<f32>(y_pos))
+            and is_near(draw.dest.width * scale, static_cast<f32>(_tilemap->tile_size)) 
+            and is_near(draw.dest.height * scale, static_cast<f32>(_tilemap->tile_size));
+        }
+      }
+    }
+    mismatch_count += is_matching ? 0u : 1u;
+  }
+  return mismatch_count;
+}
+/**
+ * @brief Props in the view, ordered like the render queues they belong to: z-index slot, then y for y-based props,
+ * @brief then static before sprite and vector order. The list is reused by the next call
+ */
+const std::vector<tilemap_prop_address>& collect_visible_props(const tilemap *const _tilemap, Rectangle camera_view, bool is_y_based) {
+  static std::vector<map_spatial_ref> candidates = std::vector<map_spatial_ref>();
+  static std::vector<tilemap_prop_address> visible_props = std::vector<tilemap_prop_address>();
+  candidates.clear();
+  visible_props.clear();
+
+  if (_tilemap->spatial_index.cell_count_axis <= 0) { // INFO: Index is not built, the queues are already in order
+    for (const arena_vector<tilemap_prop_address>& queue : (is_y_based ? _tilemap->render_y_based_queue : _tilemap->render_z_index_queue)) {
+      visible_props.insert(visible_props.end(), queue.begin(), queue.end());
+    }
+    return visible_props;
+  }
+  map_spatial_index_query(_tilemap, camera_view, candidates);
+  for (const map_spatial_ref& ref : candidates) {
+    const u32 slot = map_spatial_index_get_slot(_tilemap, ref.kind, ref.id);
+    if (slot == INVALID_IDU32) {
+      continue;
+    }
+    if (ref.kind == MAP_SPATIAL_KIND_PROP_STATIC) {
+      const tilemap_prop_static& prop = _tilemap->static_props.at(slot);
+      if (prop.use_y_based_zindex == is_y_based) {
+        visible_props.push_back(tilemap_prop_address(const_cast<tilemap_prop_static *>(__builtin_addressof(prop))));
+      }
+    }
+    else if (ref.kind == MAP_SPATIAL_KIND_PROP_SPRITE) {
+      const tilemap_prop_sprite& prop = _tilemap->sprite_props.at(slot);
+      if (prop.use_y_based_zindex == is_y_based) {
+        visible_props.push_back(tilemap_prop_address(const_cast<tilemap_prop_sprite *>(__builtin_addressof(prop))));
+      }
+    }
+  }
+  auto zindex_of = [](const tilemap_prop_address& prop) { 
+    return prop.type == TILEMAP_PROP_TYPE_SPRITE ? prop.data.prop_sprite->zindex : prop.data.prop_static->zindex; 
+  };
+  auto y_of = [](const tilemap_prop_address& prop) { // INFO: Same value as sort_render_y_based_queue()
+    return prop.type == TILEMAP_PROP_TYPE_SPRITE 
+      ? static_cast<i32>(prop.data.prop_sprite->sprite.coord.y + prop.data.prop_sprite->sprite.coord.height)
+      : static_cast<i32>(prop.data.prop_static->dest.y + (prop.data.prop_static->dest.height * prop.data.prop_static->scale));
+  };
+  std::sort(visible_props.begin(), visible_props.end(), [&](const tilemap_prop_address& lhs, const tilemap_prop_address& rhs) {
+    if (zindex_of(lhs) != zindex_of(rhs)) {
+      return zindex_of(lhs) < zindex_of(rhs);
+    }
+    if (is_y_based and y_of(lhs) != y_of(rhs)) {
+      return y_of(lhs) < y_of(rhs);
+    }
+    const bool is_lhs_sprite = lhs.type == TILEMAP_PROP_TYPE_SPRITE;
+    const bool is_rhs_sprite = rhs.type == TILEMAP_PROP_TYPE_SPRITE;
+    if (is_lhs_sprite != is_rhs_sprite) {
+      return is_rhs_sprite;
+    }
+    return is_lhs_sprite 
+      ? lhs.data.prop_sprite < rhs.data.prop_sprite // INFO: Same vector, so the address is the vector order
+      : lhs.data.prop_static < rhs.data.prop_static;
+  });
+  return visible_props;
+}
+
+void map_spatial_index_rebuild(tilemap *const map) {
+  if (not map or map == nullptr) {
+    IWARN("tilemap::map_spatial_index_rebuild()::Map is invalid");
+    return;
+  }
+  map_spatial_index& index = map->spatial_index;
+  const f32 map_extent = static_cast<f32>(map->map_dim * map->tile_size);
+
+  index.origin = map->position;
+  index.cell_count_axis = std::max(static_cast<i32>(map_extent / MAP_SPATIAL_CELL_SIZE) + 1, 1);
+  index.cells.assign(static_cast<size_t>(index.cell_count_axis * index.cell_count_axis), std::vector<map_spatial_ref>());
+  index.slot_by_id.fill(std::vector<u32>());
+
+  for (size_t itr_000 = 0u; itr_000 < map->static_props.size(); ++itr_000) {
+    map_spatial_insert_unpacked(map, MAP_SPATIAL_KIND_PROP_STATIC, static_cast<u32>(itr_000));
+  }
+  for (size_t itr_000 = 0u; itr_000 < map->sprite_props.size(); ++itr_000) {
+    map_spatial_insert_unpacked(map, MAP_SPATIAL_KIND_PROP_SPRITE, static_cast<u32>(itr_000));
+  }
+  for (size_t itr_000 = 0u; itr_000 < map->collisions.size(); ++itr_000) {
+    map_spatial_insert_unpacked(map, MAP_SPATIAL_KIND_COLLISION, static_cast<u32>(itr_000));
+  }
+  map_spatial_pack_collisions(index);
+}
+void map_spatial_index_insert(tilemap *const map, map_spatial_kind kind, u32 slot) {
+  if (map_spatial_insert_unpacked(map, kind, slot) and kind == MAP_SPATIAL_KIND_COLLISION) {
+    map_spatial_pack_collisions(map->spatial_index);
+  }
+}
+bool map_spatial_insert_unpacked(tilemap *const map, map_spatial_kind kind, u32 slot) {
+  if (not map or map == nullptr or map->spatial_index.cell_count_axis <= 0) {
+    return false;
+  }
+  i32 id = I32_MAX;
+  switch (kind) {
+    case MAP_SPATIAL_KIND_PROP_STATIC: id = slot < map->static_props.size() ? map->static_props.at(slot).map_id : I32_MAX; break;
+    case MAP_SPATIAL_KIND_PROP_SPRITE: id = slot < map->sprite_props.size() ? map->sprite_props.at(slot).map_id : I32_MAX; break;
+    case MAP_SPATIAL_KIND_COLLISION:   id = slot < map->collisions.size()   ? map->collisions.at(slot).coll_id    : I32_MAX; break;
+    default: break;
+  }
+  if (id < 0 or id == I32_MAX) {
+    IWARN("tilemap::map_spatial_index_insert()::Element has no valid id");
+    return false;
+  }
+  std::vector<u32>& slots = map->spatial_index.slot_by_id.at(kind);
+  if (static_cast<size_t>(id) >= slots.size()) {
+    slots.resize(static_cast<size_t>(id) + 1u, INVALID_IDU32);
+  }
+  slots.at(id) = slot;
+  map_spatial_file(map->spatial_index, map_spatial_ref(kind, id, map_spatial_bounds(map, kind, slot)));
+  return true;
+}
+void map_spatial_index_remove(tilemap *const map, map_spatial_kind kind, i32 id) {
+  const u32 erased_slot = map_spatial_index_get_slot(map, kind, id);
+  if (erased_slot == INVALID_IDU32) {
+    return;
+  }
+  map_spatial_unfile(map->spatial_index, kind, id);
+
+  std::vector<u32>& slots = map->spatial_index.slot_by_id.at(kind);
+  slots.at(id) = INVALID_IDU32;
+  for (u32& slot : slots) { // INFO: The element is already erased from its vector, the ones after it moved down by one
+    if (slot != INVALID_IDU32 and slot > erased_slot) {
+      slot--;
+    }
+  }
+  if (kind == MAP_SPATIAL_KIND_COLLISION) {
+    map_spatial_pack_collisions(map->spatial_index);
+  }
+}
+void map_spatial_index_update(tilemap *const map, map_spatial_kind kind, i32 id) {
+  const u32 slot = map_spatial_index_get_slot(map, kind, id);
+  if (slot == INVALID_IDU32) {
+    return;
+  }
+  map_spatial_unfile(map->spatial_index, kind, id);
+  map_spatial_file(map->spatial_index, map_spatial_ref(kind, id, map_spatial_bounds(map, kind, slot)));
+  if (kind == MAP_SPATIAL_KIND_COLLISION) {
+    map_spatial_pack_collisions(map->spatial_index);
+  }
+}
+u32 map_spatial_index_get_slot(const tilemap *const map, map_spatial_kind kind, i32 id) {
+  if (not map or map == nullptr or kind <= MAP_SPATIAL_KIND_UNDEFINED or kind >= MAP_SPATIAL_KIND_MAX or id < 0) {
+    return INVALID_IDU32;
+  }
+  const std::vector<u32>& slots = map->spatial_index.slot_by_id.at(kind);
+  return static_cast<size_t>(id) < slots.size() ? slots.at(id) : INVALID_IDU32;
+}
+void map_spatial_index_query(const tilemap *const map, Rectangle area, std::vector<map_spatial_ref>& out_refs) {
+  if (not map or map == nullptr or map->spatial_index.cell_count_axis <= 0) {
+    return;
+  }
+  const map_spatial_index& index = map->spatial_index;
+  auto cell_of = [&index](f32 value, f32 origin) {
+    return std::clamp(static_cast<i32>(std::floor((value - origin) / MAP_SPATIAL_CELL_SIZE)), 0, index.cell_count_axis - 1);
+  };
+  const i32 start_x = cell_of(area.x, index.origin.x);
+  const i32 start_y = cell_of(area.y, index.origin.y);
+  const i32 end_x = cell_of(area.x + area.width, index.origin.x);
+  const i32 end_y = cell_of(area.y + area.height, index.origin.y);
+
+  for (i32 y = start_y; y <= end_y; ++y) {
+    for (i32 x = start_x; x <= end_x; ++x) {
+      for (const map_spatial_ref& ref : index.cells.at(static_cast<size_t>(y * index.cell_count_axis + x))) {
+        // INFO: A ref is filed in every cell it touches, report it only from the first cell both ranges share
+        if (x != std::max(start_x, cell_of(ref.bounds.x, index.origin.x)) or y != std::max(start_y, cell_of(ref.bounds.y, index.origin.y))) {
+          continue;
+        }
+        const bool is_overlapping = 
+          ref.bounds.x <= area.x + area.width  and area.x <= ref.bounds.x + ref.bounds.width and 
+          ref.bounds.y <= area.y + area.height and area.y <= ref.bounds.y + ref.bounds.height;
+        if (is_overlapping) {
+          out_refs.push_back(ref);
+        }
+      }
+    }
+  }
+}
+bool map_spatial_index_overlaps_collision(const tilemap *const map, Rectangle area) {
+  if (not map or map == nullptr) {
+    return false;
+  }
+  const map_spatial_index& index = map->spatial_index;
+  if (index.cell_count_axis <= 0 or index.collision_cell_start.empty()) { // INFO: Index is not built yet
+    for (const map_collision& coll : map->collisions) {
+      if (CheckCollisionRecs(coll.dest, area)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  auto cell_of = [&index](f32 value, f32 origin) {
+    return std::clamp(static_cast<i32>(std::floor((value - origin) / MAP_SPATIAL_CELL_SIZE)), 0, index.cell_count_axis - 1);
+  };
+  const i32 start_x = cell_of(area.x, index.origin.x);
+  const i32 start_y = cell_of(area.y, index.origin.y);
+  const i32 end_x = cell_of(area.x + area.width, index.origin.x);
+  const i32 end_y = cell_of(area.y + area.height, index.origin.y);
+
+  for (i32 y = start_y; y <= end_y; ++y) {
+    for (i32 x = start_x; x <= end_x; ++x) {
+      const size_t cell = static_cast<size_t>(y * index.cell_count_axis + x);
+      const Rectangle * end = index.collision_rects.data() + index.collision_cell_start[cell + 1u];
+
+      for (const Rectangle * itr = index.collision_rects.data() + index.collision_cell_start[cell]; itr != end; ++itr) {
+        if (CheckCollisionRecs(*itr, area)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+/**
+ * @brief Covers every rectangle the element is culled, drawn or picked with. Props are drawn around their center and may rotate
+ */
+Rectangle map_spatial_bounds(const tilemap *const map, map_spatial_kind kind, u32 slot) {
+  auto prop_bounds = [](Rectangle rect, f32 scale) {
+    const f32 width = std::fabs(rect.width * scale);
+    const f32 height = std::fabs(rect.height * scale);
+    const f32 radius = std::max(std::sqrt(width * width + height * height), std::max(std::fabs(rect.width), std::fabs(rect.height))) * .5f;
+    const f32 min_x = std::min(rect.x - radius, rect.x);
+    const f32 min_y = std::min(rect.y - radius, rect.y);
+    const f32 max_x = std::max(rect.x + radius, rect.x + width);
+    const f32 max_y = std::max(rect.y + radius, rect.y + height);
+    return Rectangle { min_x, min_y, max_x - min_x, max_y - min_y };
+  };
+  switch (kind) {
+    case MAP_SPATIAL_KIND_PROP_STATIC: return prop_bounds(map->static_props.at(slot).dest, map->static_props.at(slot).scale);
+    case MAP_SPATIAL_KIND_PROP_SPRITE: return prop_bounds(map->sprite_props.at(slot).sprite.coord, 1.f);
+    case MAP_SPATIAL_KIND_COLLISION:   return map->collisions.at(slot).dest;
+    default: return ZERORECT;
+  }
+}
+void map_spatial_file(map_spatial_index& index, const map_spatial_ref& ref) {
+  auto cell_of = [&index](f32 value, f32 origin) {
+    return std::clamp(static_cast<i32>(std::floor((value - origin) / MAP_SPATIAL_CELL_SIZE)), 0, index.cell_count_axis - 1);
+  };
+  const i32 start_x = cell_of(ref.bounds.x, index.origin.x);
+  const i32 start_y = cell_of(ref.bounds.y, index.origin.y);
+  const i32 end_x = cell_of(ref.bounds.x + ref.bounds.width, index.origin.x);
+  const i32 end_y = cell_of(ref.bounds.y + ref.bounds.height, index.origin.y);
+
+  for (i32 y = start_y; y <= end_y; ++y) {
+    for (i32 x = start_x; x <= end_x; ++x) {
+      index.cells.at(static_cast<size_t>(y * index.cell_count_axis + x)).push_back(ref);
+    }
+  }
+}
+void map_spatial_pack_collisions(map_spatial_index& index) {
+  index.collision_cell_start.assign(index.cells.size() + 1u, 0u);
+  index.collision_rects.clear();
+
+  for (size_t cell = 0u; cell < index.cells.size(); ++cell) {
+    index.collision_cell_start.at(cell) = static_cast<u32>(index.collision_rects.size());
+    for (const map_spatial_ref& ref : index.cells.at(cell)) {
+      if (ref.kind == MAP_SPATIAL_KIND_COLLISION) {
+        index.collision_rects.push_back(ref.bounds);
+      }
+    }
+  }
+  index.collision_cell_start.back() = static_cast<u32>(index.collision_rects.size());
+}
+void map_spatial_unfile(map_spatial_index& index, map_spatial_kind kind, i32 id) {
+  for (std::vector<map_spatial_ref>& cell : index.cells) {
+    std::erase_if(cell, [kind, id](const map_spatial_ref& ref) { return ref.kind == kind and ref.id == id; });
+  }
+}
+
+/**
+ * @brief Bakes at the atlas resolution, render_tilemap() scales the chunk up to the map tile size
+ */
+void tilemap_chunk_bake(const tilemap *const _tilemap, const tilesheet *const sheet, i32 chunk_index) {
+  tilemap_chunk& chunk = chunk_state->chunks.at(chunk_index);
+  const i32 tile_x = (chunk_index % chunk_state->chunk_count_axis) * TILEMAP_CHUNK_DIM;
+  const i32 tile_y = (chunk_index / chunk_state->chunk_count_axis) * TILEMAP_CHUNK_DIM;
+  const i32 end_x = std::min(tile_x + TILEMAP_CHUNK_DIM, _tilemap->map_dim);
+  const i32 end_y = std::min(tile_y + TILEMAP_CHUNK_DIM, _tilemap->map_dim);
+  const i32 width = (end_x - tile_x) * sheet->tile_size;
+  const i32 height = (end_y - tile_y) * sheet->tile_size;
+  const bool will_draw = chunk_state->backend == TILEMAP_CHUNK_BACKEND_RAYLIB;
+
+  chunk.recorded_draws.clear();
+  if (will_draw) {
+    if (chunk.target.id != 0u and (chunk.target.texture.width != width or chunk.target.texture.height != height)) {
+      UnloadRenderTexture(chunk.target);
+      chunk.target = RenderTexture2D {};
+    }
+    if (chunk.target.id == 0u) {
+      chunk.target = LoadRenderTexture(width, height);
+      SetTextureFilter(chunk.target.texture, TEXTURE_FILTER_POINT);
+    }
+    BeginTextureMode(chunk.target);
+    ClearBackground(BLANK);
+  }
+  for (i32 y = tile_y; y < end_y; ++y) {
+    for (i32 x = tile_x; x < end_x; ++x) {
+      const Rectangle tile_dest = Rectangle {
+        static_cast<f32>((x - tile_x) * sheet->tile_size), static_cast<f32>((y - tile_y) * sheet->tile_size),
+        static_cast<f32>(sheet->tile_size), static_cast<f32>(sheet->tile_size)
+      };
+      const tilemap_cell& cell = _tilemap->tiles.cell(x, y);
+
+      for (i32 layer = 0; layer < MAX_TILEMAP_LAYERS; ++layer) {
+        if (will_draw) {
+          render_tile(cell.layers[layer], tile_dest, sheet);
+        }
+        else {
+          chunk.recorded_draws.push_back(tilemap_chunk_draw(get_tile_source_rect(cell.layers[layer], sheet), tile_dest));
+        }
+      }
+    }
+  }
+  if (will_draw) {
+    EndTextureMode();
+  }
+  chunk.is_baked = true;
 }
 
 Vector2 get_tilesheet_dim(const tilesheet* sheet) {
@@ -574,7 +1097,7 @@ tile get_tile_from_map_by_mouse_pos (const tilemap* map, const Vector2 mouse_pos
   if (_tile.position.x >= map->map_dim or _tile.position.y >= map->map_dim) { // NOTE: Assumes tilemap x and y are unsigned
     return tile();
   }
-  _tile.symbol = map->tiles[layer][_tile.position.x][_tile.position.y];
+  _tile.symbol = map->tiles.at(layer, _tile.position.x, _tile.position.y);
   _tile.is_initialized = true;
 
   return _tile;
@@ -600,13 +1123,16 @@ void map_to_str(tilemap *const map, tilemap_stringtify_package *const out_packag
   // TILE SERIALIZE
   for (size_t itr_000 = 0u; itr_000 < MAX_TILEMAP_LAYERS; ++itr_000) {
     out_package->size_tilemap_str[itr_000] = sizeof(tile_symbol) * MAX_TILEMAP_TILESLOT_X * MAX_TILEMAP_TILESLOT_Y;
-
-    for (size_t itr_111 = 0u; itr_111 < MAX_TILEMAP_TILESLOT_X; ++itr_111) {
-      copy_memory(
-        out_package->str_tilemap[itr_000] + (sizeof(tile_symbol) * itr_111 * MAX_TILEMAP_TILESLOT_Y), 
-        map->tiles[itr_000][itr_111], 
-        sizeof(tile_symbol) * MAX_TILEMAP_TILESLOT_Y
-      );
+  }
+  for (i32 y = 0; y < MAX_TILEMAP_TILESLOT_Y; ++y) {
+    for (i32 x = 0; x < MAX_TILEMAP_TILESLOT_X; ++x) {
+      const tilemap_cell& cell = map->tiles.cell(x, y);
+      const size_t file_offset = sizeof(tile_symbol) * (static_cast<size_t>(x) * MAX_TILEMAP_TILESLOT_Y + static_cast<size_t>(y)); // INFO: Layer files stay column-major
+
+      for (size_t itr_000 = 0u; itr_000 < MAX_TILEMAP_LAYERS; ++itr_000) {
+        out_package->str_tilemap[itr_000][file_offset]      = cell.layers[itr_000].c[0];
+        out_package->str_tilemap[itr_000][file_offset + 1u] = cell.layers[itr_000].c[1];
+      }
     }
   }
   // TILE SERIALIZE
@@ -700,20 +1226,22 @@ void str_to_map(tilemap *const map, tilemap_stringtify_package *const out_packag
   out_package->is_success = false;
   map->sprite_props.clear();
   map->static_props.clear();
-  for (auto itr_000 : map->render_z_index_queue) itr_000.clear();
+  for (auto& itr_000 : map->render_z_index_queue) itr_000.clear();
   
   const tilesheet *const sheet = get_tilesheet_by_enum(TILESHEET_TYPE_MAP);
   if (not sheet or sheet == nullptr) {
     IERROR("tilemap::str_to_map()::Map sheet resource is invalid");
     return;
   }
-  for (size_t itr_000 = 0u; itr_000 < MAX_TILEMAP_LAYERS; ++itr_000) {
-    for (size_t itr_111 = 0u; itr_111 < MAX_TILEMAP_TILESLOT_X; ++itr_111) {
-      copy_memory(
-        map->tiles[itr_000][itr_111], 
-        out_package->str_tilemap[itr_000] + (sizeof(tile_symbol) * itr_111 * MAX_TILEMAP_TILESLOT_X), 
-        sizeof(tile_symbol) * MAX_TILEMAP_TILESLOT_X
-      );
+  for (i32 y = 0; y < MAX_TILEMAP_TILESLOT_Y; ++y) {
+    for (i32 x = 0; x < MAX_TILEMAP_TILESLOT_X; ++x) {
+      tilemap_cell& cell = map->tiles.cell(x, y);
+      const size_t file_offset = sizeof(tile_symbol) * (static_cast<size_t>(x) * MAX_TILEMAP_TILESLOT_Y + static_cast<size_t>(y)); // INFO: Layer files stay column-major
+
+      for (size_t itr_000 = 0u; itr_000 < MAX_TILEMAP_LAYERS; ++itr_000) {
+        cell.layers[itr_000].c[0] = out_package->str_tilemap[itr_000][file_offset];
+        cell.layers[itr_000].c[1] = out_package->str_tilemap[itr_000][file_offset + 1u];
+      }
     }
   }
   string_parse_result str_prop_parse_buffer = parse_string(out_package->str_props.c_str(), PROP_PARSE_PROP_BUFFER_PARSE_SYMBOL_C, PROP_BUFFER_PARSE_TOP_LIMIT);
@@ -841,11 +1369,11 @@ bool load_map_data(tilemap *const map, tilemap_stringtify_package *const out_pac
     out_package->str_collisions = file->file_collision;
     
     for(i32 itr_000 = 0; itr_000 < MAX_TILEMAP_LAYERS; ++itr_000) {
-      const std::string& src_str = file->layer_data.at(itr_000);
+      const std::string_view src_str = file->layer_data.at(itr_000);
       u8* dest_buffer = out_package->str_tilemap[itr_000];
       const size_t bytes_to_copy = std::min(src_str.size(), sizeof(out_package->str_tilemap[itr_000]));
   
-      copy_memory(dest_buffer, src_str.c_str(), bytes_to_copy);
+      copy_memory(dest_buffer, src_str.data(), bytes_to_copy);
       
       out_package->size_tilemap_str[itr_000] = bytes_to_copy;
     }
@@ -888,11 +1416,11 @@ bool load_or_create_map_data(tilemap *const map, tilemap_stringtify_package *con
     out_package->str_collisions = file->file_collision;
 
     for(i32 itr_000 = 0; itr_000 < MAX_TILEMAP_LAYERS; ++itr_000) {
-      const std::string& src_str = file->layer_data.at(itr_000);
+      const std::string_view src_str = file->layer_data.at(itr_000);
       u8* dest_buffer = out_package->str_tilemap[itr_000];
       const size_t bytes_to_copy = std::min(src_str.size(), sizeof(out_package->str_tilemap[itr_000]));
   
-      copy_memory(dest_buffer, src_str.c_str(), bytes_to_copy);
+      copy_memory(dest_buffer, src_str.data(), bytes_to_copy);
       
       out_package->size_tilemap_str[itr_000] = bytes_to_copy;
     }
@@ -4,15 +4,29 @@
 
 #include "game_types.h"
 
+#define TILEMAP_CHUNK_DIM 16 // INFO: In tiles, along both axes
+#define TILEMAP_CHUNK_COUNT_AXIS ((MAX_TILEMAP_TILESLOT_X + TILEMAP_CHUNK_DIM - 1) / TILEMAP_CHUNK_DIM)
+
+typedef enum tilemap_chunk_backend {
+  TILEMAP_CHUNK_BACKEND_UNDEFINED,
+  TILEMAP_CHUNK_BACKEND_RAYLIB,
+  TILEMAP_CHUNK_BACKEND_RECORDING, // INFO: Keeps the draws a bake would make instead of a texture, so it can be checked without a GPU
+  TILEMAP_CHUNK_BACKEND_MAX,
+} tilemap_chunk_backend;
+
 bool create_tilemap(const tilesheet_type _type, const Vector2 _position, const i32 _grid_size, const i32 _tile_size,tilemap *const out_tilemap);
 void create_tilesheet(tilesheet_type _type, i32 _dest_tile_size, f32 _offset, tilesheet *const out_tilesheet);
 
 void update_tilemap(tilemap *const _tilemap, f32 delta_time);
 void render_tilemap(const tilemap *const _tilemap, Rectangle camera_view);
+/**
+ * @brief Queued into the scene layer when a sprite batch is open, so they get depth sorted with the actors. Drawn in place otherwise
+ */
 void render_props_y_based_all(const tilemap *const _tilemap, Rectangle camera_view, i32 start_y, i32 end_y);
 void render_props_y_based_by_zindex(const tilemap *const _tilemap, size_t index, Rectangle camera_view, i32 start_y, i32 end_y);
 void render_tilesheet(const tilesheet *const sheet, f32 zoom);
 void render_tile(const tile_symbol& symbol, const Rectangle& dest, const tilesheet *const sheet);
+Rectangle get_tile_source_rect(const tile_symbol& symbol, const tilesheet *const sheet);
 void render_mainmenu(const tilemap *const _tilemap, Rectangle camera_view, const app_settings *const in_settings);
 
 Vector2 get_tilesheet_dim(const tilesheet *const sheet);
@@ -23,4 +37,37 @@ bool save_map_data(tilemap *const map, tilemap_stringtify_package *const out_pac
 bool load_map_data(tilemap *const map, tilemap_stringtify_package *const out_package);
 bool load_or_create_map_data(tilemap *const map, tilemap_stringtify_package *const out_package);
 
+[[__nodiscard__]] bool tilemap_chunk_cache_initialize(tilemap_chunk_backend backend);
+
+/**
+ * @brief Tile layers of one map at a time are baked into chunk textures, switching to another map rebakes every chunk.
+ * @brief An invalidated chunk is drawn tile by tile until the next sync. Sync must run outside of texture and camera modes
+ */
+void tilemap_chunk_cache_sync(const tilemap *const _tilemap);
+void tilemap_chunk_cache_invalidate_tile(const tilemap *const _tilemap, i32 x, i32 y);
+void tilemap_chunk_cache_invalidate_all(void);
+u32 tilemap_chunk_cache_baked_count(void);
+
+/**
+ * @brief Compares every chunk with the draws of the per-tile path and returns the mismatching chunk count. Recording backend only
+ */
+u32 tilemap_chunk_cache_verify(const tilemap *const _tilemap);
+
+/**
+ * @brief Built on map load. Insert takes the slot of an element already in its vector, remove comes after the erase.
+ * @brief Update re-files an element that moved or resized in place. Query appends each ref overlapping the area once
+ */
+void map_spatial_index_rebuild(tilemap *const map);
+void map_spatial_index_insert(tilemap *const map, map_spatial_kind kind, u32 slot);
+void map_spatial_index_remove(tilemap *const map, map_spatial_kind kind, i32 id);
+void map_spatial_index_update(tilemap *const map, map_spatial_kind kind, i32 id);
+u32 map_spatial_index_get_slot(const tilemap *const map, map_spatial_kind kind, i32 id);
+void map_spatial_index_query(const tilemap *const map, Rectangle area, std::vector<map_spatial_ref>& out_refs);
+
+/**
+ * @brief Broadphase for movement against the map collisions. Read only and allocation free, safe to call from jobs
+ * @brief as long as the map is not edited meanwhile
+ */
+bool map_spatial_index_overlaps_collision(const tilemap *const map, Rectangle area);
+
 #endif
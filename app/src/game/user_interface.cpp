@@ -10,10 +10,14 @@
 
 #include "core/event.h"
 #include "core/fmemory.h"
+#include "core/fprofiler.h"
 #include "core/logger.h"
 #include "core/ftime.h"
+#include "core/frandom.h"
+#include "core/fjob.h"
 
 #include "game_types.h"
+#include "game/resource.h"
 #include "game/spritesheet.h"
 #include "game/fshader.h"
 
@@ -21,6 +25,23 @@
 #define UI_SIGIL_ARCH_RAD_SCALE_BY_VIEWPORT_SIZE 0.06885f
 #define UI_SIGIL_COMMON_RAD_SCALE_BY_VIEWPORT_SIZE 0.0595f
 
+typedef struct font_decode_request {
+  const file_buffer * file;
+  i32 font_size;
+  Font font;
+  Image atlas;
+  font_decode_request(void) {
+    this->file = nullptr;
+    this->font_size = 0;
+    this->font = ZERO_FONT;
+    this->atlas = ZERO_IMAGE;
+  }
+  font_decode_request(const file_buffer * _file, i32 _font_size) : font_decode_request() {
+    this->file = _file;
+    this->font_size = _font_size;
+  }
+} font_decode_request;
+
 typedef struct user_interface_system_state {
   const app_settings * in_app_settings;
   const camera_metrics * in_camera_metrics;
@@ -153,6 +174,8 @@ void draw_text_shader(const char *text, shader_id sdr_id, Vector2 position, Font
 void DrawTextBoxed(Font font, const char *text, Rectangle rec, float fontSize, float spacing, bool wordWrap, Color tint);
 const char* wrap_text(const char* text, Font font, i32 font_size, Rectangle bounds, bool center_x);
 Font load_font(pak_file_id pak_id, i32 asset_id, i32 font_size, i32* _codepoints, i32 _codepoint_count);
+void font_decode_job(u32 job_index, void* user_data);
+Font font_upload(font_decode_request * request);
 bool load_localization(std::string language_name, i32 lang_index, std::string _codepoints, i32 font_size);
 localization_package& ui_get_localization_by_name(const char * language_name);
 localization_package& ui_get_localization_by_index(language_index index);
@@ -242,7 +265,7 @@ bool user_interface_system_initialize(const camera_metrics * in_camera_metrics)
     IERROR("user_interface::user_interface_system_initialize()::Camera pointer is invalid");
     return false;
   }
-  state = (user_interface_system_state *)allocate_memory_linear(sizeof(user_interface_system_state), true);
+  state = (user_interface_system_state *)allocate_memory_linear(sizeof(user_interface_system_state), true, MEMORY_TAG_USER_INTERFACE);
   if(not state) {
     IERROR("user_interface::user_interface_system_initialize()::UI state init failed");
     return false;
@@ -260,6 +283,13 @@ bool user_interface_system_initialize(const camera_metrics * in_camera_metrics)
     COMBAT_FEEDBACK_FLOATING_TEXT_MIN_SCALE,
     COMBAT_FEEDBACK_FLOATING_TEXT_MAX_SCALE
   );
+  // INFO: List nodes carry two links next to the text
+  if (memory_pool_create(__builtin_addressof(state->cfft_display_state.pool), 
+      sizeof(combat_feedback_floating_text) + 2u * sizeof(void*), MAX_COMBAT_FEEDBACK_FLOATING_TEXT_COUNT, MEMORY_TAG_USER_INTERFACE)) {
+    state->cfft_display_state.queue = std::list<combat_feedback_floating_text, pool_allocator<combat_feedback_floating_text>>(
+      pool_allocator<combat_feedback_floating_text>(__builtin_addressof(state->cfft_display_state.pool))
+    );
+  }
 
   const std::array<loc_data, LANGUAGE_INDEX_MAX>& langs = loc_parser_get_loc_langs();
 
@@ -481,6 +511,7 @@ bool user_interface_system_initialize(const camera_metrics * in_camera_metrics)
   return true;
 }
 void update_user_interface(f32 delta_time) {
+  PROFILE_FUNCTION();
   Vector2 mouse_pos_screen_unscaled = GetMousePosition();
   state->mouse_pos_screen.x = mouse_pos_screen_unscaled.x * state->in_app_settings->scale_ratio.at(0);
   state->mouse_pos_screen.y = mouse_pos_screen_unscaled.y * state->in_app_settings->scale_ratio.at(1);
@@ -859,11 +890,11 @@ void gui_progress_bar(progress_bar_id bar_id, Rectangle dest, bool _should_cente
   BeginScissorMode(scr_rect.x,scr_rect.y,scr_rect.width,scr_rect.height);
     BeginShaderMode(get_shader_by_enum(prg_bar.type.mask_shader_id)->handle);
     {
-      set_shader_uniform(prg_bar.type.mask_shader_id, "progress", data128(progress));
-      set_shader_uniform(prg_bar.type.mask_shader_id, "tint", data128(
+      set_shader_uniform_float(SHADER_UNIFORM_ID_PROGRESS_BAR_MASK_PROGRESS, progress);
+      set_shader_uniform_vec4(SHADER_UNIFORM_ID_PROGRESS_BAR_MASK_TINT, Vector4 {
         static_cast<f32>(inside_tint.r), static_cast<f32>(inside_tint.g),
         static_cast<f32>(inside_tint.b), static_cast<f32>(inside_tint.a)
-      ));
+      });
       draw_atlas_texture_stretch(prg_bar.type.body_inside, strecth_part_inside, dest, false);
     }
     EndShaderMode();
@@ -1573,7 +1604,7 @@ void combat_feedback_spawn_floating_text(const char* _text, combat_feedback_floa
       return;
     }
   }
-  const f32 text_duration = get_random(
+  const f32 text_duration = random_range(RANDOM_STREAM_UI, 
     static_cast<i32>(state->cfft_display_state.duration_min * 100.f), 
     static_cast<i32>(state->cfft_display_state.duration_max * 100.f)
   ) * 0.01f;
@@ -1625,7 +1656,7 @@ void combat_feedback_update_floating_texts(f32 delta_time) {
       iterator->duration
     );
     const f32 bg_tex_font_ratio = 1.5f;
-    const Vector2 text_measure = MeasureTextEx(font, iterator->text.c_str(), iterator->interpolated_font_size, UI_FONT_SPACING);
+    const Vector2 text_measure = MeasureTextEx(font, iterator->text.data(), iterator->interpolated_font_size, UI_FONT_SPACING);
     const Vector2 texture_size = Vector2 {text_measure.x * bg_tex_font_ratio, text_measure.y * bg_tex_font_ratio};
     Vector2 texture_position = Vector2 { 
       iterator->interpolate.x + text_measure.x * .5f, 
@@ -1654,7 +1685,7 @@ void combat_feedback_render_floating_texts(void) {
 
   for (auto iterator = system.queue.begin(); iterator != system.queue.end(); iterator++) {
     gui_draw_atlas_texture_id(iterator->background_tex_id, iterator->tex_dest, iterator->tex_origin, 0.f, iterator->background_tint);
-    draw_text_ex(iterator->text.c_str(), iterator->interpolate, iterator->font_type, iterator->interpolated_font_size, iterator->font_tint);
+    draw_text_ex(iterator->text.data(), iterator->interpolate, iterator->font_type, iterator->interpolated_font_size, iterator->font_tint);
   }
 }
 
@@ -2368,22 +2399,40 @@ data_pack* get_slider_current_value(slider_id id) {
   return __builtin_addressof(state->sliders.at(id).options.at(state->sliders.at(id).current_value).content);
 }
 Font load_font(pak_file_id pak_id, i32 asset_id, i32 font_size, [[__maybe_unused__]] i32* _codepoints,  [[__maybe_unused__]] i32 _codepoint_count) {
-  Font font = ZERO_FONT;
-  font.baseSize = font_size;
- 
-  const file_buffer *const file = get_asset_file_buffer(pak_id, asset_id);
-  if (not file or file == nullptr) {
-    IWARN("user_interface::load_font()::Font cannot loading, returning default");
-    return GetFontDefault();
+  font_decode_request request = font_decode_request(get_asset_file_buffer(pak_id, asset_id), font_size);
+  font_decode_job(0u, __builtin_addressof(request));
+  return font_upload(__builtin_addressof(request));
+}
+/**
+ * @brief Glyph rasterization and atlas packing, CPU only. user_data is an array of font_decode_request.
+ */
+void font_decode_job(u32 job_index, void* user_data) {
+  font_decode_request& request = static_cast<font_decode_request *>(user_data)[job_index];
+  if (not request.file or request.file == nullptr) {
+    return;
   }
-  else {
-    //font = LoadFontFromMemory(file->file_extension.c_str(), reinterpret_cast<const u8 *>(file->content.c_str()), static_cast<i32>(file->content.size()), font_size, 0, 0); 
-    font.glyphs = LoadFontData(reinterpret_cast<const u8 *>(file->content.c_str()), static_cast<i32>(file->content.size()), font_size, 0, 0, FONT_SDF, __builtin_addressof(font.glyphCount));
-    Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, 0, font_size, 0, 1);
-    font.texture = LoadTextureFromImage(atlas);
-    UnloadImage(atlas);
-    SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+  request.font.baseSize = request.font_size;
+  //font = LoadFontFromMemory(file->file_extension.c_str(), reinterpret_cast<const u8 *>(file->content.c_str()), static_cast<i32>(file->content.size()), font_size, 0, 0); 
+  request.font.glyphs = LoadFontData(
+    reinterpret_cast<const u8 *>(request.file->content.data()), static_cast<i32>(request.file->content.size()), request.font_size, 0, 0, FONT_SDF, __builtin_addressof(request.font.glyphCount)
+  );
+  request.atlas = GenImageFontAtlas(request.font.glyphs, &request.font.recs, 0, request.font_size, 0, 1);
+}
+/**
+ * @brief Main thread only
+ */
+Font font_upload(font_decode_request * request) {
+  if (not request->file or request->file == nullptr) {
+    IWARN("user_interface::font_upload()::Font cannot loading, returning default");
+    return GetFontDefault();
   }
+  Font font = request->font;
+  font.texture = resource_upload_texture(request->atlas);
+  UnloadImage(request->atlas);
+  request->atlas = ZERO_IMAGE;
+  #if not HEADLESS_BUILD
+  SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+  #endif
   return font;
 }
 bool load_localization(std::string language_name, i32 lang_index, std::string _codepoints, i32 font_size) {
@@ -2400,18 +2449,32 @@ bool load_localization(std::string language_name, i32 lang_index, std::string _c
   loc_pack.index = static_cast<language_index>(lang_index);
   loc_pack.language_name = language_name;
   loc_pack.codepoints = codepoints;
-  loc_pack.italic_font = load_font(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_ITALIC, font_size, codepoints, codepoint_count);
-  loc_pack.light_font  = load_font(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_LIGHT, font_size, codepoints, codepoint_count);
-  loc_pack.regular_font  = load_font(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_REGULAR, font_size, codepoints, codepoint_count);
-  loc_pack.bold_font  = load_font(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_BOLD, font_size, codepoints, codepoint_count);
-  loc_pack.mood = load_font(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MOOD, 28, codepoints, codepoint_count);
+  {
+    // INFO: Fonts are rasterized in parallel, their atlases are uploaded here in order
+    std::array<font_decode_request, 5> requests = {
+      font_decode_request(get_asset_file_buffer(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_ITALIC),  font_size),
+      font_decode_request(get_asset_file_buffer(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_LIGHT),   font_size),
+      font_decode_request(get_asset_file_buffer(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_REGULAR), font_size),
+      font_decode_request(get_asset_file_buffer(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MIOSEVKA_BOLD),    font_size),
+      font_decode_request(get_asset_file_buffer(PAK_FILE_ASSET1, PAK_FILE_ASSET1_FONT_MOOD),             28),
+    };
+    job_dispatch(static_cast<u32>(requests.size()), font_decode_job, requests.data());
+
+    loc_pack.italic_font  = font_upload(__builtin_addressof(requests.at(0)));
+    loc_pack.light_font   = font_upload(__builtin_addressof(requests.at(1)));
+    loc_pack.regular_font = font_upload(__builtin_addressof(requests.at(2)));
+    loc_pack.bold_font    = font_upload(__builtin_addressof(requests.at(3)));
+    loc_pack.mood         = font_upload(__builtin_addressof(requests.at(4)));
+  }
   UnloadCodepoints(codepoints);
 
+  #if not HEADLESS_BUILD
   SetTextureFilter(loc_pack.italic_font.texture, TEXTURE_FILTER_ANISOTROPIC_16X);
   SetTextureFilter(loc_pack.light_font .texture, TEXTURE_FILTER_ANISOTROPIC_16X);
   SetTextureFilter(loc_pack.regular_font .texture, TEXTURE_FILTER_ANISOTROPIC_16X);
   SetTextureFilter(loc_pack.bold_font .texture, TEXTURE_FILTER_ANISOTROPIC_16X);
   SetTextureFilter(loc_pack.mood.texture, TEXTURE_FILTER_ANISOTROPIC_16X);
+  #endif
 
   state->localization_info[lang_index] = loc_pack;
   state->localization_info[lang_index].is_valid = true;
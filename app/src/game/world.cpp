@@ -3,8 +3,10 @@
 #include <loc_types.h>
 
 #include <core/fmemory.h>
+#include <core/fprofiler.h>
 #include <core/logger.h>
 
+#include "spritesheet.h"
 #include "tilemap.h"
 
 typedef struct world_system_state {
@@ -23,16 +25,19 @@ typedef struct world_system_state {
 static world_system_state * state = nullptr;
 
 #define MAINMENU_STAGE_INDEX 0
+#define WORLD_RENDER_QUEUE_MIN_CAPACITY 256
+#define WORLD_RENDER_QUEUE_HEADROOM 2 // INFO: Room for the props the editor adds after the map is loaded
 
 constexpr Rectangle get_position_view_rect(Camera2D camera, Vector2 pos, f32 zoom);
 constexpr size_t get_renderqueue_prop_index_by_id(i16 zindex, i32 map_id);
-void sort_render_y_based_queue(i32 id);
+void sort_render_y_based_queue(i32 id, bool refresh_keys);
+tilemap_prop_address y_based_prop_address(tilemap_prop_address prop);
 
 bool world_system_initialize(const app_settings *const _in_app_settings) {
   if (state and state != nullptr) {
     return true;
   }
-  state = (world_system_state*)allocate_memory_linear(sizeof(world_system_state), true);
+  state = (world_system_state*)allocate_memory_linear(sizeof(world_system_state), true, MEMORY_TAG_WORLD);
   if (not state or state == nullptr) {
     IERROR("world::world_system_initialize()::State allocation failed");
     return false;
@@ -487,6 +492,7 @@ bool world_system_initialize(const app_settings *const _in_app_settings) {
     state->worldmap_locations.at(itr_000).spawning_areas.at(0u) = level_bound;
     state->worldmap_locations.at(itr_000).level_bound = level_bound;
     refresh_render_queue(itr_000);
+    map_spatial_index_rebuild(__builtin_addressof(state->map.at(itr_000)));
   }
   return true;
 }
@@ -535,35 +541,53 @@ void set_map_tile(i32 layer, tile src, tile dst) {
     IWARN("world::set_map_tile()::Tile is out of bound");
     return;
   }
-  state->active_map->tiles[layer][src.position.x][src.position.y].c[0] = dst.symbol.c[0];
-  state->active_map->tiles[layer][src.position.x][src.position.y].c[1] = dst.symbol.c[1];
+  tile_symbol& symbol = state->active_map->tiles.at(layer, src.position.x, src.position.y);
+  symbol.c[0] = dst.symbol.c[0];
+  symbol.c[1] = dst.symbol.c[1];
+  tilemap_chunk_cache_invalidate_tile(state->active_map, src.position.x, src.position.y);
 }
 tilemap_prop_address get_map_prop_by_pos(Vector2 pos) {
   if (not state or state == nullptr) {
     IERROR("world::get_map_prop_by_pos()::State is not valid");
     return tilemap_prop_address();
   }
-  for (size_t itr_000 = 0u; itr_000 < state->active_map->static_props.size(); ++itr_000) {
-    Rectangle prop_dest = state->active_map->static_props.at(itr_000).dest;
-    prop_dest.x -= prop_dest.width  * .5f;
-    prop_dest.y -= prop_dest.height * .5f;
-    if(CheckCollisionPointRec(pos, prop_dest)) { // Props are always centered
-      tilemap_prop_address prop = tilemap_prop_address(__builtin_addressof(state->active_map->static_props.at(itr_000)));
-      prop.type = prop.data.prop_static->prop_type;
-      return prop;
+  std::vector<map_spatial_ref> candidates = std::vector<map_spatial_ref>();
+  map_spatial_index_query(state->active_map, Rectangle {pos.x, pos.y, 0.f, 0.f}, candidates);
+
+  u32 static_slot = INVALID_IDU32;
+  u32 sprite_slot = INVALID_IDU32;
+  for (const map_spatial_ref& ref : candidates) { // INFO: Static props win over sprites, then the first in the vector, as before the index
+    const u32 slot = map_spatial_index_get_slot(state->active_map, ref.kind, ref.id);
+    if (slot == INVALID_IDU32) {
+      continue;
     }
-  }
-  for (size_t itr_000 = 0u; itr_000 < state->active_map->sprite_props.size(); ++itr_000) {
-    Rectangle prop_dest = state->active_map->sprite_props.at(itr_000).sprite.coord;
-    prop_dest.x -= prop_dest.width  * .5f;
-    prop_dest.y -= prop_dest.height * .5f;
-    if(CheckCollisionPointRec(pos, prop_dest)) { // Props are always centered
-      tilemap_prop_address prop = tilemap_prop_address(__builtin_addressof(state->active_map->sprite_props.at(itr_000)));
-      prop.type = prop.data.prop_sprite->prop_type;
-      return prop;
+    if (ref.kind == MAP_SPATIAL_KIND_PROP_STATIC and slot < static_slot) {
+      Rectangle prop_dest = state->active_map->static_props.at(slot).dest;
+      prop_dest.x -= prop_dest.width  * .5f;
+      prop_dest.y -= prop_dest.height * .5f;
+      if(CheckCollisionPointRec(pos, prop_dest)) { // Props are always centered
+        static_slot = slot;
+      }
+    }
+    else if (ref.kind == MAP_SPATIAL_KIND_PROP_SPRITE and slot < sprite_slot) {
+      Rectangle prop_dest = state->active_map->sprite_props.at(slot).sprite.coord;
+      prop_dest.x -= prop_dest.width  * .5f;
+      prop_dest.y -= prop_dest.height * .5f;
+      if(CheckCollisionPointRec(pos, prop_dest)) {
+        sprite_slot = slot;
+      }
     }
   }
-
+  if (static_slot != INVALID_IDU32) {
+    tilemap_prop_address prop = tilemap_prop_address(__builtin_addressof(state->active_map->static_props.at(static_slot)));
+    prop.type = prop.data.prop_static->prop_type;
+    return prop;
+  }
+  if (sprite_slot != INVALID_IDU32) {
+    tilemap_prop_address prop = tilemap_prop_address(__builtin_addressof(state->active_map->sprite_props.at(sprite_slot)));
+    prop.type = prop.data.prop_sprite->prop_type;
+    return prop;
+  }
   return tilemap_prop_address();
 }
 map_collision* get_map_collision_by_pos(Vector2 pos) {
@@ -571,20 +595,24 @@ map_collision* get_map_collision_by_pos(Vector2 pos) {
     IERROR("world::get_map_collision_by_pos()::State is not valid");
     return nullptr;
   }
-  for (size_t itr_000 = 0u; itr_000 < state->active_map->collisions.size(); ++itr_000) {
-    Rectangle coll_dest = state->active_map->collisions.at(itr_000).dest;
-    if(CheckCollisionPointRec(pos, coll_dest)) {
-      return __builtin_addressof(state->active_map->collisions.at(itr_000));;
+  std::vector<map_spatial_ref> candidates = std::vector<map_spatial_ref>();
+  map_spatial_index_query(state->active_map, Rectangle {pos.x, pos.y, 0.f, 0.f}, candidates);
+
+  u32 coll_slot = INVALID_IDU32;
+  for (const map_spatial_ref& ref : candidates) {
+    const u32 slot = map_spatial_index_get_slot(state->active_map, ref.kind, ref.id);
+    if (ref.kind == MAP_SPATIAL_KIND_COLLISION and slot < coll_slot and CheckCollisionPointRec(pos, state->active_map->collisions.at(slot).dest)) {
+      coll_slot = slot;
     }
   }
-  return nullptr;
+  return coll_slot != INVALID_IDU32 ? __builtin_addressof(state->active_map->collisions.at(coll_slot)) : nullptr;
 }
 constexpr size_t get_renderqueue_prop_index_by_id(i16 zindex, i32 map_id) {
   if (not state or state == nullptr) {
     IERROR("world::get_renderqueue_prop_index_by_id()::State is not valid");
     return INVALID_IDU32;
   }
-  const std::vector<tilemap_prop_address>& _queue = state->active_map->render_z_index_queue.at(zindex);
+  const arena_vector<tilemap_prop_address>& _queue = state->active_map->render_z_index_queue.at(zindex);
   for (size_t itr_000 = 0u; itr_000 < _queue.size(); ++itr_000) {
     const tilemap_prop_address *const _queue_elm = __builtin_addressof(_queue.at(itr_000));
     if (_queue_elm->type <= TILEMAP_PROP_TYPE_UNDEFINED or _queue_elm->type >= TILEMAP_PROP_TYPE_MAX) {
@@ -597,34 +625,28 @@ constexpr size_t get_renderqueue_prop_index_by_id(i16 zindex, i32 map_id) {
   return INVALID_IDU32;
 }
 tilemap_prop_static* get_map_prop_static_by_id(i32 map_id) {
-  for (size_t iter = 0u; iter < state->active_map->static_props.size(); ++iter) {
-    if (state->active_map->static_props.at(iter).map_id == map_id) {
-      return __builtin_addressof(state->active_map->static_props.at(iter));
-    }
+  const u32 slot = map_spatial_index_get_slot(state->active_map, MAP_SPATIAL_KIND_PROP_STATIC, map_id);
+  if (slot == INVALID_IDU32) {
+    IWARN("world::get_map_prop_static_by_id()::No match found");
+    return nullptr;  
   }
-  IWARN("world::get_map_prop_static_by_id()::No match found");
-  return nullptr;  
+  return __builtin_addressof(state->active_map->static_props.at(slot));
 }
 tilemap_prop_sprite* get_map_prop_sprite_by_id(i32 map_id) {
-  for (size_t iter = 0u; iter < state->active_map->sprite_props.size(); ++iter) {
-    if (state->active_map->sprite_props.at(iter).map_id == map_id) {
-      return __builtin_addressof(state->active_map->sprite_props.at(iter));
-    }
+  const u32 slot = map_spatial_index_get_slot(state->active_map, MAP_SPATIAL_KIND_PROP_SPRITE, map_id);
+  if (slot == INVALID_IDU32) {
+    IWARN("world::get_map_prop_sprite_by_id()::No match found");
+    return nullptr;  
   }
-  IWARN("world::get_map_prop_sprite_by_id()::No match found");
-  return nullptr;  
+  return __builtin_addressof(state->active_map->sprite_props.at(slot));
 }
 const map_collision* get_map_collision_by_id(i32 coll_id) {
   if (not state or state == nullptr) {
     IERROR("world::get_map_collision_by_id()::State is not valid");
     return nullptr;
   }
-  for (size_t itr_000 = 0u; itr_000 < state->active_map->collisions.size(); ++itr_000) {
-    if (state->active_map->collisions.at(itr_000).coll_id == coll_id) {
-      return __builtin_addressof(state->active_map->collisions.at(itr_000));
-    }
-  }
-  return nullptr;
+  const u32 slot = map_spatial_index_get_slot(state->active_map, MAP_SPATIAL_KIND_COLLISION, coll_id);
+  return slot != INVALID_IDU32 ? __builtin_addressof(state->active_map->collisions.at(slot)) : nullptr;
 }
 
 void save_current_map(void) {
@@ -638,11 +660,17 @@ void load_current_map(void) {
   if(!load_map_data(state->active_map, &state->map_stringtify.at(state->active_map_stage.map_id))) {
     IWARN("world::load_current_map()::load_map_data returned false");
   }
+  tilemap_chunk_cache_invalidate_all();
   refresh_render_queue(state->active_map_stage.map_id);
+  map_spatial_index_rebuild(state->active_map);
 }
 
 void update_map(f32 delta_time) {
   update_tilemap(&state->map.at(state->active_map_stage.map_id), delta_time);
+
+  if (state->active_map_stage.map_id != MAINMENU_STAGE_INDEX) { // INFO: Main menu draws the map at a resolution based size, see render_mainmenu()
+    tilemap_chunk_cache_sync(state->active_map);
+  }
 }
 
 void drag_tilesheet(Vector2 vec) {
@@ -650,6 +678,7 @@ void drag_tilesheet(Vector2 vec) {
   state->palette.position.y += vec.y;
 }
 void render_map() {
+  PROFILE_FUNCTION();
   if (state->active_map_stage.map_id == MAINMENU_STAGE_INDEX) {
     render_mainmenu(state->active_map, state->in_camera_metrics->frustum, state->in_app_settings);
   }
@@ -674,6 +703,7 @@ bool add_prop_curr_map(tilemap_prop_static prop_static) {
   }
   prop_static.map_id = state->active_map->next_map_id++;
   state->active_map->static_props.push_back(prop_static);
+  map_spatial_index_insert(state->active_map, MAP_SPATIAL_KIND_PROP_STATIC, static_cast<u32>(state->active_map->static_props.size() - 1u));
   
   refresh_render_queue(state->active_map_stage.map_id);
   return true;
@@ -685,6 +715,7 @@ bool add_prop_curr_map(tilemap_prop_sprite prop_sprite) {
   }
   prop_sprite.map_id = state->active_map->next_map_id++;
   state->active_map->sprite_props.push_back(prop_sprite);
+  map_spatial_index_insert(state->active_map, MAP_SPATIAL_KIND_PROP_SPRITE, static_cast<u32>(state->active_map->sprite_props.size() - 1u));
 
   refresh_render_queue(state->active_map_stage.map_id);
   return true;
@@ -701,30 +732,22 @@ bool add_map_coll_curr_map(Rectangle in_collision) {
     return false;
   }
   state->active_map->collisions.push_back(map_collision(state->active_map->next_collision_id++, in_collision));
+  map_spatial_index_insert(state->active_map, MAP_SPATIAL_KIND_COLLISION, static_cast<u32>(state->active_map->collisions.size() - 1u));
   return true;
 }
 bool remove_prop_cur_map_by_id(i32 map_id, tilemap_prop_types type) {
-  bool found = false;
-
-  if (type != TILEMAP_PROP_TYPE_SPRITE) {
-    for (size_t itr_000 = 0; itr_000 < state->active_map->static_props.size(); ++itr_000) {
-      if (state->active_map->static_props.at(itr_000).map_id == map_id) {
-        state->active_map->static_props.erase(state->active_map->static_props.begin() + itr_000);
-        found = true;
-        break;
-      }
-    }
+  const map_spatial_kind kind = type == TILEMAP_PROP_TYPE_SPRITE ? MAP_SPATIAL_KIND_PROP_SPRITE : MAP_SPATIAL_KIND_PROP_STATIC;
+  const u32 slot = map_spatial_index_get_slot(state->active_map, kind, map_id);
+  const bool found = slot != INVALID_IDU32;
+
+  if (found and kind == MAP_SPATIAL_KIND_PROP_STATIC) {
+    state->active_map->static_props.erase(state->active_map->static_props.begin() + slot);
   }
-  if (type == TILEMAP_PROP_TYPE_SPRITE) {
-    for (size_t itr_000 = 0; itr_000 < state->active_map->sprite_props.size(); ++itr_000) {
-      if (state->active_map->sprite_props.at(itr_000).map_id == map_id) {
-        state->active_map->sprite_props.erase(state->active_map->sprite_props.begin() + itr_000);
-        found = true;
-        break;
-      }
-    }
+  if (found and kind == MAP_SPATIAL_KIND_PROP_SPRITE) {
+    state->active_map->sprite_props.erase(state->active_map->sprite_props.begin() + slot);
   }
   if (found) {
+    map_spatial_index_remove(state->active_map, kind, map_id);
     refresh_render_queue(state->active_map_stage.map_id);
     return true;
   }
@@ -738,13 +761,20 @@ bool remove_map_collision_by_id(i32 coll_id) {
     IERROR("world::remove_map_collision_by_id()::State is not valid");
     return false;
   }
-  for (size_t itr_000 = 0u; itr_000 < state->active_map->collisions.size(); ++itr_000) {
-    if (state->active_map->collisions.at(itr_000).coll_id == coll_id) {
-      state->active_map->collisions.erase(state->active_map->collisions.begin() + itr_000);
-      return true;
-    }
+  const u32 slot = map_spatial_index_get_slot(state->active_map, MAP_SPATIAL_KIND_COLLISION, coll_id);
+  if (slot == INVALID_IDU32) {
+    return false;
   }
-  return false;
+  state->active_map->collisions.erase(state->active_map->collisions.begin() + slot);
+  map_spatial_index_remove(state->active_map, MAP_SPATIAL_KIND_COLLISION, coll_id);
+  return true;
+}
+void refresh_prop_bounds_cur_map(i32 map_id, tilemap_prop_types type) {
+  if (not state or state == nullptr) {
+    IERROR("world::refresh_prop_bounds_cur_map()::State is not valid");
+    return;
+  }
+  map_spatial_index_update(state->active_map, type == TILEMAP_PROP_TYPE_SPRITE ? MAP_SPATIAL_KIND_PROP_SPRITE : MAP_SPATIAL_KIND_PROP_STATIC, map_id);
 }
 constexpr Rectangle get_position_view_rect(Camera2D camera, Vector2 pos, f32 zoom) {
   int screen_width = state->in_app_settings->render_width;
@@ -769,11 +799,39 @@ void refresh_render_queue(i32 id) {
   tilemap& tilemap_ref = state->map.at(id);
   std::vector<tilemap_prop_static>& static_prop_queue = tilemap_ref.static_props;
   std::vector<tilemap_prop_sprite>& sprite_prop_queue = tilemap_ref.sprite_props;
-  for (auto& _queue : tilemap_ref.render_z_index_queue) {
-    _queue.clear();
+  const size_t prop_count = static_prop_queue.size() + sprite_prop_queue.size();
+  memory_arena *const queue_arena = __builtin_addressof(tilemap_ref.render_queue_arena);
+  if (queue_arena->base == nullptr and not memory_arena_create(queue_arena, 
+      (std::max(prop_count, static_cast<size_t>(WORLD_RENDER_QUEUE_MIN_CAPACITY)) * WORLD_RENDER_QUEUE_HEADROOM + MAX_Z_INDEX_SLOT + MAX_Y_INDEX_SLOT) * sizeof(tilemap_prop_address), 
+      MEMORY_TAG_WORLD)) {
+    IWARN("world::refresh_render_queue()::Render queue arena cannot be created, queues stay on the heap");
+  }
+  std::array<size_t, MAX_Z_INDEX_SLOT> z_index_counts = {};
+  std::array<size_t, MAX_Y_INDEX_SLOT> y_based_counts = {};
+  auto count_prop = [&](bool use_y_based_zindex, i32 zindex) {
+    if (use_y_based_zindex) y_based_counts.at(zindex)++;
+    else if (zindex >= 0 and zindex < MAX_Z_INDEX_SLOT) z_index_counts.at(zindex)++;
+    else z_index_counts.at(0)++;
+  };
+  for (const tilemap_prop_static& prop : static_prop_queue) count_prop(prop.use_y_based_zindex, prop.zindex);
+  for (const tilemap_prop_sprite& prop : sprite_prop_queue) count_prop(prop.use_y_based_zindex, prop.zindex);
+
+  // INFO: Old queues give their storage back before the reset, then every queue takes its exact size in one block.
+  // Props past the arena's capacity, added by the editor after the first refresh, spill to the heap
+  for (size_t itr_000 = 0u; itr_000 < MAX_Z_INDEX_SLOT; ++itr_000) {
+    tilemap_ref.render_z_index_queue.at(itr_000) = arena_vector<tilemap_prop_address>(arena_allocator<tilemap_prop_address>(queue_arena));
+  }
+  for (size_t itr_000 = 0u; itr_000 < MAX_Y_INDEX_SLOT; ++itr_000) {
+    tilemap_ref.render_y_based_queue.at(itr_000) = arena_vector<tilemap_prop_address>(arena_allocator<tilemap_prop_address>(queue_arena));
+  }
+  if (queue_arena->base != nullptr) {
+    memory_arena_reset(queue_arena);
   }
-  for (auto& _queue : tilemap_ref.render_y_based_queue) {
-    _queue.clear();
+  for (size_t itr_000 = 0u; itr_000 < MAX_Z_INDEX_SLOT; ++itr_000) {
+    tilemap_ref.render_z_index_queue.at(itr_000).reserve(z_index_counts.at(itr_000));
+  }
+  for (size_t itr_000 = 0u; itr_000 < MAX_Y_INDEX_SLOT; ++itr_000) {
+    tilemap_ref.render_y_based_queue.at(itr_000).reserve(y_based_counts.at(itr_000));
   }
 
   for (size_t static_itr_111 = 0u; static_itr_111 < static_prop_queue.size(); ++static_itr_111) {
@@ -785,7 +843,7 @@ void refresh_render_queue(i32 id) {
     }
 
     if (map_static_ptr->use_y_based_zindex) {
-      tilemap_ref.render_y_based_queue.at(map_static_ptr->zindex).push_back(tilemap_prop_address(map_static_ptr));
+      tilemap_ref.render_y_based_queue.at(map_static_ptr->zindex).push_back(y_based_prop_address(tilemap_prop_address(map_static_ptr)));
     }
     else if(map_static_ptr->zindex >= 0 and map_static_ptr->zindex < MAX_Z_INDEX_SLOT) {
       tilemap_ref.render_z_index_queue.at(map_static_ptr->zindex).push_back(tilemap_prop_address(map_static_ptr));
@@ -806,7 +864,7 @@ void refresh_render_queue(i32 id) {
     }
 
     if (map_sprite_ptr->use_y_based_zindex) {
-      tilemap_ref.render_y_based_queue.at(map_sprite_ptr->zindex).push_back(tilemap_prop_address(map_sprite_ptr));
+      tilemap_ref.render_y_based_queue.at(map_sprite_ptr->zindex).push_back(y_based_prop_address(tilemap_prop_address(map_sprite_ptr)));
     }
     else if(map_sprite_ptr->zindex >= 0 and map_sprite_ptr->zindex < MAX_Z_INDEX_SLOT) { 
       tilemap_ref.render_z_index_queue.at(map_sprite_ptr->zindex).push_back(tilemap_prop_address(map_sprite_ptr));
@@ -817,63 +875,73 @@ void refresh_render_queue(i32 id) {
       tilemap_ref.render_z_index_queue.at(0).push_back(tilemap_prop_address(map_sprite_ptr));
     }
   }
-  sort_render_y_based_queue(id);
+  if (static_prop_queue.size() + sprite_prop_queue.size() != prop_count) { // INFO: Invalid props were dropped, slots moved
+    map_spatial_index_rebuild(__builtin_addressof(tilemap_ref));
+  }
+  sort_render_y_based_queue(id, false);
 }
-void sort_render_y_based_queue(i32 id) {
+/**
+ * @brief Sort key is computed when the prop is queued and kept in the queue entry. Queues keep their order between sorts,
+ * @brief after an editor move only that prop is out of place and the insertion sort is about one pass. Freshly built queues
+ * @brief that are far from sorted, or that run out of the insertion sort's move budget, take the stable sort instead
+ */
+void sort_render_y_based_queue(i32 id, bool refresh_keys) {
   if (not state or state == nullptr) {
-    IERROR("world::refresh_render_queue()::State is not valid");
+    IERROR("world::sort_render_y_based_queue()::State is not valid");
     return;
   }
   for (size_t itr_000 = 0u; itr_000 < MAX_Y_INDEX_SLOT; ++itr_000) {
-    std::vector<tilemap_prop_address>& queue = state->map.at(id).render_y_based_queue.at(itr_000); 
+    arena_vector<tilemap_prop_address>& queue = state->map.at(id).render_y_based_queue.at(itr_000); 
 
-    std::sort(queue.begin(), queue.end(), [](const tilemap_prop_address& a, const tilemap_prop_address& b) {
-      if (a.type == TILEMAP_PROP_TYPE_SPRITE) {
-        tilemap_prop_sprite * _prp_sprite_a = a.data.prop_sprite;
-        i32 y_value_sprite_a = _prp_sprite_a->sprite.coord.y + _prp_sprite_a->sprite.coord.height;
-
-        if (b.type == TILEMAP_PROP_TYPE_SPRITE) {
-          tilemap_prop_sprite * _prp_sprite_b = b.data.prop_sprite;
-          i32 y_value_sprite_b = _prp_sprite_b->sprite.coord.y + _prp_sprite_b->sprite.coord.height;
-
-          return y_value_sprite_a < y_value_sprite_b;
-        }
-        else if (b.type != TILEMAP_PROP_TYPE_SPRITE) {
-          tilemap_prop_static * _prp_static_b = b.data.prop_static;
-          i32 y_value_static_b = _prp_static_b->dest.y + (_prp_static_b->dest.height * _prp_static_b->scale);
-        
-          return y_value_sprite_a < y_value_static_b;
-        }
-        else return false;
+    size_t descent_count = 0u;
+    for (size_t itr_111 = 0u; itr_111 < queue.size(); ++itr_111) {
+      if (refresh_keys) {
+        queue[itr_111] = y_based_prop_address(queue[itr_111]);
       }
-      else if (a.type != TILEMAP_PROP_TYPE_SPRITE) {
-        tilemap_prop_static * _prp_static_a = a.data.prop_static;
-        i32 y_value_sprite_a = _prp_static_a->dest.y + (_prp_static_a->dest.height * _prp_static_a->scale);
-
-        if (b.type == TILEMAP_PROP_TYPE_SPRITE) {
-          tilemap_prop_sprite * _prp_sprite_b = b.data.prop_sprite;
-          i32 y_value_sprite_b = _prp_sprite_b->sprite.coord.y + _prp_sprite_b->sprite.coord.height;
-        
-          return y_value_sprite_a < y_value_sprite_b;
-        }
-        else if (b.type != TILEMAP_PROP_TYPE_SPRITE) {
-          tilemap_prop_static * _prp_static_b = b.data.prop_static;
-          i32 y_value_static_b = _prp_static_b->dest.y + (_prp_static_b->dest.height * _prp_static_b->scale);
-        
-          return y_value_sprite_a < y_value_static_b;
+      if (itr_111 > 0u and queue[itr_111 - 1u].y_key > queue[itr_111].y_key) {
+        descent_count++;
+      }
+    }
+    if (descent_count == 0u) {
+      continue;
+    }
+    bool is_sorted = false;
+    if (descent_count * SPRITE_BATCH_INSERTION_SORT_DIV <= queue.size()) {
+      size_t shift_budget = queue.size() * SPRITE_BATCH_INSERTION_SHIFT_BUDGET;
+      is_sorted = true;
+      for (size_t itr_111 = 1u; itr_111 < queue.size() and is_sorted; ++itr_111) {
+        const tilemap_prop_address entry = queue[itr_111];
+        size_t insert_at = itr_111;
+        for (; insert_at > 0u and queue[insert_at - 1u].y_key > entry.y_key; --insert_at) {
+          if (shift_budget == 0u) {
+            is_sorted = false;
+            break;
+          }
+          queue[insert_at] = queue[insert_at - 1u];
+          shift_budget--;
         }
-        else return false;
+        queue[insert_at] = entry;
       }
-      else return false;
-    });
+    }
+    if (not is_sorted) {
+      std::stable_sort(queue.begin(), queue.end(), [](const tilemap_prop_address& lhs, const tilemap_prop_address& rhs) {
+        return lhs.y_key < rhs.y_key;
+      });
+    }
   }
 }
+tilemap_prop_address y_based_prop_address(tilemap_prop_address prop) {
+  prop.y_key = prop.type == TILEMAP_PROP_TYPE_SPRITE
+    ? static_cast<i32>(prop.data.prop_sprite->sprite.coord.y + prop.data.prop_sprite->sprite.coord.height)
+    : static_cast<i32>(prop.data.prop_static->dest.y + (prop.data.prop_static->dest.height * prop.data.prop_static->scale));
+  return prop;
+}
 void _sort_render_y_based_queue(void) {
   if (not state or state == nullptr) {
     IERROR("world::_sort_render_y_based_queue()::State is not valid");
     return;
   }
-  sort_render_y_based_queue(state->active_map_stage.map_id);
+  sort_render_y_based_queue(state->active_map_stage.map_id, true); // INFO: Editor moved a prop, its stored key is stale
 }
 Rectangle wld_calc_mainmenu_prop_dest(const tilemap * const _tilemap, Rectangle dest, f32 scale) {
   return calc_mainmenu_prop_dest(_tilemap, dest, scale, state->in_app_settings);
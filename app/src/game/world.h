@@ -33,6 +33,7 @@ bool add_prop_curr_map(tilemap_prop_sprite prop_sprite);
 bool add_map_coll_curr_map(Rectangle map_coll);
 bool remove_prop_cur_map_by_id(i32 map_id, tilemap_prop_types type);
 bool remove_map_collision_by_id(i32 coll_id);
+void refresh_prop_bounds_cur_map(i32 map_id, tilemap_prop_types type);
 void update_map(f32 delta_time);
 void drag_tilesheet(Vector2 vec);
 void _render_tile_on_pos(const tile& _tile, Vector2 pos, const tilesheet *const sheet);
@@ -41,5 +42,6 @@ void render_map_palette(f32 zoom);
 void refresh_render_queue(i32 id);
 
 #define _remove_prop_cur_map_by_id(PROP) remove_prop_cur_map_by_id(PROP->map_id, PROP->prop_type)
+#define _refresh_prop_bounds_cur_map(PROP) refresh_prop_bounds_cur_map(PROP->map_id, PROP->prop_type)
 
 #endif
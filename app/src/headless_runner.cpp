@@ -0,0 +1,987 @@
+#include "headless_runner.h"
+
+#if HEADLESS_BUILD
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <unordered_set>
+
+#if PLATFORM_LINUX
+  #include <unistd.h>
+#endif
+
+#include "settings.h"
+#include "sound.h"
+
+#include "tools/loc_parser.h"
+#include "tools/pak_parser.h"
+
+#include "core/event.h"
+#include "core/finput.h"
+#include "core/fjob.h"
+#include "core/fmemory.h"
+#include "core/frandom.h"
+#include "core/ftime.h"
+#include "core/logger.h"
+
+#include "game/camera.h"
+#include "game/game_manager.h"
+#include "game/player.h"
+#include "game/replay.h"
+#include "game/resource.h"
+#include "game/spawn.h"
+#include "game/spritesheet.h"
+#include "game/tilemap.h"
+#include "game/world.h"
+
+#define HEADLESS_RENDER_WIDTH 1920
+#define HEADLESS_RENDER_HEIGHT 1080
+#define HEADLESS_DEFAULT_FRAME_COUNT 3000u
+#define HEADLESS_DEFAULT_SPAWN_COUNT MAX_SPAWN_COUNT
+#define HEADLESS_DEFAULT_TICK_RATE 60.f
+#define HEADLESS_DEFAULT_STAGE 1
+#define HEADLESS_DEFAULT_SEED 0x1C3D1A5ull // INFO: Fixed, so two runs of the same build roll the same spawns and loot
+
+#define HEADLESS_SCRIPT_TURN_INTERVAL 90u
+#define HEADLESS_SCRIPT_ATTACK_INTERVAL 30u
+#define HEADLESS_SCRIPT_ROLL_INTERVAL 240u
+#define HEADLESS_TILE_TRAVERSAL_PASSES 2000u
+#define HEADLESS_MAP_COLLISION_PASSES 20u
+#define HEADLESS_MAP_COLLISION_STEP 4.f
+#define HEADLESS_SPAWN_BATCH_STEP_COUNT 4u
+#define HEADLESS_SPAWN_CHURN_FRAME_COUNT 600u // INFO: Ten seconds at 60 Hz
+#define HEADLESS_SPAWN_CHURN_POPULATION 2048u
+#define HEADLESS_SPAWN_CHURN_PER_FRAME 64u // INFO: Killed and spawned each frame, 3840 of each per second at 60 Hz
+#define HEADLESS_SPAWN_CHURN_ATTEMPT_DIV 4u // INFO: Spawn attempts per frame are this many times the churn, placements overlapping a spawn are refused
+#define HEADLESS_SPAWN_SWEEP_POPULATION 8192u
+#define HEADLESS_SPAWN_SWEEP_FRAME_COUNT 120u
+#define HEADLESS_PAK_LOOKUP_PASSES 1000u
+#define HEADLESS_SPAWN_POPULATION_STEP_COUNT 3u
+#define HEADLESS_SPAWN_POPULATION_FRAME_COUNT 120u
+#define HEADLESS_SPAWN_POPULATION_HIT_COUNT 16u // INFO: Collision damage queries per frame, stands in for the player's projectiles
+#define HEADLESS_SPAWN_GRID_REBUILD_PASSES 200u
+#define HEADLESS_SPAWN_GRID_QUERY_COUNT 10000u
+
+typedef struct headless_runner_config {
+  u32 frame_count;
+  u32 spawn_count;
+  f32 tick_rate;
+  i32 stage_id;
+  ability_id starter_ability;
+  u64 seed;
+  const char * record_path;
+  const char * replay_path;
+  pak_load_backend pak_backend;
+  bool invulnerable;
+
+  headless_runner_config(void) {
+    this->frame_count = HEADLESS_DEFAULT_FRAME_COUNT;
+    this->spawn_count = HEADLESS_DEFAULT_SPAWN_COUNT;
+    this->tick_rate = HEADLESS_DEFAULT_TICK_RATE;
+    this->stage_id = HEADLESS_DEFAULT_STAGE;
+    this->starter_ability = ABILITY_ID_FIREBALL;
+    this->seed = HEADLESS_DEFAULT_SEED;
+    this->record_path = nullptr;
+    this->replay_path = nullptr;
+    this->pak_backend = PAK_LOAD_BACKEND_MAX; // INFO: Max keeps the pak parser's default
+    this->invulnerable = true;
+  }
+} headless_runner_config;
+
+typedef struct headless_map_collision_stats {
+  f64 broadphase_us;
+  f64 brute_force_us;
+  u32 query_count;
+  u32 hit_count;
+  u32 mismatch_count;
+  headless_map_collision_stats(void) {
+    this->broadphase_us = 0.0;
+    this->brute_force_us = 0.0;
+    this->query_count = 0u;
+    this->hit_count = 0u;
+    this->mismatch_count = 0u;
+  }
+} headless_map_collision_stats;
+
+typedef struct headless_resident_memory {
+  u64 after_resource_init_kb;
+  u64 after_pak_drop_kb;
+  headless_resident_memory(void) {
+    this->after_resource_init_kb = 0u;
+    this->after_pak_drop_kb = 0u;
+  }
+} headless_resident_memory;
+
+typedef struct headless_pak_stats {
+  std::array<f64, PAK_FILE_MAX> parse_ms;
+  f64 lookup_ns;
+  f64 viewed_mb;
+  u32 lookup_count;
+  u32 missing_file_count;
+  headless_pak_stats(void) {
+    this->parse_ms.fill(0.0);
+    this->lookup_ns = 0.0;
+    this->viewed_mb = 0.0;
+    this->lookup_count = 0u;
+    this->missing_file_count = 0u;
+  }
+} headless_pak_stats;
+
+typedef struct headless_stage_stats {
+  f64 total_ms;
+  f64 max_ms;
+  headless_stage_stats(void) {
+    this->total_ms = 0.0;
+    this->max_ms = 0.0;
+  }
+} headless_stage_stats;
+
+static const char * const headless_stage_names[GM_UPDATE_STAGE_MAX] = {
+  "undefined", "player", "collectibles", "spawns", "spawn contact", "abilities", "spawn damage"
+};
+
+bool headless_parse_arguments(int argc, char** argv, headless_runner_config& config);
+bool headless_initialize_systems(const headless_runner_config& config, headless_resident_memory& out_resident, headless_pak_stats& out_pak_stats);
+bool headless_parse_pak_timed(pak_file_id id, headless_pak_stats& out_pak_stats);
+void headless_benchmark_pak_lookup(headless_pak_stats& out_pak_stats);
+u64 headless_resident_memory_kb(void);
+bool headless_begin_stage(const headless_runner_config& config);
+input_frame headless_script_input(u32 frame);
+f64 headless_percentile(std::vector<f64> samples, f64 perc);
+f64 headless_benchmark_tile_traversal(const tilemap *const map, i32& out_tiles_x, i32& out_tiles_y);
+headless_map_collision_stats headless_benchmark_map_collision(const tilemap *const map, const spawn_data_soa *const spawns);
+bool headless_check_spawn_batching(i32 stage_id);
+bool headless_stress_spawn_churn(i32 stage_id);
+bool headless_benchmark_spawn_worker_sweep(i32 stage_id);
+bool headless_benchmark_spawn_population(i32 stage_id);
+bool headless_benchmark_spawn_grid(i32 stage_id);
+size_t headless_populate_spawn_lattice(Rectangle area, u32 count);
+
+int headless_runner_main(int argc, char** argv) {
+  headless_runner_config config = headless_runner_config();
+  if (not headless_parse_arguments(argc, argv, config)) {
+    return EXIT_FAILURE;
+  }
+  headless_resident_memory resident = headless_resident_memory();
+  headless_pak_stats pak_stats = headless_pak_stats();
+  if (not headless_initialize_systems(config, resident, pak_stats)) {
+    fprintf(stderr, "headless_runner::Systems failed to initialize\n");
+    return EXIT_FAILURE;
+  }
+  random_set_seed(config.seed);
+  set_simulation_tick_rate(static_cast<i32>(config.tick_rate));
+
+  if (config.replay_path) {
+    const replay_stats * const recorded = replay_arm_playback(config.replay_path) ? replay_get_stats() : nullptr;
+    if (not recorded or recorded->map_id <= 0 or recorded->map_id >= MAX_WORLDMAP_LOCATIONS) {
+      fprintf(stderr, "headless_runner::Replay '%s' could not be loaded\n", config.replay_path);
+      job_system_shutdown();
+      return EXIT_FAILURE;
+    }
+    config.stage_id = recorded->map_id;
+    config.frame_count = recorded->frame_count;
+  }
+  else if (config.record_path and not replay_arm_recording(config.record_path)) {
+    fprintf(stderr, "headless_runner::Recording to '%s' could not be started\n", config.record_path);
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+  const replay_mode run_replay_mode = replay_get_mode();
+
+  if (not headless_begin_stage(config)) {
+    fprintf(stderr, "headless_runner::Stage %d failed to start\n", config.stage_id);
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+  const ingame_info * const game_info = gm_get_ingame_info();
+  const size_t spawn_count_on_begin = game_info->in_spawns->size();
+
+  set_fixed_delta_time(get_simulation_step()); // INFO: One simulation tick per frame, playback has set the recorded rate by now
+
+  std::vector<f64> frame_times;
+  frame_times.reserve(config.frame_count);
+  std::array<headless_stage_stats, GM_UPDATE_STAGE_MAX> stage_stats = {};
+  u64 heap_allocation_total = 0u;
+  u64 heap_allocation_max = 0u;
+  u32 frames_played = 0u;
+
+  for (; frames_played < config.frame_count; ++frames_played) {
+    if ((*game_info->ingame_phase) == INGAME_PLAY_PHASE_RESULTS) {
+      break;
+    }
+    if (run_replay_mode == REPLAY_MODE_PLAYBACK and not replay_is_playing()) {
+      break;
+    }
+    if (run_replay_mode != REPLAY_MODE_PLAYBACK) {
+      input_set_scripted_frame(headless_script_input(frames_played));
+    }
+
+    const auto frame_begin = std::chrono::steady_clock::now();
+    update_game_manager();
+    event_dispatch_deferred();
+    frame_times.push_back(std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - frame_begin).count());
+
+    const std::array<f64, GM_UPDATE_STAGE_MAX>& stage_times = gm_get_update_stage_times();
+    for (size_t itr_000 = GM_UPDATE_STAGE_UNDEFINED + 1; itr_000 < GM_UPDATE_STAGE_MAX; ++itr_000) {
+      stage_stats.at(itr_000).total_ms += stage_times.at(itr_000);
+      stage_stats.at(itr_000).max_ms = std::max(stage_stats.at(itr_000).max_ms, stage_times.at(itr_000));
+    }
+    if (config.invulnerable) {
+      player_heal_player(I32_MAX / 2);
+    }
+    const u64 heap_allocation_count = static_cast<u64>(get_heap_allocation_count_frame());
+    heap_allocation_total += heap_allocation_count;
+    heap_allocation_max = std::max(heap_allocation_max, heap_allocation_count);
+    update_time();
+    memory_frame_reset();
+  }
+  const bool replay_result = replay_get_mode() != REPLAY_MODE_NONE ? replay_finish() : true;
+
+  f64 total_ms = 0.0;
+  for (const f64 ms : frame_times) {
+    total_ms += ms;
+  }
+  const f64 frame_div = frames_played > 0u ? static_cast<f64>(frames_played) : 1.0;
+
+  printf("Incendium headless run\n");
+  printf("  stage %d, %u / %u frames at %.1f Hz, %u worker(s), seed %llu\n", config.stage_id, frames_played, config.frame_count, 1.f / get_simulation_step(), job_system_thread_count() - 1u,
+    static_cast<unsigned long long>(random_get_seed())
+  );
+  printf("  spawns requested %u, on begin %zu, on end %zu\n", config.spawn_count, spawn_count_on_begin, game_info->in_spawns->size());
+  printf("  tile chunks %u baked, matching the per-tile renderer\n", tilemap_chunk_cache_baked_count());
+  printf("  update_game_manager  avg %8.3f ms  p50 %8.3f ms  p99 %8.3f ms  max %8.3f ms\n",
+    total_ms / frame_div,
+    headless_percentile(frame_times, .50), headless_percentile(frame_times, .99), headless_percentile(frame_times, 1.)
+  );
+  if (resident.after_resource_init_kb > 0u) {
+    printf("  resident memory      %llu KB after resource init, %llu KB after dropping the asset paks, %s backend\n",
+      static_cast<unsigned long long>(resident.after_resource_init_kb), static_cast<unsigned long long>(resident.after_pak_drop_kb),
+      pak_parser_get_load_backend() == PAK_LOAD_BACKEND_MMAP ? "mmap" : "file data"
+    );
+  }
+  printf("  pak parse            %8.3f ms asset1, %8.3f ms asset2, %8.3f ms map, %s backend\n", 
+    pak_stats.parse_ms.at(PAK_FILE_ASSET1), pak_stats.parse_ms.at(PAK_FILE_ASSET2), pak_stats.parse_ms.at(PAK_FILE_MAP),
+    pak_parser_get_load_backend() == PAK_LOAD_BACKEND_MMAP ? "mmap" : "file data"
+  );
+  printf("  pak file lookup      avg %8.3f ns over %u lookups, %.1f MB viewed without a copy, %u file(s) missing from the paks\n", 
+    pak_stats.lookup_ns, pak_stats.lookup_count, pak_stats.viewed_mb, pak_stats.missing_file_count
+  );
+  printf("  heap allocations     avg %8.2f per frame, max %llu\n", static_cast<f64>(heap_allocation_total) / frame_div, static_cast<unsigned long long>(heap_allocation_max));
+  const memory_usage_stats * const mem_stats = get_memory_usage_stats();
+  printf("  linear memory        %llu / %llu KB reserved\n", mem_stats->linear_memory_allocated / 1024u, mem_stats->linear_memory_total_size / 1024u);
+  for (size_t itr_000 = MEMORY_TAG_UNKNOWN; itr_000 < MEMORY_TAG_MAX; ++itr_000) {
+    if (mem_stats->high_water[itr_000] == 0u) {
+      continue;
+    }
+    printf("  memory %-14s in use %8llu KB, high water %8llu KB\n", memory_tag_to_string(static_cast<memory_tag>(itr_000)),
+      mem_stats->current[itr_000] / 1024u, mem_stats->high_water[itr_000] / 1024u
+    );
+  }
+  for (size_t itr_000 = GM_UPDATE_STAGE_UNDEFINED + 1; itr_000 < GM_UPDATE_STAGE_MAX; ++itr_000) {
+    printf("  %-20s avg %8.3f ms  max %8.3f ms  share %5.1f%%\n", headless_stage_names[itr_000],
+      stage_stats.at(itr_000).total_ms / frame_div, stage_stats.at(itr_000).max_ms,
+      total_ms > 0.0 ? stage_stats.at(itr_000).total_ms / total_ms * 100.0 : 0.0
+    );
+  }
+  i32 traversal_tiles_x = 0;
+  i32 traversal_tiles_y = 0;
+  const f64 traversal_us = headless_benchmark_tile_traversal(get_active_map(), traversal_tiles_x, traversal_tiles_y);
+  printf("  tile traversal       avg %8.3f us per full-screen pass, %dx%d tiles, %d layers\n", traversal_us, traversal_tiles_x, traversal_tiles_y, MAX_TILEMAP_LAYERS);
+  const headless_map_collision_stats coll_stats = headless_benchmark_map_collision(get_active_map(), game_info->in_spawns);
+  printf("  map collision        avg %8.3f us broadphase, %8.3f us brute force per sweep, %u queries, %zu walls, %u hits\n",
+    coll_stats.broadphase_us, coll_stats.brute_force_us, coll_stats.query_count, get_active_map()->collisions.size(), coll_stats.hit_count
+  );
+  const replay_stats * const replay = replay_get_stats();
+  if (run_replay_mode == REPLAY_MODE_RECORD) {
+    printf("  replay recorded      %u frames, %u checksums, %s '%s'\n", replay->frame_count, replay->checksum_count, replay_result ? "written to" : "failed to write", config.record_path);
+  }
+  else if (run_replay_mode == REPLAY_MODE_PLAYBACK) {
+    printf("  replay played        %u / %u frames, %u checksums compared, %u mismatched, first divergent frame %d\n",
+      replay->frames_played, replay->frame_count, replay->checksum_count, replay->checksum_mismatch_count, replay->first_divergent_frame
+    );
+  }
+  if (coll_stats.mismatch_count > 0u) {
+    fprintf(stderr, "headless_runner::%u map collision queries differ from the brute force\n", coll_stats.mismatch_count);
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+
+  if (not replay_result or replay->checksum_mismatch_count > 0u) {
+    fprintf(stderr, "headless_runner::Replay %s\n", replay_result ? "diverged from the recording" : "file could not be written");
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+  if (not headless_check_spawn_batching(config.stage_id)) {
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+  if (not headless_stress_spawn_churn(config.stage_id)) {
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+  if (not headless_benchmark_spawn_worker_sweep(config.stage_id)) {
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+  if (not headless_benchmark_spawn_population(config.stage_id)) {
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+  if (not headless_benchmark_spawn_grid(config.stage_id)) {
+    job_system_shutdown();
+    return EXIT_FAILURE;
+  }
+
+  IINFO("headless_runner::headless_runner_main()::%u frames played, %.3f ms average update", frames_played, total_ms / frame_div);
+
+  job_system_shutdown();
+  return EXIT_SUCCESS;
+}
+
+bool headless_parse_arguments(int argc, char** argv, headless_runner_config& config) {
+  for (i32 itr_000 = 1; itr_000 < argc; ++itr_000) {
+    const char * arg = argv[itr_000];
+
+    if (std::strncmp(arg, "--frames=", 9) == 0) {
+      config.frame_count = static_cast<u32>(std::strtoul(arg + 9, nullptr, 10));
+    }
+    else if (std::strncmp(arg, "--spawns=", 9) == 0) {
+      config.spawn_count = static_cast<u32>(std::strtoul(arg + 9, nullptr, 10));
+    }
+    else if (std::strncmp(arg, "--tick-rate=", 12) == 0) {
+      config.tick_rate = std::strtof(arg + 12, nullptr);
+    }
+    else if (std::strncmp(arg, "--stage=", 8) == 0) {
+      config.stage_id = static_cast<i32>(std::strtol(arg + 8, nullptr, 10));
+    }
+    else if (std::strncmp(arg, "--seed=", 7) == 0) {
+      config.seed = static_cast<u64>(std::strtoull(arg + 7, nullptr, 0));
+    }
+    else if (std::strncmp(arg, "--record=", 9) == 0) {
+      config.record_path = arg + 9;
+    }
+    else if (std::strncmp(arg, "--replay=", 9) == 0) {
+      config.replay_path = arg + 9;
+    }
+    else if (std::strcmp(arg, "--pak-backend=mmap") == 0) {
+      config.pak_backend = PAK_LOAD_BACKEND_MMAP;
+    }
+    else if (std::strcmp(arg, "--pak-backend=file") == 0) {
+      config.pak_backend = PAK_LOAD_BACKEND_FILE_DATA;
+    }
+    else if (std::strcmp(arg, "--mortal") == 0) {
+      config.invulnerable = false;
+    }
+    else {
+      fprintf(stderr, "headless_runner::Unknown argument '%s'\n", arg);
+      fprintf(stderr, "Usage: %s [--frames=N] [--spawns=N] [--tick-rate=HZ] [--stage=ID] [--seed=N] [--record=PATH | --replay=PATH] [--pak-backend=mmap|file] [--mortal]\n", argv[0]);
+      return false;
+    }
+  }
+  if (config.spawn_count > MAX_SPAWN_COUNT) {
+    fprintf(stderr, "headless_runner::Spawn count is clamped to %d\n", MAX_SPAWN_COUNT);
+    config.spawn_count = MAX_SPAWN_COUNT;
+  }
+  if (config.tick_rate < 1.f) {
+    fprintf(stderr, "headless_runner::Tick rate must be at least 1 Hz\n");
+    return false;
+  }
+  if (config.stage_id <= 0 or config.stage_id >= MAX_WORLDMAP_LOCATIONS) {
+    fprintf(stderr, "headless_runner::Stage id is out of bound\n");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Same order as app_initialize(), minus the window, the scene manager and the shaders
+ */
+bool headless_initialize_systems(const headless_runner_config& config, headless_resident_memory& out_resident, headless_pak_stats& out_pak_stats) {
+  memory_system_initialize();
+  if (not event_system_initialize() or not time_system_initialize()) {
+    return false;
+  }
+  if (not random_system_initialize(HEADLESS_DEFAULT_SEED)) {
+    return false;
+  }
+  if (not job_system_initialize(job_system_recommended_worker_count())) {
+    return false;
+  }
+  if (not input_system_initialize()) {
+    return false;
+  }
+  input_set_source(INPUT_SOURCE_SCRIPTED);
+  if (not replay_system_initialize()) {
+    return false;
+  }
+
+  if (not settings_initialize()) {
+    return false;
+  }
+  set_resolution(HEADLESS_RENDER_WIDTH, HEADLESS_RENDER_HEIGHT);
+  set_window_size(HEADLESS_RENDER_WIDTH, HEADLESS_RENDER_HEIGHT);
+
+  if (not logging_system_initialize(0)) {
+    return false;
+  }
+  if (not pak_parser_system_initialize()) {
+    return false;
+  }
+  if (config.pak_backend != PAK_LOAD_BACKEND_MAX) {
+    pak_parser_set_load_backend(config.pak_backend);
+  }
+  if (not headless_parse_pak_timed(PAK_FILE_ASSET1, out_pak_stats) or not headless_parse_pak_timed(PAK_FILE_ASSET2, out_pak_stats) or not headless_parse_pak_timed(PAK_FILE_MAP, out_pak_stats)) {
+    IERROR("headless_runner::headless_initialize_systems()::Pak parse failed");
+    return false;
+  }
+  headless_benchmark_pak_lookup(out_pak_stats); // INFO: Before resources are loaded and the asset paks are dropped
+  if (not loc_parser_system_initialize()) {
+    return false;
+  }
+  _loc_parser_parse_localization_data();
+
+  if (not resource_system_initialize() or not sound_system_initialize()) {
+    return false;
+  }
+  out_resident.after_resource_init_kb = headless_resident_memory_kb();
+  pak_parser_drop_pak_data(PAK_FILE_ASSET1);
+  pak_parser_drop_pak_data(PAK_FILE_ASSET2);
+  out_resident.after_pak_drop_kb = headless_resident_memory_kb();
+
+  if (not sprite_batch_initialize(SPRITE_BATCH_BACKEND_RECORDING)) {
+    return false;
+  }
+  if (not tilemap_chunk_cache_initialize(TILEMAP_CHUNK_BACKEND_RECORDING)) {
+    return false;
+  }
+  const app_settings * const settings = get_app_settings();
+  if (not world_system_initialize(settings)) {
+    return false;
+  }
+  if (not create_camera(settings->render_width_div2, settings->render_height_div2, settings->render_width, settings->render_height)) {
+    return false;
+  }
+  if (not world_system_begin(get_in_game_camera())) {
+    return false;
+  }
+  return game_manager_initialize(get_in_game_camera(), settings, get_active_map_ptr());
+}
+
+bool headless_begin_stage(const headless_runner_config& config) {
+  set_worldmap_location(config.stage_id);
+
+  tilemap_chunk_cache_sync(get_active_map());
+  const u32 chunk_mismatch_count = tilemap_chunk_cache_verify(get_active_map());
+  if (chunk_mismatch_count > 0u) {
+    fprintf(stderr, "headless_runner::%u tile chunk(s) differ from the per-tile renderer\n", chunk_mismatch_count);
+    return false;
+  }
+
+  worldmap_stage stage = get_worldmap_locations().at(config.stage_id);
+  stage.spawn_on_begin = static_cast<i32>(config.spawn_count);
+  stage.spawn_on_map_max = static_cast<i32>(config.spawn_count);
+
+  std::vector<character_trait> traits = std::vector<character_trait>();
+  if (not gm_init_game(stage, traits, config.starter_ability)) {
+    return false;
+  }
+  gm_start_game();
+  return true;
+}
+
+/**
+ * @brief Deterministic input, walks the eight directions in turn while attacking and rolling on fixed intervals
+ */
+input_frame headless_script_input(u32 frame) {
+  input_frame input = input_frame();
+  const u32 heading = (frame / HEADLESS_SCRIPT_TURN_INTERVAL) % 8u;
+
+  input.down.at(INPUT_ACTION_MOVE_UP)    = heading == 7u or heading == 0u or heading == 1u;
+  input.down.at(INPUT_ACTION_MOVE_RIGHT) = heading == 1u or heading == 2u or heading == 3u;
+  input.down.at(INPUT_ACTION_MOVE_DOWN)  = heading == 3u or heading == 4u or heading == 5u;
+  input.down.at(INPUT_ACTION_MOVE_LEFT)  = heading == 5u or heading == 6u or heading == 7u;
+
+  input.released.at(INPUT_ACTION_ATTACK) = frame % HEADLESS_SCRIPT_ATTACK_INTERVAL == 0u;
+  input.released.at(INPUT_ACTION_ROLL)   = frame % HEADLESS_SCRIPT_ROLL_INTERVAL == HEADLESS_SCRIPT_ROLL_INTERVAL - 1u;
+
+  input.mouse_position = Vector2 {
+    HEADLESS_RENDER_WIDTH  * .5f + static_cast<f32>(heading) * 40.f,
+    HEADLESS_RENDER_HEIGHT * .5f - static_cast<f32>(heading) * 20.f
+  };
+  return input;
+}
+
+/**
+ * @brief Reads every layer of a screen's worth of tiles in the renderer's order, y outer and x inner. Returns microseconds per pass
+ */
+f64 headless_benchmark_tile_traversal(const tilemap *const map, i32& out_tiles_x, i32& out_tiles_y) {
+  if (not map or map == nullptr or map->tile_size <= 0) {
+    return 0.0;
+  }
+  out_tiles_x = std::min(HEADLESS_RENDER_WIDTH / map->tile_size + 1, map->map_dim);
+  out_tiles_y = std::min(HEADLESS_RENDER_HEIGHT / map->tile_size + 1, map->map_dim);
+  u32 checksum = 0u;
+
+  const auto traversal_begin = std::chrono::steady_clock::now();
+  for (u32 pass = 0u; pass < HEADLESS_TILE_TRAVERSAL_PASSES; ++pass) {
+    for (i32 y = 0; y < out_tiles_y; ++y) {
+      for (i32 x = 0; x < out_tiles_x; ++x) {
+        const tilemap_cell& cell = map->tiles.cell(x, y);
+        for (i32 layer = 0; layer < MAX_TILEMAP_LAYERS; ++layer) {
+          checksum += cell.layers[layer].c[0] + cell.layers[layer].c[1];
+        }
+      }
+    }
+  }
+  const f64 total_us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - traversal_begin).count();
+
+  IDEBUG("headless_runner::headless_benchmark_tile_traversal()::Checksum %u", checksum); // INFO: Keeps the reads alive
+  return total_us / HEADLESS_TILE_TRAVERSAL_PASSES;
+}
+
+/**
+ * @brief Sweeps MAX_SPAWN_COUNT spawn rects against the map walls the way spawn movement does, one query per axis.
+ * @brief Live spawns are reused round robin when fewer are left. Returns microseconds per sweep of both paths
+ */
+headless_map_collision_stats headless_benchmark_map_collision(const tilemap *const map, const spawn_data_soa *const spawns) {
+  headless_map_collision_stats stats = headless_map_collision_stats();
+  if (not map or map == nullptr or not spawns or spawns == nullptr or spawns->collision.empty()) {
+    return stats;
+  }
+  std::vector<Rectangle> queries;
+  queries.reserve(MAX_SPAWN_COUNT * 2u);
+  for (size_t itr_000 = 0u; itr_000 < MAX_SPAWN_COUNT; ++itr_000) {
+    const Rectangle& coll = spawns->collision.at(itr_000 % spawns->collision.size());
+    queries.push_back(Rectangle {coll.x + HEADLESS_MAP_COLLISION_STEP, coll.y, coll.width, coll.height});
+    queries.push_back(Rectangle {coll.x, coll.y + HEADLESS_MAP_COLLISION_STEP, coll.width, coll.height});
+  }
+  stats.query_count = static_cast<u32>(queries.size());
+  std::vector<u8> broadphase_hits(queries.size(), 0u);
+  std::vector<u8> brute_force_hits(queries.size(), 0u);
+
+  const auto broadphase_begin = std::chrono::steady_clock::now();
+  for (u32 pass = 0u; pass < HEADLESS_MAP_COLLISION_PASSES; ++pass) {
+    for (size_t itr_000 = 0u; itr_000 < queries.size(); ++itr_000) {
+      broadphase_hits[itr_000] = map_spatial_index_overlaps_collision(map, queries[itr_000]);
+    }
+  }
+  stats.broadphase_us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - broadphase_begin).count() / HEADLESS_MAP_COLLISION_PASSES;
+
+  const auto brute_force_begin = std::chrono::steady_clock::now();
+  for (u32 pass = 0u; pass < HEADLESS_MAP_COLLISION_PASSES; ++pass) {
+    for (size_t itr_000 = 0u; itr_000 < queries.size(); ++itr_000) {
+      bool is_hit = false;
+      for (const map_collision& coll : map->collisions) {
+        if (CheckCollisionRecs(coll.dest, queries[itr_000])) {
+          is_hit = true;
+          break;
+        }
+      }
+      brute_force_hits[itr_000] = is_hit;
+    }
+  }
+  stats.brute_force_us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - brute_force_begin).count() / HEADLESS_MAP_COLLISION_PASSES;
+
+  for (size_t itr_000 = 0u; itr_000 < queries.size(); ++itr_000) {
+    stats.hit_count += broadphase_hits[itr_000];
+    stats.mismatch_count += broadphase_hits[itr_000] != brute_force_hits[itr_000];
+  }
+  return stats;
+}
+
+/**
+ * @brief Resident set size of the process, 0 where it cannot be read
+ */
+/**
+ * @brief Load and index of one pak, from reading the file to the last file view
+ */
+bool headless_parse_pak_timed(pak_file_id id, headless_pak_stats& out_pak_stats) {
+  const auto parse_begin = std::chrono::steady_clock::now();
+  const bool result = id == PAK_FILE_MAP ? parse_map_pak() : parse_asset_pak(id);
+  out_pak_stats.parse_ms.at(id) = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - parse_begin).count();
+  return result;
+}
+
+/**
+ * @brief Every asset file of both asset paks looked up HEADLESS_PAK_LOOKUP_PASSES times through get_asset_file_buffer()
+ */
+void headless_benchmark_pak_lookup(headless_pak_stats& out_pak_stats) {
+  static constexpr std::array<std::pair<pak_file_id, i32>, 2> paks = {
+    std::pair<pak_file_id, i32>(PAK_FILE_ASSET1, static_cast<i32>(PAK_FILE_ASSET1_MAX)), 
+    std::pair<pak_file_id, i32>(PAK_FILE_ASSET2, static_cast<i32>(PAK_FILE_ASSET2_MAX))
+  };
+  std::vector<std::pair<pak_file_id, i32>> files = std::vector<std::pair<pak_file_id, i32>>();
+  for (const std::pair<pak_file_id, i32>& pak : paks) {
+    for (i32 index = 1; index < pak.second; ++index) {
+      if (get_asset_file_buffer(pak.first, index)) {
+        files.push_back(std::pair<pak_file_id, i32>(pak.first, index));
+      }
+      else {
+        out_pak_stats.missing_file_count++; // INFO: Left out of the timing, a miss goes through the error path every time
+      }
+    }
+  }
+  u64 viewed_bytes = 0u; // INFO: Keeps the lookups from being optimized out
+  const auto lookup_begin = std::chrono::steady_clock::now();
+  for (u32 pass = 0u; pass < HEADLESS_PAK_LOOKUP_PASSES; ++pass) {
+    for (const std::pair<pak_file_id, i32>& file : files) {
+      viewed_bytes += get_asset_file_buffer(file.first, file.second)->content.size();
+    }
+  }
+  const f64 lookup_ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - lookup_begin).count();
+  out_pak_stats.lookup_count = static_cast<u32>(files.size()) * HEADLESS_PAK_LOOKUP_PASSES;
+  out_pak_stats.lookup_ns = out_pak_stats.lookup_count > 0u ? lookup_ns / static_cast<f64>(out_pak_stats.lookup_count) : 0.0;
+  out_pak_stats.viewed_mb = static_cast<f64>(viewed_bytes) / (1024.0 * 1024.0);
+}
+
+u64 headless_resident_memory_kb(void) {
+  #if PLATFORM_LINUX
+    FILE * statm = std::fopen("/proc/self/statm", "r");
+    if (not statm or statm == nullptr) {
+      return 0u;
+    }
+    unsigned long long total_pages = 0u;
+    unsigned long long resident_pages = 0u;
+    const i32 read_count = std::fscanf(statm, "%llu %llu", &total_pages, &resident_pages);
+    std::fclose(statm);
+    if (read_count != 2) {
+      return 0u;
+    }
+    return static_cast<u64>(resident_pages) * static_cast<u64>(sysconf(_SC_PAGESIZE)) / 1024u;
+  #else
+    return 0u;
+  #endif
+}
+
+f64 headless_percentile(std::vector<f64> samples, f64 perc) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const size_t index = std::min(samples.size() - 1u, static_cast<size_t>(perc * static_cast<f64>(samples.size())));
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+  return samples.at(index);
+}
+
+/**
+ * @brief Spawns up to count spawns on an even lattice over area, cycling the spawn types.
+ * @return The spawn count after placement, which can fall short of count when the spawn storage is full
+ */
+size_t headless_populate_spawn_lattice(Rectangle area, u32 count) {
+  static constexpr std::array<spawn_type, 4> spawn_types = {SPAWN_TYPE_BROWN, SPAWN_TYPE_ORANGE, SPAWN_TYPE_YELLOW, SPAWN_TYPE_RED};
+  const u32 columns = static_cast<u32>(std::ceil(std::sqrt(static_cast<f32>(count))));
+
+  for (u32 itr_000 = 0u; itr_000 < count; ++itr_000) {
+    const Vector2 position = Vector2 {
+      area.x + area.width  * (static_cast<f32>(itr_000 % columns) + .5f) / static_cast<f32>(columns),
+      area.y + area.height * (static_cast<f32>(itr_000 / columns) + .5f) / static_cast<f32>(columns)
+    };
+    spawn_character(Character2D(spawn_types.at(itr_000 % spawn_types.size()), 1, 0, position));
+  }
+  return get_spawns()->size();
+}
+
+/**
+ * @brief Lays out a growing number of spawns inside the stage's spawning area and records a scene batch of them each time.
+ * @brief Shader and texture switches have to stay where the smallest count left them, every spawn belongs in the same draw call.
+ * @brief Runs on the live spawn state, so it clears whatever the main run left behind
+ */
+bool headless_check_spawn_batching(i32 stage_id) {
+  static constexpr std::array<u32, HEADLESS_SPAWN_BATCH_STEP_COUNT> spawn_counts = {64u, 256u, 1024u, 4096u};
+  const Rectangle area = get_worldmap_locations().at(stage_id).spawning_areas.at(0);
+  std::array<sprite_batch_stats, HEADLESS_SPAWN_BATCH_STEP_COUNT> batch_stats = {};
+  std::array<size_t, HEADLESS_SPAWN_BATCH_STEP_COUNT> spawned_counts = {};
+
+  for (size_t step = 0u; step < spawn_counts.size(); ++step) {
+    clean_up_spawn_state();
+    spawned_counts.at(step) = headless_populate_spawn_lattice(area, spawn_counts.at(step));
+
+    sprite_batch_begin();
+    render_spawns();
+    sprite_batch_flush();
+    batch_stats.at(step) = sprite_batch_get_stats();
+  }
+  clean_up_spawn_state();
+
+  bool is_flat = true;
+  for (size_t step = 0u; step < spawn_counts.size(); ++step) {
+    const sprite_batch_stats& stats = batch_stats.at(step);
+    printf("  spawn batching       %5zu spawns, %6u quads, %u shader switches, %u texture switches\n", 
+      spawned_counts.at(step), stats.quad_count, stats.shader_switch_count, stats.texture_switch_count
+    );
+    is_flat = is_flat and stats.shader_switch_count == batch_stats.at(0).shader_switch_count and stats.texture_switch_count == batch_stats.at(0).texture_switch_count;
+  }
+  if (not is_flat) {
+    fprintf(stderr, "headless_runner::Spawn batch switches grow with the spawn count\n");
+  }
+  return is_flat;
+}
+
+/**
+ * @brief Kills and spawns HEADLESS_SPAWN_CHURN_PER_FRAME spawns every frame on a populated stage, so slots are released and reused all the time.
+ * @brief Killed ids must stop resolving once update_spawns() removes them, every live id must resolve to its own spawn,
+ * @brief and no id may be handed out twice in the run.
+ * @brief Runs on the live spawn state, so it clears whatever the main run left behind
+ */
+bool headless_stress_spawn_churn(i32 stage_id) {
+  static constexpr std::array<spawn_type, 4> spawn_types = {SPAWN_TYPE_BROWN, SPAWN_TYPE_ORANGE, SPAWN_TYPE_YELLOW, SPAWN_TYPE_RED};
+  const Rectangle area = get_worldmap_locations().at(stage_id).spawning_areas.at(0);
+  const Vector2 player_position = Vector2 { area.x + area.width * .5f, area.y + area.height * .5f };
+  const spawn_data_soa * const spawns = get_spawns();
+
+  std::unordered_set<i32> issued_ids = std::unordered_set<i32>();
+  std::vector<i32> killed_ids = std::vector<i32>();
+  killed_ids.reserve(HEADLESS_SPAWN_CHURN_PER_FRAME);
+  u32 spawned_count = 0u;
+  u32 killed_count = 0u;
+  u32 reused_id_count = 0u;
+  u32 stale_resolve_count = 0u;
+  u32 live_mismatch_count = 0u;
+
+  auto spawn_batch = [&](u32 count) {
+    u32 placed = 0u;
+    for (u32 attempt = 0u; attempt < count * HEADLESS_SPAWN_CHURN_ATTEMPT_DIV and placed < count; ++attempt) {
+      const Vector2 position = Vector2 { 
+        area.x + area.width  * random_f32(RANDOM_STREAM_SPAWN), 
+        area.y + area.height * random_f32(RANDOM_STREAM_SPAWN)
+      };
+      const i32 id = spawn_character(Character2D(spawn_types.at(attempt % spawn_types.size()), 1, 0, position));
+      if (id < 0) {
+        continue;
+      }
+      if (not issued_ids.insert(id).second) {
+        reused_id_count++;
+      }
+      placed++;
+    }
+    spawned_count += placed;
+  };
+  clean_up_spawn_state();
+  spawn_batch(HEADLESS_SPAWN_CHURN_POPULATION);
+  spawned_count = 0u; // INFO: Only the churn is counted
+
+  f64 churn_ms = 0.0;
+  for (u32 frame = 0u; frame < HEADLESS_SPAWN_CHURN_FRAME_COUNT; ++frame) {
+    const auto frame_begin = std::chrono::steady_clock::now();
+
+    killed_ids.clear();
+    for (u32 itr_000 = 0u; itr_000 < HEADLESS_SPAWN_CHURN_PER_FRAME and spawns->size() > 0u; ++itr_000) {
+      const size_t index = (static_cast<size_t>(frame) * 7919u + static_cast<size_t>(itr_000) * 104729u) % spawns->size();
+      const i32 id = spawns->character_id[index];
+      if (damage_spawn(id, MAX_SPAWN_HEALTH).type == DAMAGE_DEAL_RESULT_SUCCESS and spawns->has_flag(index, SPAWN_FLAG_DEAD)) {
+        killed_ids.push_back(id);
+      }
+    }
+    update_spawns(player_position);
+    spawn_batch(HEADLESS_SPAWN_CHURN_PER_FRAME);
+
+    churn_ms += std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - frame_begin).count();
+    killed_count += static_cast<u32>(killed_ids.size());
+
+    for (const i32 id : killed_ids) {
+      if (get_spawn_by_id(id) != nullptr) {
+        stale_resolve_count++;
+      }
+    }
+    for (size_t index = 0u; index < spawns->size(); ++index) {
+      const Character2D * const spawn = get_spawn_by_id(spawns->character_id[index]);
+      if (not spawn or spawn->character_id != spawns->character_id[index]) {
+        live_mismatch_count++;
+      }
+    }
+    const element_handle * const nearest = get_nearest_spawn();
+    if (nearest->index < spawns->size() and spawns->character_id[nearest->index] != nearest->id) {
+      live_mismatch_count++;
+    }
+    event_dispatch_deferred();
+    memory_frame_reset();
+  }
+  clean_up_spawn_state();
+
+  printf("  spawn churn          %u killed, %u spawned in %u frames, avg %8.3f ms per frame, %u stale ids resolved, %u live ids lost, %u ids reused\n",
+    killed_count, spawned_count, HEADLESS_SPAWN_CHURN_FRAME_COUNT, churn_ms / static_cast<f64>(HEADLESS_SPAWN_CHURN_FRAME_COUNT),
+    stale_resolve_count, live_mismatch_count, reused_id_count
+  );
+  const bool is_valid = killed_count > 0u and stale_resolve_count == 0u and live_mismatch_count == 0u and reused_id_count == 0u;
+  if (not is_valid) {
+    fprintf(stderr, "headless_runner::Spawn handles did not survive the churn\n");
+  }
+  return is_valid;
+}
+
+/**
+ * @brief Runs the same spawn lattice through update_spawns() with 0 .. job_system_recommended_worker_count() workers.
+ * @brief Every worker count has to end with the spawns of the single threaded run, bit for bit, or the run fails.
+ * @brief Runs on the live spawn state and leaves the job system with the workers it was given on initialize
+ */
+bool headless_benchmark_spawn_worker_sweep(i32 stage_id) {
+  const Rectangle area = get_worldmap_locations().at(stage_id).spawning_areas.at(0);
+  const Vector2 player_position = Vector2 { area.x + area.width * .5f, area.y + area.height * .5f };
+  const spawn_data_soa * const spawns = get_spawns();
+  const u32 initial_worker_count = job_system_thread_count() - 1u;
+  const u32 max_worker_count = job_system_recommended_worker_count();
+
+  u64 reference_hash = 0u;
+  f64 reference_ms = 0.0;
+  bool is_deterministic = true;
+
+  for (u32 worker_count = 0u; worker_count <= max_worker_count; ++worker_count) {
+    if (not job_system_set_worker_count(worker_count)) {
+      return false;
+    }
+    clean_up_spawn_state();
+    const size_t population = headless_populate_spawn_lattice(area, HEADLESS_SPAWN_SWEEP_POPULATION);
+
+    f64 update_ms = 0.0;
+    for (u32 frame = 0u; frame < HEADLESS_SPAWN_SWEEP_FRAME_COUNT; ++frame) {
+      const auto update_begin = std::chrono::steady_clock::now();
+      update_spawns(player_position);
+      update_ms += std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - update_begin).count();
+      event_dispatch_deferred();
+      memory_frame_reset();
+    }
+    update_ms /= static_cast<f64>(HEADLESS_SPAWN_SWEEP_FRAME_COUNT);
+
+    u64 hash = 0xCBF29CE484222325ull; // INFO: FNV-1a over what the update writes
+    auto mix = [&hash](const void * data, size_t size) {
+      const u8 * bytes = static_cast<const u8 *>(data);
+      for (size_t itr_000 = 0u; itr_000 < size; ++itr_000) {
+        hash ^= bytes[itr_000];
+        hash *= 0x100000001B3ull;
+      }
+    };
+    for (size_t index = 0u; index < spawns->size(); ++index) {
+      mix(&spawns->character_id[index], sizeof(i32));
+      mix(&spawns->position[index], sizeof(Vector2));
+      mix(&spawns->collision[index], sizeof(Rectangle));
+      mix(&spawns->flags[index], sizeof(spawns->flags[index]));
+    }
+    if (worker_count == 0u) {
+      reference_hash = hash;
+      reference_ms = update_ms;
+    }
+    const bool matches = hash == reference_hash;
+    is_deterministic = is_deterministic and matches;
+
+    printf("  spawn worker sweep   %u thread(s), %5zu spawns, avg %8.3f ms per update, %5.2fx, %s\n",
+      worker_count + 1u, population, update_ms, update_ms > 0.0 ? reference_ms / update_ms : 0.0, matches ? "matches 1 thread" : "DIFFERS from 1 thread"
+    );
+  }
+  clean_up_spawn_state();
+  job_system_set_worker_count(initial_worker_count);
+
+  if (not is_deterministic) {
+    fprintf(stderr, "headless_runner::Spawn update result depends on the worker count\n");
+  }
+  return is_deterministic;
+}
+
+/**
+ * @brief Times a whole spawn frame at 1k, 5k and 10k spawns: update_spawns(), collision damage queries and their resolve, then the scene batch.
+ * @brief Damage is 0, so the population stays the same through the run and every frame is measured at its count.
+ * @brief Runs on the live spawn state, so it clears whatever the main run left behind
+ */
+bool headless_benchmark_spawn_population(i32 stage_id) {
+  static constexpr std::array<u32, HEADLESS_SPAWN_POPULATION_STEP_COUNT> spawn_counts = {1000u, 5000u, MAX_SPAWN_COUNT};
+  const Rectangle area = get_worldmap_locations().at(stage_id).spawning_areas.at(0);
+  const Vector2 player_position = Vector2 { area.x + area.width * .5f, area.y + area.height * .5f };
+  const Vector2 hit_size = Vector2 { area.width * .05f, area.height * .05f };
+
+  for (size_t step = 0u; step < spawn_counts.size(); ++step) {
+    clean_up_spawn_state();
+    const size_t population = headless_populate_spawn_lattice(area, spawn_counts.at(step));
+    if (population < spawn_counts.at(step)) {
+      fprintf(stderr, "headless_runner::Spawn population benchmark placed %zu of %u spawns\n", population, spawn_counts.at(step));
+      clean_up_spawn_state();
+      return false;
+    }
+    std::vector<f64> frame_samples = std::vector<f64>();
+    frame_samples.reserve(HEADLESS_SPAWN_POPULATION_FRAME_COUNT);
+
+    for (u32 frame = 0u; frame < HEADLESS_SPAWN_POPULATION_FRAME_COUNT; ++frame) {
+      const auto frame_begin = std::chrono::steady_clock::now();
+      update_spawns(player_position);
+      for (u32 itr_000 = 0u; itr_000 < HEADLESS_SPAWN_POPULATION_HIT_COUNT; ++itr_000) {
+        const u32 cell = (frame * HEADLESS_SPAWN_POPULATION_HIT_COUNT + itr_000) * 7919u;
+        const Rectangle hit = Rectangle {
+          area.x + (area.width  - hit_size.x) * static_cast<f32>(cell % 97u) / 96.f,
+          area.y + (area.height - hit_size.y) * static_cast<f32>(cell % 89u) / 88.f,
+          hit_size.x, hit_size.y
+        };
+        queue_spawn_damage_by_collision(hit, 0, COLLISION_TYPE_RECTANGLE_RECTANGLE, -1);
+      }
+      resolve_spawn_damage();
+      sprite_batch_begin();
+      render_spawns();
+      sprite_batch_flush();
+      frame_samples.push_back(std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - frame_begin).count());
+
+      event_dispatch_deferred();
+      memory_frame_reset();
+    }
+    f64 total_ms = 0.0;
+    for (const f64 sample : frame_samples) {
+      total_ms += sample;
+    }
+    printf("  spawn population     %5zu spawns, avg %8.3f ms  p99 %8.3f ms per frame over %u frames\n",
+      get_spawns()->size(), total_ms / static_cast<f64>(frame_samples.size()), headless_percentile(frame_samples, .99), HEADLESS_SPAWN_POPULATION_FRAME_COUNT
+    );
+  }
+  clean_up_spawn_state();
+  return true;
+}
+
+/**
+ * @brief Times the spawn grid on its own at MAX_SPAWN_COUNT spawns: inserts through spawn_character(), full rebuilds with nothing else updated,
+ * @brief and player contact queries the size of the player's collision laid out on a lattice over the spawning area.
+ * @brief Runs on the live spawn state, so it clears whatever the main run left behind
+ */
+bool headless_benchmark_spawn_grid(i32 stage_id) {
+  const Rectangle area = get_worldmap_locations().at(stage_id).spawning_areas.at(0);
+  const player_state * const player = gm_get_ingame_info()->player_state_dynamic;
+  if (not player or player == nullptr) {
+    fprintf(stderr, "headless_runner::Spawn grid benchmark has no player to size the queries with\n");
+    return false;
+  }
+  const Vector2 query_size = Vector2 { player->collision.width, player->collision.height };
+
+  clean_up_spawn_state();
+  const auto insert_begin = std::chrono::steady_clock::now();
+  const size_t population = headless_populate_spawn_lattice(area, MAX_SPAWN_COUNT);
+  const f64 insert_ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - insert_begin).count();
+  if (population < MAX_SPAWN_COUNT) {
+    fprintf(stderr, "headless_runner::Spawn grid benchmark placed %zu of %u spawns\n", population, MAX_SPAWN_COUNT);
+    clean_up_spawn_state();
+    return false;
+  }
+
+  const auto rebuild_begin = std::chrono::steady_clock::now();
+  for (u32 pass = 0u; pass < HEADLESS_SPAWN_GRID_REBUILD_PASSES; ++pass) {
+    spawn_rebuild_spatial_grid();
+  }
+  const f64 rebuild_us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - rebuild_begin).count() / static_cast<f64>(HEADLESS_SPAWN_GRID_REBUILD_PASSES);
+
+  const u32 columns = static_cast<u32>(std::ceil(std::sqrt(static_cast<f32>(HEADLESS_SPAWN_GRID_QUERY_COUNT))));
+  u32 contact_count = 0u;
+  const auto query_begin = std::chrono::steady_clock::now();
+  for (u32 itr_000 = 0u; itr_000 < HEADLESS_SPAWN_GRID_QUERY_COUNT; ++itr_000) {
+    const Rectangle query = Rectangle {
+      area.x + (area.width  - query_size.x) * static_cast<f32>(itr_000 % columns) / static_cast<f32>(columns),
+      area.y + (area.height - query_size.y) * static_cast<f32>(itr_000 / columns) / static_cast<f32>(columns),
+      query_size.x, query_size.y
+    };
+    contact_count += query_spawn_player_contact(query).contact_count;
+  }
+  const f64 query_ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - query_begin).count() / static_cast<f64>(HEADLESS_SPAWN_GRID_QUERY_COUNT);
+  clean_up_spawn_state();
+
+  printf("  spawn grid           %5zu spawns, insert %8.3f ns per spawn, rebuild %8.3f us, query %8.3f ns per %.0fx%.0f rect, %u contacts in %u queries\n",
+    population, insert_ms * 1000000.0 / static_cast<f64>(population), rebuild_us, query_ns, query_size.x, query_size.y, contact_count, HEADLESS_SPAWN_GRID_QUERY_COUNT
+  );
+  return true;
+}
+
+#endif // HEADLESS_BUILD
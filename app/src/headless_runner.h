@@ -0,0 +1,13 @@
+
+#ifndef HEADLESS_RUNNER_H
+#define HEADLESS_RUNNER_H
+
+#include "defines.h"
+
+/**
+ * @brief Plays a stage with scripted input at a fixed step, without window, GPU, audio or Steam.
+ * @brief Arguments: --frames=N --spawns=N --tick-rate=HZ --stage=ID --mortal
+ */
+int headless_runner_main(int argc, char** argv);
+
+#endif
@@ -1,8 +1,21 @@
 #include "app.h"
+#include "defines.h"
+
+#if HEADLESS_BUILD
+
+#include "headless_runner.h"
+
+int main(int argc, char** argv)
+{
+	return headless_runner_main(argc, argv);
+}
+
+#else
+
 #include <debugapi.h>
 #include <eh.h>
 
-#include "defines.h"
+#include "core/fjob.h"
 
 #ifdef _RELEASE
 	#include "core/logger.h"
@@ -107,6 +120,7 @@ int entry(void)
   	}
 
     // TODO: Destr
+	job_system_shutdown();
 
 	// Shutdown the SteamAPI
 	SteamAPI_Shutdown();
@@ -162,3 +176,5 @@ int main(void)
     return -1;
 }
 #endif // PLATFORM_WINDOWS
+
+#endif // HEADLESS_BUILD
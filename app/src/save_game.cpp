@@ -117,7 +117,7 @@ bool save_system_initialize() {
     return true;
   }
   // Use fmemory.h for memory allocation
-  state = (save_game_system_state*)allocate_memory_linear(sizeof(save_game_system_state), true);
+  state = (save_game_system_state*)allocate_memory_linear(sizeof(save_game_system_state), true, MEMORY_TAG_APP);
   if (!state) {
     IFATAL("save_game::save_system_initialize()::Save system state allocation failed");
     return false;
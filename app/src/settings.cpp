@@ -46,12 +46,17 @@ constexpr const char * SETTINGS_ACTIVE_SAVE_SLOT = "Active Save Slot";
 constexpr const char * SETTINGS_SOUND = "sound";
 constexpr const char * SETTINGS_WINDOW = "window";
 constexpr const char * SETTINGS_LOCALIZATION = "localization";
+constexpr const char * SETTINGS_SIMULATION = "simulation";
 
 constexpr const char * SETTINGS_SOUND_MASTER = "master";
 constexpr const char * SETTINGS_WINDOW_MODE = "mode";
 constexpr const char * SETTINGS_WINDOW_WIDTH  = "width";
 constexpr const char * SETTINGS_WINDOW_HEIGHT = "heigth";
 constexpr const char * SETTINGS_LOCALIZATION_LANGUAGE = "language";
+constexpr const char * SETTINGS_SIMULATION_TICK_RATE = "tick_rate";
+
+constexpr i32 SETTINGS_SIMULATION_TICK_RATE_MIN = 20;
+constexpr i32 SETTINGS_SIMULATION_TICK_RATE_MAX = 240;
 
 constexpr const char * SETTINGS_WINDOW_MODE_WINDOWED = "windowed";
 constexpr const char * SETTINGS_WINDOW_MODE_BORDERLESS = "borderless";
@@ -98,7 +103,7 @@ bool settings_initialize(void) {
   if (state and state != nullptr) {
     return true;
   }
-  state = (app_settings_system_state *)allocate_memory_linear(sizeof(app_settings_system_state), true);
+  state = (app_settings_system_state *)allocate_memory_linear(sizeof(app_settings_system_state), true, MEMORY_TAG_APP);
   if (not state or state == nullptr) {
     IFATAL("settings::settings_initialize()::State allocation failed");
     return false;
@@ -243,6 +248,7 @@ bool settings_initialize(void) {
     defaults.window_width  = GetMonitorWidth(GetCurrentMonitor()),
     defaults.window_height = GetMonitorHeight(GetCurrentMonitor()),
     defaults.master_sound_volume = DEFAULT_SETTINGS_MASTER_VOLUME;
+    defaults.simulation_tick_rate = DEFAULT_SETTINGS_SIMULATION_TICK_RATE;
     defaults.window_state  = FLAG_BORDERLESS_WINDOWED_MODE;
     defaults.language = DEFAULT_SETTINGS_LANGUAGE;
 
@@ -407,10 +413,14 @@ bool write_ini_file(app_settings& _settings) {
   json localization;
   localization[SETTINGS_LOCALIZATION_LANGUAGE] = _settings.language;
 
+  json simulation;
+  simulation[SETTINGS_SIMULATION_TICK_RATE] = _settings.simulation_tick_rate;
+
   j[SETTINGS_ACTIVE_SAVE_SLOT] = _save_slot;
   j[SETTINGS_SOUND] = sound;
   j[SETTINGS_WINDOW] = window;
   j[SETTINGS_LOCALIZATION] = localization;
+  j[SETTINGS_SIMULATION] = simulation;
 
   return SaveFileText(CONFIG_FILE_LOCATION, j.dump().c_str()); 
 }
@@ -624,6 +634,12 @@ void deserialize_settings_data(json j) {
   }
   else state->settings.language = defaults.language;
 
+  if (j.contains(SETTINGS_SIMULATION)) {
+    const i32 tick_rate = j[SETTINGS_SIMULATION].value(SETTINGS_SIMULATION_TICK_RATE, defaults.simulation_tick_rate);
+    state->settings.simulation_tick_rate = std::clamp(tick_rate, SETTINGS_SIMULATION_TICK_RATE_MIN, SETTINGS_SIMULATION_TICK_RATE_MAX);
+  }
+  else state->settings.simulation_tick_rate = defaults.simulation_tick_rate;
+
   state->settings.active_save_slot = j.value(SETTINGS_ACTIVE_SAVE_SLOT, defaults.active_save_slot);
 
   state->offset = state->settings.window_height * WINDOW_HEIGHT_OFFSET_SCALE;
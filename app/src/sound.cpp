@@ -5,6 +5,8 @@
 #include "core/event.h"
 #include "core/logger.h"
 #include "core/ftime.h"
+#include "core/frandom.h"
+#include "core/fjob.h"
 
 #if USE_PAK_FORMAT 
   #include "tools/pak_parser.h"
@@ -44,8 +46,11 @@ typedef struct sound_system_state {
   std::array<sound_data, SOUND_ID_MAX> sounds;
   std::array<music_data, MUSIC_ID_MAX> musics;
   std::array<soundgroup, SOUNDGROUP_ID_MAX> sound_groups;
+  std::vector<sound_id> pending_sound_decodes;
 
-  #if not USE_PAK_FORMAT
+  #if USE_PAK_FORMAT
+  std::array<std::string, MUSIC_ID_MAX> music_stream_datas; // INFO: Streams decode as they play, asset paks are dropped once loading is done
+  #else
   std::array<file_buffer, SOUND_ID_MAX> sound_datas; 
   std::array<file_buffer, MUSIC_ID_MAX> music_datas; 
   #endif
@@ -71,6 +76,8 @@ static sound_system_state * state = nullptr;
 void load_sound_pak(pak_file_id pak_id, i32 file_id, sound_id id, std::array<f32, 2> pitch_range = {1.f, 1.f});
 void load_music_pak(pak_file_id pak_id, i32 file_id, music_id id);
 void load_sound_disk(const char * filename, sound_id id, std::array<f32, 2> pitch_range = {1.f, 1.f});
+void sound_flush_pending_decodes(void);
+void sound_decode_job(u32 job_index, void* user_data);
 void load_music_disk(const char * filename, music_id id);
 bool media_prev(playlist_control_system_state * playlist_ptr, bool play_now);
 bool media_next(playlist_control_system_state * playlist_ptr, bool play_now);
@@ -89,14 +96,16 @@ bool sound_system_initialize(void) {
   if (state and state != nullptr) {
     return true;
   }
-  state = (sound_system_state*)allocate_memory_linear(sizeof(sound_system_state), true);
+  state = (sound_system_state*)allocate_memory_linear(sizeof(sound_system_state), true, MEMORY_TAG_SOUND);
   if (not state or state == nullptr) {
     IERROR("sound::sound_system_initialize()::State allocation failed");
     return false;
   }
   *state = sound_system_state();
 
+  #if not HEADLESS_BUILD
   InitAudioDevice();
+  #endif
   
   #if USE_PAK_FORMAT
   load_sound_pak(PAK_FILE_ASSET1, PAK_FILE_ASSET1_SOUND_BTN_CLICK_1,      SOUND_ID_BUTTON_ON_CLICK1);
@@ -116,6 +125,7 @@ bool sound_system_initialize(void) {
   load_sound_pak(PAK_FILE_ASSET1, PAK_FILE_ASSET1_SOUND_ZOMBIE_DIE_3,     SOUND_ID_ZOMBIE_DIE3);
   load_sound_pak(PAK_FILE_ASSET1, PAK_FILE_ASSET1_SPIN_SFX,              SOUND_ID_SPIN_SFX);
   load_sound_pak(PAK_FILE_ASSET1, PAK_FILE_ASSET1_SPIN_RESULT,           SOUND_ID_SPIN_RESULT);
+  sound_flush_pending_decodes();
   load_music_pak(PAK_FILE_ASSET1, PAK_FILE_ASSET1_THEME_MAINMENU_1,      MUSIC_ID_MAINMENU_THEME1);
   load_music_pak(PAK_FILE_ASSET1, PAK_FILE_ASSET1_THEME_MAINMENU_2,      MUSIC_ID_MAINMENU_THEME2);
   load_music_pak(PAK_FILE_ASSET1, PAK_FILE_ASSET1_THEME_MAINMENU_3,      MUSIC_ID_MAINMENU_THEME3);
@@ -157,6 +167,7 @@ bool sound_system_initialize(void) {
 
   event_register(EVENT_CODE_PLAY_SOUND, sound_system_on_event);
   event_register(EVENT_CODE_PLAY_SOUND_GROUP, sound_system_on_event);
+  event_set_coalescing(EVENT_CODE_PLAY_SOUND_GROUP, true); // INFO: Same group posted many times in a frame plays once
   event_register(EVENT_CODE_PLAY_MUSIC, sound_system_on_event);
   event_register(EVENT_CODE_RESET_SOUND, sound_system_on_event);
   event_register(EVENT_CODE_RESET_MUSIC, sound_system_on_event);
@@ -182,7 +193,6 @@ void update_sound_system(void) {
 void load_sound_pak([[__maybe_unused__]] pak_file_id pak_file, [[__maybe_unused__]] i32 file_id, [[__maybe_unused__]] sound_id id, [[__maybe_unused__]] std::array<f32, 2> pitch_range) {
   #if USE_PAK_FORMAT
   const file_buffer * file = nullptr;
-  Wave wav;
   sound_data data;
 
   file = get_asset_file_buffer(pak_file, file_id);
@@ -190,22 +200,51 @@ void load_sound_pak([[__maybe_unused__]] pak_file_id pak_file, [[__maybe_unused_
     IWARN("sound::load_sound_pak()::File %d:%d is invalid", pak_file, file_id);
     return;
   }
-  wav = LoadWaveFromMemory(file->file_extension.c_str(), reinterpret_cast<const u8*>(file->content.data()), file->content.size());
   if (not file->is_success) {
     IWARN("sound::load_sound_pak()::File id %d:%d cannot load successfully", pak_file, file_id);
     return;
   }
-  
   data.wav = ZERO_WAV;
   data.file = file;
   data.id = id;
-  data.handle = LoadSoundFromWave(wav);
   data.pitch_range = pitch_range;
-  UnloadWave(wav);
 
   state->sounds.at(id) = data;
+  state->pending_sound_decodes.push_back(id); // INFO: Decoded later by sound_flush_pending_decodes()
   #endif
 }
+/**
+ * @brief Waves are decoded over the job system, sounds are created from them on the calling thread
+ */
+void sound_flush_pending_decodes(void) {
+  if (state->pending_sound_decodes.empty()) {
+    return;
+  }
+  job_dispatch(static_cast<u32>(state->pending_sound_decodes.size()), sound_decode_job, __builtin_addressof(state->pending_sound_decodes));
+
+  for (const sound_id id : state->pending_sound_decodes) {
+    sound_data& data = state->sounds.at(id);
+    if (not data.wav.data or data.wav.data == nullptr) {
+      IWARN("sound::sound_flush_pending_decodes()::Sound %d cannot be decoded", id);
+      continue;
+    }
+    #if not HEADLESS_BUILD
+    data.handle = LoadSoundFromWave(data.wav);
+    #endif
+    UnloadWave(data.wav);
+    data.wav = ZERO_WAV;
+  }
+  state->pending_sound_decodes.clear();
+}
+/**
+ * @brief CPU only, runs on workers
+ */
+void sound_decode_job(u32 job_index, void* user_data) {
+  const std::vector<sound_id>& ids = *static_cast<const std::vector<sound_id>*>(user_data);
+  sound_data& data = state->sounds.at(ids.at(job_index));
+
+  data.wav = LoadWaveFromMemory(data.file->file_extension.c_str(), reinterpret_cast<const u8*>(data.file->content.data()), static_cast<i32>(data.file->content.size()));
+}
 void load_sound_disk([[__maybe_unused__]] const char * filename, [[__maybe_unused__]] sound_id id, [[__maybe_unused__]] std::array<f32, 2> pitch_range) {
   #if not USE_PAK_FORMAT
   const file_buffer * file = __builtin_addressof(state->sound_datas.at(id));
@@ -239,7 +278,9 @@ void load_music_pak([[__maybe_unused__]] pak_file_id pak_file, [[__maybe_unused_
     IWARN("sound::load_music_pak()::File %d:%d is invalid", pak_file, file_id);
     return;
   }
-  music = LoadMusicStreamFromMemory(file->file_extension.c_str(), reinterpret_cast<const u8*>(file->content.data()), file->content.size());
+  std::string& stream_data = state->music_stream_datas.at(id);
+  stream_data.assign(file->content);
+  music = LoadMusicStreamFromMemory(file->file_extension.c_str(), reinterpret_cast<const u8*>(stream_data.data()), static_cast<i32>(stream_data.size()));
   if (not file->is_success) {
     IWARN("sound::load_music_pak()::File id %d cannot load successfully", file->file_id);
     return;
@@ -287,7 +328,7 @@ void play_sound(sound_id id, bool random_pitch) {
     const i32 low = sound.pitch_range.at(0) * 10.f;
     const i32 high = sound.pitch_range.at(1) * 10.f;
   
-    pitch = get_random(low, high) * .1f;
+    pitch = random_range(RANDOM_STREAM_SOUND, low, high) * .1f;
   }
 
   SetSoundPitch(sound.handle, pitch);
@@ -347,7 +388,7 @@ bool media_next(playlist_control_system_state * playlist_ptr, bool play_now) {
   }
 
   if (playlist_ptr->mix_list) {
-    playlist_ptr->current_index = get_random(0, static_cast<i32>(playlist_ptr->queue.size() - 1u));
+    playlist_ptr->current_index = random_range(RANDOM_STREAM_SOUND, 0, static_cast<i32>(playlist_ptr->queue.size() - 1u));
   }
   else {
     if (playlist_ptr->loop_one) {
@@ -482,7 +523,7 @@ void play_soundgroup_sound(soundgroup * group, bool random_pitch) {
   }
 
   if (group->mix_list) {
-    group->current_index = get_random(0, static_cast<i32>(group->queue.size() - 1u));
+    group->current_index = random_range(RANDOM_STREAM_SOUND, 0, static_cast<i32>(group->queue.size() - 1u));
   }
   else {
     if (group->loop_one) {
@@ -80,7 +80,7 @@ bool loc_parser_system_initialize(void) {
   if (state and state != nullptr) {
     return true;
   }
-  state = (loc_parser_system_state*)allocate_memory_linear(sizeof(loc_parser_system_state), true);
+  state = (loc_parser_system_state*)allocate_memory_linear(sizeof(loc_parser_system_state), true, MEMORY_TAG_TOOLS);
   if (not state or state == nullptr) {
     IERROR("loc_parser::loc_parser_system_initialize()::loc parser state allocation failed");
     return false;
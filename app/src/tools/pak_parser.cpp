@@ -4,6 +4,21 @@
 #include "core/fmemory.h"
 #include "core/logger.h"
 
+#if PLATFORM_LINUX
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#ifndef PAK_DEFAULT_LOAD_BACKEND
+  #if PLATFORM_LINUX
+    #define PAK_DEFAULT_LOAD_BACKEND PAK_LOAD_BACKEND_MMAP
+  #else
+    #define PAK_DEFAULT_LOAD_BACKEND PAK_LOAD_BACKEND_FILE_DATA
+  #endif
+#endif
+
 #define HEADER_SYMBOL_BEGIN "__BEGIN__"
 #define HEADER_SYMBOL_BEGIN_LENGTH 9
 #define HEADER_SYMBOL_END "__END__"
@@ -44,40 +59,71 @@ typedef struct filename_offset_data {
   }
 } filename_offset_data;
 
+/**
+ * @brief Bounds of a single __BEGIN__ ... __END__ section in a pak
+ */
+typedef struct pak_section {
+  size_t content_begin;
+  size_t content_length;
+  size_t next_offset;
+  pak_section(void) {
+    this->content_begin = 0u;
+    this->content_length = 0u;
+    this->next_offset = 0u;
+  }
+} pak_section;
+
+/**
+ * @brief Owner of the raw pak bytes. Every index view of a pak points into its storage.
+ */
+typedef struct pak_storage {
+  pak_load_backend backend;
+  u8* data;
+  size_t size;
+  pak_storage(void) {
+    this->backend = PAK_LOAD_BACKEND_FILE_DATA;
+    this->data = nullptr;
+    this->size = 0u;
+  }
+} pak_storage;
+
 typedef struct pak_parser_system_state {
   std::array<worldmap_stage_file, MAX_WORLDMAP_LOCATIONS> worldmap_location_file_datas;
 
   std::array<asset_pak_file, PAK_FILE_MAX> asset_pak_datas;
-  std::string map_pak_data;
+  std::string_view map_pak_data;
   bool is_map_pak_data_initialized;
+  bool is_map_pak_indexed;
 
-  std::string read_buffer;
-  worldmap_stage_file read_wsf_buffer;
+  std::array<pak_storage, PAK_FILE_MAX> pak_storages;
+  pak_load_backend load_backend;
   pak_parser_system_state(void) {
     this->worldmap_location_file_datas.fill(worldmap_stage_file());
 
     this->asset_pak_datas.fill(asset_pak_file());
-    this->map_pak_data = std::string();
+    this->map_pak_data = std::string_view();
     this->is_map_pak_data_initialized = false;
+    this->is_map_pak_indexed = false;
 
-    this->read_buffer = std::string();
-    this->read_wsf_buffer = worldmap_stage_file();
+    this->pak_storages.fill(pak_storage());
+    this->load_backend = PAK_DEFAULT_LOAD_BACKEND;
   }
 } pak_parser_system_state;
 
 static pak_parser_system_state * state = nullptr;
-size_t read_pak_file_data(pak_file_id pak_id, size_t read_start_offset, size_t * out_file_start_offset);
 
-size_t pak_parser_read_to_header_begin(pak_file_id pak_id, size_t offset, size_t delimiter);
-size_t pak_parser_read_to_header_end(pak_file_id pak_id, size_t offset, size_t delimiter);
-size_t pak_parser_read_map_data(size_t offset, size_t *const out_pak_start_offset);
+bool pak_parser_load_pak_data(pak_file_id id);
+bool pak_storage_load(const char * path, u64 max_size, pak_load_backend backend, pak_storage *const out_storage);
+void pak_storage_release(pak_storage *const storage);
+bool pak_parser_build_asset_index(pak_file_id id);
+bool pak_parser_build_map_index(void);
+bool pak_parser_next_section(std::string_view pak_data, size_t offset, pak_section *const out_section);
 
 std::string pak_id_to_file_name(pak_file_id id);
 const asset_pak_file * pak_id_to_pak_file(pak_file_id id);
-const std::string * pak_id_to_pak_data_pointer(pak_file_id id);
+const std::string_view * pak_id_to_pak_data_pointer(pak_file_id id);
 const file_buffer * pak_id_to_file_data_pointer(pak_file_id id, i32 index);
 void assign_pak_data_by_id(pak_file_id id);
-void assign_file_data_by_id(pak_file_id id, i32 index, size_t file_offset_in_pak_data);
 
 u64 get_file_size(pak_file_id id) {
   switch (id) {
@@ -88,22 +134,71 @@ u64 get_file_size(pak_file_id id) {
   }
 }
 
-i32 read_file(const char * path, u64 max_size) {
+/**
+ * @brief FILE_DATA keeps the buffer LoadFileData returns without copying it. MMAP maps the pak read only,
+ * so its pages are read when an asset is decoded and stay reclaimable by the kernel.
+ */
+bool pak_storage_load(const char * path, u64 max_size, pak_load_backend backend, pak_storage *const out_storage) {
   if (not FileExists(path)) {
-    IERROR("main::write_map_pak()::file '%s' doesn't exist", path);
-    return 0;
+    IERROR("pak_parser::pak_storage_load()::file '%s' doesn't exist", path);
+    return false;
   }
-  state->read_buffer.clear();
+  #if PLATFORM_LINUX
+    if (backend == PAK_LOAD_BACKEND_MMAP) {
+      const i32 file_descriptor = open(path, O_RDONLY | O_CLOEXEC);
+      if (file_descriptor < 0) {
+        IERROR("pak_parser::pak_storage_load()::file '%s' cannot be opened", path);
+        return false;
+      }
+      struct stat file_stat = {};
+      if (fstat(file_descriptor, __builtin_addressof(file_stat)) != 0 or file_stat.st_size <= 1 or static_cast<u64>(file_stat.st_size) > max_size) {
+        IERROR("pak_parser::pak_storage_load()::file '%s' is empty or exceeds the maximum size", path);
+        close(file_descriptor);
+        return false;
+      }
+      void * mapped = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+      close(file_descriptor); // INFO: Mapping holds its own reference to the file
+      if (mapped == MAP_FAILED) {
+        IERROR("pak_parser::pak_storage_load()::file '%s' cannot be mapped", path);
+        return false;
+      }
+      out_storage->backend = PAK_LOAD_BACKEND_MMAP;
+      out_storage->data = static_cast<u8*>(mapped);
+      out_storage->size = static_cast<size_t>(file_stat.st_size);
+      return true;
+    }
+  #else
+    if (backend == PAK_LOAD_BACKEND_MMAP) {
+      IWARN("pak_parser::pak_storage_load()::Memory mapped paks are not supported on this platform, using file data");
+    }
+  #endif
   i32 loaded_data = 1;
   u8* data = LoadFileData(path, &loaded_data);
-  if (loaded_data <= 1 or static_cast<u64>(loaded_data) > max_size) {
-    IERROR("pak_parser::read_file()::file '%s' doesn't exist or exceeds the maximum size", path);
-    return 0;
+  if (not data or loaded_data <= 1 or static_cast<u64>(loaded_data) > max_size) {
+    IERROR("pak_parser::pak_storage_load()::file '%s' doesn't exist or exceeds the maximum size", path);
+    if (data) {
+      UnloadFileData(data);
+    }
+    return false;
   }
-  state->read_buffer.assign(data, data + loaded_data);
-
-  UnloadFileData(data);
-	return loaded_data;
+  out_storage->backend = PAK_LOAD_BACKEND_FILE_DATA;
+  out_storage->data = data;
+  out_storage->size = static_cast<size_t>(loaded_data);
+	return true;
+}
+void pak_storage_release(pak_storage *const storage) {
+  if (not storage->data or storage->data == nullptr) {
+    return;
+  }
+  #if PLATFORM_LINUX
+    if (storage->backend == PAK_LOAD_BACKEND_MMAP) {
+      munmap(storage->data, storage->size);
+      *storage = pak_storage();
+      return;
+    }
+  #endif
+  UnloadFileData(storage->data);
+  *storage = pak_storage();
 }
 
 bool pak_parser_system_initialize(void) {
@@ -111,7 +206,7 @@ bool pak_parser_system_initialize(void) {
     IERROR("pak_parser::pak_parser_system_initialize()::Called twice");
     return true;
   }
-  state = (pak_parser_system_state*)allocate_memory_linear(sizeof(pak_parser_system_state), true);
+  state = (pak_parser_system_state*)allocate_memory_linear(sizeof(pak_parser_system_state), true, MEMORY_TAG_TOOLS);
   if (not state or state == nullptr) {
     IERROR("pak_parser::pak_parser_system_initialize()::State allocation failed");
     return false;
@@ -227,190 +322,151 @@ bool pak_parser_system_initialize(void) {
 }
 
 bool parse_asset_pak(pak_file_id id) {
-  switch (id) {
-  	case PAK_FILE_ASSET1: {
-  		if(not state->asset_pak_datas.at(id).is_initialized) {
-  		  const std::string path = pak_id_to_file_name(id);
-  		  state->read_buffer.clear();
-
-  		  if (not read_file(path.c_str(), get_file_size(id))) {
-  		    IERROR("pak_parser::parse_asset_pak()::File read failed");
-  		    return false;
-  		  }
-  		  assign_pak_data_by_id(id);
-  		}
-
-			size_t pak_file_offset = 0u;
-			size_t asset_file_start_offset = 0u;
-  		for (i32 itr_000 = PAK_FILE_ASSET1_UNDEFINED+1; itr_000 < PAK_FILE_ASSET1_MAX; itr_000++) {
-				if (pak_file_offset < state->asset_pak_datas.at(id).pak_data.size()) {
-					pak_file_offset = read_pak_file_data(PAK_FILE_ASSET1, pak_file_offset, __builtin_addressof(asset_file_start_offset));
-          assign_file_data_by_id(id, itr_000, asset_file_start_offset);
-				}
-				else {
-					return true;
-				}
-  		}
-			return true;
-		}
-  	case PAK_FILE_ASSET2: {
-  		if(not state->asset_pak_datas.at(id).is_initialized) {
-  		  const std::string path = pak_id_to_file_name(id);
-  		  state->read_buffer.clear();
-
-  		  if (not read_file(path.c_str(), get_file_size(id))) {
-  		    IERROR("pak_parser::parse_asset_pak()::File read failed");
-  		    return false;
-  		  }
-        //std::string read_buffer_end = state->read_buffer.substr(state->read_buffer.size() - 16u, 16u);
-  		  assign_pak_data_by_id(id);
-  		}
-			size_t pak_file_offset = 0u;
-			size_t asset_file_start_offset = 0u;
-  		for (i32 itr_000 = PAK_FILE_ASSET2_UNDEFINED+1; itr_000 < PAK_FILE_ASSET2_MAX; itr_000++) {
-				if (pak_file_offset < state->asset_pak_datas.at(id).pak_data.size()) {
-					pak_file_offset = read_pak_file_data(PAK_FILE_ASSET2, pak_file_offset, __builtin_addressof(asset_file_start_offset));
-					assign_file_data_by_id(id, itr_000, asset_file_start_offset);
-				}
-				else {
-					return true;
-				}
-  		}
-			return true;
-		}
-  	default: {
-  	  IWARN("pak_parser::parse_asset_pak()::Unsupported Id");
-  	  return false;
-		}
+  if (not state or state == nullptr) {
+    IERROR("pak_parser::parse_asset_pak()::Pak parser system didn't initialized");
+    return false;
   }
-  return false;
+  if (id != PAK_FILE_ASSET1 and id != PAK_FILE_ASSET2) {
+    IWARN("pak_parser::parse_asset_pak()::Unsupported Id");
+    return false;
+  }
+  if (not pak_parser_load_pak_data(id)) {
+    IERROR("pak_parser::parse_asset_pak()::File read failed");
+    return false;
+  }
+  return pak_parser_build_asset_index(id);
 }
 bool parse_map_pak(void) {
-  if(state->map_pak_data.empty()) {
-    const std::string path = pak_id_to_file_name(PAK_FILE_MAP);
-    state->read_buffer.clear();
-    if (not read_file(path.c_str(), get_file_size(PAK_FILE_MAP))) {
-      IERROR("pak_parser::parse_map_pak()::Pak file:'%s' read failed", path.c_str());
+  if (not state or state == nullptr) {
+    IERROR("pak_parser::parse_map_pak()::Pak parser system didn't initialized");
+    return false;
+  }
+  if (not pak_parser_load_pak_data(PAK_FILE_MAP)) {
+    IERROR("pak_parser::parse_map_pak()::Pak file:'%s' read failed", pak_id_to_file_name(PAK_FILE_MAP).c_str());
+    return false;
+  }
+  return pak_parser_build_map_index();
+}
+
+bool pak_parser_load_pak_data(pak_file_id id) {
+  switch (id) {
+    case PAK_FILE_ASSET1:
+    case PAK_FILE_ASSET2: {
+      if (state->asset_pak_datas.at(id).is_initialized) {
+        return true;
+      }
+      break;
+    }
+    case PAK_FILE_MAP: {
+      if (state->is_map_pak_data_initialized) {
+        return true;
+      }
+      break;
+    }
+    default: {
+      IWARN("pak_parser::pak_parser_load_pak_data()::Unsupported pak id");
       return false;
     }
-    assign_pak_data_by_id(PAK_FILE_MAP);
-  }
-	size_t pak_file_offset = 0u;
-	size_t pak_file_start_offset = 0u;
-  for (i32 itr_000 = 0; itr_000 < MAX_WORLDMAP_LOCATIONS; itr_000++) {
-		if (pak_file_offset < state->map_pak_data.size()) {
-      pak_file_offset = pak_parser_read_map_data(pak_file_offset, __builtin_addressof(pak_file_start_offset));
-      assign_file_data_by_id(PAK_FILE_MAP, itr_000, pak_file_start_offset);
-      state->worldmap_location_file_datas.at(itr_000).is_success = true;
-		}
-		else {
-			return true;
-		}
   }
-	return true;
+  const std::string path = pak_id_to_file_name(id);
+  pak_storage_release(__builtin_addressof(state->pak_storages.at(id)));
+  if (not pak_storage_load(path.c_str(), get_file_size(id), state->load_backend, __builtin_addressof(state->pak_storages.at(id)))) {
+    return false;
+  }
+  assign_pak_data_by_id(id);
+  return true;
 }
 
-size_t read_pak_file_data(pak_file_id pak_id, size_t read_start_offset, size_t * out_file_start_offset) {
-  state->read_buffer.clear();
-  const std::string * pak_data = pak_id_to_pak_data_pointer(pak_id);
-  if (not pak_data or pak_data == nullptr) {
-    IERROR("pak_parser::read_pak_file_data()::Pak data is invalid");
-    return 0u;
+/**
+ * @brief Finds the next section starting at offset. Returns false when there is no complete section left.
+ */
+bool pak_parser_next_section(std::string_view pak_data, size_t offset, pak_section *const out_section) {
+  const size_t header_begin = pak_data.find(HEADER_SYMBOL_BEGIN, offset);
+  if (header_begin == std::string_view::npos) {
+    return false;
   }
-  size_t accumulator = read_start_offset;
-
-	accumulator = pak_parser_read_to_header_begin(pak_id, accumulator, pak_data->size());
-
-  //std::string header_begin = std::string();
-  //if (accumulator + HEADER_SYMBOL_BEGIN_LENGTH <= pak_file->pak_data.size()) {
-  //  header_begin = pak_file->pak_data.substr(accumulator, HEADER_SYMBOL_BEGIN_LENGTH);
-  //}
-  //else {
-  //  header_begin = pak_file->pak_data.substr(accumulator, pak_file->pak_data.size() - accumulator);
-  //}
-
-  *out_file_start_offset = accumulator;
-  size_t out_size = pak_parser_read_to_header_end(pak_id, accumulator, pak_data->size());
+  const size_t content_begin = header_begin + HEADER_SYMBOL_BEGIN_LENGTH;
+  const size_t header_end = pak_data.find(HEADER_SYMBOL_END, content_begin);
+  if (header_end == std::string_view::npos) {
+    return false;
+  }
+  out_section->content_begin = content_begin;
+  out_section->content_length = header_end - content_begin;
+  out_section->next_offset = header_end + HEADER_SYMBOL_END_LENGTH;
+  return true;
+}
 
-  //std::string header_end = state->read_buffer.substr(state->read_buffer.size() - 16u, 16u);
+/**
+ * @brief Walks the pak once and points every file buffer into the pak data. Later lookups are plain index accesses.
+ */
+bool pak_parser_build_asset_index(pak_file_id id) {
+  asset_pak_file& pak = state->asset_pak_datas.at(id);
+  if (pak.is_indexed) {
+    return true;
+  }
+  const std::string_view pak_data = pak.pak_data;
+  const i32 file_count = id == PAK_FILE_ASSET1 ? static_cast<i32>(PAK_FILE_ASSET1_MAX) : static_cast<i32>(PAK_FILE_ASSET2_MAX);
+  
+  size_t pak_file_offset = 0u;
+  pak_section section = pak_section();
+  for (i32 itr_000 = 1; itr_000 < file_count and static_cast<size_t>(itr_000) < pak.file_buffers.size(); ++itr_000) {
+    if (not pak_parser_next_section(pak_data, pak_file_offset, __builtin_addressof(section))) {
+      IWARN("pak_parser::pak_parser_build_asset_index()::Pak '%s' ended at file %d", pak.pak_file_name.c_str(), itr_000);
+      break;
+    }
+    file_buffer& file = pak.file_buffers.at(static_cast<size_t>(itr_000));
+    file.content = pak_data.substr(section.content_begin, section.content_length);
+    file.offset = section.content_begin;
+    file.is_success = true;
 
-  return out_size;
+    pak_file_offset = section.next_offset;
+  }
+  pak.is_indexed = true;
+  return true;
 }
 
-size_t pak_parser_read_to_header_begin(pak_file_id pak_id, size_t offset, size_t delimiter) {
-  state->read_buffer.clear();
-  const std::string * pak_data = pak_id_to_pak_data_pointer(pak_id);
-  if (not pak_data or pak_data == nullptr) {
-    IERROR("pak_parser::read_pak_file_data()::Pak data is invalid");
-    return 0u;
+/**
+ * @brief Map pak has collision, one section per tilemap layer and prop sections for every stage in that order
+ */
+bool pak_parser_build_map_index(void) {
+  if (state->is_map_pak_indexed) {
+    return true;
   }
-  size_t out_offset = offset;
-	
-  for (size_t itr_000 = out_offset; itr_000 + HEADER_SYMBOL_BEGIN_LENGTH < delimiter; ++itr_000) {
+  const std::string_view pak_data = state->map_pak_data;
 
-		std::string header_symbol = pak_data->substr(itr_000, HEADER_SYMBOL_BEGIN_LENGTH);
-    if (TextIsEqual(header_symbol.c_str(), HEADER_SYMBOL_BEGIN)) {
-			break;
+  size_t pak_file_offset = 0u;
+  pak_section section = pak_section();
+  for (i32 itr_000 = 0; itr_000 < MAX_WORLDMAP_LOCATIONS; ++itr_000) {
+    worldmap_stage_file stage = worldmap_stage_file();
+    stage.stage_index = itr_000;
+
+    if (not pak_parser_next_section(pak_data, pak_file_offset, __builtin_addressof(section))) {
+      break;
     }
-    state->read_buffer.push_back(pak_data->at(itr_000));
-    out_offset = itr_000;
-  }
-  if (out_offset + HEADER_SYMBOL_BEGIN_LENGTH > delimiter) {
-    return delimiter;
-  }
-  else {
-    return out_offset + HEADER_SYMBOL_BEGIN_LENGTH;
-  }
-}
-size_t pak_parser_read_to_header_end(pak_file_id pak_id, size_t offset, size_t delimiter) {
-  state->read_buffer.clear();
-  const std::string * pak_data = pak_id_to_pak_data_pointer(pak_id);
-  if (not pak_data or pak_data == nullptr) {
-    IERROR("pak_parser::read_pak_file_data()::Pak data is invalid");
-    return 0u;
-  }
-  size_t out_offset = offset;
-	
-  for (size_t itr_000 = out_offset; itr_000 + HEADER_SYMBOL_END_LENGTH < delimiter; ++itr_000) {
-    out_offset = itr_000;
-
-		std::string header_symbol = pak_data->substr(itr_000, HEADER_SYMBOL_END_LENGTH);
-    if (TextIsEqual(header_symbol.c_str(), HEADER_SYMBOL_END)) {
-			break;
+    stage.pak_offset = section.content_begin;
+    stage.file_collision = pak_data.substr(section.content_begin, section.content_length);
+    pak_file_offset = section.next_offset;
+
+    bool is_complete = true;
+    for (i32 itr_111 = 0; itr_111 < MAX_TILEMAP_LAYERS and is_complete; ++itr_111) {
+      is_complete = pak_parser_next_section(pak_data, pak_file_offset, __builtin_addressof(section));
+      if (is_complete) {
+        stage.layer_data.at(itr_111) = pak_data.substr(section.content_begin, section.content_length);
+        pak_file_offset = section.next_offset;
+      }
     }
-    state->read_buffer.push_back(pak_data->at(itr_000));
-  }
+    if (not is_complete or not pak_parser_next_section(pak_data, pak_file_offset, __builtin_addressof(section))) {
+      IWARN("pak_parser::pak_parser_build_map_index()::Stage %d is incomplete", itr_000);
+      break;
+    }
+    stage.file_prop = pak_data.substr(section.content_begin, section.content_length);
+    pak_file_offset = section.next_offset;
 
-  if (out_offset + HEADER_SYMBOL_END_LENGTH > delimiter) {
-    return delimiter;
-  }
-  else {
-    return out_offset + HEADER_SYMBOL_END_LENGTH;
+    stage.is_success = true;
+    state->worldmap_location_file_datas.at(itr_000) = stage;
   }
-}
-size_t pak_parser_read_map_data(size_t offset, size_t *const out_pak_start_offset) {
-  state->read_buffer.clear();
-  size_t out_offset = offset;
-  size_t file_start = 0u;
-
-  out_offset = read_pak_file_data(PAK_FILE_MAP, out_offset, __builtin_addressof(file_start));
-  state->read_wsf_buffer.file_collision = state->read_buffer;
-  *out_pak_start_offset = file_start;
-
-  out_offset = read_pak_file_data(PAK_FILE_MAP, out_offset, __builtin_addressof(file_start));
-  state->read_wsf_buffer.layer_data.at(0) = state->read_buffer;
-  out_offset = read_pak_file_data(PAK_FILE_MAP, out_offset, __builtin_addressof(file_start));
-  state->read_wsf_buffer.layer_data.at(1) = state->read_buffer;
-  out_offset = read_pak_file_data(PAK_FILE_MAP, out_offset, __builtin_addressof(file_start));
-  state->read_wsf_buffer.layer_data.at(2) = state->read_buffer;
-  out_offset = read_pak_file_data(PAK_FILE_MAP, out_offset, __builtin_addressof(file_start));
-  state->read_wsf_buffer.layer_data.at(3) = state->read_buffer;
-  out_offset = read_pak_file_data(PAK_FILE_MAP, out_offset, __builtin_addressof(file_start));
-  state->read_wsf_buffer.layer_data.at(4) = state->read_buffer;
-  
-  out_offset = read_pak_file_data(PAK_FILE_MAP, out_offset, __builtin_addressof(file_start));
-  state->read_wsf_buffer.file_prop = state->read_buffer;
-  return out_offset;
+  state->is_map_pak_indexed = true;
+  return true;
 }
 
 std::string pak_id_to_file_name(pak_file_id id) {
@@ -450,7 +506,7 @@ const asset_pak_file * pak_id_to_pak_file(pak_file_id id) {
   IERROR("pak_parser::pak_id_to_pak_file()::Function ended unexpectedly");
   return nullptr;
 }
-const std::string * pak_id_to_pak_data_pointer(pak_file_id id) {
+const std::string_view * pak_id_to_pak_data_pointer(pak_file_id id) {
   if (id >= PAK_FILE_MAX or id <= PAK_FILE_UNDEFINED) {
     IWARN("pak_parser::pak_id_to_pak_data_pointer()::File id is out of bound");
     return nullptr;
@@ -480,14 +536,14 @@ const file_buffer * pak_id_to_file_data_pointer(pak_file_id id, i32 index) {
   }
   switch (id) {
     case PAK_FILE_ASSET1: {
-			if (static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
+			if (index < 0 or static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
     		IWARN("pak_parser::pak_id_to_file_data_pointer()::Index is out of bound");
 				return nullptr;
 			}
 			return __builtin_addressof(state->asset_pak_datas.at(id).file_buffers.at(index));
 		}
     case PAK_FILE_ASSET2: {
-			if (static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
+			if (index < 0 or static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
     		IWARN("pak_parser::pak_id_to_file_data_pointer()::Index is out of bound");
 				return nullptr;
 			}
@@ -506,23 +562,25 @@ void assign_pak_data_by_id(pak_file_id id) {
     IWARN("pak_parser::assign_pak_data_by_id()::File id is out of bound");
     return;
   }
+  const pak_storage& storage = state->pak_storages.at(id);
+  const std::string_view pak_storage_view = std::string_view(reinterpret_cast<const char *>(storage.data), storage.size);
   switch (id) {
     case PAK_FILE_ASSET1: {
-      state->asset_pak_datas.at(id).pak_data.clear();
-      state->asset_pak_datas.at(id).pak_data.assign(state->read_buffer);
+      state->asset_pak_datas.at(id).pak_data = pak_storage_view;
       state->asset_pak_datas.at(id).is_initialized = true;
+      state->asset_pak_datas.at(id).is_indexed = false;
       return;
     }
     case PAK_FILE_ASSET2: {
-      state->asset_pak_datas.at(id).pak_data.clear();
-      state->asset_pak_datas.at(id).pak_data.assign(state->read_buffer);
+      state->asset_pak_datas.at(id).pak_data = pak_storage_view;
       state->asset_pak_datas.at(id).is_initialized = true;
+      state->asset_pak_datas.at(id).is_indexed = false;
       return;
     }
     case PAK_FILE_MAP: {
-      state->map_pak_data.clear();
-      state->map_pak_data.assign(state->read_buffer);
+      state->map_pak_data = pak_storage_view;
       state->is_map_pak_data_initialized = true;
+      state->is_map_pak_indexed = false;
       return;
     }
     default:{
@@ -533,68 +591,35 @@ void assign_pak_data_by_id(pak_file_id id) {
   IERROR("pak_parser::pak_id_to_file_name()::Function ended unexpectedly");
   return;
 }
+/**
+ * @brief Releases the pak bytes. Every file view of that pak is invalidated and will be fetched again on the next access.
+ */
 void pak_parser_drop_pak_data(pak_file_id id) {
   switch (id) {
-    case PAK_FILE_ASSET1: {
-      state->asset_pak_datas.at(id).pak_data.clear();
-      return;
-    }
-    case PAK_FILE_ASSET2: {
-      state->asset_pak_datas.at(id).pak_data.clear();
-      return;
-    }
-    case PAK_FILE_MAP: {
-      state->map_pak_data.clear();
-    }
-    default: return;
-  }
-}
-void assign_file_data_by_id(pak_file_id id, i32 index, size_t file_offset_in_pak_data) {
-  if (id >= PAK_FILE_MAX or id <= PAK_FILE_UNDEFINED) {
-    IWARN("pak_parser::assign_file_data_by_id()::File id is out of bound");
-    return;
-  }
-  switch (id) {
-    case PAK_FILE_ASSET1: {
-			if (static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
-    		IERROR("pak_parser::assign_file_data_by_id()::Index is out of bound");
-				return;
-			}
-      //std::string header_begin = state->read_buffer.substr(0, HEADER_SYMBOL_BEGIN_LENGTH);
-      //std::string header_end = state->read_buffer.substr(state->read_buffer.size() - 16u, 16u);
-
-      state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).content.clear();
-      state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).content.assign(state->read_buffer);
-			state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).offset = file_offset_in_pak_data;
-			state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).is_success = true;
-      return;
-    }
+    case PAK_FILE_ASSET1:
     case PAK_FILE_ASSET2: {
-			if (static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
-    		IWARN("pak_parser::assign_file_data_by_id()::Index is out of bound");
-				return;
-			}
-      state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).content.clear();
-      state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).content.assign(state->read_buffer);
-			state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).offset = file_offset_in_pak_data;
-			state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index)).is_success = true;
+      asset_pak_file& pak = state->asset_pak_datas.at(id);
+      for (file_buffer& file : pak.file_buffers) {
+        file.content = std::string_view();
+        file.offset = 0u;
+        file.is_success = false;
+      }
+      pak.pak_data = std::string_view();
+      pak.is_initialized = false;
+      pak.is_indexed = false;
+      pak_storage_release(__builtin_addressof(state->pak_storages.at(id)));
       return;
     }
     case PAK_FILE_MAP: {
-			if (static_cast<size_t>(index) >= state->worldmap_location_file_datas.size()) {
-    		IWARN("pak_parser::assign_file_data_by_id()::Index is out of bound");
-				return;
-			}
-      state->worldmap_location_file_datas.at(index) = state->read_wsf_buffer;
-      return;
-    }
-    default:{
-      IWARN("pak_parser::assign_file_data_by_id()::Unsupported pak id");
+      state->worldmap_location_file_datas.fill(worldmap_stage_file());
+      state->map_pak_data = std::string_view();
+      state->is_map_pak_data_initialized = false;
+      state->is_map_pak_indexed = false;
+      pak_storage_release(__builtin_addressof(state->pak_storages.at(id)));
       return;
     }
+    default: return;
   }
-  IERROR("pak_parser::assign_file_data_by_id()::Function ended unexpectedly");
-  return;
 }
 
 const file_buffer * get_asset_file_buffer(pak_file_id id, i32 index) {
@@ -602,58 +627,24 @@ const file_buffer * get_asset_file_buffer(pak_file_id id, i32 index) {
     IERROR("pak_parser::get_asset_file_buffer()::Pak parser system didn't initialized");
     return nullptr;
   }
-  if (id >= PAK_FILE_MAX or id <= PAK_FILE_UNDEFINED) {
-    IWARN("pak_parser::get_asset_file_buffer()::File id is out of bound");
+  if (id != PAK_FILE_ASSET1 and id != PAK_FILE_ASSET2) {
+    IWARN("pak_parser::get_asset_file_buffer()::Unsupported pak id");
     return nullptr;
   }
-  switch (id) {
-    case PAK_FILE_ASSET1: {
-  		if (static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
-  		  IWARN("pak_parser::get_asset_file_buffer()::Index is out of bound");
-  		  return nullptr;
-  		}
-      file_buffer& file = state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index));
-      if (file.is_success) {
-        return &file;
-      }
-      else {
-        return fetch_asset_file_buffer(id, index);
-      }
-    }
-    case PAK_FILE_ASSET2:{
-  		if (static_cast<size_t>(index) >= state->asset_pak_datas.at(id).file_buffers.size()) {
-  		  IWARN("pak_parser::get_asset_file_buffer()::Index is out of bound");
-  		  return nullptr;
-  		}
-      file_buffer& file = state->asset_pak_datas.at(id).file_buffers.at(static_cast<size_t>(index));
-      if (file.is_success) {
-        return &file;
-      }
-      else {
-        return fetch_asset_file_buffer(id, index);
-      }
-    }
-    default:{
-      IWARN("pak_parser::get_asset_file_buffer()::Unsupported pak id");
-      return nullptr;
-    }
+  const file_buffer * const file = pak_id_to_file_data_pointer(id, index);
+  if (not file or file == nullptr) {
+    return nullptr;
   }
-  IERROR("pak_parser::get_asset_file_buffer()::Function ended unexpectedly");
-  return nullptr;
+  return file->is_success ? file : fetch_asset_file_buffer(id, index);
 }
 const file_buffer * fetch_asset_file_buffer(pak_file_id id, i32 index) {
-  if (id >= PAK_FILE_MAX or id <= PAK_FILE_UNDEFINED) {
-    IWARN("pak_parser::fetch_asset_file_buffer()::Pak id is out of bound");
+  if (not state or state == nullptr) {
+    IERROR("pak_parser::fetch_asset_file_buffer()::Pak parser system didn't initialized");
     return nullptr;
   }
-  if (not state->asset_pak_datas.at(id).is_initialized) {
-    const std::string path = pak_id_to_file_name(id);
-    state->read_buffer.clear();
-    if (not read_file(path.c_str(), get_file_size(id))) {
-      IERROR("pak_parser::fetch_asset_file_buffer()::File read failed");
-      return nullptr;
-    }
-    assign_pak_data_by_id(id);
+  if (id != PAK_FILE_ASSET1 and id != PAK_FILE_ASSET2) {
+    IWARN("pak_parser::fetch_asset_file_buffer()::Pak id is out of bound");
+    return nullptr;
   }
   if (id == PAK_FILE_ASSET1 and (index <= PAK_FILE_ASSET1_UNDEFINED or index >= PAK_FILE_ASSET1_MAX)) {
     return nullptr;
@@ -661,49 +652,68 @@ const file_buffer * fetch_asset_file_buffer(pak_file_id id, i32 index) {
   else if (id == PAK_FILE_ASSET2 and (index <= PAK_FILE_ASSET2_UNDEFINED or index >= PAK_FILE_ASSET2_MAX)) {
     return nullptr;
   }
-  const file_buffer * const buffer = pak_id_to_file_data_pointer(id, index);
-  if (not buffer or buffer == nullptr) {
-    IERROR("pak_parser::fetch_asset_file_buffer()::File pointer is invalid");
+  if (not pak_parser_load_pak_data(id)) {
+    IERROR("pak_parser::fetch_asset_file_buffer()::File read failed");
     return nullptr;
   }
-  size_t file_start_offset_in_pak= 0u;
-  for (i32 itr_000 = 0; itr_000 < index; ++itr_000) {
-	  read_pak_file_data(id, file_start_offset_in_pak, __builtin_addressof(file_start_offset_in_pak));
+  pak_parser_build_asset_index(id);
+
+  const file_buffer * const buffer = pak_id_to_file_data_pointer(id, index);
+  if (not buffer or buffer == nullptr or not buffer->is_success) {
+    IERROR("pak_parser::fetch_asset_file_buffer()::File:%d is not in the pak", index);
+    return nullptr;
   }
-	assign_file_data_by_id(id, index, file_start_offset_in_pak);
   return buffer;
 }
 
 const worldmap_stage_file * get_map_file_buffer(i32 index) {
   if (not state or state == nullptr) {
-    IERROR("pak_parser::get_asset_file_buffer()::Pak parser system didn't initialized");
+    IERROR("pak_parser::get_map_file_buffer()::Pak parser system didn't initialized");
     return nullptr;
   }
   if (index >= MAX_WORLDMAP_LOCATIONS or index < 0) {
-    IWARN("pak_parser::get_asset_file_buffer()::File id is out of bound");
+    IWARN("pak_parser::get_map_file_buffer()::File id is out of bound");
     return nullptr;
   }
-  worldmap_stage_file& file = state->worldmap_location_file_datas.at(index);
+  const worldmap_stage_file& file = state->worldmap_location_file_datas.at(index);
   return file.is_success ? &file : fetch_map_file_buffer(index);
 }
 const worldmap_stage_file * fetch_map_file_buffer(i32 index) {
-  if (state->map_pak_data.empty()) {
-    const std::string path = pak_id_to_file_name(PAK_FILE_MAP);
-    state->read_buffer.clear();
-    if (not read_file(path.c_str(), get_file_size(PAK_FILE_MAP))) {
-      IERROR("pak_parser::fetch_asset_file_buffer()::File read failed");
-      return nullptr;
-    }
-    assign_pak_data_by_id(PAK_FILE_MAP);
+  if (not state or state == nullptr) {
+    IERROR("pak_parser::fetch_map_file_buffer()::Pak parser system didn't initialized");
+    return nullptr;
   }
   if (index < 0 or index >= MAX_WORLDMAP_LOCATIONS) {
     return nullptr;
   }
-  size_t file_start_offset_in_pak= 0u;
-  for (i32 itr_000 = 0; itr_000 < index; ++itr_000) {
-	  pak_parser_read_map_data(file_start_offset_in_pak, __builtin_addressof(file_start_offset_in_pak));
-    assign_file_data_by_id(PAK_FILE_MAP, index, file_start_offset_in_pak);
+  if (not pak_parser_load_pak_data(PAK_FILE_MAP)) {
+    IERROR("pak_parser::fetch_map_file_buffer()::File read failed");
+    return nullptr;
+  }
+  pak_parser_build_map_index();
+
+  const worldmap_stage_file& file = state->worldmap_location_file_datas.at(index);
+  if (not file.is_success) {
+    IERROR("pak_parser::fetch_map_file_buffer()::Stage:%d is not in the pak", index);
+    return nullptr;
   }
+  return __builtin_addressof(file);
+}
 
-  return __builtin_addressof(state->worldmap_location_file_datas.at(index));;
+void pak_parser_set_load_backend(pak_load_backend backend) {
+  if (not state or state == nullptr) {
+    IERROR("pak_parser::pak_parser_set_load_backend()::Pak parser system didn't initialized");
+    return;
+  }
+  if (backend >= PAK_LOAD_BACKEND_MAX) {
+    IWARN("pak_parser::pak_parser_set_load_backend()::Backend is out of bound");
+    return;
+  }
+  state->load_backend = backend;
+}
+pak_load_backend pak_parser_get_load_backend(void) {
+  if (not state or state == nullptr) {
+    return PAK_DEFAULT_LOAD_BACKEND;
+  }
+  return state->load_backend;
 }
@@ -4,6 +4,15 @@
 
 #include "defines.h"
 
+/**
+ * @brief How pak bytes are brought into memory. Only affects paks loaded after it is set.
+ */
+typedef enum pak_load_backend {
+  PAK_LOAD_BACKEND_FILE_DATA,
+  PAK_LOAD_BACKEND_MMAP, // INFO: Linux only, other platforms fall back to file data
+  PAK_LOAD_BACKEND_MAX,
+} pak_load_backend;
+
 [[__nodiscard__]] bool pak_parser_system_initialize(void);
 
 bool parse_asset_pak(pak_file_id id);
@@ -17,4 +26,7 @@ const worldmap_stage_file * fetch_map_file_buffer(i32 index);
 
 void pak_parser_drop_pak_data(pak_file_id id);
 
+void pak_parser_set_load_backend(pak_load_backend backend);
+pak_load_backend pak_parser_get_load_backend(void);
+
 #endif
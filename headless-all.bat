@@ -0,0 +1,10 @@
+@ECHO OFF
+REM Build the headless runner
+
+ECHO "Building headless runner..."
+
+REM App
+make -f "Makefile.app.windows.headless.mak" all
+IF %ERRORLEVEL% NEQ 0 (echo Error:%ERRORLEVEL% && exit)
+
+ECHO "All assemblies built successfully."